@@ -0,0 +1,354 @@
+// src/Game/Actor.cpp
+#include "Actor.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/JobSystem.hpp"
+#include "src/Game/ScriptCache.hpp"
+
+namespace fs = std::filesystem;
+
+// ===================================================================
+// WorkspaceSnapshot
+// ===================================================================
+
+void WorkspaceSnapshot::capture(Workspace& ws) {
+    parts.clear();
+    byName.clear();
+    parts.reserve(ws.cubes.size());
+    bySlot.assign(ws.cubes.slotCount(), -1);
+
+    for (auto& cube : ws.cubes) {
+        if (!cube.isActive()) continue;   // Actor からは workspace にあるパーツだけが見える
+        PartSnapshot s;
+        s.source = &cube;
+        s.handle = cube.handle;
+        s.Name = cube.Name;
+        s.ClassName = cube.ClassName;
+        s.pos = cube.pos();
+        s.size = cube.size();
+        s.color = cube.color();
+        s.rotation = cube.rotation();
+        s.velocity = cube.velocity();
+        s.transparency = cube.transparency();
+        s.anchored = cube.anchored();
+        byName.emplace(s.Name, parts.size());  // 同名なら最初のものを残す
+        bySlot[cube.handle.index] = (int32_t)parts.size();
+        parts.push_back(std::move(s));
+    }
+}
+
+const PartSnapshot* WorkspaceSnapshot::find(const std::string& name) const {
+    Atom key = Atom::find(name);
+    if (!key.valid()) return nullptr;
+    auto it = byName.find(key);
+    return (it != byName.end()) ? &parts[it->second] : nullptr;
+}
+
+const PartSnapshot* WorkspaceSnapshot::get(PartHandle h) const {
+    if (h.index >= bySlot.size() || bySlot[h.index] < 0) return nullptr;
+    const PartSnapshot& part = parts[(size_t)bySlot[h.index]];
+    return part.handle == h ? &part : nullptr;
+}
+
+// ===================================================================
+// Lua バインディング（Actor 用）
+// ===================================================================
+namespace {
+    const char* ACTOR_PART_META = "ActorPart";
+
+    void pushVector(lua_State* L, const Vector3& v) {
+        lua_newtable(L);
+        lua_pushnumber(L, v.x); lua_setfield(L, -2, "X");
+        lua_pushnumber(L, v.y); lua_setfield(L, -2, "Y");
+        lua_pushnumber(L, v.z); lua_setfield(L, -2, "Z");
+    }
+
+    Vector3 checkVector(lua_State* L, int index) {
+        luaL_checktype(L, index, LUA_TTABLE);
+        lua_getfield(L, index, "X");
+        lua_getfield(L, index, "Y");
+        lua_getfield(L, index, "Z");
+        Vector3 v((float)luaL_checknumber(L, -3), (float)luaL_checknumber(L, -2), (float)luaL_checknumber(L, -1));
+        lua_pop(L, 3);
+        return v;
+    }
+
+    // スナップショットの添字はフレームごとに変わるので、ハンドルで持つ
+    void pushPart(lua_State* L, const PartSnapshot& part) {
+        lua_newtable(L);
+        lua_pushinteger(L, (lua_Integer)part.handle.pack());
+        lua_setfield(L, -2, "_handle");
+        luaL_setmetatable(L, ACTOR_PART_META);
+    }
+
+    // self テーブルからスナップショット上のパーツを取得
+    const PartSnapshot* toPart(lua_State* L, int index) {
+        const WorkspaceSnapshot* snap = Actor::fromState(L)->currentSnapshot();
+        if (!snap || !lua_istable(L, index)) return nullptr;
+
+        lua_getfield(L, index, "_handle");
+        bool ok = lua_isinteger(L, -1);
+        PartHandle h = ok ? PartHandle::unpack(lua_tointeger(L, -1)) : PartHandle{};
+        lua_pop(L, 1);
+
+        return ok ? snap->get(h) : nullptr;
+    }
+
+    int part_IsA(lua_State* L) {
+        const char* className = luaL_checkstring(L, 2);
+        const PartSnapshot* part = toPart(L, 1);
+        // IsA は不変の ClassName しか見ないので並列フェーズ中でも安全
+        lua_pushboolean(L, part && part->source->IsA(className));
+        return 1;
+    }
+
+    int part_index(lua_State* L) {
+        const char* key = luaL_checkstring(L, 2);
+        const PartSnapshot* part = toPart(L, 1);
+        if (!part) {
+            lua_pushnil(L);
+            return 1;
+        }
+
+        if (strcmp(key, "Name") == 0)              lua_pushstring(L, part->Name.c_str());
+        else if (strcmp(key, "ClassName") == 0)    lua_pushstring(L, part->ClassName.c_str());
+        else if (strcmp(key, "Position") == 0)     pushVector(L, part->pos);
+        else if (strcmp(key, "Velocity") == 0)     pushVector(L, part->velocity);
+        else if (strcmp(key, "Size") == 0)         pushVector(L, part->size);
+        else if (strcmp(key, "Color") == 0)        pushVector(L, part->color);
+        else if (strcmp(key, "Rotation") == 0)     pushVector(L, part->rotation);
+        else if (strcmp(key, "Transparency") == 0) lua_pushnumber(L, part->transparency);
+        else if (strcmp(key, "Anchored") == 0)     lua_pushboolean(L, part->anchored);
+        else if (strcmp(key, "IsA") == 0)          lua_pushcfunction(L, part_IsA);
+        else                                       lua_pushnil(L);
+        return 1;
+    }
+
+    int part_newindex(lua_State* L) {
+        const char* key = luaL_checkstring(L, 2);
+        const PartSnapshot* part = toPart(L, 1);
+        if (!part) return 0;
+
+        DeferredWrite w{part->handle, DeferredWrite::Property::Position, Vector3(0, 0, 0), 0.0f};
+        if (strcmp(key, "Position") == 0) {
+            w.property = DeferredWrite::Property::Position;
+            w.value = checkVector(L, 3);
+        } else if (strcmp(key, "Velocity") == 0) {
+            w.property = DeferredWrite::Property::Velocity;
+            w.value = checkVector(L, 3);
+        } else if (strcmp(key, "Color") == 0) {
+            w.property = DeferredWrite::Property::Color;
+            w.value = checkVector(L, 3);
+        } else if (strcmp(key, "Transparency") == 0) {
+            w.property = DeferredWrite::Property::Transparency;
+            w.scalar = (float)luaL_checknumber(L, 3);
+        } else {
+            return luaL_error(L, "%s is not a writable property", key);
+        }
+
+        Actor::fromState(L)->queueWrite(w);
+        return 0;
+    }
+
+    // workspace:FindFirstChild(name)
+    int ws_FindFirstChild(lua_State* L) {
+        int nameIndex = lua_istable(L, 1) ? 2 : 1;
+        const char* name = luaL_checkstring(L, nameIndex);
+
+        const WorkspaceSnapshot* snap = Actor::fromState(L)->currentSnapshot();
+        const PartSnapshot* found = snap ? snap->find(name) : nullptr;
+        if (found) {
+            pushPart(L, *found);
+        } else {
+            lua_pushnil(L);
+        }
+        return 1;
+    }
+
+    // workspace:GetChildren()
+    int ws_GetChildren(lua_State* L) {
+        const WorkspaceSnapshot* snap = Actor::fromState(L)->currentSnapshot();
+        size_t n = snap ? snap->parts.size() : 0;
+
+        lua_createtable(L, (int)n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            pushPart(L, snap->parts[i]);
+            lua_rawseti(L, -2, (lua_Integer)(i + 1));
+        }
+        return 1;
+    }
+
+    // RunService.Heartbeat:Connect(fn)
+    int heartbeat_Connect(lua_State* L) {
+        int fnIndex = (lua_type(L, 1) == LUA_TTABLE) ? 2 : 1;
+        luaL_checktype(L, fnIndex, LUA_TFUNCTION);
+        Actor* actor = Actor::fromState(L);
+        ScriptStats* script = actor->getProfiler().statsForFunction(L, fnIndex);
+        lua_pushvalue(L, fnIndex);
+        actor->addHeartbeat(luaL_ref(L, LUA_REGISTRYINDEX), script);
+        return 0;
+    }
+}
+
+// ===================================================================
+// Actor
+// ===================================================================
+
+Actor::Actor(const std::string& name, const std::vector<std::string>& scriptPaths)
+    : Name(name), profiler(name), L(nullptr), scripts(scriptPaths), snapshot(nullptr)
+{
+    L = profiler.newState();
+    luaL_openlibs(L);
+    profiler.registerLua(L, false);  // 並列フェーズ中に他の VM を読まないよう自分の分だけ
+    lua_gc(L, LUA_GCGEN, 0, 0);
+
+    // lua_State -> Actor を extraspace に保持（レジストリ参照より速い）
+    *static_cast<Actor**>(lua_getextraspace(L)) = this;
+
+    registerBindings();
+}
+
+Actor::~Actor() {
+    if (L) {
+        lua_close(L);
+        L = nullptr;
+    }
+}
+
+Actor* Actor::fromState(lua_State* L) {
+    return *static_cast<Actor**>(lua_getextraspace(L));
+}
+
+void Actor::registerBindings() {
+    // パーツのメタテーブル
+    luaL_newmetatable(L, ACTOR_PART_META);
+    lua_pushcfunction(L, part_index);
+    lua_setfield(L, -2, "__index");
+    lua_pushcfunction(L, part_newindex);
+    lua_setfield(L, -2, "__newindex");
+    lua_pop(L, 1);
+
+    // workspace
+    lua_newtable(L);
+    lua_pushcfunction(L, ws_FindFirstChild);
+    lua_setfield(L, -2, "FindFirstChild");
+    lua_pushcfunction(L, ws_GetChildren);
+    lua_setfield(L, -2, "GetChildren");
+    lua_setglobal(L, "workspace");
+
+    // RunService.Heartbeat
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushcfunction(L, heartbeat_Connect);
+    lua_setfield(L, -2, "Connect");
+    lua_setfield(L, -2, "Heartbeat");
+    lua_setglobal(L, "RunService");
+}
+
+bool Actor::load(const WorkspaceSnapshot& snap) {
+    snapshot = &snap;
+    bool ok = true;
+    for (const auto& path : scripts) {
+        if (ScriptCache::get().doFile(L, path) != LUA_OK) {
+            std::cerr << "Lua load error [" << Name << "]: " << lua_tostring(L, -1) << std::endl;
+            lua_pop(L, 1);
+            ok = false;
+        }
+    }
+    snapshot = nullptr;
+    return ok;
+}
+
+void Actor::step(const WorkspaceSnapshot& snap, float dt) {
+    snapshot = &snap;
+    for (const auto& hb : heartbeats) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, hb.ref);
+        lua_pushnumber(L, dt);
+        if (profiler.call(L, 1, hb.script) != LUA_OK) {
+            std::cerr << "Lua error [" << Name << "]: " << lua_tostring(L, -1) << std::endl;
+            lua_pop(L, 1);
+        }
+    }
+    snapshot = nullptr;
+}
+
+// ===================================================================
+// ActorManager
+// ===================================================================
+
+Actor* ActorManager::createActor(Workspace& ws, const std::string& name, const std::vector<std::string>& scriptPaths) {
+    actors.push_back(std::make_unique<Actor>(name, scriptPaths));
+    Actor* actor = actors.back().get();
+
+    // 初回実行もスナップショット越しに行い、書き込みはすぐコミットする
+    snapshot.capture(ws);
+    actor->load(snapshot);
+    commit(ws);
+    return actor;
+}
+
+void ActorManager::loadDirectory(Workspace& ws, const std::string& root) {
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) return;
+
+    std::vector<fs::path> entries;
+    for (const auto& entry : fs::directory_iterator(root, ec)) {
+        entries.push_back(entry.path());
+    }
+    std::sort(entries.begin(), entries.end());
+
+    for (const auto& path : entries) {
+        if (fs::is_directory(path, ec)) {
+            std::vector<std::string> group;
+            for (const auto& file : fs::directory_iterator(path, ec)) {
+                if (file.path().extension() == ".lua") group.push_back(file.path().string());
+            }
+            if (group.empty()) continue;
+            std::sort(group.begin(), group.end());
+            createActor(ws, path.filename().string(), group);
+        } else if (path.extension() == ".lua") {
+            createActor(ws, path.stem().string(), {path.string()});
+        }
+    }
+
+    std::cout << "✓ Actors loaded: " << actors.size()
+              << " (workers: " << JobSystem::get().concurrency() << ")" << std::endl;
+}
+
+void ActorManager::step(Workspace& ws, float dt) {
+    if (actors.empty()) return;
+
+    // 1. スナップショット（メインスレッド）
+    snapshot.capture(ws);
+
+    // 2. 並列フェーズ: 各 Actor は自分の lua_State とスナップショットだけに触る
+    JobSystem::get().parallelFor(actors.size(), [&](size_t i) {
+        actors[i]->step(snapshot, dt);
+    });
+
+    // 3. コミットフェーズ（メインスレッド）
+    commit(ws);
+}
+
+void ActorManager::commit(Workspace& ws) {
+    // Actor の登録順に適用するので、同じプロパティへの競合は後の Actor が勝つ
+    for (auto& actor : actors) {
+        for (const auto& w : actor->pendingWrites()) {
+            Cube* c = ws.getPart(w.target);
+            if (!c) continue;   // 並列フェーズの後に削除された
+            switch (w.property) {
+                case DeferredWrite::Property::Position:     c->pos() = w.value; c->markChanged(Prop_Position); break;
+                case DeferredWrite::Property::Velocity:     c->setVelocity(w.value); c->markChanged(Prop_Velocity); break;
+                case DeferredWrite::Property::Color:        c->color() = w.value; c->markChanged(Prop_Color); break;
+                case DeferredWrite::Property::Transparency: c->transparency() = w.scalar; c->markChanged(Prop_Transparency); break;
+            }
+            c->wakeUp();
+        }
+        actor->pendingWrites().clear();
+    }
+}
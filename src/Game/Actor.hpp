@@ -0,0 +1,120 @@
+// src/Game/Actor.hpp
+#ifndef ACTOR_HPP
+#define ACTOR_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Game/Atom.hpp"
+#include "src/Game/Workspace.hpp"
+#include "src/Game/ScriptProfiler.hpp"
+
+struct lua_State;
+
+// ===================================================================
+// Workspace の読み取り専用スナップショット
+// 並列フェーズ中、Actor はこれだけを読む（本物の cubes には触らない）
+// ===================================================================
+struct PartSnapshot {
+    Cube* source;          // 元のパーツ（並列フェーズ中は不変の classId しか読まない）
+    PartHandle handle;
+    Atom Name;             // 毎フレームのコピーは文字列でなくポインタ
+    Atom ClassName;
+    Vector3 pos, size, color, rotation, velocity;
+    float transparency;
+    bool anchored;
+};
+
+struct WorkspaceSnapshot {
+    std::vector<PartSnapshot> parts;
+    std::unordered_map<Atom, size_t> byName;  // 名前 -> 最初に見つかった parts の添字
+    std::vector<int32_t> bySlot;              // ハンドルのスロット番号 -> parts の添字（なければ -1）
+
+    void capture(Workspace& ws);
+    const PartSnapshot* find(const std::string& name) const;
+    // 削除済みのパーツなら nullptr
+    const PartSnapshot* get(PartHandle h) const;
+};
+
+// 並列フェーズで発生した書き込み。メインスレッドのコミットフェーズで適用する
+struct DeferredWrite {
+    enum class Property { Position, Velocity, Color, Transparency };
+
+    PartHandle target;     // コミット時に引き直す（削除済みなら捨てる）
+    Property property;
+    Vector3 value;
+    float scalar;
+};
+
+// ===================================================================
+// Actor: 独立した lua_State を持つスクリプトグループ
+// ===================================================================
+class Actor {
+public:
+    std::string Name;
+
+    Actor(const std::string& name, const std::vector<std::string>& scriptPaths);
+    ~Actor();
+
+    Actor(const Actor&) = delete;
+    Actor& operator=(const Actor&) = delete;
+
+    // スクリプトを読み込んで実行する（メインスレッドから呼ぶ）
+    bool load(const WorkspaceSnapshot& snapshot);
+
+    // 並列フェーズ: Heartbeat コールバックを実行する（ワーカースレッドから呼ばれる）
+    void step(const WorkspaceSnapshot& snapshot, float dt);
+
+    // コミットフェーズ: 溜まった書き込みを取り出す
+    std::vector<DeferredWrite>& pendingWrites() { return writes; }
+
+    // Lua バインディングから使う
+    static Actor* fromState(lua_State* L);
+    const WorkspaceSnapshot* currentSnapshot() const { return snapshot; }
+    void queueWrite(const DeferredWrite& w) { writes.push_back(w); }
+    void addHeartbeat(int ref, ScriptStats* script) { heartbeats.push_back({ref, script}); }
+    ScriptProfiler& getProfiler() { return profiler; }
+
+private:
+    struct Heartbeat {
+        int ref;
+        ScriptStats* script;
+    };
+
+    ScriptProfiler profiler;   // L より先に作り、L より後に壊す
+    lua_State* L;
+    std::vector<std::string> scripts;
+    std::vector<Heartbeat> heartbeats;
+    std::vector<DeferredWrite> writes;
+    const WorkspaceSnapshot* snapshot;
+
+    void registerBindings();
+};
+
+// ===================================================================
+// ActorManager: 全 Actor を JobSystem 上で並列に回す
+// ===================================================================
+class ActorManager {
+public:
+    // root 直下のサブディレクトリ1つ = Actor 1つ（中の *.lua をまとめて読む）
+    // root 直下の *.lua はそれぞれ単独の Actor になる
+    void loadDirectory(Workspace& ws, const std::string& root);
+
+    Actor* createActor(Workspace& ws, const std::string& name, const std::vector<std::string>& scriptPaths);
+
+    // 1フレーム分: スナップショット取得 -> 並列実行 -> メインスレッドでコミット
+    void step(Workspace& ws, float dt);
+
+    size_t actorCount() const { return actors.size(); }
+
+private:
+    std::vector<std::unique_ptr<Actor>> actors;
+    WorkspaceSnapshot snapshot;
+
+    void commit(Workspace& ws);
+};
+
+#endif // ACTOR_HPP
@@ -0,0 +1,289 @@
+// src/Game/Animation.cpp
+#include "Animation.hpp"
+#include <algorithm>
+#include <cmath>
+
+#include "src/Game/Joint.hpp"
+#include "src/Game/JobSystem.hpp"
+
+// ====================================================================
+// AnimationClip
+// ====================================================================
+
+Quaternion AnimationClip::JointTrack::sample(float t) const {
+    if (keys.empty()) return Quaternion();
+    if (t <= keys.front().time) return keys.front().rotation;
+    if (t >= keys.back().time) return keys.back().rotation;
+
+    auto it = std::upper_bound(keys.begin(), keys.end(), t,
+                               [](float time, const Keyframe& k) { return time < k.time; });
+    const Keyframe& b = *it;
+    const Keyframe& a = *(it - 1);
+    float u = (t - a.time) / (b.time - a.time);
+    return Quaternion::slerp(a.rotation, b.rotation, u);
+}
+
+void AnimationClip::addKey(const std::string& joint, float time, const Quaternion& rotation) {
+    Atom name(joint);
+    auto track = std::find_if(tracks.begin(), tracks.end(),
+                              [&](const JointTrack& t) { return t.joint == name; });
+    if (track == tracks.end()) {
+        tracks.push_back(JointTrack{name, {}});
+        track = tracks.end() - 1;
+    }
+    auto at = std::upper_bound(track->keys.begin(), track->keys.end(), time,
+                               [](float t, const Keyframe& k) { return t < k.time; });
+    track->keys.insert(at, Keyframe{time, rotation.normalized()});
+}
+
+// 両腕をゆっくり前後に揺らす
+std::shared_ptr<AnimationClip> AnimationClip::r6Idle() {
+    auto clip = std::make_shared<AnimationClip>("Idle", 2.0f, true);
+    for (float t : {0.0f, 1.0f, 2.0f}) {
+        float a = (t == 1.0f) ? 4.0f : 0.0f;
+        // 左右の肩は C0 が鏡写しなので、同じ向きに振るには符号を逆にする
+        clip->addKeyAngle("Right Shoulder", t, a);
+        clip->addKeyAngle("Left Shoulder", t, -a);
+    }
+    return clip;
+}
+
+// 腕と脚を互い違いに振る（Roblox の旧 Animate スクリプトと同じ組み合わせ）
+std::shared_ptr<AnimationClip> AnimationClip::r6Walk() {
+    const float length = 0.8f;
+    const float amplitude = 40.0f;
+    const int segments = 8;
+    auto clip = std::make_shared<AnimationClip>("Walk", length, true);
+    for (int i = 0; i <= segments; ++i) {
+        float t = length * i / segments;
+        float a = amplitude * std::sin(2.0f * M_PI * i / segments);
+        if (std::abs(a) < 1e-3f) a = 0.0f;
+        clip->addKeyAngle("Right Shoulder", t, a);
+        clip->addKeyAngle("Left Shoulder", t, a);
+        clip->addKeyAngle("Right Hip", t, -a);
+        clip->addKeyAngle("Left Hip", t, -a);
+    }
+    return clip;
+}
+
+// ====================================================================
+// AnimationTrack
+// ====================================================================
+
+void AnimationTrack::fadeTo(float target, float fadeTime) {
+    targetWeight = target;
+    fadeRate = fadeTime > 0.0f ? std::abs(target - weight) / fadeTime : 0.0f;
+}
+
+void AnimationTrack::play(float fadeTime, float w, float s) {
+    // 止まりきったトラックは頭から（フェードアウト中なら続きから）
+    if (!playing && weight == 0.0f) time = 0.0f;
+    playing = true;
+    speed = s;
+    fadeTo(w, fadeTime);
+}
+
+void AnimationTrack::stop(float fadeTime) {
+    playing = false;
+    fadeTo(0.0f, fadeTime);
+}
+
+void AnimationTrack::adjustWeight(float w, float fadeTime) {
+    if (playing) fadeTo(w, fadeTime);
+}
+
+void AnimationTrack::advance(float dt) {
+    if (weight != targetWeight) {
+        if (fadeRate <= 0.0f) {
+            weight = targetWeight;
+        } else {
+            float step = fadeRate * dt;
+            weight = weight < targetWeight ? std::min(targetWeight, weight + step)
+                                           : std::max(targetWeight, weight - step);
+        }
+    }
+    if (weight == 0.0f && !playing) return;
+
+    float length = clip->length;
+    time += dt * speed;
+    if (length <= 0.0f) {
+        time = 0.0f;
+    } else if (looped) {
+        time = std::fmod(time, length);
+        if (time < 0.0f) time += length;
+    } else if (time >= length || time < 0.0f) {
+        // ループしないクリップは端の姿勢のまま消えていく
+        time = std::max(0.0f, std::min(length, time));
+        if (playing) stop();
+    }
+}
+
+// ====================================================================
+// Animator
+// ====================================================================
+
+Animator::Animator(AnimationSystem* system)
+    : Instance("Animator", "Animator"), system(system)
+{
+    if (system) system->add(this);
+}
+
+Animator::~Animator() {
+    if (system) system->remove(this);
+}
+
+AnimationTrack* Animator::loadAnimation(std::shared_ptr<const AnimationClip> clip) {
+    if (!clip) return nullptr;
+    // 後から足された関節も拾えるように引き直す
+    bind();
+    tracks.push_back(std::unique_ptr<AnimationTrack>(new AnimationTrack(std::move(clip))));
+    AnimationTrack* track = tracks.back().get();
+    bindTrack(*track);
+    return track;
+}
+
+bool Animator::needsUpdate() const {
+    if (applied) return true;
+    for (const auto& t : tracks) {
+        if (t->playing || t->weight > 0.0f) return true;
+    }
+    return false;
+}
+
+void Animator::bindIfStale() {
+    if (Parent != boundParent || DestroyQueue::releaseCount() != boundReleases) bind();
+}
+
+void Animator::bind() {
+    joints.clear();
+    boundParent = Parent;
+    boundReleases = DestroyQueue::releaseCount();
+    if (Parent) {
+        Parent->forEachDescendant([&](Instance* d) {
+            if (d->IsA(ClassId::Motor6D) && !d->destroying && joints.size() < INT16_MAX) {
+                joints.push_back(static_cast<JointInstance*>(d));
+            }
+        });
+    }
+
+    size_t n = joints.size();
+    pose.assign(n, Quaternion());
+    posed.assign(n, 0);
+    layerSum.assign(n, Quaternion());
+    layerWeight.assign(n, 0.0f);
+    layerJoints.clear();
+    layerJoints.reserve(n);
+    order.reserve(tracks.size() + 1);
+    for (auto& t : tracks) bindTrack(*t);
+}
+
+void Animator::bindTrack(AnimationTrack& track) const {
+    const auto& clipTracks = track.clip->tracks;
+    track.binding.assign(clipTracks.size(), -1);
+    for (size_t k = 0; k < clipTracks.size(); ++k) {
+        for (size_t b = 0; b < joints.size(); ++b) {
+            if (joints[b]->Name == clipTracks[k].joint) {
+                track.binding[k] = (int16_t)b;
+                break;
+            }
+        }
+    }
+}
+
+void Animator::evaluate(float dt) {
+    // 重みのあるトラックを優先度の低い順に（数個なので挿入ソート。確保しない）
+    order.clear();
+    for (auto& t : tracks) {
+        t->advance(dt);
+        if (t->weight <= 0.0f) continue;
+        order.push_back(t.get());
+        for (size_t i = order.size() - 1; i > 0 && order[i - 1]->priority > order[i]->priority; --i) {
+            std::swap(order[i - 1], order[i]);
+        }
+    }
+
+    std::fill(posed.begin(), posed.end(), 0);
+    for (size_t i = 0; i < order.size();) {
+        // 同じ優先度の層: 重み付きで足し合わせる（符号を揃えて短い方の弧で混ぜる）
+        AnimationPriority layer = order[i]->priority;
+        layerJoints.clear();
+        for (; i < order.size() && order[i]->priority == layer; ++i) {
+            const AnimationTrack& t = *order[i];
+            const auto& clipTracks = t.clip->tracks;
+            for (size_t k = 0; k < clipTracks.size(); ++k) {
+                int b = t.binding[k];
+                if (b < 0) continue;
+                Quaternion q = clipTracks[k].sample(t.time);
+                if (layerWeight[b] == 0.0f) {
+                    layerJoints.push_back((uint16_t)b);
+                    layerSum[b] = q * t.weight;
+                } else {
+                    if (q.dot(layerSum[b]) < 0.0f) q = -q;
+                    layerSum[b] = layerSum[b] + q * t.weight;
+                }
+                layerWeight[b] += t.weight;
+            }
+        }
+
+        // 下の層の結果に、この層を重みの合計（最大 1）だけ重ねる
+        for (uint16_t b : layerJoints) {
+            Quaternion q = layerSum[b].normalized();
+            float alpha = std::min(layerWeight[b], 1.0f);
+            pose[b] = alpha >= 1.0f ? q : Quaternion::nlerp(posed[b] ? pose[b] : Quaternion(), q, alpha);
+            posed[b] = 1;
+            layerWeight[b] = 0.0f;
+        }
+    }
+}
+
+void Animator::apply() {
+    bool wrote = false;
+    for (size_t b = 0; b < joints.size(); ++b) {
+        joints[b]->setTransform(posed[b] ? pose[b] : Quaternion());
+        wrote = wrote || posed[b];
+    }
+    applied = wrote;
+}
+
+// ====================================================================
+// AnimationSystem
+// ====================================================================
+
+AnimationSystem::~AnimationSystem() {
+    // 後から解放される Animator が触らないように
+    for (Animator* a : animators) a->system = nullptr;
+}
+
+void AnimationSystem::remove(Animator* a) {
+    auto it = std::find(animators.begin(), animators.end(), a);
+    if (it != animators.end()) {
+        *it = animators.back();
+        animators.pop_back();
+    }
+}
+
+void AnimationSystem::step(float dt) {
+    // 1. メインスレッド: 関節を引き直し、書くものがある Animator だけ集める
+    active.clear();
+    for (Animator* a : animators) {
+        if (a->destroying) continue;
+        a->bindIfStale();
+        if (a->needsUpdate()) active.push_back(a);
+    }
+    if (active.empty()) return;
+
+    // 2. 並列フェーズ: 1 Animator は数十マイクロ秒もかからないので、まとめて1ジョブにする
+    const size_t kChunk = 16;
+    size_t jobs = (active.size() + kChunk - 1) / kChunk;
+    if (parallel && jobs > 1) {
+        JobSystem::get().parallelFor(jobs, [&](size_t job) {
+            size_t end = std::min(active.size(), (job + 1) * kChunk);
+            for (size_t i = job * kChunk; i < end; ++i) active[i]->evaluate(dt);
+        });
+    } else {
+        for (Animator* a : active) a->evaluate(dt);
+    }
+
+    // 3. メインスレッド: Motor6D に書く（姿勢の反映は JointSystem::step）
+    for (Animator* a : active) a->apply();
+}
@@ -0,0 +1,190 @@
+// src/Game/Animation.hpp
+#ifndef ANIMATION_HPP
+#define ANIMATION_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+#include "src/Math/Quaternion.hpp"
+#include "src/Game/Atom.hpp"
+#include "src/Game/Instance.hpp"
+
+class JointInstance;
+class AnimationSystem;
+
+struct Keyframe {
+    float time;            // 秒
+    Quaternion rotation;   // Motor6D.Transform に書く回転
+};
+
+// ===================================================================
+// AnimationClip: 関節ごとの回転のキーフレーム列
+// 関節は名前（Motor6D の Name）で指すので、同じ名前の関節を持つリグなら使い回せる。
+// 再生中は読むだけ（複数の Animator が並列に同時に読む）
+// ===================================================================
+class AnimationClip {
+public:
+    struct JointTrack {
+        Atom joint;
+        std::vector<Keyframe> keys;   // time の昇順
+
+        // 時刻 t の回転（前後のキーを球面補間。範囲外は端のキー）
+        Quaternion sample(float t) const;
+    };
+
+    std::string name;
+    float length;
+    bool looped;
+    std::vector<JointTrack> tracks;
+
+    AnimationClip(const std::string& name, float length, bool looped = true)
+        : name(name), length(length), looped(looped) {}
+
+    // キーを足す（時刻順でなくてもよい）
+    void addKey(const std::string& joint, float time, const Quaternion& rotation);
+    // Motor6D の回転軸（C0 の Z軸）回りに degrees 度
+    void addKeyAngle(const std::string& joint, float time, float degrees) {
+        addKey(joint, time, Quaternion::fromAxisAngle(Vector3(0, 0, 1), degrees * M_PI / 180.0f));
+    }
+
+    // R6 リグ（Player）用の組み込みクリップ
+    static std::shared_ptr<AnimationClip> r6Idle();
+    static std::shared_ptr<AnimationClip> r6Walk();
+};
+
+// 高い方が上に重なる（Roblox の AnimationPriority と同じ並び）
+enum class AnimationPriority : uint8_t { Core, Idle, Movement, Action };
+
+// ===================================================================
+// AnimationTrack: Animator の上で再生されるクリップ（Roblox の AnimationTrack）
+// Animator::loadAnimation で作り、Animator が持つ（Animator と一緒に消える）
+// ===================================================================
+class AnimationTrack {
+public:
+    AnimationPriority priority = AnimationPriority::Core;
+    bool looped;
+
+    // fadeTime 秒かけて weight まで上げる
+    void play(float fadeTime = 0.1f, float weight = 1.0f, float speed = 1.0f);
+    // fadeTime 秒かけて 0 まで下げ、止める
+    void stop(float fadeTime = 0.1f);
+    void adjustWeight(float weight, float fadeTime = 0.1f);
+    void adjustSpeed(float s) { speed = s; }
+
+    bool isPlaying() const { return playing; }
+    float getWeight() const { return weight; }       // フェード中の今の重み
+    float getSpeed() const { return speed; }
+    float getTimePosition() const { return time; }
+    void setTimePosition(float t) { time = t; }
+    const AnimationClip& getClip() const { return *clip; }
+
+private:
+    friend class Animator;
+
+    explicit AnimationTrack(std::shared_ptr<const AnimationClip> clip)
+        : looped(clip->looped), clip(std::move(clip)) {}
+
+    std::shared_ptr<const AnimationClip> clip;
+    std::vector<int16_t> binding;   // clip->tracks の添字 -> Animator の関節の添字（-1 は対応なし）
+    float time = 0.0f;
+    float speed = 1.0f;
+    float weight = 0.0f;
+    float targetWeight = 0.0f;
+    float fadeRate = 0.0f;          // 1秒あたりの重みの変化（0 ならすぐ targetWeight）
+    bool playing = false;
+
+    void fadeTo(float target, float fadeTime);
+    // 時刻と重みを dt だけ進める
+    void advance(float dt);
+};
+
+// ===================================================================
+// Animator: 親（Model / Player）の Motor6D にアニメーションを書く
+//
+// 同じ優先度のトラックは重みで平均し、優先度の低い層から順に
+// 上の層を（その層の重みの合計だけ）重ねる。結果は Motor6D.Transform に書く。
+// evaluate() は自分のトラックとポーズの配列にしか触らないので、
+// AnimationSystem が全 Animator をワーカースレッドで並列に評価できる
+// ===================================================================
+class Animator : public Instance {
+public:
+    explicit Animator(AnimationSystem* system);
+    ~Animator() override;
+
+    // クリップを再生できるトラックを作る（Animator:LoadAnimation）
+    AnimationTrack* loadAnimation(std::shared_ptr<const AnimationClip> clip);
+
+    size_t boundJointCount() const { return joints.size(); }
+
+    // 書き込むものがあるか（再生中・フェードアウト中のトラックか、戻すべき Transform）
+    bool needsUpdate() const;
+
+    // ---- AnimationSystem から呼ばれる ----
+    // メインスレッド: 親の Motor6D を名前で引き直す（親・関節が変わったときだけ）
+    void bindIfStale();
+    // ワーカースレッド: トラックを進めてポーズを計算する
+    void evaluate(float dt);
+    // メインスレッド: ポーズを Motor6D.Transform に書く
+    void apply();
+
+private:
+    friend class AnimationSystem;
+
+    AnimationSystem* system;   // AnimationSystem が先に壊れたら nullptr
+    std::vector<std::unique_ptr<AnimationTrack>> tracks;
+
+    // 親の Motor6D（DestroyQueue::releaseCount が変わるか親が変わったら引き直す）
+    std::vector<JointInstance*> joints;
+    const Instance* boundParent = nullptr;
+    uint64_t boundReleases = UINT64_MAX;
+
+    // 評価の結果と作業用の配列（フレームごとに確保しない）
+    std::vector<Quaternion> pose;
+    std::vector<uint8_t> posed;            // この関節に書いた層があるか
+    std::vector<Quaternion> layerSum;
+    std::vector<float> layerWeight;
+    std::vector<uint16_t> layerJoints;     // 今の層が触った関節
+    std::vector<AnimationTrack*> order;    // 優先度順のトラック
+    bool applied = false;                  // 前回 Transform を書いた（止まったら単位回転に戻す）
+
+    void bind();
+    void bindTrack(AnimationTrack& track) const;
+};
+
+// ===================================================================
+// AnimationSystem: Animator の登録と毎フレームの一括評価
+//   1. メインスレッド: 関節の引き直し、更新の要る Animator の列挙
+//   2. 並列フェーズ: Animator ごとにポーズを計算（JobSystem）
+//   3. メインスレッド: Motor6D.Transform に書く（JointSystem への通知はスレッド安全でない）
+// ===================================================================
+class AnimationSystem {
+public:
+    AnimationSystem() = default;
+    ~AnimationSystem();
+
+    AnimationSystem(const AnimationSystem&) = delete;
+    AnimationSystem& operator=(const AnimationSystem&) = delete;
+
+    // 毎フレーム物理の前に呼ぶ（Motor6D の姿勢は JointSystem::step で反映される）
+    void step(float dt);
+
+    // false なら全てメインスレッドで評価する（比較・デバッグ用）
+    void setParallel(bool p) { parallel = p; }
+    bool isParallel() const { return parallel; }
+
+    size_t animatorCount() const { return animators.size(); }
+    size_t activeCount() const { return active.size(); }   // 前回の step で評価した数
+
+    // Animator から呼ばれる
+    void add(Animator* a) { animators.push_back(a); }
+    void remove(Animator* a);
+
+private:
+    std::vector<Animator*> animators;
+    std::vector<Animator*> active;     // 今フレームに評価する Animator（容量を使い回す）
+    bool parallel = true;
+};
+
+#endif // ANIMATION_HPP
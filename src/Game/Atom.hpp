@@ -0,0 +1,86 @@
+// src/Game/Atom.hpp
+#ifndef ATOM_HPP
+#define ATOM_HPP
+
+#include <string>
+#include <unordered_set>
+#include <functional>
+#include <ostream>
+
+// ===================================================================
+// Atom: インターンされた文字列
+// 同じ内容の文字列は1つの実体を共有するので、比較はポインタ比較、
+// ハッシュはアドレスで済む。実体はプログラム終了まで解放しない
+// 登録（文字列からの構築）はメインスレッドだけで行う。Actor の並列フェーズ中は
+// find と比較しか呼ばれないので、表にロックは持たない
+// ===================================================================
+class Atom {
+public:
+    Atom() : s(&emptyString()) {}
+    Atom(const std::string& str) : s(intern(str)) {}
+    Atom(const char* str) : s(intern(str)) {}
+
+    // 登録済みの Atom を探す（登録はしない）
+    // 見つからなければどの Atom とも一致しない値を返す
+    static Atom find(const std::string& str) {
+        const auto& strings = table();
+        auto it = strings.find(str);
+        return Atom(it != strings.end() ? &*it : &missing());
+    }
+
+    bool valid() const { return s != &missing(); }
+
+    const std::string& str() const { return *s; }
+    operator const std::string&() const { return *s; }
+    const char* c_str() const { return s->c_str(); }
+    bool empty() const { return s->empty(); }
+    size_t size() const { return s->size(); }
+
+    bool operator==(const Atom& other) const { return s == other.s; }
+    bool operator!=(const Atom& other) const { return s != other.s; }
+    // インターンしていない文字列とは中身で比べる
+    bool operator==(const std::string& other) const { return *s == other; }
+    bool operator!=(const std::string& other) const { return *s != other; }
+    bool operator==(const char* other) const { return *s == other; }
+    bool operator!=(const char* other) const { return *s != other; }
+
+    size_t hash() const { return std::hash<const void*>()(s); }
+
+    // 登録済みの文字列の数
+    static size_t count() { return table().size(); }
+
+private:
+    const std::string* s;
+
+    explicit Atom(const std::string* p) : s(p) {}
+
+    // unordered_set のノードは rehash しても動かないので、要素のアドレスを実体として使う
+    static std::unordered_set<std::string>& table() {
+        static auto* t = new std::unordered_set<std::string>();   // 静的オブジェクトの破棄中も使えるよう解放しない
+        return *t;
+    }
+    static const std::string& emptyString() {
+        static const std::string* e = intern(std::string());
+        return *e;
+    }
+    static const std::string& missing() {
+        static const std::string m;
+        return m;
+    }
+    static const std::string* intern(const std::string& str) {
+        return &*table().insert(str).first;
+    }
+};
+
+inline bool operator==(const std::string& a, const Atom& b) { return b == a; }
+inline bool operator!=(const std::string& a, const Atom& b) { return b != a; }
+
+inline std::ostream& operator<<(std::ostream& os, const Atom& a) { return os << a.str(); }
+
+namespace std {
+    template <> struct hash<Atom> {
+        size_t operator()(const Atom& a) const { return a.hash(); }
+    };
+}
+
+#endif // ATOM_HPP
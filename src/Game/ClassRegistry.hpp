@@ -0,0 +1,99 @@
+// src/Game/ClassRegistry.hpp
+#ifndef CLASSREGISTRY_HPP
+#define CLASSREGISTRY_HPP
+
+#include <cstdint>
+#include <string>
+#include <cstring>
+
+// ===================================================================
+// クラス登録表
+// X(クラス名, 親クラス名) の順に並べる（親は必ず先に書く）。
+// 祖先の集合はコンパイル時にビットマスクとして計算するので、
+// IsA はマスクのテスト1回で済む
+// ===================================================================
+#define INSTANCE_CLASSES(X) \
+    X(Instance,      Instance)        \
+    X(Workspace,     Instance)        \
+    X(Model,         Instance)        \
+    X(Player,        Model)           \
+    X(Folder,        Instance)        \
+    X(BasePart,      Instance)        \
+    X(Part,          BasePart)        \
+    X(MeshPart,      BasePart)        \
+    X(JointInstance, Instance)        \
+    X(Weld,          JointInstance)   \
+    X(Motor6D,       JointInstance)   \
+    X(Animator,      Instance)
+
+enum class ClassId : uint8_t {
+#define X(name, parent) name,
+    INSTANCE_CLASSES(X)
+#undef X
+    Count
+};
+
+namespace ClassRegistry {
+    using Mask = uint64_t;
+    static_assert((size_t)ClassId::Count <= 64, "ClassId は Mask のビット数まで");
+
+    constexpr ClassId kParents[] = {
+#define X(name, parent) ClassId::parent,
+        INSTANCE_CLASSES(X)
+#undef X
+    };
+
+    constexpr const char* kNames[] = {
+#define X(name, parent) #name,
+        INSTANCE_CLASSES(X)
+#undef X
+    };
+
+    constexpr Mask bit(ClassId id) { return Mask(1) << (unsigned)id; }
+
+    // 自分と全ての祖先のビット
+    constexpr Mask ancestorsOf(ClassId id) {
+        Mask m = bit(id);
+        while (id != ClassId::Instance) {
+            id = kParents[(size_t)id];
+            m |= bit(id);
+        }
+        return m;
+    }
+
+    struct AncestorTable {
+        Mask masks[(size_t)ClassId::Count];
+        constexpr AncestorTable() : masks() {
+            for (size_t i = 0; i < (size_t)ClassId::Count; ++i) masks[i] = ancestorsOf((ClassId)i);
+        }
+    };
+    constexpr AncestorTable kAncestors{};
+
+    constexpr bool isA(ClassId cls, ClassId base) {
+        return (kAncestors.masks[(size_t)cls] & bit(base)) != 0;
+    }
+
+    inline const char* name(ClassId id) { return kNames[(size_t)id]; }
+
+    constexpr size_t kNameLengths[] = {
+#define X(name, parent) sizeof(#name) - 1,
+        INSTANCE_CLASSES(X)
+#undef X
+    };
+
+    // クラス名 -> ClassId。未登録なら false
+    inline bool find(const std::string& className, ClassId& out) {
+        for (size_t i = 0; i < (size_t)ClassId::Count; ++i) {
+            if (className.size() == kNameLengths[i] && std::memcmp(className.data(), kNames[i], kNameLengths[i]) == 0) {
+                out = (ClassId)i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static_assert(isA(ClassId::Part, ClassId::BasePart) && isA(ClassId::Part, ClassId::Instance), "Part の祖先");
+    static_assert(!isA(ClassId::BasePart, ClassId::Part), "祖先は上向きだけ");
+}
+
+#endif // CLASSREGISTRY_HPP
@@ -0,0 +1,336 @@
+// src/Game/ComponentStore.hpp
+#ifndef COMPONENTSTORE_HPP
+#define COMPONENTSTORE_HPP
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Math/MathUtils.hpp"
+
+struct Cube;
+
+// ===================================================================
+// 構成要素（コンポーネント）
+// パーツのデータは種類ごとに分けて持ち、必要なものだけを付ける。
+// 例: プレイヤーの手足（装飾）は Transform + Renderable だけで、
+//     慣性テンソルや反発係数は持たない
+// ===================================================================
+
+// パーツの形（Roblox の Part.Shape）。どれも大きさ size の箱に収まる
+//   Ball: 直径は size の一番短い辺
+//   Cylinder: ローカルの X 軸向き。長さは size.x、直径は size.y と size.z の短い方
+//   Wedge: 底面と後ろ（+Z）の面を持ち、斜面は前（-Z）の下の辺から後ろの上の辺へ上る
+//   Mesh: MeshPart。Transform::mesh の三角形メッシュ（MeshLibrary）を大きさの箱に引き伸ばす
+enum class PartShape : uint8_t { Block, Ball, Cylinder, Wedge, Mesh };
+static const int kPartShapeCount = 5;
+static const char* const kPartShapeNames[kPartShapeCount] = { "Block", "Ball", "Cylinder", "Wedge", "Mesh" };
+
+inline const char* partShapeName(PartShape shape) { return kPartShapeNames[(int)shape]; }
+
+// 未知の名前なら false
+inline bool partShapeFromName(const std::string& name, PartShape& out) {
+    for (int i = 0; i < kPartShapeCount; ++i) {
+        if (name == kPartShapeNames[i]) { out = (PartShape)i; return true; }
+    }
+    return false;
+}
+
+struct Transform {
+    Vector3 pos;
+    Vector3 rotation;   // オイラー角（度）
+    Vector3 size;
+    PartShape shape = PartShape::Block;
+    uint16_t mesh = 0;   // 形が Mesh のときの MeshLibrary の番号（0 は箱）
+};
+
+// 動く物体だけが持つ（Anchored・非シミュレートのパーツにはない）
+struct RigidBody {
+    Vector3 velocity = Vector3(0, 0, 0);
+    Vector3 angularVelocity = Vector3(0, 0, 0);
+
+    float mass = 1.0f, invMass = 1.0f;
+    Matrix3 invInertiaTensorLocal;
+    Matrix3 invInertiaTensorWorld;
+
+    bool isSleeping = false;
+    float sleepTimer = 0.0f;
+
+    // 剛体アセンブリ（Weld などで繋がったパーツ）の一部で、根に合わせて動かされる。
+    // 積分・衝突応答は根の RigidBody で行う。
+    // アセンブリの根でないのに kinematic なら CharacterController が動かす（衝突では動かない障害物）
+    bool kinematic = false;
+    // 重心（自分の位置から見た、自分の回転の座標系でのずれ）。アセンブリの根だけが 0 以外
+    Vector3 centerOfMass = Vector3(0, 0, 0);
+
+    void updateInertiaWorld(const Vector3& rotation) {
+        Matrix3 R = Matrix3::rotate(rotation);
+        invInertiaTensorWorld = R * invInertiaTensorLocal * R.transpose();
+    }
+};
+
+// 衝突するパーツだけが持つ（CanCollide=false ならない）
+struct Collider {
+    float restitution = 0.2f;
+    float friction = 0.5f;
+};
+
+struct Renderable {
+    Vector3 color = Vector3(255, 255, 255);
+    float transparency = 0.0f;   // 0.0=不透明, 1.0=透明（描画しない）
+    std::string texturePath;
+};
+
+// プレイヤー操作・スクリプト向けの状態（プレイヤーのルートパーツだけが持つ）
+struct Script {
+    bool isPlayer = false;
+    bool onGround = false;
+};
+
+enum ComponentBit : uint32_t {
+    Comp_Transform  = 1u << 0,
+    Comp_RigidBody  = 1u << 1,
+    Comp_Collider   = 1u << 2,
+    Comp_Renderable = 1u << 3,
+    Comp_Script     = 1u << 4,
+    Comp_Anchored   = 1u << 5,   // 目印だけ（列はない）。RigidBody がなくても非シミュレートとは区別する
+};
+
+// エンティティ（スロット番号 + 世代）
+struct EntityId {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != UINT32_MAX; }
+    bool operator==(const EntityId& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const EntityId& o) const { return !(*this == o); }
+};
+
+// ===================================================================
+// Archetype: 同じ構成要素の組を持つエンティティの表
+// 構成要素ごとに連続した配列を持ち（持たないものは空のまま）、
+// システムは必要な列だけを先頭から順に読む
+// ===================================================================
+struct Archetype {
+    uint32_t mask;
+
+    std::vector<EntityId> entities;
+    std::vector<Cube*> owners;           // 対応するパーツ（Lua・木構造側の窓口）
+    std::vector<Transform> transforms;
+    std::vector<RigidBody> bodies;
+    std::vector<Collider> colliders;
+    std::vector<Renderable> renderables;
+    std::vector<Script> scripts;
+
+    explicit Archetype(uint32_t m) : mask(m) {}
+
+    size_t size() const { return entities.size(); }
+    bool has(uint32_t bits) const { return (mask & bits) == bits; }
+
+    template <typename T> std::vector<T>& column();
+    template <typename T> const std::vector<T>& column() const {
+        return const_cast<Archetype*>(this)->column<T>();
+    }
+};
+
+template <> inline std::vector<Transform>& Archetype::column<Transform>() { return transforms; }
+template <> inline std::vector<RigidBody>& Archetype::column<RigidBody>() { return bodies; }
+template <> inline std::vector<Collider>& Archetype::column<Collider>() { return colliders; }
+template <> inline std::vector<Renderable>& Archetype::column<Renderable>() { return renderables; }
+template <> inline std::vector<Script>& Archetype::column<Script>() { return scripts; }
+
+template <typename T> struct ComponentTraits;
+template <> struct ComponentTraits<Transform>  { static const uint32_t bit = Comp_Transform; };
+template <> struct ComponentTraits<RigidBody>  { static const uint32_t bit = Comp_RigidBody; };
+template <> struct ComponentTraits<Collider>   { static const uint32_t bit = Comp_Collider; };
+template <> struct ComponentTraits<Renderable> { static const uint32_t bit = Comp_Renderable; };
+template <> struct ComponentTraits<Script>     { static const uint32_t bit = Comp_Script; };
+
+// ===================================================================
+// ComponentStore: アーキタイプ別の構成要素の置き場
+// get() が返す参照・ポインタは、エンティティの追加・削除・構成の変更で
+// 無効になる（配列が伸びる・詰められる）ので、フレームをまたいで持たない
+// ===================================================================
+class ComponentStore {
+public:
+    ComponentStore() = default;
+    ComponentStore(const ComponentStore&) = delete;
+    ComponentStore& operator=(const ComponentStore&) = delete;
+
+    // 構成要素は既定値で作る（呼び出し側が get() で書き込む）
+    EntityId create(uint32_t mask, Cube* owner) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = (uint32_t)records.size();
+            records.push_back(Record{});
+        }
+
+        Archetype& arch = archetypeFor(mask | Comp_Transform);
+        Record& r = records[index];
+        r.alive = true;
+        r.archetype = archetypeIndex(arch.mask);
+        r.row = (uint32_t)arch.size();
+
+        EntityId id{index, r.generation};
+        arch.entities.push_back(id);
+        arch.owners.push_back(owner);
+        appendDefaults(arch);
+        live++;
+        layout++;
+        return id;
+    }
+
+    void destroy(EntityId e) {
+        if (!alive(e)) return;
+        Record& r = records[e.index];
+        removeRow(*archetypes[r.archetype], r.row);
+        r.alive = false;
+        r.generation++;
+        freeSlots.push_back(e.index);
+        live--;
+        layout++;
+    }
+
+    bool alive(EntityId e) const {
+        return e.index < records.size() && records[e.index].alive && records[e.index].generation == e.generation;
+    }
+
+    uint32_t maskOf(EntityId e) const {
+        return alive(e) ? archetypes[records[e.index].archetype]->mask : 0;
+    }
+
+    // エンティティの持ち主のパーツ（破棄済みなら nullptr）
+    Cube* ownerOf(EntityId e) const {
+        if (!alive(e)) return nullptr;
+        const Record& r = records[e.index];
+        return archetypes[r.archetype]->owners[r.row];
+    }
+
+    // 持っていなければ nullptr
+    template <typename T>
+    T* get(EntityId e) {
+        if (!alive(e)) return nullptr;
+        const Record& r = records[e.index];
+        Archetype& arch = *archetypes[r.archetype];
+        if (!(arch.mask & ComponentTraits<T>::bit)) return nullptr;
+        return &arch.column<T>()[r.row];
+    }
+    template <typename T>
+    const T* get(EntityId e) const { return const_cast<ComponentStore*>(this)->get<T>(e); }
+
+    // 構成要素を付け外しする（行を別のアーキタイプへ移す。共通の構成要素は値を引き継ぐ）
+    void setMask(EntityId e, uint32_t mask) {
+        if (!alive(e)) return;
+        mask |= Comp_Transform;
+        Record& r = records[e.index];
+        uint32_t fromIndex = r.archetype;
+        if (archetypes[fromIndex]->mask == mask) return;
+
+        Archetype& to = archetypeFor(mask);        // ここで archetypes が伸びることがある
+        Archetype& from = *archetypes[fromIndex];
+        uint32_t row = r.row;
+
+        to.entities.push_back(e);
+        to.owners.push_back(from.owners[row]);
+        moveColumn(from.transforms, to.transforms, row, from.mask, to.mask, Comp_Transform);
+        moveColumn(from.bodies, to.bodies, row, from.mask, to.mask, Comp_RigidBody);
+        moveColumn(from.colliders, to.colliders, row, from.mask, to.mask, Comp_Collider);
+        moveColumn(from.renderables, to.renderables, row, from.mask, to.mask, Comp_Renderable);
+        moveColumn(from.scripts, to.scripts, row, from.mask, to.mask, Comp_Script);
+
+        removeRow(from, row);
+        r.archetype = archetypeIndex(mask);
+        r.row = (uint32_t)to.size() - 1;
+        layout++;
+    }
+
+    // required を全て持つアーキタイプごとに f(Archetype&) を呼ぶ
+    template <typename F>
+    void forEach(uint32_t required, F&& f) {
+        for (auto& arch : archetypes) {
+            if (arch->has(required) && arch->size() > 0) f(*arch);
+        }
+    }
+    template <typename F>
+    void forEach(uint32_t required, F&& f) const {
+        for (const auto& arch : archetypes) {
+            if (arch->has(required) && arch->size() > 0) f(static_cast<const Archetype&>(*arch));
+        }
+    }
+
+    size_t entityCount() const { return live; }
+
+    // 行の配置が変わる（追加・削除・構成の変更）たびに増える。
+    // 構成要素へのポインタを持ち回る側は、これが変わったら取り直す
+    uint64_t layoutVersion() const { return layout; }
+    size_t archetypeCount() const { return archetypes.size(); }
+
+private:
+    struct Record {
+        uint32_t generation = 0;
+        uint32_t archetype = 0;
+        uint32_t row = 0;
+        bool alive = false;
+    };
+
+    std::vector<std::unique_ptr<Archetype>> archetypes;   // Archetype& はアーキタイプが増えても動かない
+    std::unordered_map<uint32_t, uint32_t> byMask;        // mask -> archetypes の添字
+    std::vector<Record> records;
+    std::vector<uint32_t> freeSlots;
+    size_t live = 0;
+    uint64_t layout = 0;
+
+    uint32_t archetypeIndex(uint32_t mask) const { return byMask.at(mask); }
+
+    Archetype& archetypeFor(uint32_t mask) {
+        auto it = byMask.find(mask);
+        if (it != byMask.end()) return *archetypes[it->second];
+        byMask.emplace(mask, (uint32_t)archetypes.size());
+        archetypes.push_back(std::make_unique<Archetype>(mask));
+        return *archetypes.back();
+    }
+
+    static void appendDefaults(Archetype& a) {
+        if (a.mask & Comp_Transform)  a.transforms.emplace_back();
+        if (a.mask & Comp_RigidBody)  a.bodies.emplace_back();
+        if (a.mask & Comp_Collider)   a.colliders.emplace_back();
+        if (a.mask & Comp_Renderable) a.renderables.emplace_back();
+        if (a.mask & Comp_Script)     a.scripts.emplace_back();
+    }
+
+    template <typename T>
+    static void moveColumn(std::vector<T>& from, std::vector<T>& to, uint32_t row,
+                           uint32_t fromMask, uint32_t toMask, uint32_t bit) {
+        if (!(toMask & bit)) return;
+        if (fromMask & bit) to.push_back(std::move(from[row]));
+        else to.emplace_back();
+    }
+
+    template <typename T>
+    static void swapRemove(std::vector<T>& column, uint32_t row) {
+        if (row + 1 != column.size()) column[row] = std::move(column.back());
+        column.pop_back();
+    }
+
+    // 行を末尾と入れ替えて詰める（移ってきたエンティティの行番号を直す）
+    void removeRow(Archetype& a, uint32_t row) {
+        EntityId moved = a.entities.back();
+        swapRemove(a.entities, row);
+        swapRemove(a.owners, row);
+        if (a.mask & Comp_Transform)  swapRemove(a.transforms, row);
+        if (a.mask & Comp_RigidBody)  swapRemove(a.bodies, row);
+        if (a.mask & Comp_Collider)   swapRemove(a.colliders, row);
+        if (a.mask & Comp_Renderable) swapRemove(a.renderables, row);
+        if (a.mask & Comp_Script)     swapRemove(a.scripts, row);
+        if (row < a.size()) records[moved.index].row = row;
+    }
+};
+
+#endif // COMPONENTSTORE_HPP
@@ -1,3 +1,13 @@
 #include "src/Game/GameData.hpp"
+#include "src/Game/PartPool.hpp"
 
-EventBase RunService::Heartbeat{};
\ No newline at end of file
+Signal<float> RunService::Heartbeat{};
+
+void Cube::release() {
+    // プールのチャンクに置かれた Cube は delete しない（置いたプールに返す）
+    if (pool) {
+        pool->destroy(this);
+        return;
+    }
+    delete this;
+}
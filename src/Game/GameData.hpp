@@ -7,11 +7,14 @@
 #include <cmath>
 #include <functional>
 #include <string>
-#include <any>
+#include <algorithm>
 
 #include "src/Math/Vector3.hpp"
 #include "src/Math/MathUtils.hpp"
 #include "src/Game/Instance.hpp"
+#include "src/Game/Signal.hpp"
+#include "src/Game/ComponentStore.hpp"
+#include "src/Game/Mesh.hpp"
 
 // 定数
 const float SCREEN_W = 800;
@@ -20,193 +23,228 @@ const float FOV_Y = 60.0f;
 const float Z_NEAR = 0.1f;
 const float Z_FAR = 2000.0f;
 
-class Connection {
-public:
-    bool connected = true;
-    void disconnect() { connected = false; }
+struct RunService {
+    static Signal<float> Heartbeat;   // 引数: dt（秒）
 };
 
-class EventBase {
-public:
-    using Callback = std::function<void(std::any)>;
-    std::vector<std::pair<Callback, Connection*>> listeners;
+// PartPool 上の Cube を指すハンドル
+// スロット番号 + 世代なので、削除後やスロット再利用後の古いハンドルは解決できない
+struct PartHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
 
-    // 【修正】デストラクタを追加してConnectionを解放
-    ~EventBase() {
-        for (auto& [cb, conn] : listeners) {
-            delete conn;
-        }
-        listeners.clear();
-    }
+    bool valid() const { return index != UINT32_MAX; }
+    bool operator==(const PartHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const PartHandle& o) const { return !(*this == o); }
 
-    Connection* connect(Callback cb) {
-        auto* conn = new Connection();
-        listeners.emplace_back(cb, conn);
-        return conn;
+    // Lua の整数1つに詰める
+    int64_t pack() const { return (int64_t)(((uint64_t)generation << 32) | index); }
+    static PartHandle unpack(int64_t v) {
+        return PartHandle{(uint32_t)((uint64_t)v & 0xffffffffu), (uint32_t)((uint64_t)v >> 32)};
     }
+};
 
-    void fire(std::any value = std::any()) {
-        for (auto it = listeners.begin(); it != listeners.end(); ) {
-            if (it->second->connected) {
-                it->first(value);
-                ++it;
-            } else {
-                // 【修正】切断されたConnectionを削除
-                delete it->second;
-                it = listeners.erase(it);
-            }
-        }
+// パーツの初期値（CubeBuilder が作り、PartPool::create が Cube と構成要素に振り分ける）
+struct PartDesc {
+    Vector3 size = Vector3(1,1,1);
+    Vector3 pos = Vector3(0,0,0);
+    Vector3 color = Vector3(255,255,255);
+    Vector3 rotation = Vector3(0,0,0);
+    PartShape shape = PartShape::Block;
+    uint16_t mesh = 0;   // 形が Mesh のときの MeshLibrary の番号
+    std::string texturePath = "";
+    bool anchored = false;
+    bool isPlayer = false;
+    std::string name = "Part";
+    bool canCollide = true;
+    bool simulated = true;
+    float transparency = 0.0f;
+
+    // このパーツに必要な構成要素
+    uint32_t componentMask() const {
+        uint32_t m = Comp_Transform | Comp_Renderable;
+        if (simulated && !anchored) m |= Comp_RigidBody;
+        if (canCollide) m |= Comp_Collider;
+        if (isPlayer) m |= Comp_Script;
+        if (anchored) m |= Comp_Anchored;
+        return m;
     }
 };
 
-struct RunService {
-    static EventBase Heartbeat;
-};
+class PartPool;
 
 // Cube は Instance を継承
+// データ本体は ComponentStore の構成要素にあり、Cube は Lua・木構造向けの窓口。
+// 物理・描画は Cube を経由せず、アーキタイプの配列を直接走査する
 struct Cube : public Instance {
-    Vector3 size, pos, color;
-    Vector3 rotation;
-    
-    std::string texturePath;
-    unsigned int textureID;
-    bool useTexture;
-    bool anchored;
-
-    // --- 物理/衝突フラグ ---
-    bool canCollide; 
-    bool simulated;  
-
-    // --- 追加: 透明度 (0.0=不透明, 1.0=透明) ---
-    float transparency;
-    // ---------------------------------------
-
-    // 物理パラメータ
-    Vector3 velocity;
-    Vector3 angularVelocity;
-    
-    float mass, invMass;
-    Matrix3 invInertiaTensorLocal;
-    Matrix3 invInertiaTensorWorld;
-    
-    float restitution;
-    float friction;
-    
-    bool isPlayer;
-    bool onGround;
-    bool isSleeping;
-    float sleepTimer;
-
-    Cube(Vector3 s, Vector3 p, Vector3 c, Vector3 r = Vector3(0,0,0),
-         const std::string& texPath = "",
-         unsigned int texID = 0, bool useTex = false, bool an = false, bool isPl = false,
-         std::string name = "Part",
-         bool canCol = true, bool sim = true,
-         float trans = 0.0f)
-         : Instance(name, "Part"),
-           size(s), pos(p), color(c), rotation(r), 
-           texturePath(texPath), textureID(texID), useTexture(useTex), anchored(an), 
-           canCollide(canCol), simulated(sim), transparency(trans),
-           velocity(0,0,0), angularVelocity(0,0,0), 
-           isPlayer(isPl), onGround(false), 
-           restitution(0.2f), friction(0.5f),
-           isSleeping(false), sleepTimer(0.0f)
+    PartHandle handle;   // PartPool に置かれたときに設定される
+    PartPool* pool = nullptr;   // 置かれている PartPool（contains・解放で使う。nullptr ならプールの外）
+    EntityId entity;
+
+    Cube(ComponentStore& components, const PartDesc& d)
+        : Instance(d.name, d.shape == PartShape::Mesh ? "MeshPart" : "Part"), store(&components)
     {
-        if (an || !simulated) { 
-            mass = 0.0f;
-            invMass = 0.0f;
-            invInertiaTensorLocal.setZero();
-        } else {
-            mass = s.x * s.y * s.z * 1.0f; 
-            if(mass < 0.001f) mass = 1.0f;
-            invMass = 1.0f / mass;
-
-            if (isPlayer) {
-                invInertiaTensorLocal.setZero();
+        entity = store->create(d.componentMask(), this);
+
+        Transform& t = transform();
+        t.pos = d.pos;
+        t.rotation = d.rotation;
+        t.size = d.size;
+        t.shape = d.shape;
+        t.mesh = d.mesh;
+
+        Renderable& r = renderable();
+        r.color = d.color;
+        r.transparency = d.transparency;
+        r.texturePath = d.texturePath;
+
+        if (Script* s = script()) s->isPlayer = d.isPlayer;
+
+        updateMass();
+    }
+
+    ~Cube() override { store->destroy(entity); }
+
+    // 構成要素を共有できないのでコピーはしない
+    Cube(const Cube&) = delete;
+    Cube& operator=(const Cube&) = delete;
+
+    // ---------------------------------------------------------------
+    // 構成要素（持っていなければ nullptr）
+    // 参照はパーツの追加・削除で無効になるので、フレームをまたいで持たない
+    // ---------------------------------------------------------------
+    Transform& transform() { return *store->get<Transform>(entity); }
+    const Transform& transform() const { return *store->get<Transform>(entity); }
+    Renderable& renderable() { return *store->get<Renderable>(entity); }
+    const Renderable& renderable() const { return *store->get<Renderable>(entity); }
+    RigidBody* body() { return store->get<RigidBody>(entity); }               // Anchored・非シミュレートなら nullptr
+    const RigidBody* body() const { return store->get<RigidBody>(entity); }
+    Collider* collider() { return store->get<Collider>(entity); }             // CanCollide=false なら nullptr
+    const Collider* collider() const { return store->get<Collider>(entity); }
+    Script* script() { return store->get<Script>(entity); }                   // プレイヤーのルートだけ
+    const Script* script() const { return store->get<Script>(entity); }
+
+    // ---------------------------------------------------------------
+    // プロパティ（Lua・Actor・Player 向け）
+    // ---------------------------------------------------------------
+    Vector3& pos() { return transform().pos; }
+    const Vector3& pos() const { return transform().pos; }
+    Vector3& rotation() { return transform().rotation; }
+    const Vector3& rotation() const { return transform().rotation; }
+    Vector3& size() { return transform().size; }
+    const Vector3& size() const { return transform().size; }
+    Vector3& color() { return renderable().color; }
+    const Vector3& color() const { return renderable().color; }
+    float& transparency() { return renderable().transparency; }
+    float transparency() const { return renderable().transparency; }
+    const std::string& texturePath() const { return renderable().texturePath; }
+
+    // 剛体を持たないパーツの速度は 0（書き込みは無視する）
+    Vector3 velocity() const {
+        const RigidBody* b = body();
+        return b ? b->velocity : Vector3(0, 0, 0);
+    }
+    void setVelocity(const Vector3& v) {
+        if (RigidBody* b = body()) b->velocity = v;
+    }
+
+    bool anchored() const { return (store->maskOf(entity) & Comp_Anchored) != 0; }
+    bool canCollide() const { return collider() != nullptr; }
+    bool isPlayer() const { const Script* s = script(); return s && s->isPlayer; }
+    bool onGround() const { const Script* s = script(); return s && s->onGround; }
+
+    // 形と大きさから質量・慣性テンソルを決める（密度 1）。形・大きさを変えたら呼ぶ
+    void updateMass() {
+        RigidBody* b = body();
+        if (!b) return;
+        const Transform& t = transform();
+        const Vector3& s = t.size;
+
+        // 球・円柱は大きさの箱に収まる分だけ（PartShape のコメント）
+        float r = 0.0f;
+        if (t.shape == PartShape::Ball) r = 0.5f * std::min(s.x, std::min(s.y, s.z));
+        if (t.shape == PartShape::Cylinder) r = 0.5f * std::min(s.y, s.z);
+
+        switch (t.shape) {
+            case PartShape::Ball:     b->mass = (4.0f / 3.0f) * (float)M_PI * r * r * r; break;
+            case PartShape::Cylinder: b->mass = (float)M_PI * r * r * s.x; break;
+            case PartShape::Wedge:    b->mass = 0.5f * s.x * s.y * s.z; break;
+            case PartShape::Mesh:     b->mass = MeshLibrary::get().asset(t.mesh).volumeFraction * s.x * s.y * s.z; break;
+            default:                  b->mass = s.x * s.y * s.z * 1.0f; break;
+        }
+        if (b->mass < 0.001f) b->mass = 1.0f;
+        b->invMass = 1.0f / b->mass;
+
+        b->invInertiaTensorLocal.setZero();
+        if (!isPlayer()) {
+            Matrix3 I;
+            I.setZero();
+
+            const float inertiaScale = 5.0f;
+
+            if (t.shape == PartShape::Ball) {
+                float k = 0.4f * b->mass * r * r * inertiaScale;
+                I.m[0][0] = I.m[1][1] = I.m[2][2] = k;
+            } else if (t.shape == PartShape::Cylinder) {
+                I.m[0][0] = 0.5f * b->mass * r * r * inertiaScale;
+                I.m[1][1] = I.m[2][2] = (1.0f/12.0f) * b->mass * (3.0f*r*r + s.x*s.x) * inertiaScale;
             } else {
-                Matrix3 I;
-                I.setZero();
-                
-                const float inertiaScale = 5.0f; 
-
-                I.m[0][0] = (1.0f/12.0f) * mass * (size.y*size.y + size.z*size.z) * inertiaScale;
-                I.m[1][1] = (1.0f/12.0f) * mass * (size.x*size.x + size.z*size.z) * inertiaScale;
-                I.m[2][2] = (1.0f/12.0f) * mass * (size.x*size.x + size.y*size.y) * inertiaScale;
-
-                invInertiaTensorLocal.setZero();
-                if(I.m[0][0] > 1e-6f) invInertiaTensorLocal.m[0][0] = 1.0f / I.m[0][0];
-                if(I.m[1][1] > 1e-6f) invInertiaTensorLocal.m[1][1] = 1.0f / I.m[1][1];
-                if(I.m[2][2] > 1e-6f) invInertiaTensorLocal.m[2][2] = 1.0f / I.m[2][2];
+                // くさび・メッシュも箱の式で近似する（重心も箱の中心のまま）
+                I.m[0][0] = (1.0f/12.0f) * b->mass * (s.y*s.y + s.z*s.z) * inertiaScale;
+                I.m[1][1] = (1.0f/12.0f) * b->mass * (s.x*s.x + s.z*s.z) * inertiaScale;
+                I.m[2][2] = (1.0f/12.0f) * b->mass * (s.x*s.x + s.y*s.y) * inertiaScale;
             }
+
+            if(I.m[0][0] > 1e-6f) b->invInertiaTensorLocal.m[0][0] = 1.0f / I.m[0][0];
+            if(I.m[1][1] > 1e-6f) b->invInertiaTensorLocal.m[1][1] = 1.0f / I.m[1][1];
+            if(I.m[2][2] > 1e-6f) b->invInertiaTensorLocal.m[2][2] = 1.0f / I.m[2][2];
         }
-        updateInertiaWorld();
+        b->updateInertiaWorld(t.rotation);
     }
 
-    void updateInertiaWorld() {
-        if(anchored || !simulated) return;
-        Matrix3 R = Matrix3::rotate(rotation);
-        invInertiaTensorWorld = R * invInertiaTensorLocal * R.transpose();
-    }
-    
     void wakeUp() {
-        isSleeping = false;
-        sleepTimer = 0.0f;
+        if (RigidBody* b = body()) {
+            b->isSleeping = false;
+            b->sleepTimer = 0.0f;
+        }
     }
 
-    Vector3 getPointVelocity(const Vector3& worldPoint) const {
-        Vector3 r = worldPoint - pos;
-        return velocity + angularVelocity.cross(r);
-    }
+    // Workspace に置かれていて破棄予約もされていない（物理・描画・Actor の対象）
+    bool isActive() const { return Parent && !destroying; }
 
-    bool IsA(const std::string& className) const override {
-        return className == "Part" || className == "BasePart" || Instance::IsA(className);
-    }
+protected:
+    // PartPool 上の Cube はプールに返す（GameData.cpp）
+    void release() override;
+
+private:
+    ComponentStore* store;
 };
 
 struct CubeBuilder {
-    Vector3 _size = Vector3(1,1,1);
-    Vector3 _pos = Vector3(0,0,0);
-    Vector3 _color = Vector3(255,255,255);
-    Vector3 _rotation = Vector3(0,0,0);
-    std::string _texturePath = "";
-    unsigned int _texID = 0;
-    bool _useTex = false;
-    bool _anchored = false;
-    bool _isPlayer = false;
-    std::string _name = "Part";
-    bool _canCollide = true;
-    bool _simulated = true;
-    
-    float _transparency = 0.0f;
-
-    CubeBuilder& size(float x, float y, float z) { _size = Vector3(x,y,z); return *this; }
-    CubeBuilder& size(const Vector3& v) { _size = v; return *this; }
-    CubeBuilder& pos(float x, float y, float z) { _pos = Vector3(x,y,z); return *this; }
-    CubeBuilder& pos(const Vector3& v) { _pos = v; return *this; }
-    CubeBuilder& color(float r, float g, float b) { _color = Vector3(r,g,b); return *this; }
-    CubeBuilder& color(const Vector3& v) { _color = v; return *this; }
-    CubeBuilder& rotation(float x, float y, float z) { _rotation = Vector3(x,y,z); return *this; }
-    CubeBuilder& rotation(const Vector3& v) { _rotation = v; return *this; }
-
-    CubeBuilder& texture(const std::string& path) { _texturePath = path; _useTex = true; return *this; }
-    CubeBuilder& texture(unsigned int id) { _texID = id; _useTex = true; return *this; }
-    CubeBuilder& setStatic() { _anchored = true; return *this; }
-    CubeBuilder& setPlayer() { _isPlayer = true; return *this; }
-    CubeBuilder& setName(const std::string& s) { _name = s; return *this; }
-    CubeBuilder& setCanCollide(bool enable) { _canCollide = enable; return *this; }
-    CubeBuilder& setSimulated(bool enable) { _simulated = enable; return *this; }
-
-    CubeBuilder& setTransparency(float t) { _transparency = t; return *this; }
-
-    Cube build() {
-        return Cube(
-            _size, _pos, _color, _rotation,
-            _texturePath, _texID, _useTex,
-            _anchored, _isPlayer, _name,
-            _canCollide, _simulated,
-            _transparency
-        );
-    }
+    PartDesc d;
+
+    CubeBuilder& size(float x, float y, float z) { d.size = Vector3(x,y,z); return *this; }
+    CubeBuilder& size(const Vector3& v) { d.size = v; return *this; }
+    CubeBuilder& pos(float x, float y, float z) { d.pos = Vector3(x,y,z); return *this; }
+    CubeBuilder& pos(const Vector3& v) { d.pos = v; return *this; }
+    CubeBuilder& color(float r, float g, float b) { d.color = Vector3(r,g,b); return *this; }
+    CubeBuilder& color(const Vector3& v) { d.color = v; return *this; }
+    CubeBuilder& rotation(float x, float y, float z) { d.rotation = Vector3(x,y,z); return *this; }
+    CubeBuilder& rotation(const Vector3& v) { d.rotation = v; return *this; }
+    CubeBuilder& shape(PartShape s) { d.shape = s; return *this; }
+    // MeshPart にする（読み込めなければ箱のメッシュ）。大きさは size で決める
+    CubeBuilder& mesh(const std::string& path) { d.shape = PartShape::Mesh; d.mesh = MeshLibrary::get().load(path); return *this; }
+
+    CubeBuilder& texture(const std::string& path) { d.texturePath = path; return *this; }
+    CubeBuilder& setStatic() { d.anchored = true; return *this; }
+    CubeBuilder& setPlayer() { d.isPlayer = true; return *this; }
+    CubeBuilder& setName(const std::string& s) { d.name = s; return *this; }
+    CubeBuilder& setCanCollide(bool enable) { d.canCollide = enable; return *this; }
+    CubeBuilder& setSimulated(bool enable) { d.simulated = enable; return *this; }
+
+    CubeBuilder& setTransparency(float t) { d.transparency = t; return *this; }
+
+    PartDesc build() const { return d; }
 };
 
 struct Camera {
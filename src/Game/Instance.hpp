@@ -5,30 +5,272 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "src/Game/Signal.hpp"
+#include "src/Game/Atom.hpp"
+#include "src/Game/ClassRegistry.hpp"
+#include "src/Game/InstancePool.hpp"
 
 // 前方宣言
 class Instance;
+class DescendantWalker;
+struct DescendantRange;
+
+// ===================================================================
+// プロパティ変更通知
+// 書き込み側は markChanged() でビットを立てるだけで、通知はフレームに1回
+// PropertyChangeQueue::dispatch() でまとめて行う。リスナーのいないプロパティは
+// ビットも立たないので、誰も購読していなければほぼコストはかからない
+// ===================================================================
+enum PropertyBit : uint32_t {
+    Prop_Name         = 1u << 0,
+    Prop_Position     = 1u << 1,
+    Prop_Rotation     = 1u << 2,
+    Prop_Size         = 1u << 3,
+    Prop_Color        = 1u << 4,
+    Prop_Velocity     = 1u << 5,
+    Prop_Transparency = 1u << 6,
+    Prop_Anchored     = 1u << 7,
+    Prop_CanCollide   = 1u << 8,
+    Prop_Shape        = 1u << 9,
+    Prop_MeshId       = 1u << 10,
+    Prop_All          = 0xffffffffu,   // Changed（全プロパティ）用
+};
+
+static const char* const kPropertyNames[] = {
+    "Name", "Position", "Rotation", "Size", "Color",
+    "Velocity", "Transparency", "Anchored", "CanCollide", "Shape",
+    "MeshId",
+};
+static const int kPropertyCount = sizeof(kPropertyNames) / sizeof(kPropertyNames[0]);
+
+inline const char* propertyName(uint32_t bit) {
+    for (int i = 0; i < kPropertyCount; ++i) {
+        if (bit == (1u << i)) return kPropertyNames[i];
+    }
+    return "";
+}
+
+// 未知の名前なら 0
+inline uint32_t propertyFromName(const char* name) {
+    for (int i = 0; i < kPropertyCount; ++i) {
+        if (strcmp(name, kPropertyNames[i]) == 0) return 1u << i;
+    }
+    return 0;
+}
+
+// Instance ごとのシグナル。購読されるまで確保しない
+struct PropertySignals {
+    Signal<const char*> Changed;                 // 引数: プロパティ名
+    std::map<uint32_t, Signal<>> byProperty;     // GetPropertyChangedSignal 用
+};
+
+// 今フレームに変更された（かつリスナーのいる）Instance の一覧
+class PropertyChangeQueue {
+public:
+    static void push(Instance* inst) { queue().pending.push_back(inst); }
+
+    // 破棄される Instance を一覧から外す（dirtyMask が立っているときだけ呼ばれる）
+    static void remove(Instance* inst) {
+        Queue& q = queue();
+        std::replace(q.pending.begin(), q.pending.end(), inst, (Instance*)nullptr);
+        std::replace(q.batch.begin(), q.batch.end(), inst, (Instance*)nullptr);
+    }
+
+    // 溜まった変更を通知する（メインスレッドから1フレームに1回）
+    // コールバック中の変更は次のフレームに回る
+    static void dispatch();
+
+    static size_t pendingCount() { return queue().pending.size(); }
+
+    // 位置・回転・サイズが書き換えられた回数（リスナーの有無に関係なく数える）。
+    // 形を覚えておく側（空間クエリの木など）は、これが変わったら取り直す
+    static void noteGeometryChange() { queue().geometry++; }
+    static uint64_t geometryVersion() { return queue().geometry; }
+
+private:
+    struct Queue {
+        std::vector<Instance*> pending;
+        std::vector<Instance*> batch;    // dispatch 中の一覧（容量を使い回す）
+        uint64_t geometry = 0;
+    };
+    static Queue& queue() {
+        static Queue q;
+        return q;
+    }
+};
+
+// ===================================================================
+// 子の索引
+// 名前・クラス名 -> 子の一覧。各一覧は siblingOrder 順（= Children の順）に並べるので、
+// 先頭が FindFirstChild の結果になる。子が少ないうちは線形探索の方が速いので作らない
+// ===================================================================
+struct ChildIndex {
+    using Map = std::unordered_map<Atom, std::vector<Instance*>>;
+
+    Map byName;
+    Map byClass;
+
+    static const size_t kThreshold = 16;   // 子がこの数に達したら索引を作る
+
+    static void insert(Map& map, Atom key, Instance* inst);
+    static void erase(Map& map, Atom key, Instance* inst);
+    static Instance* first(const Map& map, Atom key);
+
+    // keys の一覧から破棄予約済みの Instance をまとめて外す（keys は重複していてよい）
+    // 外した数を返す
+    static size_t eraseDestroyed(Map& map, std::vector<Atom>& keys);
+};
+
+// ===================================================================
+// 子孫の索引（Workspace などのルートだけが持つ）
+// 再帰の FindFirstChild / FindFirstChildOfClass を候補の絞り込みで済ませる
+// ===================================================================
+class DescendantIndex {
+public:
+    void add(Instance* subtree);       // 部分木ごと登録
+    void remove(Instance* subtree);    // 部分木ごと解除
+    void rename(Instance* inst, Atom oldName);
+
+    // 破棄予約済みの部分木をまとめて外す（names / classes は部分木全体のキー）
+    void eraseDestroyed(std::vector<Atom>& names, std::vector<Atom>& classes) {
+        count -= ChildIndex::eraseDestroyed(byName, names);
+        ChildIndex::eraseDestroyed(byClass, classes);
+    }
+
+    // ancestor の子孫のうち、再帰探索で最初に見つかるものを found に入れて true を返す
+    // 候補の数が ancestor の部分木より多いなら false（そのまま辿る方が速い）
+    // root は ancestor がこの索引を持つ Instance のとき（部分木は索引の全体なので数えない。
+    // Workspace のパーツのように Children にないものの子孫も索引にだけは載っている）
+    bool findFirstByName(const Instance* ancestor, bool root, Atom name, Instance*& found) const {
+        return findFirst(byName, ancestor, root, name, found);
+    }
+    bool findFirstByClass(const Instance* ancestor, bool root, Atom className, Instance*& found) const {
+        return findFirst(byClass, ancestor, root, className, found);
+    }
+
+    size_t size() const { return count; }
+
+private:
+    // 一覧の順序は保たない（順序は findFirst で木の位置から決める）
+    std::unordered_map<Atom, std::vector<Instance*>> byName;
+    std::unordered_map<Atom, std::vector<Instance*>> byClass;
+    size_t count = 0;
+
+    static bool eraseUnordered(std::unordered_map<Atom, std::vector<Instance*>>& map,
+                               Atom key, Instance* inst);
+    static bool findFirst(const std::unordered_map<Atom, std::vector<Instance*>>& map,
+                          const Instance* ancestor, bool root, Atom key, Instance*& found);
+};
+
+// ===================================================================
+// 破棄の予約
+// Destroy() はその場では解放せず、フレームの終わり（描画の後）に flush() で
+// まとめて一覧・索引から外して解放する。物理・描画・Actor のスナップショットが
+// フレームの途中で解放済みのメモリを見ることはない
+// ===================================================================
+class DestroyQueue {
+public:
+    static void push(Instance* inst) { queue().roots.push_back(inst); }
+
+    // flush を待たずに解放される Instance を一覧から外す（destroying のときだけ呼ばれる）
+    static void remove(Instance* inst) {
+        Queue& q = queue();
+        std::replace(q.roots.begin(), q.roots.end(), inst, (Instance*)nullptr);
+    }
+
+    // 予約された Instance を解放する（メインスレッドから1フレームに1回）
+    static void flush();
+
+    static size_t pendingCount() { return queue().roots.size(); }
+
+    // 何かを解放した flush の回数。Instance* を持ち越す側はこれが変わったら無効とみなす
+    static uint64_t releaseCount() { return queue().releases; }
+
+private:
+    struct Queue {
+        std::vector<Instance*> roots;
+        std::vector<Instance*> batch;    // flush 中の一覧（容量を使い回す）
+        uint64_t releases = 0;
+    };
+    static Queue& queue() {
+        static Queue q;
+        return q;
+    }
+};
 
 // Instanceの基底クラス（Robloxライク）
 class Instance {
 public:
-    std::string Name;
-    std::string ClassName;
+    Atom Name;           // 比較はポインタ比較で済む
+    Atom ClassName;
+    ClassId classId;     // ClassName が登録表にないクラスは ClassId::Instance
     Instance* Parent;
     std::vector<Instance*> Children;
 
+    // 親の中での並び順（addChild のたびに増える番号。Children はこの昇順に並ぶ）
+    uint64_t siblingOrder = 0;
+
+    // Destroy() 済みで、フレームの終わりの解放を待っている
+    bool destroying = false;
+
+    // Lua の参照表のスロット（InstanceRefs。未登録なら UINT32_MAX）
+    uint32_t refSlot = UINT32_MAX;
+
+    // 変更通知の状態
+    uint32_t dirtyMask = 0;       // 今フレームに変わったプロパティ（listenerMask でフィルタ済み）
+    uint32_t listenerMask = 0;    // リスナーのいるプロパティ
+    std::unique_ptr<PropertySignals> propertySignals;
+
     Instance(const std::string& name = "Instance", const std::string& className = "Instance")
-        : Name(name), ClassName(className), Parent(nullptr) {}
+        : Name(name), ClassName(className), classId(classIdOf(className)), Parent(nullptr) {}
+
+    // コピーはプロパティだけ。接続・索引・未通知の変更は引き継がない
+    Instance(const Instance& other)
+        : Name(other.Name), ClassName(other.ClassName), classId(other.classId), Parent(other.Parent), Children(other.Children) {}
+
+    Instance& operator=(const Instance& other) {
+        Name = other.Name;
+        ClassName = other.ClassName;
+        classId = other.classId;
+        Parent = other.Parent;
+        Children = other.Children;
+        return *this;
+    }
 
     virtual ~Instance() {
-        // 子を削除
+        if (dirtyMask) PropertyChangeQueue::remove(this);
+        if (destroying) DestroyQueue::remove(this);
+        InstanceRefs::release(refSlot);
+
+        // 親の一覧・索引に残らないよう外す
+        if (Parent) Parent->removeChild(this);
+
+        // 子を解放（プールに置かれたものはプールに返す）
         for (auto* child : Children) {
             child->Parent = nullptr;
-            delete child;
+            child->release();
         }
         Children.clear();
     }
 
+    // Instance 派生クラスの new / delete はクラス（サイズ）別のフリーリストから取る
+    static void* operator new(size_t size) { return InstanceAllocator::allocate(size); }
+    static void operator delete(void* ptr, size_t size) { InstanceAllocator::deallocate(ptr, size); }
+
+    // 破棄を予約する。子孫も含めて検索から外れ、シグナルは切断される
+    // メモリの解放は DestroyQueue::flush()（フレームの終わり）まで遅らせる
+    void Destroy() {
+        if (destroying) return;
+        markDestroying();
+        DestroyQueue::push(this);
+    }
+
     // 子を追加
     void addChild(Instance* child) {
         if (!child) return;
@@ -39,31 +281,238 @@ public:
         }
         
         child->Parent = this;
+        child->siblingOrder = takeSiblingOrder();
         Children.push_back(child);
+
+        if (childIndex) {
+            ChildIndex::insert(childIndex->byName, child->Name, child);
+            ChildIndex::insert(childIndex->byClass, child->ClassName, child);
+        } else if (Children.size() >= ChildIndex::kThreshold) {
+            buildChildIndex();
+        }
+
+        indexSubtree(child);
     }
 
     // 子を削除
     void removeChild(Instance* child) {
         auto it = std::find(Children.begin(), Children.end(), child);
-        if (it != Children.end()) {
-            (*it)->Parent = nullptr;
-            Children.erase(it);
+        if (it == Children.end()) return;
+
+        unindexSubtree(child);
+        if (childIndex) {
+            ChildIndex::erase(childIndex->byName, child->Name, child);
+            ChildIndex::erase(childIndex->byClass, child->ClassName, child);
+        }
+
+        (*it)->Parent = nullptr;
+        Children.erase(it);
+    }
+
+    // 子の部分木を祖先の子孫索引に載せる・外す
+    // Children を通さずに Parent を付け替えるとき（Workspace のパーツ）に、付けた後・外す前に呼ぶ
+    void indexChildSubtrees() {
+        for (auto* child : Children) indexSubtree(child);
+    }
+    void unindexChildSubtrees() {
+        for (auto* child : Children) unindexSubtree(child);
+    }
+
+    // 名前の変更（親と祖先の索引も更新する）
+    // Name を直接書き換えると索引とずれるので、生成後の変更は必ずこれを通す
+    void setName(const std::string& name) {
+        Atom newName(name);
+        if (Name == newName) return;
+        Atom oldName = Name;
+        Name = newName;
+
+        if (Parent) {
+            Parent->childRenamed(this, oldName);
+            for (Instance* a = Parent; a; a = a->Parent) {
+                if (a->descendantIndex) a->descendantIndex->rename(this, oldName);
+            }
         }
+        markChanged(Prop_Name);
+    }
+
+    // この Instance を子孫索引のルートにする
+    void enableDescendantIndex() {
+        if (descendantIndex) return;
+        descendantIndex = std::make_unique<DescendantIndex>();
+        for (auto* child : Children) descendantIndex->add(child);
     }
 
     // FindFirstChild (名前で検索) - virtual にする
     virtual Instance* FindFirstChild(const std::string& name, bool recursive = false) {
-        // 直接の子を検索
+        // 一度も使われていない名前なら、どの子もその名前ではない
+        Atom key = Atom::find(name);
+        return key.valid() ? findChild(key, recursive) : nullptr;
+    }
+
+    // インターン済みの名前で探す（比較はポインタ比較のみ）
+    Instance* findChild(Atom name, bool recursive = false) {
+        return searchChild(name, recursive, true);
+    }
+
+    // FindFirstChildOfClass (クラス名で検索)
+    Instance* FindFirstChildOfClass(const std::string& name, bool recursive = false) {
+        Atom className = Atom::find(name);
+        if (!className.valid()) return nullptr;
+        return searchChildOfClass(className, recursive, true);
+    }
+
+    // GetChildren (全ての子を取得)
+    // 毎回 vector を作るので、走査だけなら forEachChild を使う
+    std::vector<Instance*> GetChildren() {
+        std::vector<Instance*> children;
+        children.reserve(Children.size());
+        forEachChild([&](Instance* child) { children.push_back(child); });
+        return children;
+    }
+
+    // GetDescendants (全ての子孫を取得)
+    // 走査だけなら descendants() / forEachDescendant を使う（確保しない）
+    std::vector<Instance*> GetDescendants() const;
+
+    // 破棄予約済みを除いた子を順に渡す
+    template <typename F>
+    void forEachChild(F&& visit) const {
         for (auto* child : Children) {
-            if (child->Name == name) {
-                return child;
+            if (!child->destroying) visit(child);
+        }
+    }
+
+    // 子孫を GetDescendants と同じ順（前順）に渡す。途中で抜けるなら descendants() を使う
+    template <typename F>
+    void forEachDescendant(F&& visit) const;
+
+    // for (Instance* d : inst->descendants()) { ... }
+    DescendantRange descendants() const;
+
+    // IsA (型チェック)
+    // 登録済みクラス同士なら祖先ビットマスクのテスト1回
+    bool IsA(ClassId base) const {
+        return ClassRegistry::isA(classId, base);
+    }
+
+    bool IsA(const std::string& className) const {
+        ClassId base;
+        if (ClassRegistry::find(className, base)) return IsA(base);
+        return ClassName == className;   // 登録表にないクラス名
+    }
+
+    // 仮想関数（オーバーライド可能）
+    virtual void onAdded() {}
+    virtual void onRemoved() {}
+
+protected:
+    // 子の名前が変わったとき（子の索引を持つ派生クラスはオーバーライドする）
+    virtual void childRenamed(Instance* child, Atom oldName) {
+        if (!childIndex) return;
+        ChildIndex::erase(childIndex->byName, oldName, child);
+        ChildIndex::insert(childIndex->byName, child->Name, child);
+    }
+
+    // 破棄予約された子 dead[0..count) を一覧・索引からまとめて外す（DestroyQueue::flush から呼ぶ）
+    // 子の索引を持つ派生クラスはオーバーライドする
+    virtual void removeDestroyedChildren(Instance* const* dead, size_t count);
+
+    // メモリを返す。プールに置かれるクラスはオーバーライドしてプールに返す
+    virtual void release() { delete this; }
+
+    // 次の子の siblingOrder（Children を通さない子を持つ派生クラスも同じ番号から取る。
+    // 再帰の探索で Children の子とそれ以外の子の順を比べられるように）
+    uint64_t takeSiblingOrder() { return nextSiblingOrder++; }
+
+    friend class DestroyQueue;
+
+public:
+    // ---------------------------------------------------------------
+    // プロパティ変更通知
+    // ---------------------------------------------------------------
+
+    // プロパティを書き換えた側が呼ぶ。リスナーがいなければ通知の予約はしない
+    void markChanged(uint32_t props) {
+        if (props & (Prop_Position | Prop_Rotation | Prop_Size | Prop_MeshId)) PropertyChangeQueue::noteGeometryChange();
+        uint32_t bits = props & listenerMask;
+        if (!bits) return;
+        if (!dirtyMask) PropertyChangeQueue::push(this);
+        dirtyMask |= bits;
+    }
+
+    Signal<const char*>& ChangedSignal() {
+        listenerMask = Prop_All;
+        return signals().Changed;
+    }
+
+    Signal<>& GetPropertyChangedSignal(uint32_t prop) {
+        listenerMask |= prop;
+        return signals().byProperty[prop];
+    }
+
+    // dirtyMask の分だけシグナルを発火する（PropertyChangeQueue から呼ばれる）
+    void dispatchPropertyChanged() {
+        uint32_t mask = dirtyMask;
+        dirtyMask = 0;
+        if (!propertySignals) {
+            listenerMask = 0;
+            return;
+        }
+
+        PropertySignals& s = *propertySignals;
+        for (int i = 0; i < kPropertyCount; ++i) {
+            uint32_t bit = 1u << i;
+            if (!(mask & bit)) continue;
+
+            auto it = s.byProperty.find(bit);
+            if (it != s.byProperty.end() && it->second.listenerCount() > 0) it->second.fire();
+            if (s.Changed.listenerCount() > 0) s.Changed.fire(kPropertyNames[i]);
+        }
+        refreshListenerMask();
+    }
+
+private:
+    std::unique_ptr<ChildIndex> childIndex;             // 子が多いときだけ
+    std::unique_ptr<DescendantIndex> descendantIndex;   // 子孫索引のルートだけ
+    uint64_t nextSiblingOrder = 0;
+
+    static ClassId classIdOf(const std::string& className) {
+        ClassId id = ClassId::Instance;
+        ClassRegistry::find(className, id);
+        return id;
+    }
+
+    void buildChildIndex() {
+        childIndex = std::make_unique<ChildIndex>();
+        for (auto* child : Children) {
+            childIndex->byName[child->Name].push_back(child);
+            childIndex->byClass[child->ClassName].push_back(child);
+        }
+    }
+
+    // 名前で探す。useIndex なら再帰の探索に子孫索引を使う（使わないと決めた後の
+    // 部分木では、潜るたびに候補を数え直さないよう false で辿る）
+    Instance* searchChild(Atom name, bool recursive, bool useIndex) {
+        // 直接の子を検索
+        if (childIndex) {
+            if (Instance* found = ChildIndex::first(childIndex->byName, name)) return found;
+        } else {
+            for (auto* child : Children) {
+                if (child->Name == name && !child->destroying) {
+                    return child;
+                }
             }
         }
         
         // 再帰的に検索
         if (recursive) {
+            if (useIndex) {
+                const DescendantIndex* index = findDescendantIndex();
+                Instance* found = nullptr;
+                if (index && index->findFirstByName(this, index == descendantIndex.get(), name, found)) return found;
+            }
             for (auto* child : Children) {
-                Instance* result = child->FindFirstChild(name, true);
+                Instance* result = child->searchChild(name, true, false);
                 if (result) return result;
             }
         }
@@ -71,17 +520,25 @@ public:
         return nullptr;
     }
 
-    // FindFirstChildOfClass (クラス名で検索)
-    Instance* FindFirstChildOfClass(const std::string& className, bool recursive = false) {
-        for (auto* child : Children) {
-            if (child->ClassName == className) {
-                return child;
+    Instance* searchChildOfClass(Atom className, bool recursive, bool useIndex) {
+        if (childIndex) {
+            if (Instance* found = ChildIndex::first(childIndex->byClass, className)) return found;
+        } else {
+            for (auto* child : Children) {
+                if (child->ClassName == className && !child->destroying) {
+                    return child;
+                }
             }
         }
         
         if (recursive) {
+            if (useIndex) {
+                const DescendantIndex* index = findDescendantIndex();
+                Instance* found = nullptr;
+                if (index && index->findFirstByClass(this, index == descendantIndex.get(), className, found)) return found;
+            }
             for (auto* child : Children) {
-                Instance* result = child->FindFirstChildOfClass(className, true);
+                Instance* result = child->searchChildOfClass(className, true, false);
                 if (result) return result;
             }
         }
@@ -89,30 +546,383 @@ public:
         return nullptr;
     }
 
-    // GetChildren (全ての子を取得)
-    std::vector<Instance*> GetChildren() {
-        return Children;
+    // 自分を含む祖先の子孫索引に child の部分木ごと登録・解除
+    void indexSubtree(Instance* child) {
+        for (Instance* a = this; a; a = a->Parent) {
+            if (a->descendantIndex) a->descendantIndex->add(child);
+        }
+    }
+    void unindexSubtree(Instance* child) {
+        for (Instance* a = this; a; a = a->Parent) {
+            if (a->descendantIndex) a->descendantIndex->remove(child);
+        }
     }
 
-    // GetDescendants (全ての子孫を取得)
-    std::vector<Instance*> GetDescendants() {
-        std::vector<Instance*> descendants;
+    // 自分を含む最も近い祖先の子孫索引
+    const DescendantIndex* findDescendantIndex() const {
+        for (const Instance* a = this; a; a = a->Parent) {
+            if (a->descendantIndex) return a->descendantIndex.get();
+        }
+        return nullptr;
+    }
+
+    PropertySignals& signals() {
+        if (!propertySignals) propertySignals = std::make_unique<PropertySignals>();
+        return *propertySignals;
+    }
+
+    // 部分木ごと破棄予約の印を付け、通知を止める
+    void markDestroying() {
+        destroying = true;
+        if (dirtyMask) {
+            PropertyChangeQueue::remove(this);
+            dirtyMask = 0;
+        }
+        listenerMask = 0;
+        if (propertySignals) {
+            // 発火中でも安全なように、シグナル自体は解放まで残す
+            propertySignals->Changed.disconnectAll();
+            for (auto& [bit, signal] : propertySignals->byProperty) signal.disconnectAll();
+        }
         for (auto* child : Children) {
-            descendants.push_back(child);
-            auto childDescendants = child->GetDescendants();
-            descendants.insert(descendants.end(), childDescendants.begin(), childDescendants.end());
+            if (!child->destroying) child->markDestroying();
         }
-        return descendants;
     }
 
-    // IsA (型チェック)
-    virtual bool IsA(const std::string& className) const {
-        return ClassName == className || className == "Instance";
+    // 切断済みのシグナルの分をマスクから外す
+    void refreshListenerMask() {
+        uint32_t m = 0;
+        if (propertySignals->Changed.listenerCount() > 0) m = Prop_All;
+        for (auto& [bit, signal] : propertySignals->byProperty) {
+            if (signal.listenerCount() > 0) m |= bit;
+        }
+        listenerMask = m;
     }
+};
 
-    // 仮想関数（オーバーライド可能）
-    virtual void onAdded() {}
-    virtual void onRemoved() {}
+// ===================================================================
+// ChildIndex / DescendantIndex の実装（Instance の定義が必要な部分）
+// ===================================================================
+
+inline Instance* ChildIndex::first(const Map& map, Atom key) {
+    auto it = map.find(key);
+    if (it == map.end()) return nullptr;
+    // 破棄予約済みのものは flush まで一覧に残っている
+    for (Instance* inst : it->second) {
+        if (!inst->destroying) return inst;
+    }
+    return nullptr;
+}
+
+inline size_t ChildIndex::eraseDestroyed(Map& map, std::vector<Atom>& keys) {
+    std::sort(keys.begin(), keys.end(), [](const Atom& a, const Atom& b) { return a.hash() < b.hash(); });
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    size_t removed = 0;
+    for (const Atom& key : keys) {
+        auto it = map.find(key);
+        if (it == map.end()) continue;
+        auto& list = it->second;
+        auto end = std::remove_if(list.begin(), list.end(), [](const Instance* i) { return i->destroying; });
+        removed += (size_t)(list.end() - end);
+        list.erase(end, list.end());
+        if (list.empty()) map.erase(it);
+    }
+    return removed;
+}
+
+inline void ChildIndex::insert(Map& map, Atom key, Instance* inst) {
+    // siblingOrder 順を保って挿入（通常は末尾への追加になる）
+    auto& list = map[key];
+    auto pos = std::upper_bound(list.begin(), list.end(), inst, [](const Instance* a, const Instance* b) {
+        return a->siblingOrder < b->siblingOrder;
+    });
+    list.insert(pos, inst);
+}
+
+inline void ChildIndex::erase(Map& map, Atom key, Instance* inst) {
+    auto it = map.find(key);
+    if (it == map.end()) return;
+    auto& list = it->second;
+    list.erase(std::remove(list.begin(), list.end(), inst), list.end());
+    if (list.empty()) map.erase(it);
+}
+
+inline void DescendantIndex::add(Instance* subtree) {
+    byName[subtree->Name].push_back(subtree);
+    byClass[subtree->ClassName].push_back(subtree);
+    count++;
+    for (auto* child : subtree->Children) add(child);
+}
+
+inline void DescendantIndex::remove(Instance* subtree) {
+    eraseUnordered(byName, subtree->Name, subtree);
+    eraseUnordered(byClass, subtree->ClassName, subtree);
+    count--;
+    for (auto* child : subtree->Children) remove(child);
+}
+
+inline void DescendantIndex::rename(Instance* inst, Atom oldName) {
+    // 登録されていないもの（Workspace の parts など）は無視する
+    if (eraseUnordered(byName, oldName, inst)) byName[inst->Name].push_back(inst);
+}
+
+inline bool DescendantIndex::eraseUnordered(std::unordered_map<Atom, std::vector<Instance*>>& map,
+                                            Atom key, Instance* inst) {
+    auto it = map.find(key);
+    if (it == map.end()) return false;
+    auto& list = it->second;
+    auto pos = std::find(list.begin(), list.end(), inst);
+    if (pos == list.end()) return false;
+    *pos = list.back();
+    list.pop_back();
+    if (list.empty()) map.erase(it);
+    return true;
+}
+
+inline bool DescendantIndex::findFirst(const std::unordered_map<Atom, std::vector<Instance*>>& map,
+                                       const Instance* ancestor, bool root, Atom key, Instance*& found) {
+    found = nullptr;
+    auto it = map.find(key);
+    if (it == map.end()) return true;
+    const std::vector<Instance*>& candidates = it->second;
+
+    // 部分木が候補より小さければ辿る方が速い（数えるのは候補の数まで）
+    struct Counter {
+        size_t left;
+        bool atLeast(const Instance* inst) {
+            for (const Instance* child : inst->Children) {
+                if (left == 0 || --left == 0 || atLeast(child)) return true;
+            }
+            return left == 0;
+        }
+    } counter{candidates.size()};
+    if (!root && !counter.atLeast(ancestor)) return false;
+
+    // ancestor からの深さ（ancestor の子が 1）。子孫でなければ 0
+    auto depthOf = [ancestor](const Instance* inst) {
+        size_t depth = 1;
+        for (const Instance* p = inst->Parent; p; p = p->Parent, ++depth) {
+            if (p == ancestor) return depth;
+        }
+        return (size_t)0;
+    };
+
+    // 再帰探索の順序: 各ノードで直接の子を全て見てから、子を順に潜る
+    // 一方が他方の祖先なら浅い方、分岐点の直下にいる方が先、どちらも深ければ分岐した子の順
+    auto before = [](const Instance* a, size_t da, const Instance* b, size_t db) {
+        const Instance* x = a;
+        const Instance* y = b;
+        for (size_t d = da; d > db; --d) x = x->Parent;
+        for (size_t d = db; d > da; --d) y = y->Parent;
+        if (x == y) return da < db;
+        while (x->Parent != y->Parent) {
+            x = x->Parent;
+            y = y->Parent;
+        }
+        bool aChild = (x == a), bChild = (y == b);
+        if (aChild != bChild) return aChild;
+        return x->siblingOrder < y->siblingOrder;
+    };
+
+    size_t bestDepth = 0;
+    for (Instance* candidate : candidates) {
+        if (candidate->destroying) continue;
+        size_t depth = depthOf(candidate);
+        if (depth == 0) continue;
+        if (!found || before(candidate, depth, found, bestDepth)) {
+            found = candidate;
+            bestDepth = depth;
+        }
+    }
+    return true;
+}
+
+inline void PropertyChangeQueue::dispatch() {
+    Queue& q = queue();
+    if (q.pending.empty()) return;
+
+    q.batch.swap(q.pending);
+    for (size_t i = 0; i < q.batch.size(); ++i) {
+        if (Instance* inst = q.batch[i]) inst->dispatchPropertyChanged();
+    }
+    q.batch.clear();
+}
+
+// ===================================================================
+// 子孫の走査
+// 前順（GetDescendants と同じ順）で1つずつ返す。スタックは明示的に持ち、
+// 深さ kInlineDepth まではこのオブジェクトの中に置くので走査中は確保しない。
+// 走査中の Destroy() は安全（予約済みの部分木は飛ばす）。子の追加・親の付け替えは
+// ぶら下がりにはならないが、その回の結果に含まれるかどうかは決まらない
+// ===================================================================
+class DescendantWalker {
+public:
+    static const size_t kInlineDepth = 32;
+
+    explicit DescendantWalker(const Instance* root = nullptr) { reset(root); }
+
+    // root の子孫を最初から辿り直す
+    void reset(const Instance* root) {
+        depth = 0;
+        spill.clear();
+        last = nullptr;
+        if (root) push(root);
+    }
+
+    // 次の子孫。終わりなら nullptr
+    Instance* next() {
+        while (depth > 0) {
+            Frame& f = top();
+            if (f.next >= f.node->Children.size()) {
+                pop();
+                continue;
+            }
+            Instance* child = f.node->Children[f.next++];
+            if (child->destroying) continue;
+            if (!child->Children.empty()) push(child);
+            last = child;
+            return child;
+        }
+        last = nullptr;
+        return nullptr;
+    }
+
+    // 直前に返したものの子孫を飛ばす
+    void skipChildren() {
+        if (last && depth > 0 && top().node == last && top().next == 0) pop();
+    }
+
+private:
+    struct Frame {
+        const Instance* node;
+        size_t next;   // 次に見る子の位置（Children が伸びても添字なのでぶら下がらない）
+    };
+
+    Frame frames[kInlineDepth];
+    std::vector<Frame> spill;    // kInlineDepth より深い分
+    size_t depth = 0;
+    const Instance* last = nullptr;
+
+    Frame& top() { return depth <= kInlineDepth ? frames[depth - 1] : spill[depth - 1 - kInlineDepth]; }
+    void push(const Instance* node) {
+        if (depth < kInlineDepth) frames[depth] = Frame{node, 0};
+        else spill.push_back(Frame{node, 0});
+        depth++;
+    }
+    void pop() {
+        if (depth > kInlineDepth) spill.pop_back();
+        depth--;
+    }
+};
+
+// range-for 用（end は番兵）
+struct DescendantRange {
+    const Instance* root;
+
+    struct Sentinel {};
+    class Iterator {
+    public:
+        explicit Iterator(const Instance* root) : walker(root), current(walker.next()) {}
+        Instance* operator*() const { return current; }
+        Iterator& operator++() { current = walker.next(); return *this; }
+        bool operator!=(Sentinel) const { return current != nullptr; }
+        void skipChildren() { walker.skipChildren(); }
+
+    private:
+        DescendantWalker walker;
+        Instance* current;
+    };
+
+    Iterator begin() const { return Iterator(root); }
+    Sentinel end() const { return Sentinel{}; }
 };
 
-#endif // INSTANCE_HPP
\ No newline at end of file
+inline DescendantRange Instance::descendants() const { return DescendantRange{this}; }
+
+template <typename F>
+inline void Instance::forEachDescendant(F&& visit) const {
+    DescendantWalker walker(this);
+    while (Instance* d = walker.next()) visit(d);
+}
+
+inline std::vector<Instance*> Instance::GetDescendants() const {
+    std::vector<Instance*> result;
+    forEachDescendant([&](Instance* d) { result.push_back(d); });
+    return result;
+}
+
+// 部分木の名前・クラス名を集める（子孫索引の掃除用）
+inline void collectSubtreeKeys(const Instance* inst, std::vector<Atom>& names, std::vector<Atom>& classes) {
+    names.push_back(inst->Name);
+    classes.push_back(inst->ClassName);
+    for (auto* child : inst->Children) collectSubtreeKeys(child, names, classes);
+}
+
+inline void Instance::removeDestroyedChildren(Instance* const* dead, size_t count) {
+    // キーの一覧は毎フレーム使い回す（メインスレッド専用）
+    static std::vector<Atom> names, classes;
+
+    if (childIndex) {
+        names.clear();
+        classes.clear();
+        for (size_t i = 0; i < count; ++i) {
+            names.push_back(dead[i]->Name);
+            classes.push_back(dead[i]->ClassName);
+        }
+        ChildIndex::eraseDestroyed(childIndex->byName, names);
+        ChildIndex::eraseDestroyed(childIndex->byClass, classes);
+    }
+
+    if (findDescendantIndex()) {
+        names.clear();
+        classes.clear();
+        for (size_t i = 0; i < count; ++i) collectSubtreeKeys(dead[i], names, classes);
+        for (Instance* a = this; a; a = a->Parent) {
+            if (a->descendantIndex) a->descendantIndex->eraseDestroyed(names, classes);
+        }
+    }
+
+    for (auto* child : Children) {
+        if (child->destroying) child->Parent = nullptr;
+    }
+    Children.erase(std::remove_if(Children.begin(), Children.end(), [](const Instance* c) { return c->destroying; }),
+                   Children.end());
+}
+
+inline void DestroyQueue::flush() {
+    Queue& q = queue();
+    if (q.roots.empty()) return;
+
+    // 解放中（デストラクタ）に予約されたものは次の flush に回す
+    q.batch.swap(q.roots);
+    auto& batch = q.batch;
+
+    // 祖先ごと予約されたものは祖先のデストラクタが解放するので外す
+    // （どれかを解放する前に判定する）
+    for (auto& inst : batch) {
+        if (inst && inst->Parent && inst->Parent->destroying) inst = nullptr;
+    }
+    batch.erase(std::remove(batch.begin(), batch.end(), (Instance*)nullptr), batch.end());
+
+    // 親ごとにまとめて一覧・索引から外す（親1つにつき一覧の走査は1回）
+    std::sort(batch.begin(), batch.end(), [](const Instance* a, const Instance* b) {
+        return std::less<const Instance*>()(a->Parent, b->Parent);
+    });
+    for (size_t i = 0; i < batch.size();) {
+        Instance* parent = batch[i]->Parent;
+        size_t j = i + 1;
+        while (j < batch.size() && batch[j]->Parent == parent) j++;
+        if (parent) parent->removeDestroyedChildren(&batch[i], j - i);
+        i = j;
+    }
+
+    for (Instance* inst : batch) {
+        inst->Parent = nullptr;
+        inst->release();
+    }
+    if (!batch.empty()) q.releases++;
+    batch.clear();
+}
+
+#endif // INSTANCE_HPP
@@ -0,0 +1,151 @@
+// src/Game/InstancePool.hpp
+#ifndef INSTANCEPOOL_HPP
+#define INSTANCEPOOL_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+class Instance;
+
+// ===================================================================
+// InstanceAllocator: Instance 派生クラス用のフリーリスト
+// クラスごとにサイズが決まっているので、16バイト刻みのサイズクラス = クラス別のプール。
+// 解放したブロックは OS に返さずフリーリストに積み、次の new で再利用する。
+// メインスレッド専用（Instance の生成・破棄はメインスレッドだけで行う）
+// ===================================================================
+class InstanceAllocator {
+public:
+    struct Stats {
+        size_t allocations = 0;    // new の回数
+        size_t frees = 0;          // delete の回数
+        size_t systemCalls = 0;    // malloc / free を実際に呼んだ回数
+        size_t chunkBytes = 0;     // プール用に確保した合計
+    };
+
+    static const size_t kGranularity = 16;
+    static const size_t kMaxPooled = 1024;
+    static const size_t kBlocksPerChunk = 64;
+
+    static void* allocate(size_t size) {
+        State& s = state();
+        s.stats.allocations++;
+        if (size > kMaxPooled) {
+            s.stats.systemCalls++;
+            void* p = std::malloc(size);
+            if (!p) throw std::bad_alloc();
+            return p;
+        }
+
+        size_t c = classOf(size);
+        if (!s.freeLists[c]) refill(s, c);
+        FreeBlock* block = s.freeLists[c];
+        s.freeLists[c] = block->next;
+        return block;
+    }
+
+    static void deallocate(void* ptr, size_t size) {
+        if (!ptr) return;
+        State& s = state();
+        s.stats.frees++;
+        if (size > kMaxPooled) {
+            s.stats.systemCalls++;
+            std::free(ptr);
+            return;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        size_t c = classOf(size);
+        block->next = s.freeLists[c];
+        s.freeLists[c] = block;
+    }
+
+    static const Stats& getStats() { return state().stats; }
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+    struct State {
+        FreeBlock* freeLists[kMaxPooled / kGranularity] = {};
+        Stats stats;
+    };
+
+    static State& state() {
+        static State* s = new State();   // 静的オブジェクトの破棄後に delete されても動くよう解放しない
+        return *s;
+    }
+
+    static size_t classOf(size_t size) { return (size + kGranularity - 1) / kGranularity - 1; }
+
+    // チャンクを1つ確保してフリーリストに切り分ける
+    static void refill(State& s, size_t c) {
+        size_t blockSize = (c + 1) * kGranularity;
+        char* chunk = static_cast<char*>(std::malloc(blockSize * kBlocksPerChunk));
+        if (!chunk) throw std::bad_alloc();
+        s.stats.systemCalls++;
+        s.stats.chunkBytes += blockSize * kBlocksPerChunk;
+        for (size_t i = kBlocksPerChunk; i > 0; --i) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+            block->next = s.freeLists[c];
+            s.freeLists[c] = block;
+        }
+    }
+};
+
+// ===================================================================
+// InstanceRefs: Lua から Instance（パーツ以外）を参照するための世代付き表
+// ラッパーにはポインタではなく「スロット番号 + 世代」を持たせるので、
+// 破棄された Instance を Lua が触っても nullptr になるだけで済む
+// ===================================================================
+class InstanceRefs {
+public:
+    // slot はその Instance 自身が保持する（未割り当てなら UINT32_MAX）
+    static int64_t acquire(Instance* inst, uint32_t& slot) {
+        Table& t = table();
+        if (slot == UINT32_MAX) {
+            if (!t.freeSlots.empty()) {
+                slot = t.freeSlots.back();
+                t.freeSlots.pop_back();
+            } else {
+                slot = (uint32_t)t.entries.size();
+                t.entries.push_back(Entry{});
+            }
+            t.entries[slot].inst = inst;
+        }
+        return (int64_t)(((uint64_t)t.entries[slot].generation << 32) | slot);
+    }
+
+    static Instance* resolve(int64_t ref) {
+        Table& t = table();
+        uint32_t slot = (uint32_t)((uint64_t)ref & 0xffffffffu);
+        uint32_t generation = (uint32_t)((uint64_t)ref >> 32);
+        if (slot >= t.entries.size() || t.entries[slot].generation != generation) return nullptr;
+        return t.entries[slot].inst;
+    }
+
+    // ~Instance から呼ぶ。古い参照を無効にしてスロットを再利用に回す
+    static void release(uint32_t& slot) {
+        if (slot == UINT32_MAX) return;
+        Table& t = table();
+        t.entries[slot].inst = nullptr;
+        t.entries[slot].generation++;
+        t.freeSlots.push_back(slot);
+        slot = UINT32_MAX;
+    }
+
+private:
+    struct Entry {
+        Instance* inst = nullptr;
+        uint32_t generation = 0;
+    };
+    struct Table {
+        std::vector<Entry> entries;
+        std::vector<uint32_t> freeSlots;
+    };
+    static Table& table() {
+        static Table* t = new Table();
+        return *t;
+    }
+};
+
+#endif // INSTANCEPOOL_HPP
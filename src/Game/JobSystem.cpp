@@ -0,0 +1,97 @@
+// src/Game/JobSystem.cpp
+#include "JobSystem.hpp"
+
+namespace {
+    // ジョブ実行中のスレッドから parallelFor が呼ばれた場合はその場で直列実行する
+    thread_local bool tl_insideJob = false;
+}
+
+JobSystem& JobSystem::get() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem(unsigned int threadCount) {
+    if (threadCount == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        // 呼び出し元スレッドも働くので1つ減らす
+        threadCount = (hw > 1) ? hw - 1 : 0;
+    }
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCv.notify_all();
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+}
+
+void JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) return;
+
+    if (count == 1 || workers.empty() || tl_insideJob) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> batchLock(batchMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batchFn = &fn;
+        batchCount = count;
+        nextIndex.store(0);
+        activeWorkers = workers.size();
+        ++batchId;
+    }
+    wakeCv.notify_all();
+
+    // 呼び出し元スレッドも処理に参加する
+    tl_insideJob = true;
+    runBatch(fn, count);
+    tl_insideJob = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCv.wait(lock, [this] { return activeWorkers == 0; });
+    batchFn = nullptr;
+}
+
+void JobSystem::workerLoop() {
+    unsigned long long seenBatch = 0;
+    for (;;) {
+        const std::function<void(size_t)>* fn = nullptr;
+        size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCv.wait(lock, [&] { return stopping || batchId != seenBatch; });
+            if (stopping) return;
+            seenBatch = batchId;
+            fn = batchFn;
+            count = batchCount;
+        }
+
+        tl_insideJob = true;
+        runBatch(*fn, count);
+        tl_insideJob = false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--activeWorkers == 0) doneCv.notify_one();
+        }
+    }
+}
+
+void JobSystem::runBatch(const std::function<void(size_t)>& fn, size_t count) {
+    for (;;) {
+        size_t i = nextIndex.fetch_add(1);
+        if (i >= count) break;
+        fn(i);
+    }
+}
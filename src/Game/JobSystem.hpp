@@ -0,0 +1,50 @@
+// src/Game/JobSystem.hpp
+#ifndef JOBSYSTEM_HPP
+#define JOBSYSTEM_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+// ワーカースレッドのプール
+// parallelFor() で渡した関数を全ワーカー（+呼び出し元スレッド）で分担して実行する
+class JobSystem {
+public:
+    // プロセス全体で1つだけ持つ
+    static JobSystem& get();
+
+    explicit JobSystem(unsigned int threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // fn(0) ... fn(count-1) を並列に実行し、全て終わるまで待つ
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+    // 呼び出し元スレッドを含めた並列度
+    size_t concurrency() const { return workers.size() + 1; }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex batchMutex;   // parallelFor の同時呼び出しを直列化
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+
+    // 現在のバッチ
+    const std::function<void(size_t)>* batchFn = nullptr;
+    size_t batchCount = 0;
+    std::atomic<size_t> nextIndex{0};
+    size_t activeWorkers = 0;
+    unsigned long long batchId = 0;
+    bool stopping = false;
+
+    void workerLoop();
+    void runBatch(const std::function<void(size_t)>& fn, size_t count);
+};
+
+#endif // JOBSYSTEM_HPP
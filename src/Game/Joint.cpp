@@ -0,0 +1,459 @@
+// src/Game/Joint.cpp
+#include "Joint.hpp"
+#include <algorithm>
+#include <cmath>
+
+// 単位行列に近い成分はちょうど 0 にする（三角関数の誤差で子の角度がぶれないように）
+static Vector3 snappedEuler(const Matrix3& R) {
+    Vector3 e = R.toEuler();
+    if (std::abs(e.x) < 1e-4f) e.x = 0.0f;
+    if (std::abs(e.y) < 1e-4f) e.y = 0.0f;
+    if (std::abs(e.z) < 1e-4f) e.z = 0.0f;
+    return e;
+}
+
+// ====================================================================
+// JointInstance
+// ====================================================================
+
+JointInstance::JointInstance(JointSystem* system, const std::string& className)
+    : Instance(className, className), system(system)
+{
+    if (system) system->add(this);
+}
+
+JointInstance::~JointInstance() {
+    if (system) system->remove(this);
+}
+
+Cube* JointInstance::getPart0() const { return system ? system->resolve(part0) : nullptr; }
+Cube* JointInstance::getPart1() const { return system ? system->resolve(part1) : nullptr; }
+
+void JointInstance::setPart0(Cube* part) {
+    part0 = part ? part->handle : PartHandle{};
+    if (system) system->invalidate();
+}
+
+void JointInstance::setPart1(Cube* part) {
+    part1 = part ? part->handle : PartHandle{};
+    if (system) system->invalidate();
+}
+
+// C0/C1 はアセンブリの重心・慣性も変えるので組み直す
+void JointInstance::setC0(const JointFrame& f) {
+    c0 = f;
+    if (system) system->invalidate();
+}
+
+void JointInstance::setC1(const JointFrame& f) {
+    c1 = f;
+    if (system) system->invalidate();
+}
+
+void JointInstance::setEnabled(bool e) {
+    if (enabled == e) return;
+    enabled = e;
+    if (system) system->invalidate();
+}
+
+// 角度だけなら姿勢の更新で済む（重心・慣性は組んだ時のまま）
+void JointInstance::setCurrentAngle(float a) {
+    if (currentAngle == a) return;
+    currentAngle = a;
+    poseDirty = true;
+    if (system) system->poseChanged();
+}
+
+void JointInstance::setTransform(const Quaternion& q) {
+    if (transform.w == q.w && transform.x == q.x && transform.y == q.y && transform.z == q.z) return;
+    transform = q;
+    if (!isMotor()) return;
+    poseDirty = true;
+    if (system) system->poseChanged();
+}
+
+void JointInstance::relativePose(Vector3& pos, Matrix3& R) const {
+    bool animated = isMotor() && !transform.isIdentity();
+    bool turned = isMotor() && currentAngle != 0.0f;
+    if (!turned && !animated && c0.rotation.x == c1.rotation.x && c0.rotation.y == c1.rotation.y && c0.rotation.z == c1.rotation.z) {
+        // C0 と C1 の向きが同じなら回転なし（R(C0)·R(C1)ᵀ の誤差を位置に持ち込まない）
+        R = Matrix3();
+        pos = c0.pos - c1.pos;
+        return;
+    }
+    R = Matrix3::rotate(c0.rotation);
+    if (animated) R = R * transform.toMatrix();
+    if (turned) {
+        R = R * Matrix3::rotate(Vector3(0, 0, currentAngle * 180.0f / M_PI));
+    }
+    R = R * Matrix3::rotate(c1.rotation).transpose();
+    pos = c0.pos - R * c1.pos;
+}
+
+// ====================================================================
+// JointSystem
+// ====================================================================
+
+JointSystem::~JointSystem() {
+    // Workspace の子として後から解放される JointInstance が触らないように
+    for (JointInstance* j : joints) j->system = nullptr;
+}
+
+void JointSystem::remove(JointInstance* joint) {
+    auto it = std::find(joints.begin(), joints.end(), joint);
+    if (it != joints.end()) {
+        *it = joints.back();
+        joints.pop_back();
+    }
+    // edges / constraintList / pending に残っているポインタは次の step で組み直すまで使わない
+    topologyDirty = true;
+}
+
+void JointSystem::step(float dt) {
+    for (JointInstance* j : joints) {
+        if (!j->isMotor() || j->maxVelocity <= 0.0f) continue;
+        float diff = j->desiredAngle - j->currentAngle;
+        if (diff == 0.0f) continue;
+        float maxStep = j->maxVelocity * dt * 60.0f;
+        j->currentAngle += std::max(-maxStep, std::min(maxStep, diff));
+        j->poseDirty = true;
+        posesDirty = true;
+    }
+
+    if (!topologyDirty && !stillValid()) topologyDirty = true;
+    if (topologyDirty) rebuild();
+    else if (posesDirty) refreshPoses();
+}
+
+// 前回組んだ時から、パーツの破棄・Parent の変更・ジョイントの Destroy がないか
+bool JointSystem::stillValid() const {
+    auto active = [&](EntityId e) {
+        Cube* c = store.ownerOf(e);
+        return c && c->isActive();
+    };
+    for (const Edge& e : edges) {
+        if (e.joint->destroying || !active(e.child) || !active(e.parent)) return false;
+    }
+    for (const Constraint& c : constraintList) {
+        if (c.joint->destroying || !active(c.part0) || !active(c.part1)) return false;
+    }
+    // 保留中のジョイントのパーツが世界に戻った
+    for (JointInstance* j : pending) {
+        if (j->destroying) continue;
+        Cube* p0 = j->getPart0();
+        Cube* p1 = j->getPart1();
+        if (p0 && p1 && p0->isActive() && p1->isActive()) return false;
+    }
+    return true;
+}
+
+// 前回のアセンブリを解く（根の質量を戻し、メンバーを根から外す）。
+// 繋がりが変わったパーツは、寝たまま宙に残らないよう起こす
+void JointSystem::dissolve() {
+    auto wake = [&](EntityId e) {
+        if (RigidBody* b = store.get<RigidBody>(e)) {
+            b->isSleeping = false;
+            b->sleepTimer = 0.0f;
+        }
+    };
+    for (Assembly& a : assemblies) {
+        RigidBody* rootBody = store.get<RigidBody>(a.root);
+        const Transform* rootT = store.get<Transform>(a.root);
+        Vector3 center(0, 0, 0);
+        if (rootBody && rootT) center = rootT->pos + Matrix3::rotate(rootT->rotation) * rootBody->centerOfMass;
+
+        for (EntityId m : a.members) {
+            if (Cube* c = store.ownerOf(m)) hierarchy.detach(c);
+            RigidBody* b = store.get<RigidBody>(m);
+            if (!b) continue;
+            b->kinematic = false;
+            // 外れた瞬間は、アセンブリとして動いていた速度を引き継ぐ
+            if (rootBody && rootT) {
+                const Transform* t = store.get<Transform>(m);
+                b->velocity = rootBody->velocity + rootBody->angularVelocity.cross(t->pos - center);
+                b->angularVelocity = rootBody->angularVelocity;
+            }
+            wake(m);
+        }
+        wake(a.root);
+
+        if (rootBody && rootT && a.compound) {
+            rootBody->velocity += rootBody->angularVelocity.cross(rootT->pos - center);
+            rootBody->mass = a.savedMass;
+            rootBody->invMass = a.savedInvMass;
+            rootBody->invInertiaTensorLocal = a.savedInvInertia;
+            rootBody->centerOfMass = Vector3(0, 0, 0);
+            rootBody->updateInertiaWorld(rootT->rotation);
+        }
+    }
+    for (const Constraint& c : constraintList) {
+        wake(c.part0);
+        wake(c.part1);
+    }
+    assemblies.clear();
+    memberRoot.clear();
+    edges.clear();
+    constraintList.clear();
+    pending.clear();
+}
+
+void JointSystem::rebuild() {
+    topologyDirty = false;
+    posesDirty = false;
+    dissolve();
+
+    // ---- 有効なジョイントと、関わるパーツを集める ----
+    struct Link {
+        JointInstance* joint;
+        uint32_t a, b;      // nodes での Part0 / Part1
+        bool rigid;         // アセンブリとしてまとめる
+    };
+    std::vector<EntityId> nodes;
+    std::vector<Cube*> cubesOf;
+    std::unordered_map<uint32_t, uint32_t> nodeOf;
+    std::vector<Link> links;
+
+    auto nodeFor = [&](Cube* c) -> uint32_t {
+        auto it = nodeOf.find(c->entity.index);
+        if (it != nodeOf.end()) return it->second;
+        uint32_t n = (uint32_t)nodes.size();
+        nodes.push_back(c->entity);
+        cubesOf.push_back(c);
+        nodeOf.emplace(c->entity.index, n);
+        return n;
+    };
+
+    for (JointInstance* j : joints) {
+        j->poseDirty = false;
+        if (!j->enabled || j->destroying) continue;
+        Cube* p0 = j->getPart0();
+        Cube* p1 = j->getPart1();
+        if (!p0 || !p1 || p0 == p1) continue;
+        if (!p0->isActive() || !p1->isActive()) {
+            pending.push_back(j);
+            continue;
+        }
+        links.push_back(Link{j, nodeFor(p0), nodeFor(p1), false});
+    }
+    if (links.empty()) return;
+
+    // RigidBody も Anchored もないパーツ（非シミュレート）は常に相手に付いていく
+    auto isFollower = [&](uint32_t n) {
+        return (store.maskOf(nodes[n]) & (Comp_RigidBody | Comp_Anchored)) == 0;
+    };
+    for (Link& l : links) l.rigid = useAssemblies || isFollower(l.a) || isFollower(l.b);
+
+    // ---- rigid なジョイントの隣接表 ----
+    const uint32_t count = (uint32_t)nodes.size();
+    std::vector<uint32_t> adjStart(count + 1, 0), adj;
+    for (const Link& l : links) {
+        if (!l.rigid) continue;
+        adjStart[l.a + 1]++;
+        adjStart[l.b + 1]++;
+    }
+    for (uint32_t i = 0; i < count; ++i) adjStart[i + 1] += adjStart[i];
+    adj.resize(adjStart[count]);
+    {
+        std::vector<uint32_t> fill(adjStart.begin(), adjStart.end() - 1);
+        for (uint32_t li = 0; li < (uint32_t)links.size(); ++li) {
+            if (!links[li].rigid) continue;
+            adj[fill[links[li].a]++] = li;
+            adj[fill[links[li].b]++] = li;
+        }
+    }
+
+    // ---- 連結成分ごとに根を決め、根から幅優先で TransformHierarchy に繋ぐ ----
+    std::vector<int32_t> component(count, -1);
+    std::vector<Vector3> relPos(count);
+    std::vector<Matrix3> relR(count);
+    std::vector<uint32_t> queue, members;
+    std::vector<EntityId> groupNodes;
+    std::vector<Vector3> groupPos;
+    std::vector<Matrix3> groupR;
+
+    for (uint32_t start = 0; start < count; ++start) {
+        if (component[start] >= 0) continue;
+        const int32_t id = (int32_t)assemblies.size();
+
+        // 成分を集める
+        members.clear();
+        members.push_back(start);
+        component[start] = id;
+        for (size_t head = 0; head < members.size(); ++head) {
+            uint32_t u = members[head];
+            for (uint32_t k = adjStart[u]; k < adjStart[u + 1]; ++k) {
+                const Link& l = links[adj[k]];
+                uint32_t v = (l.a == u) ? l.b : l.a;
+                if (component[v] < 0) { component[v] = id; members.push_back(v); }
+            }
+        }
+        if (members.size() < 2) {
+            component[start] = -2 - (int32_t)start;   // 1つだけ（拘束の端）。他と被らない番号
+            continue;
+        }
+
+        // 根: 固定パーツ > 一番重い剛体 > 最初のパーツ
+        uint32_t root = members[0];
+        float bestMass = -1.0f;
+        bool rootAnchored = false;
+        for (uint32_t n : members) {
+            uint32_t mask = store.maskOf(nodes[n]);
+            if (mask & Comp_Anchored) {
+                if (!rootAnchored) { root = n; rootAnchored = true; }
+                continue;
+            }
+            if (rootAnchored) continue;
+            if (const RigidBody* b = store.get<RigidBody>(nodes[n])) {
+                if (b->mass > bestMass) { bestMass = b->mass; root = n; }
+            }
+        }
+
+        Assembly a;
+        a.root = nodes[root];
+        groupNodes.assign(1, nodes[root]);
+        groupPos.assign(1, Vector3(0, 0, 0));
+        groupR.assign(1, Matrix3());
+
+        queue.clear();
+        queue.push_back(root);
+        relPos[root] = Vector3(0, 0, 0);
+        relR[root] = Matrix3();
+        std::vector<char> placed(count, 0);
+        placed[root] = 1;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            uint32_t u = queue[head];
+            for (uint32_t k = adjStart[u]; k < adjStart[u + 1]; ++k) {
+                const Link& l = links[adj[k]];
+                uint32_t v = (l.a == u) ? l.b : l.a;
+                if (placed[v]) continue;   // 閉路になるジョイントは既に剛につながっている
+                placed[v] = 1;
+                queue.push_back(v);
+
+                Vector3 localPos;
+                Matrix3 localR;
+                l.joint->relativePose(localPos, localR);
+                bool inverse = (l.a != u);
+                if (inverse) {
+                    localR = localR.transpose();
+                    localPos = (localR * localPos) * -1.0f;
+                }
+                relR[v] = relR[u] * localR;
+                relPos[v] = relPos[u] + relR[u] * localPos;
+
+                hierarchy.attach(cubesOf[v], cubesOf[u], localPos, snappedEuler(localR));
+                edges.push_back(Edge{l.joint, nodes[v], nodes[u], inverse});
+                a.members.push_back(nodes[v]);
+                memberRoot[nodes[v].index] = MemberRef{nodes[v], nodes[root]};
+                groupNodes.push_back(nodes[v]);
+                groupPos.push_back(relPos[v]);
+                groupR.push_back(relR[v]);
+
+                // 剛体のメンバーは根に合わせて動かされるだけになる
+                if (RigidBody* b = store.get<RigidBody>(nodes[v])) b->kinematic = true;
+            }
+        }
+
+        if (!rootAnchored && store.get<RigidBody>(a.root)) {
+            bool memberBodies = false;
+            for (EntityId m : a.members) {
+                if (store.get<RigidBody>(m)) { memberBodies = true; break; }
+            }
+            if (memberBodies) buildCompound(a, groupNodes, groupPos, groupR);
+        }
+        assemblies.push_back(std::move(a));
+    }
+
+    // ---- 剛体同士の拘束（同じアセンブリの中なら既に剛なので要らない） ----
+    for (const Link& l : links) {
+        if (l.rigid || component[l.a] == component[l.b]) continue;
+        Constraint c;
+        c.joint = l.joint;
+        c.part0 = nodes[l.a];
+        c.part1 = nodes[l.b];
+        l.joint->relativePose(c.localPos, c.localR);
+        constraintList.push_back(c);
+    }
+}
+
+// モーターの角度だけが変わった
+void JointSystem::refreshPoses() {
+    posesDirty = false;
+    for (const Edge& e : edges) {
+        if (!e.joint->poseDirty) continue;
+        Vector3 pos;
+        Matrix3 R;
+        e.joint->relativePose(pos, R);
+        if (e.inverse) {
+            R = R.transpose();
+            pos = (R * pos) * -1.0f;
+        }
+        hierarchy.setLocal(store.ownerOf(e.child), pos, snappedEuler(R));
+    }
+    for (Constraint& c : constraintList) {
+        if (c.joint->poseDirty) c.joint->relativePose(c.localPos, c.localR);
+    }
+    for (JointInstance* j : joints) j->poseDirty = false;
+}
+
+// 根の RigidBody に全メンバーの質量・重心・慣性を合成する（根の座標系で）
+void JointSystem::buildCompound(Assembly& a, const std::vector<EntityId>& nodes,
+                                const std::vector<Vector3>& relPos, const std::vector<Matrix3>& relR) {
+    RigidBody* root = store.get<RigidBody>(a.root);
+    const Transform* rootT = store.get<Transform>(a.root);
+
+    float totalMass = 0.0f;
+    Vector3 com(0, 0, 0), momentum(0, 0, 0);
+    bool awake = false;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const RigidBody* b = store.get<RigidBody>(nodes[i]);
+        if (!b) continue;
+        totalMass += b->mass;
+        com += relPos[i] * b->mass;
+        momentum += b->velocity * b->mass;
+        if (!b->isSleeping) awake = true;
+    }
+    com = com / totalMass;
+
+    // 各パーツの慣性を根の向きに回し、平行軸の定理で重心まわりへ
+    Matrix3 I;
+    I.setZero();
+    bool fixedRotation = false;   // 回転しないパーツ（プレイヤー）を含む
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const RigidBody* b = store.get<RigidBody>(nodes[i]);
+        if (!b) continue;
+        Matrix3 local;
+        local.setZero();
+        for (int k = 0; k < 3; ++k) {
+            float inv = b->invInertiaTensorLocal.m[k][k];
+            if (inv <= 0.0f) fixedRotation = true;
+            else local.m[k][k] = 1.0f / inv;
+        }
+        I = I + relR[i] * local * relR[i].transpose();
+
+        Vector3 r = relPos[i] - com;
+        float r2 = r.dot(r);
+        float rv[3] = {r.x, r.y, r.z};
+        for (int p = 0; p < 3; ++p) {
+            for (int q = 0; q < 3; ++q) {
+                I.m[p][q] += b->mass * ((p == q ? r2 : 0.0f) - rv[p] * rv[q]);
+            }
+        }
+    }
+
+    a.compound = true;
+    a.savedMass = root->mass;
+    a.savedInvMass = root->invMass;
+    a.savedInvInertia = root->invInertiaTensorLocal;
+
+    root->mass = totalMass;
+    root->invMass = 1.0f / totalMass;
+    if (fixedRotation) root->invInertiaTensorLocal.setZero();
+    else root->invInertiaTensorLocal = I.inverse();
+    root->centerOfMass = com;
+    root->velocity = momentum / totalMass;
+    root->updateInertiaWorld(rootT->rotation);
+    if (awake) {
+        root->isSleeping = false;
+        root->sleepTimer = 0.0f;
+    }
+}
@@ -0,0 +1,183 @@
+// src/Game/Joint.hpp
+#ifndef JOINT_HPP
+#define JOINT_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Math/MathUtils.hpp"
+#include "src/Math/Quaternion.hpp"
+#include "src/Game/Instance.hpp"
+#include "src/Game/GameData.hpp"
+#include "src/Game/PartPool.hpp"
+#include "src/Game/TransformHierarchy.hpp"
+
+class JointSystem;
+
+// ジョイントの取り付け位置（パーツから見た位置・回転。Roblox の CFrame の代わり）
+struct JointFrame {
+    Vector3 pos = Vector3(0, 0, 0);
+    Vector3 rotation = Vector3(0, 0, 0);   // オイラー角（度）
+
+    JointFrame() = default;
+    JointFrame(const Vector3& p, const Vector3& r = Vector3(0, 0, 0)) : pos(p), rotation(r) {}
+};
+
+// ===================================================================
+// JointInstance: Weld / Motor6D
+//   Part1 の姿勢 = Part0 の姿勢 × C0 × (Motor6D なら Transform × C0 の Z軸回りに CurrentAngle) × C1⁻¹
+// 生きている間は JointSystem に登録される。Part0/Part1/C0/C1/Enabled を変えると
+// 繋がりの組み直しを、角度を変えると姿勢の更新を JointSystem に頼む
+// ===================================================================
+class JointInstance : public Instance {
+public:
+    // className は "Weld" か "Motor6D"
+    JointInstance(JointSystem* system, const std::string& className);
+    ~JointInstance() override;
+
+    bool isMotor() const { return classId == ClassId::Motor6D; }
+
+    Cube* getPart0() const;
+    Cube* getPart1() const;
+    void setPart0(Cube* part);
+    void setPart1(Cube* part);
+
+    const JointFrame& getC0() const { return c0; }
+    const JointFrame& getC1() const { return c1; }
+    void setC0(const JointFrame& f);
+    void setC1(const JointFrame& f);
+
+    bool isEnabled() const { return enabled; }
+    void setEnabled(bool e);
+
+    // Motor6D の角度（ラジアン）。MaxVelocity は 1/60 秒あたりの最大の変化量（Roblox と同じ）
+    float getCurrentAngle() const { return currentAngle; }
+    void setCurrentAngle(float a);
+    float desiredAngle = 0.0f;
+    float maxVelocity = 0.0f;
+
+    // Motor6D のアニメーションの回転（Roblox の Motor6D.Transform。Animator が毎フレーム書く）
+    const Quaternion& getTransform() const { return transform; }
+    void setTransform(const Quaternion& q);
+
+    // Part0 から見た Part1 の位置・回転
+    void relativePose(Vector3& pos, Matrix3& R) const;
+
+private:
+    friend class JointSystem;
+
+    JointSystem* system;    // JointSystem が先に壊れたら nullptr
+    PartHandle part0, part1;
+    JointFrame c0, c1;
+    bool enabled = true;
+    float currentAngle = 0.0f;
+    Quaternion transform;
+    bool poseDirty = false;  // 角度・Transform が変わった（次の step で姿勢を更新する）
+};
+
+// ===================================================================
+// JointSystem: ジョイントの登録と、繋がったパーツのまとめ方
+//
+// 剛体アセンブリ（既定）: ジョイントで繋がったパーツを1つの剛体にまとめる。
+//   根（固定パーツ > 一番重いパーツ）の RigidBody に質量・重心・慣性を合成し、
+//   他のパーツは TransformHierarchy で根に付いていく（積分も衝突応答も根だけ）。
+// 拘束: useAssemblies = false なら、剛体同士のジョイントは Physics が毎ステップ拘束として解く。
+//   RigidBody のないパーツ（プレイヤーの手足など）はどちらのモードでも相手に付いていく
+// ===================================================================
+class JointSystem {
+public:
+    // 剛体同士を繋ぐ拘束（アセンブリにまとめなかったジョイント）
+    struct Constraint {
+        JointInstance* joint;
+        EntityId part0, part1;
+        Vector3 localPos;   // Part0 から見た Part1
+        Matrix3 localR;
+    };
+
+    JointSystem(ComponentStore& store, PartPool& parts, TransformHierarchy& hierarchy)
+        : store(store), parts(parts), hierarchy(hierarchy) {}
+    ~JointSystem();
+
+    JointSystem(const JointSystem&) = delete;
+    JointSystem& operator=(const JointSystem&) = delete;
+
+    void setUseAssemblies(bool use) {
+        if (useAssemblies != use) { useAssemblies = use; topologyDirty = true; }
+    }
+    bool usesAssemblies() const { return useAssemblies; }
+
+    // 毎フレーム物理の前に呼ぶ（Physics::simulate）。
+    // モーターの角度を進め、繋がりが変わっていればアセンブリ・拘束を組み直す
+    void step(float dt);
+
+    const std::vector<Constraint>& constraints() const { return constraintList; }
+
+    // アセンブリの根（どのアセンブリにも属さないか根自身なら e）
+    EntityId rootOf(EntityId e) const {
+        if (memberRoot.empty()) return e;
+        auto it = memberRoot.find(e.index);
+        if (it == memberRoot.end() || it->second.member != e) return e;
+        return it->second.root;
+    }
+    bool hasAssemblies() const { return !assemblies.empty(); }
+
+    size_t jointCount() const { return joints.size(); }
+    size_t assemblyCount() const { return assemblies.size(); }
+
+    TransformHierarchy& getHierarchy() { return hierarchy; }
+    Cube* resolve(PartHandle h) const { return parts.get(h); }
+
+    // JointInstance から呼ばれる
+    void add(JointInstance* joint) { joints.push_back(joint); topologyDirty = true; }
+    void remove(JointInstance* joint);
+    void invalidate() { topologyDirty = true; }
+    void poseChanged() { posesDirty = true; }
+
+private:
+    // 根から子へのジョイント（TransformHierarchy に繋いだもの）
+    struct Edge {
+        JointInstance* joint;
+        EntityId child, parent;
+        bool inverse;       // child が Part0 側（ジョイントの逆向きに繋いだ）
+    };
+
+    struct Assembly {
+        EntityId root;
+        std::vector<EntityId> members;   // 根を除く
+        bool compound = false;           // 根の質量・慣性を合成した（元の値を saved* に持つ）
+        float savedMass = 0.0f, savedInvMass = 0.0f;
+        Matrix3 savedInvInertia;
+    };
+
+    struct MemberRef {
+        EntityId member;
+        EntityId root;
+    };
+
+    ComponentStore& store;
+    PartPool& parts;
+    TransformHierarchy& hierarchy;
+
+    std::vector<JointInstance*> joints;
+    std::vector<JointInstance*> pending;     // パーツが世界にいないので保留中のジョイント
+    std::vector<Edge> edges;
+    std::vector<Constraint> constraintList;
+    std::vector<Assembly> assemblies;
+    std::unordered_map<uint32_t, MemberRef> memberRoot;   // EntityId::index -> 根
+
+    bool useAssemblies = true;
+    bool topologyDirty = false;
+    bool posesDirty = false;
+
+    bool stillValid() const;
+    void dissolve();
+    void rebuild();
+    void refreshPoses();
+    void buildCompound(Assembly& a, const std::vector<EntityId>& nodes,
+                       const std::vector<Vector3>& relPos, const std::vector<Matrix3>& relR);
+};
+
+#endif // JOINT_HPP
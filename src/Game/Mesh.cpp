@@ -0,0 +1,784 @@
+// src/Game/Mesh.cpp
+#include "Mesh.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <array>
+#include <algorithm>
+#include <filesystem>
+
+#include <sys/stat.h>
+
+#include "src/Math/MathUtils.hpp"
+
+namespace {
+
+Vector3 mul(const Vector3& a, const Vector3& b) { return Vector3(a.x * b.x, a.y * b.y, a.z * b.z); }
+Vector3 vmin(const Vector3& a, const Vector3& b) { return Vector3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)); }
+Vector3 vmax(const Vector3& a, const Vector3& b) { return Vector3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)); }
+float axisOf(const Vector3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+float surfaceArea(const Vector3& mn, const Vector3& mx) {
+    Vector3 d = mx - mn;
+    if (d.x < 0.0f || d.y < 0.0f || d.z < 0.0f) return 0.0f;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+// 逆数（0 なら大きな値。スラブ判定用）
+float safeInverse(float v) { return std::abs(v) > 1e-12f ? 1.0f / v : (v < 0.0f ? -1e30f : 1e30f); }
+
+bool slab(const Vector3& o, const Vector3& inv, const Vector3& mn, const Vector3& mx, float maxT, float& tEnter) {
+    float t0 = (mn.x - o.x) * inv.x, t1 = (mx.x - o.x) * inv.x;
+    float lo = std::min(t0, t1), hi = std::max(t0, t1);
+    t0 = (mn.y - o.y) * inv.y; t1 = (mx.y - o.y) * inv.y;
+    lo = std::max(lo, std::min(t0, t1)); hi = std::min(hi, std::max(t0, t1));
+    t0 = (mn.z - o.z) * inv.z; t1 = (mx.z - o.z) * inv.z;
+    lo = std::max(lo, std::min(t0, t1)); hi = std::min(hi, std::max(t0, t1));
+    tEnter = lo;
+    return lo <= hi && hi >= 0.0f && lo <= maxT;
+}
+
+// 焼いた形式のヘッダ（配列はこの後に vertices, indices, nodes, hull, hullFaces, hullEdges の順）
+struct CookedHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t vertexCount, indexCount, nodeCount;
+    uint32_t hullCount, hullFaceCount, hullEdgeCount;
+    float naturalSize[3];
+    float volumeFraction;
+};
+const char kCookedMagic[4] = { 'R', 'M', 'S', 'H' };
+const uint32_t kCookedVersion = 1;
+
+static_assert(sizeof(Vector3) == 12, "焼いた形式は Vector3 を float 3 つとして書く");
+static_assert(sizeof(MeshNode) == 32, "焼いた形式の節点");
+static_assert(sizeof(MeshVertex) == 8 * sizeof(float), "描画の並び（位置3・法線3・UV2）");
+
+template <typename T>
+bool readArray(FILE* f, std::vector<T>& v, uint32_t count) {
+    v.resize(count);
+    return count == 0 || fread(v.data(), sizeof(T), count, f) == count;
+}
+
+template <typename T>
+bool writeArray(FILE* f, const std::vector<T>& v) {
+    return v.empty() || fwrite(v.data(), sizeof(T), v.size(), f) == v.size();
+}
+
+} // namespace
+
+// ====================================================================
+// MeshAsset: 作る
+// ====================================================================
+
+void MeshAsset::build(bool hasNormals) {
+    if (vertices.empty() || indices.size() < 3) {
+        nodes.clear();
+        hull.clear();
+        hullFaces.clear();
+        hullEdges.clear();
+        return;
+    }
+
+    Vector3 mn(1e30f, 1e30f, 1e30f), mx(-1e30f, -1e30f, -1e30f);
+    for (const MeshVertex& v : vertices) {
+        mn = vmin(mn, Vector3(v.x, v.y, v.z));
+        mx = vmax(mx, Vector3(v.x, v.y, v.z));
+    }
+    // 平らなメッシュでもパーツの大きさが 0 にならないよう、既定の大きさは少し厚くする
+    Vector3 ext = mx - mn;
+    naturalSize = Vector3(std::max(ext.x, 0.05f), std::max(ext.y, 0.05f), std::max(ext.z, 0.05f));
+    Vector3 center = (mn + mx) * 0.5f;
+    Vector3 inv(1.0f / naturalSize.x, 1.0f / naturalSize.y, 1.0f / naturalSize.z);
+
+    // 法線がなければ面の法線（面積の重み）を頂点ごとに足す。元の座標で作ってから箱の座標へ移す
+    if (!hasNormals) {
+        for (MeshVertex& v : vertices) v.nx = v.ny = v.nz = 0.0f;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            MeshVertex* c[3] = { &vertices[indices[i]], &vertices[indices[i + 1]], &vertices[indices[i + 2]] };
+            Vector3 a(c[0]->x, c[0]->y, c[0]->z), b(c[1]->x, c[1]->y, c[1]->z), d(c[2]->x, c[2]->y, c[2]->z);
+            Vector3 n = (b - a).cross(d - a);
+            for (MeshVertex* v : c) { v->nx += n.x; v->ny += n.y; v->nz += n.z; }
+        }
+    }
+    for (MeshVertex& v : vertices) {
+        Vector3 p = mul(Vector3(v.x, v.y, v.z) - center, inv);
+        // 法線は引き伸ばしの逆（転置の逆）で移す
+        Vector3 n = mul(Vector3(v.nx, v.ny, v.nz), naturalSize).normalized();
+        v.x = p.x; v.y = p.y; v.z = p.z;
+        v.nx = n.x; v.ny = n.y; v.nz = n.z;
+    }
+
+    // 箱の座標での体積（閉じていれば正確。閉じていなくても 0.05..1 に収める）
+    double volume = 0.0;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        Vector3 a = corner((uint32_t)(i / 3), 0), b = corner((uint32_t)(i / 3), 1), c = corner((uint32_t)(i / 3), 2);
+        volume += a.dot(b.cross(c)) / 6.0;
+    }
+    volumeFraction = std::max(0.05f, std::min(1.0f, (float)std::abs(volume)));
+
+    buildBVH();
+    buildHull();
+}
+
+void MeshAsset::buildBVH() {
+    uint32_t triCount = (uint32_t)triangleCount();
+    std::vector<Vector3> centers(triCount), boundsMin(triCount), boundsMax(triCount);
+    std::vector<uint32_t> order(triCount);
+    for (uint32_t i = 0; i < triCount; ++i) {
+        Vector3 a = corner(i, 0), b = corner(i, 1), c = corner(i, 2);
+        boundsMin[i] = vmin(a, vmin(b, c));
+        boundsMax[i] = vmax(a, vmax(b, c));
+        centers[i] = (boundsMin[i] + boundsMax[i]) * 0.5f;
+        order[i] = i;
+    }
+    nodes.clear();
+    nodes.reserve(2 * (triCount / kLeafTriangles + 1));
+    buildNode(order, centers, boundsMin, boundsMax, 0, triCount, 0);
+
+    // 葉の三角形が続けて並ぶよう indices を並べ替える
+    std::vector<uint32_t> sorted(indices.size());
+    for (uint32_t i = 0; i < triCount; ++i) {
+        std::copy_n(&indices[order[i] * 3], 3, &sorted[i * 3]);
+    }
+    indices.swap(sorted);
+}
+
+uint32_t MeshAsset::buildNode(std::vector<uint32_t>& order, const std::vector<Vector3>& centers,
+                              const std::vector<Vector3>& boundsMin, const std::vector<Vector3>& boundsMax,
+                              uint32_t begin, uint32_t end, int depth) {
+    uint32_t index = (uint32_t)nodes.size();
+    nodes.push_back(MeshNode());
+
+    Vector3 mn(1e30f, 1e30f, 1e30f), mx(-1e30f, -1e30f, -1e30f);
+    Vector3 cmn = mn, cmx = mx;
+    for (uint32_t i = begin; i < end; ++i) {
+        mn = vmin(mn, boundsMin[order[i]]);
+        mx = vmax(mx, boundsMax[order[i]]);
+        cmn = vmin(cmn, centers[order[i]]);
+        cmx = vmax(cmx, centers[order[i]]);
+    }
+    nodes[index].min = mn;
+    nodes[index].max = mx;
+    nodes[index].first = begin;
+    nodes[index].count = end - begin;
+
+    uint32_t count = end - begin;
+    // 走査のスタック（64）に収まる深さで止める
+    if (count <= (uint32_t)kLeafTriangles || depth >= 48) return index;
+
+    // SAH: 軸ごとに中心を 12 の区間に分け、区間の境目で分けたときの費用が一番小さいもの
+    const int kBins = 12;
+    float parentArea = surfaceArea(mn, mx);
+    float bestCost = 1e30f;
+    int bestAxis = -1, bestSplit = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        float lo = axisOf(cmn, axis), hi = axisOf(cmx, axis);
+        if (hi - lo < 1e-9f) continue;
+        float scale = kBins / (hi - lo);
+        uint32_t binCount[kBins] = {};
+        Vector3 binMin[kBins], binMax[kBins];
+        for (int b = 0; b < kBins; ++b) { binMin[b] = Vector3(1e30f, 1e30f, 1e30f); binMax[b] = Vector3(-1e30f, -1e30f, -1e30f); }
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t t = order[i];
+            int b = std::min(kBins - 1, (int)((axisOf(centers[t], axis) - lo) * scale));
+            binCount[b]++;
+            binMin[b] = vmin(binMin[b], boundsMin[t]);
+            binMax[b] = vmax(binMax[b], boundsMax[t]);
+        }
+        // 右から累積した面積・数
+        float rightArea[kBins];
+        uint32_t rightCount[kBins];
+        Vector3 rmn(1e30f, 1e30f, 1e30f), rmx(-1e30f, -1e30f, -1e30f);
+        uint32_t rc = 0;
+        for (int b = kBins - 1; b > 0; --b) {
+            rmn = vmin(rmn, binMin[b]); rmx = vmax(rmx, binMax[b]); rc += binCount[b];
+            rightArea[b] = surfaceArea(rmn, rmx);
+            rightCount[b] = rc;
+        }
+        Vector3 lmn(1e30f, 1e30f, 1e30f), lmx(-1e30f, -1e30f, -1e30f);
+        uint32_t lc = 0;
+        for (int b = 0; b < kBins - 1; ++b) {
+            lmn = vmin(lmn, binMin[b]); lmx = vmax(lmx, binMax[b]); lc += binCount[b];
+            if (lc == 0 || rightCount[b + 1] == 0) continue;
+            float cost = lc * surfaceArea(lmn, lmx) + rightCount[b + 1] * rightArea[b + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b + 1;
+            }
+        }
+    }
+
+    // 分けても安くならない（節点を辿る費用 1 + 葉の三角形の判定）なら葉にする
+    uint32_t mid;
+    if (bestAxis >= 0) {
+        if (parentArea > 0.0f && 1.0f + bestCost / parentArea >= (float)count && count <= 16) return index;
+        float lo = axisOf(cmn, bestAxis), scale = kBins / (axisOf(cmx, bestAxis) - lo);
+        uint32_t* split = std::partition(order.data() + begin, order.data() + end, [&](uint32_t t) {
+            return std::min(kBins - 1, (int)((axisOf(centers[t], bestAxis) - lo) * scale)) < bestSplit;
+        });
+        mid = (uint32_t)(split - order.data());
+    } else {
+        // 中心が全部同じ所: 数で半分に分ける
+        mid = begin + count / 2;
+    }
+    if (mid == begin || mid == end) mid = begin + count / 2;
+
+    nodes[index].count = 0;
+    buildNode(order, centers, boundsMin, boundsMax, begin, mid, depth + 1);
+    nodes[index].first = buildNode(order, centers, boundsMin, boundsMax, mid, end, depth + 1);
+    return index;
+}
+
+void MeshAsset::buildHull() {
+    hull.clear();
+    hullFaces.clear();
+    hullEdges.clear();
+
+    // 26 方向（箱の面・辺・角の向き）それぞれで一番外の頂点
+    std::vector<uint32_t> picked;
+    for (int x = -1; x <= 1; ++x) {
+        for (int y = -1; y <= 1; ++y) {
+            for (int z = -1; z <= 1; ++z) {
+                if (x == 0 && y == 0 && z == 0) continue;
+                Vector3 d((float)x, (float)y, (float)z);
+                uint32_t best = 0;
+                float bestDot = -1e30f;
+                for (uint32_t i = 0; i < vertices.size(); ++i) {
+                    const MeshVertex& v = vertices[i];
+                    float s = d.x * v.x + d.y * v.y + d.z * v.z;
+                    if (s > bestDot) { bestDot = s; best = i; }
+                }
+                Vector3 p(vertices[best].x, vertices[best].y, vertices[best].z);
+                bool seen = false;
+                for (const Vector3& q : hull) seen = seen || (q - p).lengthSquared() < 1e-10f;
+                if (!seen) hull.push_back(p);
+            }
+        }
+    }
+
+    // 全ての点が片側にある三つ組の平面が面。面を共有する2点の組が辺
+    const float eps = 1e-4f;
+    const int n = (int)hull.size();
+    struct Plane { Vector3 n; float d; };
+    std::vector<Plane> planes;
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            for (int k = j + 1; k < n; ++k) {
+                Vector3 normal = (hull[j] - hull[i]).cross(hull[k] - hull[i]);
+                float len = normal.length();
+                if (len < 1e-6f) continue;
+                normal = normal / len;
+                float d = normal.dot(hull[i]);
+                float lo = 0.0f, hi = 0.0f;
+                for (int m = 0; m < n; ++m) {
+                    float s = normal.dot(hull[m]) - d;
+                    lo = std::min(lo, s);
+                    hi = std::max(hi, s);
+                }
+                if (hi > eps && lo < -eps) continue;
+                if (hi > eps) { normal = normal * -1.0f; d = -d; }
+                bool seen = false;
+                for (const Plane& p : planes) seen = seen || (p.n.dot(normal) > 0.9999f && std::abs(p.d - d) < eps);
+                if (!seen) planes.push_back(Plane{normal, d});
+                // 平らな凸包は両面とも面になる
+                if (hi <= eps && lo >= -eps) {
+                    bool back = false;
+                    for (const Plane& p : planes) back = back || (p.n.dot(normal) < -0.9999f && std::abs(p.d + d) < eps);
+                    if (!back) planes.push_back(Plane{normal * -1.0f, -d});
+                }
+            }
+        }
+    }
+    for (const Plane& p : planes) {
+        bool seen = false;
+        for (const Vector3& f : hullFaces) seen = seen || std::abs(f.dot(p.n)) > 0.9999f;
+        if (!seen && (int)hullFaces.size() < kMaxHullFaces) hullFaces.push_back(p.n);
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            int shared = 0;
+            for (const Plane& p : planes) {
+                if (std::abs(p.n.dot(hull[i]) - p.d) < eps && std::abs(p.n.dot(hull[j]) - p.d) < eps) shared++;
+            }
+            if (shared < 2) continue;
+            Vector3 e = (hull[j] - hull[i]).normalized();
+            bool seen = false;
+            for (const Vector3& f : hullEdges) seen = seen || std::abs(f.dot(e)) > 0.9999f;
+            if (!seen && (int)hullEdges.size() < kMaxHullEdges) hullEdges.push_back(e);
+        }
+    }
+}
+
+// ====================================================================
+// MeshAsset: レイ
+// ====================================================================
+
+bool MeshAsset::raycast(const Vector3& origin, const Vector3& dir, float maxT, float& t, Vector3& normal) const {
+    if (nodes.empty()) return false;
+    Vector3 inv(safeInverse(dir.x), safeInverse(dir.y), safeInverse(dir.z));
+    float best = maxT;
+    bool found = false;
+
+    uint32_t stack[64];
+    int top = 0;
+    float enter;
+    if (!slab(origin, inv, nodes[0].min, nodes[0].max, best, enter)) return false;
+    stack[top++] = 0;
+    while (top > 0) {
+        uint32_t index = stack[--top];
+        const MeshNode& node = nodes[index];
+        if (node.count > 0) {
+            // 両面の三角形（Möller–Trumbore）
+            for (uint32_t tri = node.first; tri < node.first + node.count; ++tri) {
+                Vector3 a = corner(tri, 0), b = corner(tri, 1), c = corner(tri, 2);
+                Vector3 e1 = b - a, e2 = c - a;
+                Vector3 p = dir.cross(e2);
+                float det = e1.dot(p);
+                if (std::abs(det) < 1e-12f) continue;
+                float invDet = 1.0f / det;
+                Vector3 s = origin - a;
+                float u = s.dot(p) * invDet;
+                if (u < 0.0f || u > 1.0f) continue;
+                Vector3 q = s.cross(e1);
+                float v = dir.dot(q) * invDet;
+                if (v < 0.0f || u + v > 1.0f) continue;
+                float hitT = e2.dot(q) * invDet;
+                if (hitT < 0.0f || hitT > best) continue;
+                best = hitT;
+                normal = e1.cross(e2);
+                found = true;
+            }
+            continue;
+        }
+        // 近い子を後に積む（先に辿る）
+        uint32_t left = index + 1, right = node.first;
+        float tl, tr;
+        bool hl = slab(origin, inv, nodes[left].min, nodes[left].max, best, tl);
+        bool hr = slab(origin, inv, nodes[right].min, nodes[right].max, best, tr);
+        if (hl && hr) {
+            if (tl < tr) { stack[top++] = right; stack[top++] = left; }
+            else { stack[top++] = left; stack[top++] = right; }
+        } else if (hl) {
+            stack[top++] = left;
+        } else if (hr) {
+            stack[top++] = right;
+        }
+    }
+    if (found) t = best;
+    return found;
+}
+
+// ====================================================================
+// 簡略化（描画の LOD）
+// ====================================================================
+
+void simplifyMesh(const MeshAsset& mesh, int grid, std::vector<uint32_t>& out) {
+    out.clear();
+    grid = std::max(1, std::min(grid, 64));
+    const size_t n = mesh.vertices.size();
+    auto cellIndex = [grid](float v) { return std::max(0, std::min((int)((v + 0.5f) * grid), grid - 1)); };
+
+    // 升ごとの頂点の平均
+    std::vector<uint32_t> slotOfCell((size_t)grid * grid * grid, UINT32_MAX);
+    std::vector<uint32_t> slot(n);
+    std::vector<Vector3> sum;
+    std::vector<uint32_t> count;
+    for (size_t i = 0; i < n; ++i) {
+        const MeshVertex& v = mesh.vertices[i];
+        size_t cell = ((size_t)cellIndex(v.x) * grid + cellIndex(v.y)) * grid + cellIndex(v.z);
+        if (slotOfCell[cell] == UINT32_MAX) {
+            slotOfCell[cell] = (uint32_t)sum.size();
+            sum.push_back(Vector3(0, 0, 0));
+            count.push_back(0);
+        }
+        slot[i] = slotOfCell[cell];
+        sum[slot[i]] += Vector3(v.x, v.y, v.z);
+        count[slot[i]]++;
+    }
+
+    // 平均に一番近い頂点を升の代表にする（新しい頂点は作らないので、頂点のバッファはそのまま使える）
+    std::vector<uint32_t> representative(sum.size(), UINT32_MAX);
+    std::vector<float> best(sum.size(), 1e30f);
+    for (size_t i = 0; i < n; ++i) {
+        const MeshVertex& v = mesh.vertices[i];
+        uint32_t s = slot[i];
+        float d = (Vector3(v.x, v.y, v.z) - sum[s] * (1.0f / (float)count[s])).lengthSquared();
+        if (d < best[s]) { best[s] = d; representative[s] = (uint32_t)i; }
+    }
+
+    // 代表に付け替え、潰れた三角形と重なった三角形を除く（向きは残す）
+    std::vector<std::array<uint32_t, 3>> triangles;
+    triangles.reserve(mesh.triangleCount());
+    for (size_t tri = 0; tri < mesh.triangleCount(); ++tri) {
+        uint32_t a = representative[slot[mesh.indices[tri * 3]]];
+        uint32_t b = representative[slot[mesh.indices[tri * 3 + 1]]];
+        uint32_t c = representative[slot[mesh.indices[tri * 3 + 2]]];
+        if (a == b || b == c || c == a) continue;
+        // 一番小さい添字が先頭になるよう回す
+        if (b < a && b < c) triangles.push_back({ b, c, a });
+        else if (c < a && c < b) triangles.push_back({ c, a, b });
+        else triangles.push_back({ a, b, c });
+    }
+    std::sort(triangles.begin(), triangles.end());
+    triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+    out.reserve(triangles.size() * 3);
+    for (const auto& t : triangles) out.insert(out.end(), t.begin(), t.end());
+}
+
+// ====================================================================
+// 焼いた形式
+// ====================================================================
+
+bool MeshAsset::saveCooked(const std::string& file) const {
+    FILE* f = fopen(file.c_str(), "wb");
+    if (!f) return false;
+    CookedHeader h;
+    std::memcpy(h.magic, kCookedMagic, 4);
+    h.version = kCookedVersion;
+    h.vertexCount = (uint32_t)vertices.size();
+    h.indexCount = (uint32_t)indices.size();
+    h.nodeCount = (uint32_t)nodes.size();
+    h.hullCount = (uint32_t)hull.size();
+    h.hullFaceCount = (uint32_t)hullFaces.size();
+    h.hullEdgeCount = (uint32_t)hullEdges.size();
+    h.naturalSize[0] = naturalSize.x; h.naturalSize[1] = naturalSize.y; h.naturalSize[2] = naturalSize.z;
+    h.volumeFraction = volumeFraction;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 && writeArray(f, vertices) && writeArray(f, indices) &&
+              writeArray(f, nodes) && writeArray(f, hull) && writeArray(f, hullFaces) && writeArray(f, hullEdges);
+    ok = (fclose(f) == 0) && ok;
+    return ok;
+}
+
+bool MeshAsset::loadCooked(const std::string& file) {
+    FILE* f = fopen(file.c_str(), "rb");
+    if (!f) return false;
+    CookedHeader h;
+    bool ok = fread(&h, sizeof(h), 1, f) == 1 && std::memcmp(h.magic, kCookedMagic, 4) == 0 &&
+              h.version == kCookedVersion && h.indexCount >= 3 && h.indexCount % 3 == 0 &&
+              h.nodeCount >= 1 && h.hullCount >= 1 && h.hullCount <= (uint32_t)kMaxHullVerts && h.hullFaceCount <= (uint32_t)kMaxHullFaces &&
+              h.hullEdgeCount <= (uint32_t)kMaxHullEdges;
+    // 配列の大きさがファイルの残りと合うか（壊れたファイルで巨大な確保をしない）
+    if (ok) {
+        long at = ftell(f);
+        fseek(f, 0, SEEK_END);
+        long total = ftell(f);
+        fseek(f, at, SEEK_SET);
+        uint64_t expect = (uint64_t)h.vertexCount * sizeof(MeshVertex) + (uint64_t)h.indexCount * 4 +
+                          (uint64_t)h.nodeCount * sizeof(MeshNode) +
+                          (uint64_t)(h.hullCount + h.hullFaceCount + h.hullEdgeCount) * sizeof(Vector3);
+        ok = (uint64_t)(total - at) == expect;
+    }
+    ok = ok && readArray(f, vertices, h.vertexCount) && readArray(f, indices, h.indexCount) &&
+         readArray(f, nodes, h.nodeCount) && readArray(f, hull, h.hullCount) &&
+         readArray(f, hullFaces, h.hullFaceCount) && readArray(f, hullEdges, h.hullEdgeCount);
+    fclose(f);
+    if (!ok) return false;
+    // 添字が範囲の外を指していないか
+    for (uint32_t i : indices) {
+        if (i >= h.vertexCount) return false;
+    }
+    // 子は親より後ろにあり、深さは走査のスタックに収まるか（親が先に来るので、深さは一番深い道のもの）
+    std::vector<uint8_t> depth(h.nodeCount, 0);
+    for (uint32_t i = 0; i < h.nodeCount; ++i) {
+        const MeshNode& n = nodes[i];
+        if (n.count > 0) {
+            if ((uint64_t)n.first + n.count > h.indexCount / 3) return false;
+            continue;
+        }
+        if (n.first <= i + 1 || n.first >= h.nodeCount || depth[i] >= 60) return false;
+        uint8_t d = (uint8_t)(depth[i] + 1);
+        depth[i + 1] = std::max(depth[i + 1], d);
+        depth[n.first] = std::max(depth[n.first], d);
+    }
+    naturalSize = Vector3(h.naturalSize[0], h.naturalSize[1], h.naturalSize[2]);
+    volumeFraction = h.volumeFraction;
+    return true;
+}
+
+// ====================================================================
+// OBJ
+// ====================================================================
+
+namespace {
+
+struct ObjCursor {
+    const char* p;
+    const char* end;
+
+    void skipSpaces() { while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p; }
+    void skipLine() {
+        const char* nl = (const char*)std::memchr(p, '\n', (size_t)(end - p));
+        p = nl ? nl + 1 : end;
+    }
+    bool atLineEnd() { skipSpaces(); return p >= end || *p == '\n' || *p == '#'; }
+    bool number(float& out) {
+        skipSpaces();
+        if (p < end && *p == '+') ++p;
+        auto r = std::from_chars(p, end, out);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+        return true;
+    }
+    bool integer(long& out) {
+        auto r = std::from_chars(p, end, out);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+        return true;
+    }
+};
+
+// 面の頂点（v / vt / vn の添字。ないものは -1）
+struct ObjCorner {
+    long v, t, n;
+    bool operator==(const ObjCorner& o) const { return v == o.v && t == o.t && n == o.n; }
+};
+struct ObjCornerHash {
+    size_t operator()(const ObjCorner& c) const {
+        return (size_t)c.v * 0x9E3779B97F4A7C15ull ^ (size_t)(c.t + 1) * 0xC2B2AE3D27D4EB4Full ^ (size_t)(c.n + 1) * 0x165667B19E3779F9ull;
+    }
+};
+
+// 1始まり・負なら後ろから、を 0始まりに（範囲の外なら -2）
+long resolveIndex(long i, size_t count) {
+    if (i > 0 && (size_t)i <= count) return i - 1;
+    if (i < 0 && (size_t)(-i) <= count) return (long)count + i;
+    return -2;
+}
+
+} // namespace
+
+bool parseObj(const char* text, size_t length, MeshAsset& out) {
+    std::vector<Vector3> positions, normals;
+    std::vector<float> uvs;
+    std::unordered_map<ObjCorner, uint32_t, ObjCornerHash> corners;
+    out.vertices.clear();
+    out.indices.clear();
+    bool hasNormals = true;
+
+    ObjCursor c{text, text + length};
+    int line = 0;
+    std::vector<uint32_t> face;
+    while (c.p < c.end) {
+        ++line;
+        c.skipSpaces();
+        if (c.p + 1 < c.end && c.p[0] == 'v' && (c.p[1] == ' ' || c.p[1] == '\t')) {
+            c.p += 2;
+            Vector3 v;
+            if (!c.number(v.x) || !c.number(v.y) || !c.number(v.z)) {
+                std::cerr << "OBJ: bad vertex at line " << line << std::endl;
+                return false;
+            }
+            positions.push_back(v);
+        } else if (c.p + 2 < c.end && c.p[0] == 'v' && c.p[1] == 't' && (c.p[2] == ' ' || c.p[2] == '\t')) {
+            c.p += 3;
+            float u = 0.0f, v = 0.0f;
+            if (!c.number(u)) {
+                std::cerr << "OBJ: bad texture coordinate at line " << line << std::endl;
+                return false;
+            }
+            if (!c.atLineEnd()) c.number(v);
+            uvs.push_back(u);
+            uvs.push_back(v);
+        } else if (c.p + 2 < c.end && c.p[0] == 'v' && c.p[1] == 'n' && (c.p[2] == ' ' || c.p[2] == '\t')) {
+            c.p += 3;
+            Vector3 n;
+            if (!c.number(n.x) || !c.number(n.y) || !c.number(n.z)) {
+                std::cerr << "OBJ: bad normal at line " << line << std::endl;
+                return false;
+            }
+            normals.push_back(n);
+        } else if (c.p + 1 < c.end && c.p[0] == 'f' && (c.p[1] == ' ' || c.p[1] == '\t')) {
+            c.p += 2;
+            face.clear();
+            while (!c.atLineEnd()) {
+                ObjCorner k{-1, -1, -1};
+                long raw;
+                if (!c.integer(raw) || (k.v = resolveIndex(raw, positions.size())) < 0) {
+                    std::cerr << "OBJ: bad face index at line " << line << std::endl;
+                    return false;
+                }
+                if (c.p < c.end && *c.p == '/') {
+                    ++c.p;
+                    if (c.p < c.end && *c.p != '/') {
+                        if (!c.integer(raw) || (k.t = resolveIndex(raw, uvs.size() / 2)) < 0) {
+                            std::cerr << "OBJ: bad texture index at line " << line << std::endl;
+                            return false;
+                        }
+                    }
+                    if (c.p < c.end && *c.p == '/') {
+                        ++c.p;
+                        if (!c.integer(raw) || (k.n = resolveIndex(raw, normals.size())) < 0) {
+                            std::cerr << "OBJ: bad normal index at line " << line << std::endl;
+                            return false;
+                        }
+                    }
+                }
+                if (k.n < 0) hasNormals = false;
+
+                auto found = corners.find(k);
+                if (found == corners.end()) {
+                    MeshVertex v;
+                    const Vector3& p = positions[k.v];
+                    v.x = p.x; v.y = p.y; v.z = p.z;
+                    Vector3 n = k.n >= 0 ? normals[k.n] : Vector3(0, 0, 0);
+                    v.nx = n.x; v.ny = n.y; v.nz = n.z;
+                    v.u = k.t >= 0 ? uvs[k.t * 2] : 0.0f;
+                    v.v = k.t >= 0 ? uvs[k.t * 2 + 1] : 0.0f;
+                    found = corners.emplace(k, (uint32_t)out.vertices.size()).first;
+                    out.vertices.push_back(v);
+                }
+                face.push_back(found->second);
+            }
+            // 扇形に分ける
+            for (size_t i = 2; i < face.size(); ++i) {
+                out.indices.push_back(face[0]);
+                out.indices.push_back(face[i - 1]);
+                out.indices.push_back(face[i]);
+            }
+        }
+        // o / g / s / usemtl / mtllib / コメントは読み飛ばす
+        c.skipLine();
+    }
+    if (out.indices.empty()) {
+        std::cerr << "OBJ: no faces" << std::endl;
+        return false;
+    }
+    out.build(hasNormals);
+    return true;
+}
+
+bool loadObj(const std::string& path, MeshAsset& out) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    std::string text((size_t)in.tellg(), '\0');
+    in.seekg(0);
+    if (!in.read(&text[0], (std::streamsize)text.size())) return false;
+    out.path = path;
+    return parseObj(text.data(), text.size(), out);
+}
+
+// ====================================================================
+// MeshLibrary
+// ====================================================================
+
+MeshLibrary& MeshLibrary::get() {
+    static MeshLibrary instance;
+    return instance;
+}
+
+MeshLibrary::MeshLibrary() {
+    // 0 番: 大きさ 1 の箱（面ごとに頂点を分けて角を立てる）
+    std::unique_ptr<MeshAsset> box(new MeshAsset());
+    for (int axis = 0; axis < 3; ++axis) {
+        for (float sign : { -1.0f, 1.0f }) {
+            Vector3 n, u, v;
+            if (axis == 0) { n = Vector3(sign, 0, 0); u = Vector3(0, 1, 0); v = Vector3(0, 0, 1); }
+            if (axis == 1) { n = Vector3(0, sign, 0); u = Vector3(0, 0, 1); v = Vector3(1, 0, 0); }
+            if (axis == 2) { n = Vector3(0, 0, sign); u = Vector3(1, 0, 0); v = Vector3(0, 1, 0); }
+            if (sign < 0.0f) std::swap(u, v);   // 外から見て左回り
+            uint32_t base = (uint32_t)box->vertices.size();
+            for (int k = 0; k < 4; ++k) {
+                float a = (k == 1 || k == 2) ? 0.5f : -0.5f, b = (k >= 2) ? 0.5f : -0.5f;
+                Vector3 p = n * 0.5f + u * a + v * b;
+                box->vertices.push_back(MeshVertex{p.x, p.y, p.z, n.x, n.y, n.z, a + 0.5f, b + 0.5f});
+            }
+            for (uint32_t k : { 0u, 1u, 2u, 0u, 2u, 3u }) box->indices.push_back(base + k);
+        }
+    }
+    box->build(true);
+    assets.push_back(std::move(box));
+    byPath[""] = 0;
+}
+
+std::string MeshLibrary::entryPath(const std::string& path, uint64_t size, int64_t mtime) const {
+    // FNV-1a (64bit)
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&](const void* data, size_t n) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+    };
+    mix(path.data(), path.size());
+    mix(&size, sizeof(size));
+    mix(&mtime, sizeof(mtime));
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.mesh", (unsigned long long)h);
+    return cacheDir + "/" + name;
+}
+
+uint16_t MeshLibrary::load(const std::string& path) {
+    auto found = byPath.find(path);
+    if (found != byPath.end()) return found->second;
+    if (assets.size() > UINT16_MAX) {
+        std::cerr << "Mesh: too many meshes, " << path << " is drawn as a box" << std::endl;
+        return 0;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<MeshAsset> asset(new MeshAsset());
+    bool ok = false;
+    bool isCooked = path.size() > 5 && path.compare(path.size() - 5, 5, ".mesh") == 0;
+    if (isCooked) {
+        ok = asset->loadCooked(path);
+    } else {
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0) {
+            std::string cached = cacheEnabled ? entryPath(path, (uint64_t)st.st_size, (int64_t)st.st_mtime) : std::string();
+            if (!cached.empty() && asset->loadCooked(cached)) {
+                ok = true;
+                stats.cookedHits++;
+            } else if (loadObj(path, *asset)) {
+                ok = true;
+                if (!cached.empty()) {
+                    // 書きかけのファイルを読まないよう、一時ファイルに書いてから rename する
+                    std::error_code ec;
+                    std::filesystem::create_directories(cacheDir, ec);
+                    std::string tmp = cached + ".tmp";
+                    if (asset->saveCooked(tmp)) std::filesystem::rename(tmp, cached, ec);
+                    if (ec) std::remove(tmp.c_str());
+                }
+            }
+        }
+    }
+    stats.loadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        std::cerr << "Mesh: failed to load " << path << std::endl;
+        stats.failures++;
+        return 0;
+    }
+    asset->path = path;
+    stats.loaded++;
+    return add(path, std::move(asset));
+}
+
+uint16_t MeshLibrary::add(const std::string& name, std::unique_ptr<MeshAsset> asset) {
+    auto found = byPath.find(name);
+    if (found != byPath.end()) return found->second;
+    if (assets.size() > UINT16_MAX) return 0;
+    uint16_t id = (uint16_t)assets.size();
+    asset->path = name;
+    assets.push_back(std::move(asset));
+    byPath[name] = id;
+    return id;
+}
+
+bool raycastMeshPart(const Transform& part, const Vector3& origin, const Vector3& dir, float maxT,
+                     float& t, Vector3& normal) {
+    // 箱の座標へ移す（引き伸ばしは線形なので t はそのまま使える）
+    Matrix3 R = Matrix3::rotate(part.rotation);
+    Matrix3 Rt = R.transpose();
+    Vector3 inv(1.0f / std::max(part.size.x, 1e-6f), 1.0f / std::max(part.size.y, 1e-6f), 1.0f / std::max(part.size.z, 1e-6f));
+    Vector3 o = mul(Rt * (origin - part.pos), inv);
+    Vector3 d = mul(Rt * dir, inv);
+    Vector3 n;
+    if (!MeshLibrary::get().asset(part.mesh).raycast(o, d, maxT, t, n)) return false;
+    normal = (R * mul(n, inv)).normalized();
+    if (normal.dot(dir) > 0.0f) normal = normal * -1.0f;
+    return true;
+}
@@ -0,0 +1,156 @@
+// src/Game/Mesh.hpp
+#ifndef MESH_HPP
+#define MESH_HPP
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Game/ComponentStore.hpp"
+
+// 描画の頂点（Renderer の cubeVertices と同じ 位置3・法線3・UV2 の並び）
+struct MeshVertex {
+    float x, y, z;
+    float nx, ny, nz;
+    float u, v;
+};
+
+// 三角形の BVH の節点（SpatialQuery::Node と同じ並び）
+struct MeshNode {
+    Vector3 min, max;
+    uint32_t first;   // 葉: 最初の三角形（indices[first * 3] から）。内部: 右の子（左は自分の次）
+    uint32_t count;   // 葉なら三角形の数、内部なら 0
+};
+
+// ===================================================================
+// MeshAsset: MeshPart の形（読み込んだ三角形メッシュ1つ分）
+//
+// 頂点は大きさ 1 の箱（-0.5..0.5）に収めて持ち、パーツの Size で引き伸ばして使う
+// （Roblox の MeshPart と同じ。読み込んだままの大きさは naturalSize）。
+//   固定の MeshPart: 三角形そのものと当たる。BVH（SAH で分ける）で候補を絞る
+//   動く MeshPart: 凸包（26 方向の一番外の頂点から作る）で近似する
+// レイも BVH を辿る。作った後は読むだけなので、どのスレッドから読んでもよい
+// ===================================================================
+class MeshAsset {
+public:
+    static const int kMaxHullVerts = 26;
+    static const int kMaxHullFaces = 2 * kMaxHullVerts - 4;
+    static const int kMaxHullEdges = 3 * kMaxHullVerts - 6;
+    static const int kLeafTriangles = 4;
+
+    std::string path;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;     // 3 つずつ三角形。BVH の葉の順に並べ替えてある
+    std::vector<MeshNode> nodes;
+    std::vector<Vector3> hull;         // 凸包の頂点
+    std::vector<Vector3> hullFaces;    // 凸包の面の向き（裏向きの面は同じ軸なので数えない）
+    std::vector<Vector3> hullEdges;    // 凸包の辺の向き（平行なものは1本）
+    Vector3 naturalSize = Vector3(1, 1, 1);
+    float volumeFraction = 1.0f;       // 箱に対する体積の割合（質量用）
+
+    size_t triangleCount() const { return indices.size() / 3; }
+
+    // 頂点・三角形から（頂点は読み込んだままの座標）箱に収め、法線がなければ作り、BVH と凸包を作る
+    void build(bool hasNormals);
+
+    // 箱の座標のレイ origin + dir * t（t は [0, maxT]）の一番近い当たり。normal は三角形の向き（長さ 1 とは限らない）
+    bool raycast(const Vector3& origin, const Vector3& dir, float maxT, float& t, Vector3& normal) const;
+
+    // 箱の座標で AABB が [mn, mx] と重なる三角形ごとに fn(三角形の番号) を呼ぶ
+    template <typename Fn>
+    void forEachTriangle(const Vector3& mn, const Vector3& mx, Fn&& fn) const {
+        if (nodes.empty()) return;
+        uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const MeshNode& n = nodes[stack[--top]];
+            if (n.min.x > mx.x || n.max.x < mn.x || n.min.y > mx.y || n.max.y < mn.y ||
+                n.min.z > mx.z || n.max.z < mn.z) continue;
+            if (n.count > 0) {
+                for (uint32_t i = 0; i < n.count; ++i) fn(n.first + i);
+                continue;
+            }
+            uint32_t self = (uint32_t)(&n - nodes.data());
+            stack[top++] = n.first;
+            stack[top++] = self + 1;
+        }
+    }
+    Vector3 corner(uint32_t triangle, int k) const {
+        const MeshVertex& v = vertices[indices[triangle * 3 + k]];
+        return Vector3(v.x, v.y, v.z);
+    }
+
+    // 焼いた形式（.mesh）。読み込みはヘッダを確かめて配列を写すだけ
+    bool saveCooked(const std::string& file) const;
+    bool loadCooked(const std::string& file);
+
+private:
+    void buildBVH();
+    void buildHull();
+    uint32_t buildNode(std::vector<uint32_t>& order, const std::vector<Vector3>& centers,
+                       const std::vector<Vector3>& boundsMin, const std::vector<Vector3>& boundsMax,
+                       uint32_t begin, uint32_t end, int depth);
+};
+
+// OBJ（v / vt / vn / f。多角形は扇形に分ける）を読む。失敗したら false
+bool loadObj(const std::string& path, MeshAsset& out);
+bool parseObj(const char* text, size_t length, MeshAsset& out);
+
+// 描画の LOD 用に、頂点を grid^3 の升でまとめて一つにした三角形の添字を out に作る。
+// 添字は mesh.vertices を指したまま（頂点のバッファを共有できる）。潰れた三角形は除く
+void simplifyMesh(const MeshAsset& mesh, int grid, std::vector<uint32_t>& out);
+
+// ===================================================================
+// MeshLibrary: 読み込んだメッシュの一覧（Transform::mesh はこの番号）
+//
+// 0 番は大きさ 1 の箱（MeshId のない MeshPart・読み込みに失敗したもの）。
+// OBJ は読んで作った結果を .cache/meshes に焼いておき、次からはそれを読む
+// （キーは「パス + 大きさ + 更新時刻」なので、ソースが変われば読み直す）。.mesh はそのまま読む。
+// 読み込みはメインスレッドで行う前提（スレッドセーフではない）
+// ===================================================================
+class MeshLibrary {
+public:
+    struct Stats {
+        int loaded = 0;
+        int cookedHits = 0;
+        int failures = 0;
+        double loadMs = 0.0;
+    };
+
+    static MeshLibrary& get();
+
+    void setDirectory(const std::string& dir) { cacheDir = dir; }
+    void setCacheEnabled(bool enable) { cacheEnabled = enable; }
+
+    // path のメッシュの番号（初めてなら読み込む）。失敗したら 0
+    uint16_t load(const std::string& path);
+    // 作ったメッシュを名前で登録する（同じ名前なら置き換えない）
+    uint16_t add(const std::string& name, std::unique_ptr<MeshAsset> asset);
+
+    const MeshAsset& asset(uint16_t id) const { return *assets[id < assets.size() ? id : 0]; }
+    size_t count() const { return assets.size(); }
+    const Stats& getStats() const { return stats; }
+
+private:
+    MeshLibrary();
+
+    std::vector<std::unique_ptr<MeshAsset>> assets;
+    std::unordered_map<std::string, uint16_t> byPath;
+    std::string cacheDir = ".cache/meshes";
+    bool cacheEnabled = true;
+    Stats stats;
+
+    std::string entryPath(const std::string& path, uint64_t size, int64_t mtime) const;
+};
+
+// パーツ part（形は Mesh）の三角形とワールド座標のレイ origin + dir * t の一番近い当たり。
+// normal はレイに向いた長さ 1 の向き
+bool raycastMeshPart(const Transform& part, const Vector3& origin, const Vector3& dir, float maxT,
+                     float& t, Vector3& normal);
+
+#endif // MESH_HPP
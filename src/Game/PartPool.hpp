@@ -0,0 +1,163 @@
+// src/Game/PartPool.hpp
+#ifndef PARTPOOL_HPP
+#define PARTPOOL_HPP
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include "src/Game/GameData.hpp"
+
+// ===================================================================
+// PartPool: Cube 用のスロットマップ
+// Cube はチャンク単位で確保した領域に置くので、追加・削除でアドレスが動かない。
+// 生存中の Cube* は dense 配列に詰めてあり、物理・描画はこれを順に走査する。
+// 外部（Lua・Actor）は PartHandle で参照し、削除後は get() が nullptr を返す
+// Cube のデータ（構成要素）は components 側に置かれる
+// ===================================================================
+class PartPool {
+public:
+    static const size_t kChunkSize = 64;   // 1チャンクあたりの Cube 数
+
+    // dense 配列の走査用（Cube* を Cube& として返す）
+    template <typename T>
+    class Iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        explicit Iterator(Cube* const* p) : p(p) {}
+        T& operator*() const { return **p; }
+        T* operator->() const { return *p; }
+        Iterator& operator++() { ++p; return *this; }
+        Iterator operator++(int) { Iterator t = *this; ++p; return t; }
+        difference_type operator-(const Iterator& o) const { return p - o.p; }
+        bool operator==(const Iterator& o) const { return p == o.p; }
+        bool operator!=(const Iterator& o) const { return p != o.p; }
+
+    private:
+        Cube* const* p;
+    };
+
+    explicit PartPool(ComponentStore& components) : components(components) {}
+    ~PartPool() { clear(); }
+
+    PartPool(const PartPool&) = delete;
+    PartPool& operator=(const PartPool&) = delete;
+
+    // desc から作って追加する。返したポインタは destroy まで有効
+    Cube* create(const PartDesc& desc) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = (uint32_t)slots.size();
+            slots.push_back(Slot{});
+            if (index / kChunkSize >= chunks.size()) {
+                chunks.push_back(std::make_unique<Storage[]>(kChunkSize));
+            }
+        }
+
+        Cube* cube = ::new (slotPtr(index)) Cube(components, desc);   // Instance::operator new（フリーリスト）は通さない
+        Slot& slot = slots[index];
+        slot.alive = true;
+        slot.dense = (uint32_t)dense.size();
+        dense.push_back(cube);
+
+        cube->handle = PartHandle{index, slot.generation};
+        cube->pool = this;
+        return cube;
+    }
+
+    // 削除。dense 配列は末尾と入れ替えて詰める（走査順は変わる）
+    void destroy(PartHandle h) {
+        Cube* cube = get(h);
+        if (!cube) return;
+
+        Slot& slot = slots[h.index];
+        Cube* last = dense.back();
+        dense[slot.dense] = last;
+        slots[last->handle.index].dense = slot.dense;
+        dense.pop_back();
+
+        cube->~Cube();
+        slot.alive = false;
+        slot.generation++;   // 古いハンドルを無効にする
+        freeSlots.push_back(h.index);
+    }
+
+    void destroy(Cube* cube) {
+        if (cube) destroy(cube->handle);
+    }
+
+    // 生きていればその Cube、削除済み・再利用済みなら nullptr
+    Cube* get(PartHandle h) const {
+        if (h.index >= slots.size()) return nullptr;
+        const Slot& slot = slots[h.index];
+        if (!slot.alive || slot.generation != h.generation) return nullptr;
+        return slotPtr(h.index);
+    }
+
+    // inst がこのプールの生きている Cube か
+    // BasePart の Instance は全て PartPool の Cube なので、型を見てから印と世代を確かめる
+    bool contains(const Instance* inst) const {
+        if (!inst || !inst->IsA(ClassId::BasePart)) return false;
+        const Cube* cube = static_cast<const Cube*>(inst);
+        return cube->pool == this && get(cube->handle) == cube;
+    }
+
+    void clear() {
+        for (Cube* cube : dense) {
+            Slot& slot = slots[cube->handle.index];
+            cube->~Cube();
+            slot.alive = false;
+            slot.generation++;
+        }
+        dense.clear();
+
+        // スロットは残す（世代を引き継いで古いハンドルを無効のままにする）
+        freeSlots.clear();
+        for (uint32_t i = (uint32_t)slots.size(); i > 0; --i) freeSlots.push_back(i - 1);
+    }
+
+    size_t size() const { return dense.size(); }
+    bool empty() const { return dense.empty(); }
+    size_t slotCount() const { return slots.size(); }   // ハンドルの index の上限
+
+    // dense 配列の添字でアクセス（追加・削除で並びは変わる）
+    Cube& operator[](size_t i) { return *dense[i]; }
+    const Cube& operator[](size_t i) const { return *dense[i]; }
+
+    Iterator<Cube> begin() { return Iterator<Cube>(dense.data()); }
+    Iterator<Cube> end() { return Iterator<Cube>(dense.data() + dense.size()); }
+    Iterator<const Cube> begin() const { return Iterator<const Cube>(dense.data()); }
+    Iterator<const Cube> end() const { return Iterator<const Cube>(dense.data() + dense.size()); }
+
+private:
+    struct Slot {
+        uint32_t generation = 0;
+        uint32_t dense = 0;     // dense 配列での位置
+        bool alive = false;
+    };
+    using Storage = std::aligned_storage_t<sizeof(Cube), alignof(Cube)>;
+
+    ComponentStore& components;
+
+    std::vector<std::unique_ptr<Storage[]>> chunks;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::vector<Cube*> dense;
+
+    Cube* slotPtr(uint32_t index) const {
+        return reinterpret_cast<Cube*>(&chunks[index / kChunkSize][index % kChunkSize]);
+    }
+};
+
+#endif // PARTPOOL_HPP
@@ -4,6 +4,11 @@
 
 #include "GameData.hpp"
 #include "Instance.hpp"
+#include "PartPool.hpp"
+#include "TransformHierarchy.hpp"
+#include "Joint.hpp"
+#include "Animation.hpp"
+#include "src/Physics/CharacterController.hpp"
 #include <memory>
 
 // プレイヤークラス
@@ -19,6 +24,24 @@ public:
     
     bool onGround;
     Vector3 moveDirection;
+
+    TransformHierarchy* rig;   // 体のパーツを HumanoidRootPart に繋いでいる階層（buildBody で設定）
+
+    // 体の関節（Player の子。R6 と同じ名前）
+    JointInstance* RootJoint = nullptr;
+    JointInstance* Neck = nullptr;
+    JointInstance* RightShoulder = nullptr;
+    JointInstance* LeftShoulder = nullptr;
+    JointInstance* RightHip = nullptr;
+    JointInstance* LeftHip = nullptr;
+
+    // 関節を動かす Animator（Player の子）と、その上の待機・歩きのトラック
+    Animator* animator = nullptr;
+    AnimationTrack* idleTrack = nullptr;
+    AnimationTrack* walkTrack = nullptr;
+
+    // HumanoidRootPart を歩かせるカプセル（CharacterSystem が持つ）
+    CharacterController* controller = nullptr;
     
     Player(const std::string& name = "Player")
         : Instance(name, "Model"),
@@ -27,14 +50,23 @@ public:
           LeftArm(nullptr), RightArm(nullptr),
           LeftLeg(nullptr), RightLeg(nullptr),
           onGround(false),
-          moveDirection(0, 0, 0)
-    {}
+          moveDirection(0, 0, 0),
+          rig(nullptr)
+    {
+        // ClassName は Model のまま、IsA("Player") も通るようにする
+        classId = ClassId::Player;
+    }
     
-    void buildBody(std::vector<Cube>& cubesContainer, const Vector3& spawnPosition) {
-        size_t startIndex = cubesContainer.size();
-        
+    // 体のパーツ・関節・Animator か（Player がポインタを持っているので Destroy させない）
+    bool ownsPart(const Instance* part) const {
+        return part && (part == HumanoidRootPart || part == Head || part == Torso ||
+                        part == LeftArm || part == RightArm || part == LeftLeg || part == RightLeg ||
+                        (part->Parent == this && part->IsA(ClassId::JointInstance)) || part == animator);
+    }
+
+    void buildBody(PartPool& cubesContainer, JointSystem& joints, const Vector3& spawnPosition) {
         // 0. HumanoidRootPart (物理演算の本体)
-        cubesContainer.push_back(
+        HumanoidRootPart = cubesContainer.create(
             CubeBuilder()
                 .size(4, 10, 2) 
                 .pos(spawnPosition)
@@ -46,12 +78,11 @@ public:
                 .setTransparency(1.0f) // 透明化
                 .build()
         );
-        HumanoidRootPart = &cubesContainer[startIndex + 0];
         
         // --- 以下は装飾パーツ ---
         
         // 1. Torso
-        cubesContainer.push_back(
+        Torso = cubesContainer.create(
             CubeBuilder()
                 .size(4, 4, 2)
                 .pos(spawnPosition)
@@ -60,10 +91,9 @@ public:
                 .setSimulated(false).setCanCollide(false)
                 .build()
         );
-        Torso = &cubesContainer[startIndex + 1];
         
         // 2. Head
-        cubesContainer.push_back(
+        Head = cubesContainer.create(
             CubeBuilder()
                 .size(4, 2, 2)
                 .pos(spawnPosition)
@@ -73,10 +103,9 @@ public:
                 .setSimulated(false).setCanCollide(false)
                 .build()
         );
-        Head = &cubesContainer[startIndex + 2];
         
         // 3. Right Arm
-        cubesContainer.push_back(
+        RightArm = cubesContainer.create(
             CubeBuilder()
                 .size(2, 4, 2)
                 .pos(spawnPosition)
@@ -85,10 +114,9 @@ public:
                 .setSimulated(false).setCanCollide(false)
                 .build()
         );
-        RightArm = &cubesContainer[startIndex + 3];
         
         // 4. Left Arm
-        cubesContainer.push_back(
+        LeftArm = cubesContainer.create(
             CubeBuilder()
                 .size(2, 4, 2)
                 .pos(spawnPosition)
@@ -97,10 +125,9 @@ public:
                 .setSimulated(false).setCanCollide(false)
                 .build()
         );
-        LeftArm = &cubesContainer[startIndex + 4];
         
         // 5. Right Leg
-        cubesContainer.push_back(
+        RightLeg = cubesContainer.create(
             CubeBuilder()
                 .size(2, 4, 2)
                 .pos(spawnPosition)
@@ -109,10 +136,9 @@ public:
                 .setSimulated(false).setCanCollide(false)
                 .build()
         );
-        RightLeg = &cubesContainer[startIndex + 5];
         
         // 6. Left Leg
-        cubesContainer.push_back(
+        LeftLeg = cubesContainer.create(
             CubeBuilder()
                 .size(2, 4, 2)
                 .pos(spawnPosition)
@@ -121,37 +147,83 @@ public:
                 .setSimulated(false).setCanCollide(false)
                 .build()
         );
-        LeftLeg = &cubesContainer[startIndex + 6];
+
+        buildJoints(joints);
     }
     
-    void updateBodyParts() {
+    // 体のパーツを Motor6D で繋ぐ（HumanoidRootPart → Torso → 頭・手足）。
+    // 手足は RigidBody を持たないので、JointSystem が HumanoidRootPart に付いていかせる。
+    // 肩・股関節は Z軸（C0 の回転で体の左右方向に向けてある）回りに CurrentAngle だけ回る
+    void buildJoints(JointSystem& joints) {
+        rig = &joints.getHierarchy();
         if (!HumanoidRootPart) return;
-        
-        Vector3 rootPos = HumanoidRootPart->pos;
-        Vector3 rootRot = HumanoidRootPart->rotation;
-        Matrix3 R = Matrix3::rotate(rootRot);
-
-        // 各パーツのオフセット
-        Vector3 offsetTorso    = Vector3(0, 1.0f, 0);
-        Vector3 offsetHead     = Vector3(0, 4.0f, 0);
-        Vector3 offsetRightArm = Vector3(3.0f, 1.0f, 0);
-        Vector3 offsetLeftArm  = Vector3(-3.0f, 1.0f, 0);
-        Vector3 offsetRightLeg = Vector3(1.0f, -3.0f, 0);
-        Vector3 offsetLeftLeg  = Vector3(-1.0f, -3.0f, 0);
-
-        auto updatePart = [&](Cube* part, Vector3 localOffset) {
-            if(!part) return;
-            Vector3 worldOffset = R * localOffset;
-            part->pos = rootPos + worldOffset;
-            part->rotation = rootRot;
-        };
-
-        updatePart(Torso, offsetTorso);
-        updatePart(Head, offsetHead);
-        updatePart(RightArm, offsetRightArm);
-        updatePart(LeftArm, offsetLeftArm);
-        updatePart(RightLeg, offsetRightLeg);
-        updatePart(LeftLeg, offsetLeftLeg);
+        RootJoint     = addMotor(joints, "RootJoint", HumanoidRootPart, Torso,
+                                 JointFrame(Vector3(0, 1.0f, 0)), JointFrame());
+        Neck          = addMotor(joints, "Neck", Torso, Head,
+                                 JointFrame(Vector3(0, 2.0f, 0), Vector3(-90, 0, 0)),
+                                 JointFrame(Vector3(0, -1.0f, 0), Vector3(-90, 0, 0)));
+        RightShoulder = addMotor(joints, "Right Shoulder", Torso, RightArm,
+                                 JointFrame(Vector3(2.0f, 1.0f, 0), Vector3(0, 90, 0)),
+                                 JointFrame(Vector3(-1.0f, 1.0f, 0), Vector3(0, 90, 0)));
+        LeftShoulder  = addMotor(joints, "Left Shoulder", Torso, LeftArm,
+                                 JointFrame(Vector3(-2.0f, 1.0f, 0), Vector3(0, -90, 0)),
+                                 JointFrame(Vector3(1.0f, 1.0f, 0), Vector3(0, -90, 0)));
+        RightHip      = addMotor(joints, "Right Hip", Torso, RightLeg,
+                                 JointFrame(Vector3(1.0f, -2.0f, 0), Vector3(0, 90, 0)),
+                                 JointFrame(Vector3(0, 2.0f, 0), Vector3(0, 90, 0)));
+        LeftHip       = addMotor(joints, "Left Hip", Torso, LeftLeg,
+                                 JointFrame(Vector3(-1.0f, -2.0f, 0), Vector3(0, -90, 0)),
+                                 JointFrame(Vector3(0, 2.0f, 0), Vector3(0, -90, 0)));
+    }
+
+    JointInstance* addMotor(JointSystem& joints, const std::string& name, Cube* part0, Cube* part1,
+                            const JointFrame& c0, const JointFrame& c1) {
+        JointInstance* motor = new JointInstance(&joints, "Motor6D");
+        motor->setName(name);
+        motor->setPart0(part0);
+        motor->setPart1(part1);
+        motor->setC0(c0);
+        motor->setC1(c1);
+        addChild(motor);
+        return motor;
+    }
+
+    // Animator を付けて待機アニメーションを流す（buildBody の後）。クリップは全 Player で共有する
+    void loadAnimations(AnimationSystem& animations) {
+        static const std::shared_ptr<const AnimationClip> idle = AnimationClip::r6Idle();
+        static const std::shared_ptr<const AnimationClip> walk = AnimationClip::r6Walk();
+
+        animator = new Animator(&animations);
+        addChild(animator);
+        idleTrack = animator->loadAnimation(idle);
+        idleTrack->priority = AnimationPriority::Idle;
+        walkTrack = animator->loadAnimation(walk);
+        walkTrack->priority = AnimationPriority::Movement;
+        idleTrack->play(0.0f);
+    }
+
+    // HumanoidRootPart を CharacterController で動かす（buildBody の後）。体のパーツには当たらない
+    void attachController(CharacterSystem& characters) {
+        controller = characters.add(HumanoidRootPart, this);
+    }
+
+    // 水平の速さに合わせて歩きのトラックを出し入れする（毎フレーム、AnimationSystem::step の前）
+    void updateAnimation() {
+        if (!walkTrack || !HumanoidRootPart) return;
+        Vector3 v = HumanoidRootPart->velocity();
+        float speed = std::sqrt(v.x * v.x + v.z * v.z);
+        bool walking = speed > 2.0f && HumanoidRootPart->onGround();
+        if (walking) {
+            if (!walkTrack->isPlaying()) walkTrack->play(0.2f);
+            walkTrack->adjustSpeed(speed / 25.0f);   // 速さ 25 で 1 倍速
+        } else if (walkTrack->isPlaying()) {
+            walkTrack->stop(0.2f);
+        }
+    }
+
+    // 体のパーツを HumanoidRootPart に合わせる（動いていなければ何もしない）
+    void updateBodyParts() {
+        if (rig) rig->update();
     }
 
     void wakeUp() {
@@ -159,28 +231,28 @@ public:
     }
     
     Vector3 getPosition() const {
-        if (HumanoidRootPart) return HumanoidRootPart->pos;
+        if (HumanoidRootPart) return HumanoidRootPart->pos();
         return Vector3(0, 0, 0);
     }
     
     void setPosition(const Vector3& newPos) {
         if (!HumanoidRootPart) return;
-        HumanoidRootPart->pos = newPos;
+        HumanoidRootPart->pos() = newPos;
+        HumanoidRootPart->markChanged(Prop_Position);
         updateBodyParts();
     }
     
     void setVelocity(const Vector3& vel) {
-        if (HumanoidRootPart) HumanoidRootPart->velocity = vel;
+        if (HumanoidRootPart) {
+            HumanoidRootPart->setVelocity(vel);
+            HumanoidRootPart->markChanged(Prop_Velocity);
+        }
     }
     
     Vector3 getVelocity() const {
-        if (HumanoidRootPart) return HumanoidRootPart->velocity;
+        if (HumanoidRootPart) return HumanoidRootPart->velocity();
         return Vector3(0, 0, 0);
     }
-
-    bool IsA(const std::string& className) const override {
-        return className == "Model" || className == "Player" || Instance::IsA(className);
-    }
 };
 
 #endif // PLAYER_HPP
\ No newline at end of file
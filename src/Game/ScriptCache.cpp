@@ -0,0 +1,191 @@
+// src/Game/ScriptCache.cpp
+#include "ScriptCache.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+
+namespace {
+    int writeChunk(lua_State*, const void* p, size_t sz, void* ud) {
+        static_cast<std::string*>(ud)->append(static_cast<const char*>(p), sz);
+        return 0;
+    }
+}
+
+const char ScriptCache::kMagic[8] = { 'R', 'B', 'L', 'U', 'A', 'C', '\0', '1' };
+
+ScriptCache& ScriptCache::get() {
+    static ScriptCache instance;
+    return instance;
+}
+
+// FNV-1a (64bit)
+uint64_t ScriptCache::hash(const std::string& path, const std::string& source) {
+    uint64_t h = 14695981039346656037ull;
+    auto mix = [&h](const std::string& s) {
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+    };
+    mix(path);
+    h ^= 0xff; h *= 1099511628211ull;  // パスとソースの区切り
+    mix(source);
+    return h;
+}
+
+// 8 バイトずつ混ぜるチェックサム（キーの FNV-1a とは別の関数にして、キーが衝突しても見分ける）
+uint64_t ScriptCache::checksum(const char* data, size_t size) {
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ size;
+    size_t i = 0;
+    auto mix = [&h](uint64_t w) {
+        w *= 0xff51afd7ed558ccdull;
+        w ^= w >> 33;
+        h = (h ^ w) * 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 29;
+    };
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        mix(w);
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + i, size - i);
+    mix(tail);
+    return h;
+}
+
+std::string ScriptCache::entryPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.luac", (unsigned long long)key);
+    return cacheDir + "/" + name;
+}
+
+int ScriptCache::load(lua_State* L, const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+    std::string chunkName = "@" + path;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        lua_pushfstring(L, "cannot open %s", path.c_str());
+        return LUA_ERRFILE;
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    std::string source = ss.str();
+
+    int status = LUA_OK;
+    std::string cached = enabled ? entryPath(hash(path, source)) : std::string();
+
+    if (enabled && loadCached(L, cached, chunkName, source)) {
+        stats.hits++;
+    } else {
+        status = luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "t");
+        if (status == LUA_OK && enabled) store(L, cached, source);
+        stats.misses++;
+    }
+
+    stats.loadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return status;
+}
+
+int ScriptCache::doFile(lua_State* L, const std::string& path) {
+    int status = load(L, path);
+    if (status != LUA_OK) return status;
+    return lua_pcall(L, 0, LUA_MULTRET, 0);
+}
+
+bool ScriptCache::loadCached(lua_State* L, const std::string& file, const std::string& chunkName, const std::string& source) {
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) return false;
+
+    // 先頭のヘッダーで、同じソースから今の Lua で作った、切れていないエントリかを確かめる
+    const char* bytes = static_cast<const char*>(data);
+    const size_t size = (size_t)st.st_size;
+    std::string reason;
+    EntryHeader header;
+    if (size < sizeof(header)) {
+        reason = "truncated header";
+    } else {
+        std::memcpy(&header, bytes, sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.headerSize != sizeof(header)) reason = "bad header";
+        else if (header.luaVersion != LUA_VERSION_RELEASE_NUM) reason = "Lua version mismatch";
+        else if (header.sourceSize != source.size() || header.sourceChecksum != checksum(source.data(), source.size())) reason = "source mismatch";
+        else if (header.bytecodeSize != size - sizeof(header)) reason = "truncated bytecode";
+        else if (header.bytecodeChecksum != checksum(bytes + sizeof(header), header.bytecodeSize)) reason = "bytecode checksum mismatch";
+    }
+
+    if (reason.empty()) {
+        // "b" モードなのでソースとして解釈されることはない
+        if (luaL_loadbufferx(L, bytes + sizeof(header), (size_t)header.bytecodeSize, chunkName.c_str(), "b") != LUA_OK) {
+            reason = lua_tostring(L, -1);
+            lua_pop(L, 1);
+        }
+    }
+    munmap(data, size);
+
+    if (!reason.empty()) {
+        // 壊れている・Lua の版が違う・別のソース -> 捨ててソースから読み直す
+        std::cerr << "Script cache: discarding " << file << " (" << reason << ")" << std::endl;
+        std::remove(file.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ScriptCache::store(lua_State* L, const std::string& file, const std::string& source) {
+    // スタックトップのチャンクをダンプ（デバッグ情報は残してエラー行番号を保つ）
+    std::string bytecode;
+    if (lua_dump(L, writeChunk, &bytecode, 0) != 0 || bytecode.empty()) return;
+
+    EntryHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.luaVersion = LUA_VERSION_RELEASE_NUM;
+    header.headerSize = sizeof(header);
+    header.sourceSize = source.size();
+    header.sourceChecksum = checksum(source.data(), source.size());
+    header.bytecodeSize = bytecode.size();
+    header.bytecodeChecksum = checksum(bytecode.data(), bytecode.size());
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+
+    // 書きかけのファイルを読まないよう、一時ファイルに書いてから rename する
+    std::string tmp = file + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(bytecode.data(), (std::streamsize)bytecode.size());
+        if (!out) return;
+    }
+    std::filesystem::rename(tmp, file, ec);
+    if (ec) std::remove(tmp.c_str());
+}
+
+void ScriptCache::printStats() const {
+    std::cout << "✓ Scripts loaded: " << (stats.hits + stats.misses)
+              << " (cache hit " << stats.hits << " / miss " << stats.misses << ") in "
+              << stats.loadMs << " ms" << std::endl;
+}
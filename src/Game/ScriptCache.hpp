@@ -0,0 +1,62 @@
+// src/Game/ScriptCache.hpp
+#ifndef SCRIPTCACHE_HPP
+#define SCRIPTCACHE_HPP
+
+#include <string>
+#include <cstdint>
+
+struct lua_State;
+
+// lua_dump したバイトコードをディスクにキャッシュする
+// キーは「パス + ソース内容」のハッシュなので、ソースが変われば自動的にソースから読み直す。
+// Lua はバイトコードを検証しないので、各エントリの先頭に EntryHeader を置き、
+// 読む前に Lua の版・ソースの長さとチェックサム・バイトコードのチェックサムを確かめる
+// （途中で切れた・壊れたファイルやキーの衝突は、消してソースから作り直す）
+// スクリプトの読み込みはメインスレッドで行う前提（スレッドセーフではない）
+class ScriptCache {
+public:
+    struct Stats {
+        int hits = 0;
+        int misses = 0;
+        double loadMs = 0.0;   // 読み込み（パース or バイトコードのロード）に掛かった合計時間
+    };
+
+    static ScriptCache& get();
+
+    void setDirectory(const std::string& dir) { cacheDir = dir; }
+    void setEnabled(bool enable) { enabled = enable; }
+
+    // luaL_loadfile の代わり。成功するとチャンクをスタックに積んで LUA_OK を返す
+    int load(lua_State* L, const std::string& path);
+
+    // luaL_dofile の代わり
+    int doFile(lua_State* L, const std::string& path);
+
+    const Stats& getStats() const { return stats; }
+    void printStats() const;
+
+private:
+    std::string cacheDir = ".cache/luac";
+    bool enabled = true;
+    Stats stats;
+
+    struct EntryHeader {
+        char magic[8];              // kMagic
+        uint32_t luaVersion;        // LUA_VERSION_RELEASE_NUM
+        uint32_t headerSize;        // sizeof(EntryHeader)
+        uint64_t sourceSize;
+        uint64_t sourceChecksum;    // checksum(ソース)（キーとは別の関数）
+        uint64_t bytecodeSize;
+        uint64_t bytecodeChecksum;
+    };
+    static const char kMagic[8];
+
+    static uint64_t hash(const std::string& path, const std::string& source);
+    static uint64_t checksum(const char* data, size_t size);
+    std::string entryPath(uint64_t key) const;
+
+    bool loadCached(lua_State* L, const std::string& file, const std::string& chunkName, const std::string& source);
+    void store(lua_State* L, const std::string& file, const std::string& source);
+};
+
+#endif // SCRIPTCACHE_HPP
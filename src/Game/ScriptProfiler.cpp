@@ -0,0 +1,338 @@
+// src/Game/ScriptProfiler.cpp
+#include "ScriptProfiler.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+
+// ===================================================================
+// LuaAllocator
+// ===================================================================
+
+LuaAllocator::~LuaAllocator() {
+    for (char* page : pages) std::free(page);
+    pages.clear();
+    for (void* block : unpooled) std::free(block);
+    unpooled.clear();
+}
+
+void* LuaAllocator::allocBlock(size_t size) {
+    if (size > kMaxPooled) {
+        stats.systemCalls++;
+        return std::malloc(size);
+    }
+
+    size_t c = classOf(size);
+    if (FreeBlock* block = freeLists[c]) {
+        freeLists[c] = block->next;
+        return block;
+    }
+
+    // フリーリストが空ならページから切り出す
+    size_t blockSize = (c + 1) * kGranularity;
+    if (!bumpPtr[c] || bumpPtr[c] + blockSize > bumpEnd[c]) {
+        char* page = static_cast<char*>(std::malloc(kPageSize));
+        if (!page) return nullptr;
+        stats.systemCalls++;
+        stats.poolBytes += kPageSize;
+        pages.push_back(page);
+        bumpPtr[c] = page;
+        bumpEnd[c] = page + kPageSize;
+    }
+    void* p = bumpPtr[c];
+    bumpPtr[c] += blockSize;
+    return p;
+}
+
+void LuaAllocator::freeBlock(void* ptr, size_t size) {
+    if (size > kMaxPooled) {
+        stats.systemCalls++;
+        std::free(ptr);
+        return;
+    }
+    if (!unpooled.empty()) {
+        auto it = std::find(unpooled.begin(), unpooled.end(), ptr);
+        if (it != unpooled.end()) {
+            *it = unpooled.back();
+            unpooled.pop_back();
+            stats.systemCalls++;
+            std::free(ptr);
+            return;
+        }
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    size_t c = classOf(size);
+    block->next = freeLists[c];
+    freeLists[c] = block;
+}
+
+void* LuaAllocator::realloc(void* ptr, size_t osize, size_t nsize) {
+    // 解放
+    if (nsize == 0) {
+        if (ptr) {
+            freeBlock(ptr, osize);
+            stats.bytesInUse -= osize;
+        }
+        return nullptr;
+    }
+
+    // 新規確保（ptr == NULL のとき osize はオブジェクトの型なのでサイズとして扱わない）
+    if (!ptr) {
+        void* p = allocBlock(nsize);
+        if (p) {
+            stats.allocations++;
+            stats.bytesInUse += nsize;
+            stats.peakBytes = std::max(stats.peakBytes, stats.bytesInUse);
+        }
+        return p;
+    }
+
+    // サイズ変更
+    bool oldPooled = osize <= kMaxPooled;
+    bool newPooled = nsize <= kMaxPooled;
+    void* p = nullptr;
+
+    if (oldPooled && newPooled && classOf(osize) == classOf(nsize)) {
+        p = ptr;   // 同じサイズクラスならそのまま
+    } else if (!oldPooled && !newPooled) {
+        stats.systemCalls++;
+        p = std::realloc(ptr, nsize);
+        if (!p) return nullptr;
+    } else {
+        p = allocBlock(nsize);
+        if (!p) {
+            // Lua は縮小が失敗しない前提なので、縮小なら元のブロックを使い続ける。
+            // malloc のブロックは以後プールのサイズで解放されるので、free に戻すよう覚えておく
+            if (nsize <= osize) {
+                if (!oldPooled) unpooled.push_back(ptr);
+                stats.bytesInUse -= osize - nsize;
+                return ptr;
+            }
+            return nullptr;
+        }
+        std::memcpy(p, ptr, std::min(osize, nsize));
+        freeBlock(ptr, osize);
+        stats.allocations++;
+    }
+
+    stats.bytesInUse = stats.bytesInUse - osize + nsize;
+    stats.peakBytes = std::max(stats.peakBytes, stats.bytesInUse);
+    return p;
+}
+
+// ===================================================================
+// ScriptProfiler
+// ===================================================================
+
+double ScriptProfiler::budgetMs = 250.0;
+int ScriptProfiler::hookInterval = 1000;
+
+namespace {
+    // 生存中の全プロファイラ（ダンプと ScriptStats() 用）
+    std::mutex& registryMutex() {
+        static std::mutex m;
+        return m;
+    }
+    std::vector<ScriptProfiler*>& registry() {
+        static std::vector<ScriptProfiler*> profilers;
+        return profilers;
+    }
+}
+
+ScriptProfiler::ScriptProfiler(const std::string& vmName) : name(vmName) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    registry().push_back(this);
+}
+
+ScriptProfiler::~ScriptProfiler() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    auto& r = registry();
+    r.erase(std::remove(r.begin(), r.end(), this), r.end());
+}
+
+void* ScriptProfiler::luaAlloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    ScriptProfiler* self = static_cast<ScriptProfiler*>(ud);
+    if (self->current && nsize > 0) {
+        size_t old = ptr ? osize : 0;
+        if (nsize > old) self->current->allocBytes += nsize - old;
+    }
+    return self->allocator.realloc(ptr, osize, nsize);
+}
+
+lua_State* ScriptProfiler::newState() {
+    lua_State* L = lua_newstate(luaAlloc, this);
+    if (!L) return nullptr;
+    lua_atpanic(L, [](lua_State* L) -> int {
+        std::cerr << "Lua panic: " << lua_tostring(L, -1) << std::endl;
+        return 0;
+    });
+    lua_sethook(L, countHook, LUA_MASKCOUNT, hookInterval);
+    return L;
+}
+
+ScriptProfiler* ScriptProfiler::fromState(lua_State* L) {
+    void* ud = nullptr;
+    lua_getallocf(L, &ud);
+    return static_cast<ScriptProfiler*>(ud);
+}
+
+ScriptStats* ScriptProfiler::statsForFunction(lua_State* L, int index) {
+    lua_Debug ar;
+    lua_pushvalue(L, index);
+    lua_getinfo(L, ">S", &ar);
+
+    ScriptStats& s = scripts[ar.short_src];
+    if (s.name.empty()) s.name = ar.short_src;
+    return &s;
+}
+
+int ScriptProfiler::call(lua_State* L, int nargs, ScriptStats* script) {
+    using clock = std::chrono::steady_clock;
+
+    // ネストした呼び出しでも外側の状態を壊さないよう退避する
+    ScriptStats* prevCurrent = current;
+    bool prevHasDeadline = hasDeadline;
+    clock::time_point prevDeadline = deadline;
+
+    clock::time_point start = clock::now();
+    current = script;
+    depth++;
+    if (!hasDeadline && budgetMs > 0.0) {
+        hasDeadline = true;
+        deadline = start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double, std::milli>(budgetMs));
+    }
+
+    int status = lua_pcall(L, nargs, 0, 0);
+
+    double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+    if (--depth == 0) callMs += ms;
+    if (script) {
+        script->calls++;
+        script->totalMs += ms;
+        script->maxMs = std::max(script->maxMs, ms);
+    }
+
+    current = prevCurrent;
+    hasDeadline = prevHasDeadline;
+    deadline = prevDeadline;
+    return status;
+}
+
+void ScriptProfiler::countHook(lua_State* L, lua_Debug*) {
+    ScriptProfiler* self = fromState(L);
+    if (!self->hasDeadline || std::chrono::steady_clock::now() < self->deadline) return;
+
+    // 暴走スクリプト: エラーで pcall まで巻き戻す
+    if (self->current) self->current->timeouts++;
+    self->hasDeadline = false;
+    luaL_error(L, "script exceeded execution budget (%d ms)", (int)budgetMs);
+}
+
+// ===================================================================
+// 統計の公開
+// ===================================================================
+
+namespace {
+    void pushProfilerStats(lua_State* L, const ScriptProfiler& p, int vmIndex, int& scriptIndex) {
+        const LuaAllocator::Stats& a = p.getAllocator().getStats();
+
+        // vms[vmIndex]
+        lua_getfield(L, -1, "vms");
+        lua_newtable(L);
+        lua_pushstring(L, p.getName().c_str());       lua_setfield(L, -2, "name");
+        lua_pushinteger(L, (lua_Integer)a.bytesInUse);  lua_setfield(L, -2, "bytes");
+        lua_pushinteger(L, (lua_Integer)a.peakBytes);   lua_setfield(L, -2, "peakBytes");
+        lua_pushinteger(L, (lua_Integer)a.poolBytes);   lua_setfield(L, -2, "poolBytes");
+        lua_pushinteger(L, (lua_Integer)a.allocations); lua_setfield(L, -2, "allocations");
+        lua_pushinteger(L, (lua_Integer)a.systemCalls); lua_setfield(L, -2, "systemCalls");
+        lua_rawseti(L, -2, vmIndex);
+        lua_pop(L, 1);
+
+        // scripts[...]
+        lua_getfield(L, -1, "scripts");
+        for (const auto& [key, s] : p.getScripts()) {
+            lua_newtable(L);
+            lua_pushstring(L, p.getName().c_str());      lua_setfield(L, -2, "vm");
+            lua_pushstring(L, s.name.c_str());           lua_setfield(L, -2, "name");
+            lua_pushinteger(L, (lua_Integer)s.calls);    lua_setfield(L, -2, "calls");
+            lua_pushnumber(L, s.totalMs);                lua_setfield(L, -2, "totalMs");
+            lua_pushnumber(L, s.maxMs);                  lua_setfield(L, -2, "maxMs");
+            lua_pushnumber(L, s.calls ? s.totalMs / s.calls : 0.0); lua_setfield(L, -2, "avgMs");
+            lua_pushinteger(L, (lua_Integer)s.allocBytes); lua_setfield(L, -2, "allocBytes");
+            lua_pushinteger(L, (lua_Integer)s.timeouts); lua_setfield(L, -2, "timeouts");
+            lua_rawseti(L, -2, ++scriptIndex);
+        }
+        lua_pop(L, 1);
+    }
+}
+
+// ScriptStats() -> { vms = {...}, scripts = {...} }
+int ScriptProfiler::l_ScriptStats(lua_State* L) {
+    bool allVMs = lua_toboolean(L, lua_upvalueindex(1));
+
+    lua_newtable(L);
+    lua_newtable(L); lua_setfield(L, -2, "vms");
+    lua_newtable(L); lua_setfield(L, -2, "scripts");
+
+    int scriptIndex = 0;
+    if (allVMs) {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        int vmIndex = 0;
+        for (ScriptProfiler* p : registry()) pushProfilerStats(L, *p, ++vmIndex, scriptIndex);
+    } else {
+        pushProfilerStats(L, *fromState(L), 1, scriptIndex);
+    }
+    return 1;
+}
+
+void ScriptProfiler::registerLua(lua_State* L, bool allVMs) {
+    lua_pushboolean(L, allVMs);
+    lua_pushcclosure(L, l_ScriptStats, 1);
+    lua_setglobal(L, "ScriptStats");
+}
+
+bool ScriptProfiler::tick(float dt, float interval) {
+    static float elapsed = 0.0f;
+    if (interval <= 0.0f) return false;
+
+    elapsed += dt;
+    if (elapsed < interval) return false;
+
+    elapsed = 0.0f;
+    dumpAll();
+    return true;
+}
+
+void ScriptProfiler::dumpAll() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+
+    std::cout << "=== Script stats ===" << std::endl;
+    for (ScriptProfiler* p : registry()) {
+        const LuaAllocator::Stats& a = p->allocator.getStats();
+        std::cout << "[" << p->name << "] mem " << a.bytesInUse / 1024 << " KB (peak "
+                  << a.peakBytes / 1024 << " KB, pool " << a.poolBytes / 1024 << " KB), allocs "
+                  << a.allocations << ", sys " << a.systemCalls << std::endl;
+
+        // 合計時間の大きい順
+        std::vector<const ScriptStats*> sorted;
+        for (const auto& [key, s] : p->scripts) sorted.push_back(&s);
+        std::sort(sorted.begin(), sorted.end(), [](const ScriptStats* x, const ScriptStats* y) {
+            return x->totalMs > y->totalMs;
+        });
+
+        for (const ScriptStats* s : sorted) {
+            std::cout << "    " << s->name << ": " << s->calls << " calls, "
+                      << std::fixed << std::setprecision(3)
+                      << s->totalMs << " ms total, " << s->maxMs << " ms max, "
+                      << std::defaultfloat
+                      << s->allocBytes / 1024 << " KB allocated";
+            if (s->timeouts) std::cout << ", " << s->timeouts << " timeouts";
+            std::cout << std::endl;
+        }
+    }
+}
@@ -0,0 +1,127 @@
+// src/Game/ScriptProfiler.hpp
+#ifndef SCRIPTPROFILER_HPP
+#define SCRIPTPROFILER_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstddef>
+
+struct lua_State;
+struct lua_Debug;
+
+// ===================================================================
+// LuaAllocator: lua_newstate に渡すサイズクラス別プールアロケータ
+// 256バイト以下は16バイト刻みのフリーリストから、それより大きいものは malloc
+// 1つの VM 専用なのでロックは持たない
+// ===================================================================
+class LuaAllocator {
+public:
+    struct Stats {
+        size_t bytesInUse = 0;     // Lua が要求したサイズの合計
+        size_t peakBytes = 0;
+        size_t poolBytes = 0;      // プール用に確保したページの合計
+        size_t allocations = 0;    // 新規確保の回数（realloc で移動した分を含む）
+        size_t systemCalls = 0;    // malloc/realloc/free を実際に呼んだ回数
+    };
+
+    static const size_t kGranularity = 16;
+    static const size_t kMaxPooled = 256;
+    static const size_t kClassCount = kMaxPooled / kGranularity;
+    static const size_t kPageSize = 16 * 1024;   // サイズクラスごとに切り出す単位
+
+    LuaAllocator() = default;
+    ~LuaAllocator();
+
+    LuaAllocator(const LuaAllocator&) = delete;
+    LuaAllocator& operator=(const LuaAllocator&) = delete;
+
+    // lua_Alloc と同じ意味論（ptr が非 NULL のときだけ osize は元のサイズ）
+    void* realloc(void* ptr, size_t osize, size_t nsize);
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+
+    FreeBlock* freeLists[kClassCount] = {};
+    char* bumpPtr[kClassCount] = {};
+    char* bumpEnd[kClassCount] = {};
+    std::vector<char*> pages;
+    // 縮小でプールのブロックが取れず、malloc のまま小さいサイズで Lua に返したブロック。
+    // 解放はフリーリストでなく free に戻す（ページの外なのでフリーリストに載せると漏れる）
+    std::vector<void*> unpooled;
+    Stats stats;
+
+    static size_t classOf(size_t size) { return (size + kGranularity - 1) / kGranularity - 1; }
+    void* allocBlock(size_t size);
+    void freeBlock(void* ptr, size_t size);
+};
+
+// ===================================================================
+// ScriptProfiler: VM 1つ分の CPU / メモリ計測
+// ===================================================================
+struct ScriptStats {
+    std::string name;          // チャンク名（スクリプトのパス）
+    size_t calls = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+    size_t allocBytes = 0;     // このスクリプト実行中に確保したバイト数（累計）
+    size_t timeouts = 0;
+};
+
+class ScriptProfiler {
+public:
+    // コールバック1回あたりの実行時間上限。超えたら命令数フックでエラーにする
+    static double budgetMs;
+    // 命令数フックを呼ぶ間隔
+    static int hookInterval;
+
+    explicit ScriptProfiler(const std::string& vmName);
+    ~ScriptProfiler();
+
+    ScriptProfiler(const ScriptProfiler&) = delete;
+    ScriptProfiler& operator=(const ScriptProfiler&) = delete;
+
+    // 計測付きの lua_State を作る（close は呼び出し側で lua_close）
+    lua_State* newState();
+    static ScriptProfiler* fromState(lua_State* L);
+
+    // スタックトップ付近の関数からスクリプトを特定する（Connect 時に1回だけ呼ぶ）
+    ScriptStats* statsForFunction(lua_State* L, int index);
+
+    // lua_pcall の代わり。時間計測・確保量の帰属・実行時間上限を適用する
+    int call(lua_State* L, int nargs, ScriptStats* script);
+
+    // ScriptStats() を Lua に登録する
+    // allVMs = true なら全 VM の統計を返す（メインスレッドの VM 用）
+    void registerLua(lua_State* L, bool allVMs);
+
+    const std::string& getName() const { return name; }
+    const LuaAllocator& getAllocator() const { return allocator; }
+    const std::map<std::string, ScriptStats>& getScripts() const { return scripts; }
+    // call() で実行した時間の累計（ネストした分は二重に数えない）
+    double totalCallMs() const { return callMs; }
+
+    // 定期ダンプ（メインスレッドから毎フレーム呼ぶ。interval <= 0 で無効）
+    // ダンプしたフレームだけ true を返す
+    static bool tick(float dt, float interval);
+    static void dumpAll();
+
+private:
+    std::string name;
+    LuaAllocator allocator;
+    std::map<std::string, ScriptStats> scripts;   // ポインタが安定するよう map
+    ScriptStats* current = nullptr;
+    int depth = 0;
+    double callMs = 0.0;
+    bool hasDeadline = false;
+    std::chrono::steady_clock::time_point deadline;
+
+    static void* luaAlloc(void* ud, void* ptr, size_t osize, size_t nsize);
+    static void countHook(lua_State* L, lua_Debug* ar);
+    static int l_ScriptStats(lua_State* L);
+};
+
+#endif // SCRIPTPROFILER_HPP
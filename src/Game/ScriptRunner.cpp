@@ -1,19 +1,32 @@
 // src/Game/ScriptRunner.cpp
 
 #include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <new>
 #include "assets/lua-5.4.6/src/lua.hpp"
 #include "src/Game/GameData.hpp"
 #include "src/Game/Workspace.hpp"
 #include "src/Game/Instance.hpp"
+#include "src/Game/ScriptCache.hpp"
+#include "src/Game/ScriptProfiler.hpp"
+#include "src/Game/ScriptRunner.hpp"
 
 extern Workspace* global_workspace;
 lua_State* G_L = nullptr;
+ScriptProfiler G_profiler("main");
+GCController G_gc;
 
 // ===================================================================
 // Lua バインディング: Instance
 // ===================================================================
 // 前方定義
 void wrapInstance(lua_State* L, Instance* inst);
+void wrapPart(lua_State* L, Cube* part);
+void pushPropertySignal(lua_State* L, Instance* inst, uint32_t prop);
 
 // Instance* を Lua の lightuserdata として push
 void pushInstance(lua_State* L, Instance* inst) {
@@ -24,9 +37,81 @@ void pushInstance(lua_State* L, Instance* inst) {
     lua_pushlightuserdata(L, inst);
 }
 
-// Lua から Instance* を取得
+// ラッパーテーブルのフィールドを __index を通さずに読む
+static void rawField(lua_State* L, int index, const char* key) {
+    index = lua_absindex(L, index);
+    lua_pushstring(L, key);
+    lua_rawget(L, index);
+}
+
+// パーツのラッパーから Cube* を取得
+// パーツは PartHandle で持っているので、削除済みなら nullptr になる
+Cube* toPart(lua_State* L, int index) {
+    if (!lua_istable(L, index) || !global_workspace) return nullptr;
+    rawField(L, index, "_handle");
+    Cube* part = nullptr;
+    if (lua_isinteger(L, -1)) {
+        part = global_workspace->getPart(PartHandle::unpack(lua_tointeger(L, -1)));
+    }
+    lua_pop(L, 1);
+    return part;
+}
+
+// Lua から Instance* を取得（パーツ以外は _ref の InstanceRefs 参照）
+// 解放済みなら nullptr（Destroy() 済みで解放待ちのものはまだ返る）
 Instance* toInstance(lua_State* L, int index) {
-    return (Instance*)lua_touserdata(L, index);
+    if (!lua_istable(L, index)) return nullptr;
+    if (Cube* part = toPart(L, index)) return part;
+
+    rawField(L, index, "_ref");
+    Instance* inst = lua_isinteger(L, -1) ? InstanceRefs::resolve(lua_tointeger(L, -1)) : nullptr;
+    lua_pop(L, 1);
+    return inst;
+}
+
+// workspace 自身・プレイヤー・体のパーツ・関節は Parent の変更も Destroy もできない
+static bool isLocked(Instance* inst) {
+    if (!global_workspace) return false;
+    Player* player = global_workspace->getPlayerObject();
+    return inst == global_workspace || inst == player || (player && player->ownsPart(inst));
+}
+
+// inst.Parent = parent（parent は nullptr 可）
+static void setParent(lua_State* L, Instance* inst, Instance* parent) {
+    if (inst->destroying || isLocked(inst)) {
+        luaL_error(L, "The Parent property of %s is locked", inst->Name.c_str());
+        return;
+    }
+    if (parent && parent->destroying) {
+        luaL_error(L, "Cannot set %s.Parent to a destroyed instance", inst->Name.c_str());
+        return;
+    }
+
+    // パーツは workspace の PartPool にあるので、置けるのは workspace か nil だけ
+    if (global_workspace && global_workspace->cubes.contains(inst)) {
+        Cube* part = static_cast<Cube*>(inst);
+        if (!parent) {
+            global_workspace->detachPart(part);
+        } else if (parent == global_workspace) {
+            global_workspace->attachPart(part);
+        } else {
+            luaL_error(L, "%s can only be parented to workspace or nil", inst->Name.c_str());
+        }
+        return;
+    }
+
+    if (!parent) {
+        if (inst->Parent) inst->Parent->removeChild(inst);
+        return;
+    }
+    for (Instance* a = parent; a; a = a->Parent) {
+        if (a == inst) {
+            luaL_error(L, "Attempt to set parent of %s to %s would result in circular reference",
+                       inst->Name.c_str(), parent->Name.c_str());
+            return;
+        }
+    }
+    parent->addChild(inst);
 }
 
 // workspace:FindFirstChild(name)
@@ -38,21 +123,17 @@ int l_workspace_FindFirstChild(lua_State* L) {
     }
     
     const char* name = luaL_checkstring(L, nameIndex);
+    bool recursive = lua_toboolean(L, nameIndex + 1);
     
     if (!global_workspace) {
         lua_pushnil(L);
         return 1;
     }
 
-    Instance* found = global_workspace->FindFirstChild(name);
+    Instance* found = global_workspace->FindFirstChild(name, recursive);
     
     // Instance をラップして返す
-    if (found && found->IsA("Part")) {
-        wrapInstance(L, found);
-    } else {
-        lua_pushnil(L);
-    }
-    
+    wrapInstance(L, found);
     return 1;
 }
 
@@ -67,13 +148,22 @@ int l_workspace_GetChildren(lua_State* L) {
     lua_newtable(L);
     int index = 1;
     
-    // cubes配列を返す
+    // cubes配列を返す（親のないパーツ・破棄予約済みのパーツは除く）
     for (auto& cube : global_workspace->cubes) {
+        if (!cube.isActive()) continue;
         lua_pushinteger(L, index);
-        wrapInstance(L, &cube);
+        wrapPart(L, &cube);
         lua_settable(L, -3);
         index++;
     }
+
+    // Instance.new で置かれた Folder / Model など
+    global_workspace->forEachChild([&](Instance* child) {
+        lua_pushinteger(L, index);
+        wrapInstance(L, child);
+        lua_settable(L, -3);
+        index++;
+    });
     
     return 1;
 }
@@ -97,6 +187,139 @@ int l_workspace_getPlayer(lua_State* L) {
     return 1;
 }
 
+// ===================================================================
+// Lua バインディング: 子孫の走査
+// GetDescendants のようにテーブルを作らず、ジェネリック for で1つずつ返す。
+// 状態は userdata 1つ（DescendantWalker）で、ループ中に確保するのはラッパーだけ
+// ===================================================================
+
+struct DescendantIterState {
+    DescendantWalker walker;
+    uint64_t releases;    // 作った時点の DestroyQueue::releaseCount()
+    size_t partIndex;     // workspace のときだけ: 次に見る cubes の位置
+    bool workspaceParts;  // workspace のときだけ: まだパーツを返している途中
+};
+
+// for の1ステップ（upvalue なし、状態は第1引数）
+static int l_descendantIter_step(lua_State* L) {
+    auto* it = static_cast<DescendantIterState*>(luaL_checkudata(L, 1, "DescendantIterator"));
+
+    // フレームをまたいで持ち越され、途中で解放が走ったらスタックの中身は信用できない
+    if (it->releases != DestroyQueue::releaseCount()) {
+        return luaL_error(L, "descendant iterator used after instances were destroyed");
+    }
+
+    Instance* next = it->walker.next();
+
+    // workspace のパーツは Children ではなく PartPool にあるので先に返す（パーツの子孫も含む）
+    while (!next && it->workspaceParts) {
+        if (!global_workspace || it->partIndex >= global_workspace->cubes.size()) {
+            it->workspaceParts = false;
+            it->walker.reset(global_workspace);
+            next = it->walker.next();
+            break;
+        }
+        Cube& part = global_workspace->cubes[it->partIndex++];
+        if (part.isActive()) {
+            it->walker.reset(&part);
+            next = &part;
+        }
+    }
+
+    wrapInstance(L, next);   // 終わりなら nil
+    return 1;
+}
+
+// inst:IterDescendants() / workspace:IterDescendants()
+int l_IterDescendants(lua_State* L) {
+    Instance* root = toInstance(L, 1);
+    bool isWorkspace = root && root == global_workspace;
+
+    void* mem = lua_newuserdatauv(L, sizeof(DescendantIterState), 0);
+    new (mem) DescendantIterState{DescendantWalker(isWorkspace ? nullptr : root),
+                                  DestroyQueue::releaseCount(), 0, isWorkspace};
+
+    if (luaL_newmetatable(L, "DescendantIterator")) {
+        lua_pushcfunction(L, [](lua_State* L) -> int {
+            static_cast<DescendantIterState*>(luaL_checkudata(L, 1, "DescendantIterator"))->~DescendantIterState();
+            return 0;
+        });
+        lua_setfield(L, -2, "__gc");
+    }
+    lua_setmetatable(L, -2);
+
+    // ジェネリック for: 関数, 状態, 初期値
+    lua_pushcfunction(L, l_descendantIter_step);
+    lua_insert(L, -2);
+    lua_pushnil(L);
+    return 3;
+}
+
+// ===================================================================
+// Lua バインディング: Weld / Motor6D
+// C0 / C1 は {X, Y, Z, RX, RY, RZ}（位置と、オイラー角（度））のテーブル
+// ===================================================================
+
+static void pushJointFrame(lua_State* L, const JointFrame& f) {
+    lua_createtable(L, 0, 6);
+    lua_pushnumber(L, f.pos.x); lua_setfield(L, -2, "X");
+    lua_pushnumber(L, f.pos.y); lua_setfield(L, -2, "Y");
+    lua_pushnumber(L, f.pos.z); lua_setfield(L, -2, "Z");
+    lua_pushnumber(L, f.rotation.x); lua_setfield(L, -2, "RX");
+    lua_pushnumber(L, f.rotation.y); lua_setfield(L, -2, "RY");
+    lua_pushnumber(L, f.rotation.z); lua_setfield(L, -2, "RZ");
+}
+
+// 省略したフィールドは 0
+static JointFrame toJointFrame(lua_State* L, int index) {
+    luaL_checktype(L, index, LUA_TTABLE);
+    float v[6];
+    const char* keys[6] = {"X", "Y", "Z", "RX", "RY", "RZ"};
+    for (int i = 0; i < 6; ++i) {
+        lua_getfield(L, index, keys[i]);
+        v[i] = (float)luaL_optnumber(L, -1, 0.0);
+        lua_pop(L, 1);
+    }
+    return JointFrame(Vector3(v[0], v[1], v[2]), Vector3(v[3], v[4], v[5]));
+}
+
+// 値がパーツか nil であること
+static Cube* toJointPart(lua_State* L, int index, const char* key) {
+    if (lua_isnil(L, index)) return nullptr;
+    Cube* part = toPart(L, index);
+    if (!part) luaL_error(L, "%s must be a Part or nil", key);
+    return part;
+}
+
+// joint.key を積む（知らないキーなら 0 を返す）
+static int jointIndex(lua_State* L, JointInstance* joint, const char* key) {
+    if (strcmp(key, "Part0") == 0) { wrapInstance(L, joint->getPart0()); return 1; }
+    if (strcmp(key, "Part1") == 0) { wrapInstance(L, joint->getPart1()); return 1; }
+    if (strcmp(key, "C0") == 0) { pushJointFrame(L, joint->getC0()); return 1; }
+    if (strcmp(key, "C1") == 0) { pushJointFrame(L, joint->getC1()); return 1; }
+    if (strcmp(key, "Enabled") == 0) { lua_pushboolean(L, joint->isEnabled()); return 1; }
+    if (!joint->isMotor()) return 0;
+    if (strcmp(key, "CurrentAngle") == 0) { lua_pushnumber(L, joint->getCurrentAngle()); return 1; }
+    if (strcmp(key, "DesiredAngle") == 0) { lua_pushnumber(L, joint->desiredAngle); return 1; }
+    if (strcmp(key, "MaxVelocity") == 0) { lua_pushnumber(L, joint->maxVelocity); return 1; }
+    return 0;
+}
+
+// joint.key = L[3]（知らないキーなら false）
+static bool jointNewIndex(lua_State* L, JointInstance* joint, const char* key) {
+    if (strcmp(key, "Part0") == 0) joint->setPart0(toJointPart(L, 3, key));
+    else if (strcmp(key, "Part1") == 0) joint->setPart1(toJointPart(L, 3, key));
+    else if (strcmp(key, "C0") == 0) joint->setC0(toJointFrame(L, 3));
+    else if (strcmp(key, "C1") == 0) joint->setC1(toJointFrame(L, 3));
+    else if (strcmp(key, "Enabled") == 0) joint->setEnabled(lua_toboolean(L, 3));
+    else if (!joint->isMotor()) return false;
+    else if (strcmp(key, "CurrentAngle") == 0) joint->setCurrentAngle((float)luaL_checknumber(L, 3));
+    else if (strcmp(key, "DesiredAngle") == 0) joint->desiredAngle = (float)luaL_checknumber(L, 3);
+    else if (strcmp(key, "MaxVelocity") == 0) joint->maxVelocity = std::abs((float)luaL_checknumber(L, 3));
+    else return false;
+    return true;
+}
+
 // ===================================================================
 // Lua バインディング: Part (Cube)
 // ===================================================================
@@ -112,10 +335,8 @@ void createPartMetatable(lua_State* L) {
         
         const char* key = luaL_checkstring(L, 2);
         
-        // _ptr から Instance ポインタを取得
-        lua_getfield(L, 1, "_ptr");
-        Instance* inst = (Instance*)lua_touserdata(L, -1);
-        lua_pop(L, 1);
+        // _handle / _ptr から Instance ポインタを取得
+        Instance* inst = toInstance(L, 1);
         
         if (!inst) {
             lua_pushnil(L);
@@ -131,12 +352,70 @@ void createPartMetatable(lua_State* L) {
             lua_pushstring(L, inst->ClassName.c_str());
             return 1;
         }
-        else if (strcmp(key, "Position") == 0 && inst->IsA("Part")) {
+        else if (strcmp(key, "Parent") == 0) {
+            // Destroy() 済みなら解放前でも nil
+            Instance* parent = inst->destroying ? nullptr : inst->Parent;
+            if (parent && parent == global_workspace) {
+                lua_getglobal(L, "workspace");
+            } else {
+                wrapInstance(L, parent);
+            }
+            return 1;
+        }
+        else if (strcmp(key, "Position") == 0 && global_workspace && global_workspace->cubes.contains(inst)) {
             Cube* cube = static_cast<Cube*>(inst);
             lua_newtable(L);
-            lua_pushnumber(L, cube->pos.x); lua_setfield(L, -2, "X");
-            lua_pushnumber(L, cube->pos.y); lua_setfield(L, -2, "Y");
-            lua_pushnumber(L, cube->pos.z); lua_setfield(L, -2, "Z");
+            const Vector3& pos = cube->pos();
+            lua_pushnumber(L, pos.x); lua_setfield(L, -2, "X");
+            lua_pushnumber(L, pos.y); lua_setfield(L, -2, "Y");
+            lua_pushnumber(L, pos.z); lua_setfield(L, -2, "Z");
+            return 1;
+        }
+        else if (strcmp(key, "Shape") == 0 && global_workspace && global_workspace->cubes.contains(inst)) {
+            lua_pushstring(L, partShapeName(static_cast<Cube*>(inst)->transform().shape));
+            return 1;
+        }
+        else if (inst->IsA(ClassId::MeshPart) && global_workspace && global_workspace->cubes.contains(inst)) {
+            const MeshAsset& mesh = MeshLibrary::get().asset(static_cast<Cube*>(inst)->transform().mesh);
+            if (strcmp(key, "MeshId") == 0) {
+                lua_pushstring(L, mesh.path.c_str());
+                return 1;
+            }
+            if (strcmp(key, "MeshSize") == 0) {
+                lua_newtable(L);
+                lua_pushnumber(L, mesh.naturalSize.x); lua_setfield(L, -2, "X");
+                lua_pushnumber(L, mesh.naturalSize.y); lua_setfield(L, -2, "Y");
+                lua_pushnumber(L, mesh.naturalSize.z); lua_setfield(L, -2, "Z");
+                return 1;
+            }
+        }
+        else if (inst->IsA(ClassId::JointInstance)) {
+            if (jointIndex(L, static_cast<JointInstance*>(inst), key)) return 1;
+        }
+
+        // イベント: Changed（引数: プロパティ名）
+        if (strcmp(key, "Changed") == 0) {
+            pushPropertySignal(L, inst, Prop_All);
+            return 1;
+        }
+        // メソッド: GetPropertyChangedSignal
+        else if (strcmp(key, "GetPropertyChangedSignal") == 0) {
+            lua_pushcfunction(L, [](lua_State* L) -> int {
+                // L[1] = self
+                // L[2] = プロパティ名
+                const char* name = luaL_checkstring(L, 2);
+                uint32_t prop = propertyFromName(name);
+                if (!prop) return luaL_error(L, "%s is not a valid property name", name);
+
+                Instance* inst = toInstance(L, 1);
+
+                if (!inst) {
+                    lua_pushnil(L);
+                    return 1;
+                }
+                pushPropertySignal(L, inst, prop);
+                return 1;
+            });
             return 1;
         }
         // メソッド: FindFirstChild
@@ -144,18 +423,18 @@ void createPartMetatable(lua_State* L) {
             lua_pushcfunction(L, [](lua_State* L) -> int {
                 // L[1] = self
                 // L[2] = name
+                // L[3] = recursive（省略可）
                 const char* name = luaL_checkstring(L, 2);
+                bool recursive = lua_toboolean(L, 3);
                 
-                lua_getfield(L, 1, "_ptr");
-                Instance* inst = (Instance*)lua_touserdata(L, -1);
-                lua_pop(L, 1);
+                Instance* inst = toInstance(L, 1);
                 
                 if (!inst) {
                     lua_pushnil(L);
                     return 1;
                 }
                 
-                Instance* found = inst->FindFirstChild(name);
+                Instance* found = inst->FindFirstChild(name, recursive);
                 if (found) {
                     wrapInstance(L, found);
                 } else {
@@ -169,9 +448,7 @@ void createPartMetatable(lua_State* L) {
         else if (strcmp(key, "GetChildren") == 0) {
             lua_pushcfunction(L, [](lua_State* L) -> int {
                 // L[1] = self
-                lua_getfield(L, 1, "_ptr");
-                Instance* inst = (Instance*)lua_touserdata(L, -1);
-                lua_pop(L, 1);
+                Instance* inst = toInstance(L, 1);
                 
                 if (!inst) {
                     lua_newtable(L);
@@ -181,17 +458,34 @@ void createPartMetatable(lua_State* L) {
                 lua_newtable(L);
                 int index = 1;
                 
-                for (auto* child : inst->GetChildren()) {
+                inst->forEachChild([&](Instance* child) {
                     lua_pushinteger(L, index);
                     wrapInstance(L, child);
                     lua_settable(L, -3);
                     index++;
-                }
+                });
                 
                 return 1;
             });
             return 1;
         }
+        // メソッド: Destroy
+        else if (strcmp(key, "Destroy") == 0) {
+            lua_pushcfunction(L, [](lua_State* L) -> int {
+                // L[1] = self
+                Instance* inst = toInstance(L, 1);
+                if (!inst) return 0;   // 解放済み
+                if (isLocked(inst)) return luaL_error(L, "%s cannot be destroyed", inst->Name.c_str());
+                inst->Destroy();
+                return 0;
+            });
+            return 1;
+        }
+        // メソッド: IterDescendants（for d in part:IterDescendants() do ... end）
+        else if (strcmp(key, "IterDescendants") == 0) {
+            lua_pushcfunction(L, l_IterDescendants);
+            return 1;
+        }
         // メソッド: IsA
         else if (strcmp(key, "IsA") == 0) {
             lua_pushcfunction(L, [](lua_State* L) -> int {
@@ -199,9 +493,7 @@ void createPartMetatable(lua_State* L) {
                 // L[2] = className
                 const char* className = luaL_checkstring(L, 2);
                 
-                lua_getfield(L, 1, "_ptr");
-                Instance* inst = (Instance*)lua_touserdata(L, -1);
-                lua_pop(L, 1);
+                Instance* inst = toInstance(L, 1);
                 
                 if (!inst) {
                     lua_pushboolean(L, false);
@@ -227,15 +519,39 @@ void createPartMetatable(lua_State* L) {
         
         const char* key = luaL_checkstring(L, 2);
         
-        lua_getfield(L, 1, "_ptr");
-        Instance* inst = (Instance*)lua_touserdata(L, -1);
-        lua_pop(L, 1);
+        Instance* inst = toInstance(L, 1);
         
-        if (!inst || !inst->IsA("Part")) {
+        if (!inst) {
+            return 0;
+        }
+
+        if (strcmp(key, "Parent") == 0) {
+            Instance* parent = nullptr;
+            if (!lua_isnil(L, 3)) {
+                parent = toInstance(L, 3);
+                if (!parent) return luaL_error(L, "Parent must be an Instance or nil");
+            }
+            setParent(L, inst, parent);
+            return 0;
+        }
+        else if (strcmp(key, "Name") == 0) {
+            // 索引を更新するため setName を通す
+            inst->setName(luaL_checkstring(L, 3));
+            return 0;
+        }
+        else if (inst->IsA(ClassId::JointInstance)) {
+            // プレイヤーの関節は角度などは変えられるが、繋ぎ先は変えられない
+            if (isLocked(inst) && (strcmp(key, "Part0") == 0 || strcmp(key, "Part1") == 0)) {
+                return luaL_error(L, "The %s property of %s is locked", key, inst->Name.c_str());
+            }
+            jointNewIndex(L, static_cast<JointInstance*>(inst), key);
+            return 0;
+        }
+
+        Cube* cube = toPart(L, 1);
+        if (!cube) {
             return 0;
         }
-        
-        Cube* cube = static_cast<Cube*>(inst);
         
         if (strcmp(key, "Position") == 0 && lua_istable(L, 3)) {
             lua_getfield(L, 3, "X");
@@ -246,11 +562,39 @@ void createPartMetatable(lua_State* L) {
             float y = luaL_checknumber(L, -2);
             float z = luaL_checknumber(L, -1);
             
-            cube->pos = Vector3(x, y, z);
+            cube->pos() = Vector3(x, y, z);
             cube->wakeUp();
+            cube->markChanged(Prop_Position);
             
             lua_pop(L, 3);
         }
+        else if (strcmp(key, "Shape") == 0) {
+            // "Block" / "Ball" / "Cylinder" / "Wedge"。質量・慣性も形に合わせ直す
+            const char* name = luaL_checkstring(L, 3);
+            PartShape shape;
+            if (!partShapeFromName(name, shape)) return luaL_error(L, "%s is not a valid Shape", name);
+            // MeshPart と Part は別のクラス（形は MeshId で決まる）
+            if ((shape == PartShape::Mesh) != (cube->transform().shape == PartShape::Mesh)) {
+                return luaL_error(L, "Shape %s is not valid for %s", name, cube->ClassName.c_str());
+            }
+            if (cube->transform().shape != shape) {
+                cube->transform().shape = shape;
+                cube->updateMass();
+                cube->wakeUp();
+                cube->markChanged(Prop_Shape);
+            }
+        }
+        else if (strcmp(key, "MeshId") == 0) {
+            // 読み込めなければ警告を出して箱のメッシュにする。大きさ（Size）は変えない
+            if (!cube->IsA(ClassId::MeshPart)) return luaL_error(L, "MeshId is not a valid member of %s", cube->ClassName.c_str());
+            uint16_t mesh = MeshLibrary::get().load(luaL_checkstring(L, 3));
+            if (cube->transform().mesh != mesh) {
+                cube->transform().mesh = mesh;
+                cube->updateMass();
+                cube->wakeUp();
+                cube->markChanged(Prop_MeshId);
+            }
+        }
         
         return 0;
     });
@@ -266,17 +610,270 @@ void wrapInstance(lua_State* L, Instance* inst) {
         return;
     }
     
-    lua_newtable(L);
+    // Workspace のパーツはハンドルで持つ（削除後に触ってもぶら下がらない）
+    if (global_workspace && global_workspace->cubes.contains(inst)) {
+        wrapPart(L, static_cast<Cube*>(inst));
+        return;
+    }
+
+    lua_createtable(L, 0, 1);
     
-    // _ptr フィールドに lightuserdata を格納
-    lua_pushlightuserdata(L, inst);
-    lua_setfield(L, -2, "_ptr");
+    // _ref フィールドに InstanceRefs の参照を格納（解放後は解決できない）
+    lua_pushinteger(L, (lua_Integer)InstanceRefs::acquire(inst, inst->refSlot));
+    lua_setfield(L, -2, "_ref");
     
-    // メタテーブルを設定
-    if (inst->IsA("Part")) {
-        lua_getglobal(L, "PartMetatable");
-        lua_setmetatable(L, -2);
+    // メタテーブルを設定（Name / Parent / FindFirstChild / Destroy などは共通）
+    lua_getglobal(L, "PartMetatable");
+    lua_setmetatable(L, -2);
+}
+
+// PartPool 上のパーツを Lua テーブルでラップ
+void wrapPart(lua_State* L, Cube* part) {
+    lua_createtable(L, 0, 1);
+
+    // _handle フィールドに PartHandle を整数で格納
+    lua_pushinteger(L, (lua_Integer)part->handle.pack());
+    lua_setfield(L, -2, "_handle");
+
+    lua_getglobal(L, "PartMetatable");
+    lua_setmetatable(L, -2);
+}
+
+// ===================================================================
+// Lua バインディング: 空間クエリ
+// ベクトルは {X, Y, Z}、箱の位置・向きは C0 と同じ {X, Y, Z, RX, RY, RZ} のテーブル。
+// params（省略可）は {FilterDescendantsInstances = {...}, FilterType = "Exclude" | "Include",
+//                    RespectCanCollide = bool, MaxParts = n}
+// 引数を全て読んでから結果を作る（luaL_error で C++ の後始末が飛ばされないように）
+// ===================================================================
+
+static Vector3 toVector3(lua_State* L, int index) {
+    luaL_checktype(L, index, LUA_TTABLE);
+    float v[3];
+    const char* keys[3] = {"X", "Y", "Z"};
+    for (int i = 0; i < 3; ++i) {
+        lua_getfield(L, index, keys[i]);
+        if (!lua_isnumber(L, -1)) luaL_argerror(L, index, "{X, Y, Z} expected");
+        v[i] = (float)lua_tonumber(L, -1);
+        lua_pop(L, 1);
+    }
+    return Vector3(v[0], v[1], v[2]);
+}
+
+static void pushVector3(lua_State* L, const Vector3& v) {
+    lua_createtable(L, 0, 3);
+    lua_pushnumber(L, v.x); lua_setfield(L, -2, "X");
+    lua_pushnumber(L, v.y); lua_setfield(L, -2, "Y");
+    lua_pushnumber(L, v.z); lua_setfield(L, -2, "Z");
+}
+
+// workspace:Raycast(...) でも workspace.Raycast(...) でも呼べるように、最初の引数の位置を返す
+static int queryArgs(lua_State* L) {
+    return (lua_istable(L, 1) && global_workspace && toInstance(L, 1) == global_workspace) ? 2 : 1;
+}
+
+static QueryParams toQueryParams(lua_State* L, int index) {
+    if (lua_isnoneornil(L, index)) return QueryParams();
+    luaL_checktype(L, index, LUA_TTABLE);
+
+    bool include = false;
+    lua_getfield(L, index, "FilterType");
+    if (!lua_isnil(L, -1)) {
+        const char* type = luaL_checkstring(L, -1);
+        if (strcmp(type, "Include") == 0) include = true;
+        else if (strcmp(type, "Exclude") != 0) luaL_error(L, "FilterType must be \"Include\" or \"Exclude\"");
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, index, "MaxParts");
+    lua_Integer maxParts = lua_isnil(L, -1) ? 0 : luaL_checkinteger(L, -1);
+    lua_pop(L, 1);
+
+    lua_getfield(L, index, "RespectCanCollide");
+    bool respectCanCollide = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+
+    QueryParams params;
+    params.include = include;
+    params.respectCanCollide = respectCanCollide;
+    if (maxParts > 0) params.maxParts = (size_t)maxParts;
+    lua_getfield(L, index, "FilterDescendantsInstances");
+    if (lua_istable(L, -1)) {
+        lua_Integer n = (lua_Integer)lua_rawlen(L, -1);
+        for (lua_Integer i = 1; i <= n; ++i) {
+            lua_rawgeti(L, -1, i);
+            if (Instance* inst = toInstance(L, -1)) params.filter.push_back(inst);
+            lua_pop(L, 1);
+        }
+    }
+    lua_pop(L, 1);
+    return params;
+}
+
+// {Instance, Position, Normal, Distance}（当たらなければ nil）
+// 地形に当たったら Instance は workspace.Terrain で、Material に素材の名前が入る
+static int pushQueryHit(lua_State* L, bool found, const QueryHit& hit) {
+    if (!found) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_createtable(L, 0, 5);
+    if (hit.part) {
+        wrapPart(L, hit.part);
+    } else {
+        lua_getglobal(L, "workspace");
+        lua_getfield(L, -1, "Terrain");
+        lua_remove(L, -2);
+        lua_pushstring(L, terrainMaterialName(hit.material));
+        lua_setfield(L, -3, "Material");
+    }
+    lua_setfield(L, -2, "Instance");
+    pushVector3(L, hit.position);
+    lua_setfield(L, -2, "Position");
+    pushVector3(L, hit.normal);
+    lua_setfield(L, -2, "Normal");
+    lua_pushnumber(L, hit.distance);
+    lua_setfield(L, -2, "Distance");
+    return 1;
+}
+
+static int pushParts(lua_State* L, const std::vector<Cube*>& parts) {
+    lua_createtable(L, (int)parts.size(), 0);
+    for (size_t i = 0; i < parts.size(); ++i) {
+        wrapPart(L, parts[i]);
+        lua_rawseti(L, -2, (lua_Integer)i + 1);
+    }
+    return 1;
+}
+
+// workspace:Raycast(origin, direction, params)
+int l_workspace_Raycast(lua_State* L) {
+    int a = queryArgs(L);
+    Vector3 origin = toVector3(L, a);
+    Vector3 direction = toVector3(L, a + 1);
+    QueryParams params = toQueryParams(L, a + 2);
+    if (!global_workspace) { lua_pushnil(L); return 1; }
+    QueryHit hit;
+    bool found = global_workspace->spatial.raycast(origin, direction, params, hit);
+    return pushQueryHit(L, found, hit);
+}
+
+// workspace:Spherecast(position, radius, direction, params)
+int l_workspace_Spherecast(lua_State* L) {
+    int a = queryArgs(L);
+    Vector3 origin = toVector3(L, a);
+    float radius = (float)luaL_checknumber(L, a + 1);
+    Vector3 direction = toVector3(L, a + 2);
+    QueryParams params = toQueryParams(L, a + 3);
+    if (!global_workspace) { lua_pushnil(L); return 1; }
+    QueryHit hit;
+    bool found = global_workspace->spatial.spherecast(origin, radius, direction, params, hit);
+    return pushQueryHit(L, found, hit);
+}
+
+// workspace:Blockcast(cframe, size, direction, params)
+int l_workspace_Blockcast(lua_State* L) {
+    int a = queryArgs(L);
+    JointFrame frame = toJointFrame(L, a);
+    Vector3 size = toVector3(L, a + 1);
+    Vector3 direction = toVector3(L, a + 2);
+    QueryParams params = toQueryParams(L, a + 3);
+    if (!global_workspace) { lua_pushnil(L); return 1; }
+    QueryHit hit;
+    bool found = global_workspace->spatial.blockcast(frame.pos, frame.rotation, size, direction, params, hit);
+    return pushQueryHit(L, found, hit);
+}
+
+// workspace:GetPartsInRegion(min, max, params) -- AABB が重なるパーツ
+int l_workspace_GetPartsInRegion(lua_State* L) {
+    int a = queryArgs(L);
+    Vector3 mn = toVector3(L, a);
+    Vector3 mx = toVector3(L, a + 1);
+    QueryParams params = toQueryParams(L, a + 2);
+    std::vector<Cube*> parts;
+    if (global_workspace) global_workspace->spatial.partsInRegion(mn, mx, params, parts);
+    return pushParts(L, parts);
+}
+
+// workspace:GetPartsInRadius(position, radius, params)
+int l_workspace_GetPartsInRadius(lua_State* L) {
+    int a = queryArgs(L);
+    Vector3 center = toVector3(L, a);
+    float radius = (float)luaL_checknumber(L, a + 1);
+    QueryParams params = toQueryParams(L, a + 2);
+    std::vector<Cube*> parts;
+    if (global_workspace) global_workspace->spatial.partsInRadius(center, radius, params, parts);
+    return pushParts(L, parts);
+}
+
+// workspace:GetPartsInBox(cframe, size, params)
+int l_workspace_GetPartsInBox(lua_State* L) {
+    int a = queryArgs(L);
+    JointFrame frame = toJointFrame(L, a);
+    Vector3 size = toVector3(L, a + 1);
+    QueryParams params = toQueryParams(L, a + 2);
+    std::vector<Cube*> parts;
+    if (global_workspace) global_workspace->spatial.partsInBox(frame.pos, frame.rotation, size, params, parts);
+    return pushParts(L, parts);
+}
+
+// ===================================================================
+// workspace.Terrain
+// ===================================================================
+
+// Terrain:FillBlock(...) でも Terrain.FillBlock(...) でも呼べるように、最初の引数の位置を返す
+static int terrainArgs(lua_State* L) {
+    if (!lua_istable(L, 1)) return 1;
+    lua_getfield(L, 1, "_terrain");
+    bool self = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+    return self ? 2 : 1;
+}
+
+// "Grass" / "Rock" / ... / "Air"（Air は消す）
+static TerrainMaterial toTerrainMaterial(lua_State* L, int index) {
+    const char* name = luaL_checkstring(L, index);
+    TerrainMaterial m;
+    if (!terrainMaterialFromName(name, m)) luaL_error(L, "%s is not a valid terrain Material", name);
+    return m;
+}
+
+// Terrain:FillBlock(cframe, size, material)
+int l_terrain_FillBlock(lua_State* L) {
+    int a = terrainArgs(L);
+    JointFrame frame = toJointFrame(L, a);
+    Vector3 size = toVector3(L, a + 1);
+    TerrainMaterial m = toTerrainMaterial(L, a + 2);
+    if (global_workspace) global_workspace->terrain.fillBlock(frame.pos, frame.rotation, size, m);
+    return 0;
+}
+
+// Terrain:FillBall(center, radius, material)
+int l_terrain_FillBall(lua_State* L) {
+    int a = terrainArgs(L);
+    Vector3 center = toVector3(L, a);
+    float radius = (float)luaL_checknumber(L, a + 1);
+    TerrainMaterial m = toTerrainMaterial(L, a + 2);
+    if (global_workspace) global_workspace->terrain.fillBall(center, radius, m);
+    return 0;
+}
+
+// Terrain:ReadVoxel(position) -- 位置を含むボクセルの素材の名前
+int l_terrain_ReadVoxel(lua_State* L) {
+    int a = terrainArgs(L);
+    Vector3 p = toVector3(L, a);
+    TerrainMaterial m = TerrainMaterial::Air;
+    if (global_workspace) {
+        m = global_workspace->terrain.getVoxel(Terrain::toVoxel(p.x), Terrain::toVoxel(p.y), Terrain::toVoxel(p.z));
     }
+    lua_pushstring(L, terrainMaterialName(m));
+    return 1;
+}
+
+// Terrain:Clear()
+int l_terrain_Clear(lua_State*) {
+    if (global_workspace) global_workspace->terrain.clear();
+    return 0;
 }
 
 // ===================================================================
@@ -286,6 +883,12 @@ void wrapInstance(lua_State* L, Instance* inst) {
 void registerWorkspace(lua_State* L) {
     lua_newtable(L);
 
+    // Instance.new(..., workspace) / part.Parent = workspace 用
+    if (global_workspace) {
+        lua_pushinteger(L, (lua_Integer)InstanceRefs::acquire(global_workspace, global_workspace->refSlot));
+        lua_setfield(L, -2, "_ref");
+    }
+
     lua_pushcfunction(L, l_workspace_getPlayer);
     lua_setfield(L, -2, "getPlayer");
     
@@ -295,9 +898,99 @@ void registerWorkspace(lua_State* L) {
     lua_pushcfunction(L, l_workspace_GetChildren);
     lua_setfield(L, -2, "GetChildren");
 
+    lua_pushcfunction(L, l_IterDescendants);
+    lua_setfield(L, -2, "IterDescendants");
+
+    lua_pushcfunction(L, l_workspace_Raycast);
+    lua_setfield(L, -2, "Raycast");
+    lua_pushcfunction(L, l_workspace_Spherecast);
+    lua_setfield(L, -2, "Spherecast");
+    lua_pushcfunction(L, l_workspace_Blockcast);
+    lua_setfield(L, -2, "Blockcast");
+    lua_pushcfunction(L, l_workspace_GetPartsInRegion);
+    lua_setfield(L, -2, "GetPartsInRegion");
+    lua_pushcfunction(L, l_workspace_GetPartsInRadius);
+    lua_setfield(L, -2, "GetPartsInRadius");
+    lua_pushcfunction(L, l_workspace_GetPartsInBox);
+    lua_setfield(L, -2, "GetPartsInBox");
+
+    // workspace.Terrain（編集は次の描画の前に Terrain::update でメッシュ・当たり判定に反映される）
+    lua_newtable(L);
+    lua_pushboolean(L, 1);
+    lua_setfield(L, -2, "_terrain");
+    lua_pushstring(L, "Terrain");
+    lua_setfield(L, -2, "Name");
+    lua_pushcfunction(L, l_terrain_FillBlock);
+    lua_setfield(L, -2, "FillBlock");
+    lua_pushcfunction(L, l_terrain_FillBall);
+    lua_setfield(L, -2, "FillBall");
+    lua_pushcfunction(L, l_terrain_ReadVoxel);
+    lua_setfield(L, -2, "ReadVoxel");
+    lua_pushcfunction(L, l_terrain_Clear);
+    lua_setfield(L, -2, "Clear");
+    lua_setfield(L, -2, "Terrain");
+
     lua_setglobal(L, "workspace");
 }
 
+// ===================================================================
+// Instance.new
+// ===================================================================
+
+// Instance.new(className, parent?)
+// Part は PartPool、それ以外は Instance のフリーリストから取る。
+// parent を省略した Instance は Destroy() するか親に置くまで世界に出ない
+int l_Instance_new(lua_State* L) {
+    const char* className = luaL_checkstring(L, 1);
+    Instance* parent = nullptr;
+    if (!lua_isnoneornil(L, 2)) {
+        parent = toInstance(L, 2);
+        if (!parent) return luaL_error(L, "Instance.new: parent must be an Instance or nil");
+    }
+    if (!global_workspace) return luaL_error(L, "Instance.new: workspace is not ready");
+
+    ClassId id;
+    if (!ClassRegistry::find(className, id)) id = ClassId::Instance;
+
+    // setParent で失敗して作ったものが宙に浮かないよう、先に確かめる
+    if (parent && parent->destroying) return luaL_error(L, "Instance.new: parent has been destroyed");
+    if (ClassRegistry::isA(id, ClassId::BasePart) && parent && parent != global_workspace) {
+        return luaL_error(L, "Instance.new: %s can only be parented to workspace or nil", className);
+    }
+
+    Instance* inst = nullptr;
+    switch (id) {
+        case ClassId::Part:
+            inst = global_workspace->newPart(CubeBuilder().build());
+            break;
+        case ClassId::MeshPart:
+            // MeshId を入れるまでは箱のメッシュ
+            inst = global_workspace->newPart(CubeBuilder().shape(PartShape::Mesh).build());
+            break;
+        case ClassId::Folder:
+        case ClassId::Model:
+            inst = new Instance(className, className);
+            break;
+        case ClassId::Weld:
+        case ClassId::Motor6D:
+            inst = new JointInstance(&global_workspace->joints, className);
+            break;
+        default:
+            return luaL_error(L, "Unable to create an Instance of type \"%s\"", className);
+    }
+
+    if (parent) setParent(L, inst, parent);
+    wrapInstance(L, inst);
+    return 1;
+}
+
+void registerInstance(lua_State* L) {
+    lua_newtable(L);
+    lua_pushcfunction(L, l_Instance_new);
+    lua_setfield(L, -2, "new");
+    lua_setglobal(L, "Instance");
+}
+
 // ===================================================================
 // その他の関数
 // ===================================================================
@@ -308,50 +1001,277 @@ int l_movePlayer(lua_State* L) {
     float z = luaL_checknumber(L, 3);
     if (global_workspace) {
         if (Cube* p = global_workspace->getPlayer()) {
-            p->pos = Vector3(x, y, z);
-            p->velocity = Vector3(0, 0, 0);
+            p->pos() = Vector3(x, y, z);
+            p->setVelocity(Vector3(0, 0, 0));
             p->wakeUp();
+            p->markChanged(Prop_Position | Prop_Velocity);
         }
     }
     return 0;
 }
 
-static int l_connect(lua_State* L) {
-    EventBase* event = (EventBase*)lua_touserdata(L, lua_upvalueindex(1));
+// ===================================================================
+// Lua バインディング: シグナル接続
+// ===================================================================
+
+// レジストリに置いた Lua 関数の参照。コールバックが破棄されたら解放する
+struct LuaRef {
+    int ref;
+    explicit LuaRef(int r) : ref(r) {}
+    ~LuaRef() {
+        if (G_L) luaL_unref(G_L, LUA_REGISTRYINDEX, ref);
+    }
+};
 
+// Connection を Lua の userdata として push（:Disconnect() / .Connected）
+void pushConnection(lua_State* L, const Connection& conn) {
+    void* mem = lua_newuserdatauv(L, sizeof(Connection), 0);
+    new (mem) Connection(conn);
+
+    if (luaL_newmetatable(L, "RBXScriptConnection")) {
+        lua_pushcfunction(L, [](lua_State* L) -> int {
+            static_cast<Connection*>(luaL_checkudata(L, 1, "RBXScriptConnection"))->~Connection();
+            return 0;
+        });
+        lua_setfield(L, -2, "__gc");
+
+        lua_pushcfunction(L, [](lua_State* L) -> int {
+            Connection* c = static_cast<Connection*>(luaL_checkudata(L, 1, "RBXScriptConnection"));
+            const char* key = luaL_checkstring(L, 2);
+            if (strcmp(key, "Connected") == 0) {
+                lua_pushboolean(L, c->connected());
+            } else if (strcmp(key, "Disconnect") == 0) {
+                lua_pushcfunction(L, [](lua_State* L) -> int {
+                    static_cast<Connection*>(luaL_checkudata(L, 1, "RBXScriptConnection"))->disconnect();
+                    return 0;
+                });
+            } else {
+                lua_pushnil(L);
+            }
+            return 1;
+        });
+        lua_setfield(L, -2, "__index");
+    }
+    lua_setmetatable(L, -2);
+}
+
+// :Connect の第1引数（self）を飛ばして関数を取り出し、レジストリに登録する
+std::shared_ptr<LuaRef> checkCallback(lua_State* L, ScriptStats** outScript) {
     int fn_index = 1;
-    if (lua_type(L, 1) == LUA_TTABLE) {
+    if (lua_type(L, 1) == LUA_TTABLE || lua_type(L, 1) == LUA_TUSERDATA) {
         fn_index = 2;
     }
 
     luaL_checktype(L, fn_index, LUA_TFUNCTION);
+    *outScript = G_profiler.statsForFunction(L, fn_index);
     lua_pushvalue(L, fn_index);
-    int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    return std::make_shared<LuaRef>(luaL_ref(L, LUA_REGISTRYINDEX));
+}
 
-    event->connect([ref](std::any value) {
+// スタックに積んだ nargs 個の引数でコールバックを呼ぶ
+static void invokeCallback(const LuaRef& fn, ScriptStats* script, int nargs) {
+    lua_rawgeti(G_L, LUA_REGISTRYINDEX, fn.ref);
+    lua_insert(G_L, -(nargs + 1));
+    // 実行時間・確保量を計測しつつ呼ぶ
+    if (G_profiler.call(G_L, nargs, script) != LUA_OK) {
+        std::cerr << "Lua error: " << lua_tostring(G_L, -1) << std::endl;
+        lua_pop(G_L, 1);
+    }
+}
+
+// RunService.Heartbeat:Connect(function(dt) ... end)
+static int l_connect(lua_State* L) {
+    auto* event = static_cast<Signal<float>*>(lua_touserdata(L, lua_upvalueindex(1)));
+
+    ScriptStats* script = nullptr;
+    std::shared_ptr<LuaRef> fn = checkCallback(L, &script);
+
+    Connection conn = event->connect([fn, script](float dt) {
         if (!G_L) return;
-        lua_rawgeti(G_L, LUA_REGISTRYINDEX, ref);
-        if (value.type() == typeid(float)) {
-            lua_pushnumber(G_L, std::any_cast<float>(value));
+        lua_pushnumber(G_L, dt);
+        invokeCallback(*fn, script, 1);
+    });
+
+    pushConnection(L, conn);
+    return 1;
+}
+
+// part.Changed / part:GetPropertyChangedSignal(name) が返すシグナル
+struct PropertySignalRef {
+    PartHandle handle;   // パーツならハンドルで引く
+    int64_t ref;         // パーツ以外は InstanceRefs の参照
+    uint32_t prop;       // Prop_All なら Changed
+
+    Instance* resolve() const {
+        if (handle.valid()) return global_workspace ? global_workspace->getPart(handle) : nullptr;
+        return InstanceRefs::resolve(ref);
+    }
+};
+
+// signal:Connect(function(...) ... end)
+static int l_propertySignal_Connect(lua_State* L) {
+    auto* ref = static_cast<PropertySignalRef*>(luaL_checkudata(L, 1, "RBXScriptSignal"));
+
+    ScriptStats* script = nullptr;
+    std::shared_ptr<LuaRef> fn = checkCallback(L, &script);
+
+    // 削除済み・破棄予約済みのものには繋がない（切断済みの接続を返す）
+    Instance* inst = ref->resolve();
+    if (!inst || inst->destroying) {
+        pushConnection(L, Connection());
+        return 1;
+    }
+
+    Connection conn;
+    if (ref->prop == Prop_All) {
+        conn = inst->ChangedSignal().connect([fn, script](const char* name) {
+            if (!G_L) return;
+            lua_pushstring(G_L, name);
+            invokeCallback(*fn, script, 1);
+        });
+    } else {
+        conn = inst->GetPropertyChangedSignal(ref->prop).connect([fn, script]() {
+            if (!G_L) return;
+            invokeCallback(*fn, script, 0);
+        });
+    }
+
+    pushConnection(L, conn);
+    return 1;
+}
+
+void pushPropertySignal(lua_State* L, Instance* inst, uint32_t prop) {
+    auto* ref = static_cast<PropertySignalRef*>(lua_newuserdatauv(L, sizeof(PropertySignalRef), 0));
+    ref->handle = PartHandle{};
+    ref->ref = 0;
+    ref->prop = prop;
+    if (global_workspace && global_workspace->cubes.contains(inst)) {
+        ref->handle = static_cast<Cube*>(inst)->handle;
+    } else {
+        ref->ref = InstanceRefs::acquire(inst, inst->refSlot);
+    }
+
+    if (luaL_newmetatable(L, "RBXScriptSignal")) {
+        lua_newtable(L);
+        lua_pushcfunction(L, l_propertySignal_Connect);
+        lua_setfield(L, -2, "Connect");
+        lua_setfield(L, -2, "__index");
+    }
+    lua_setmetatable(L, -2);
+}
+
+// ===================================================================
+// GCController
+// ===================================================================
+
+void GCController::attach(lua_State* state, ScriptProfiler* prof) {
+    L = state;
+    profiler = prof;
+    if (!L) return;
+
+    if (enabled) {
+        // 世代別モード: 若いオブジェクトだけを見るマイナー GC が主になる
+        lua_gc(L, LUA_GCGEN, 0, 0);
+    }
+    kbAfterLastStep = heapKB();
+    lastScriptMs = profiler ? profiler->totalCallMs() : 0.0;
+}
+
+double GCController::heapKB() const {
+    return lua_gc(L, LUA_GCCOUNT) + lua_gc(L, LUA_GCCOUNTB) / 1024.0;
+}
+
+int GCController::bucketOf(double ms) {
+    double limit = 0.5;
+    for (int i = 0; i < kBuckets - 1; ++i, limit *= 2.0) {
+        if (ms < limit) return i;
+    }
+    return kBuckets - 1;
+}
+
+void GCController::step(double idleMs) {
+    if (!L) return;
+
+    double pauseMs = 0.0;
+
+    // 前回の GC から stepKB 以上確保されていて、空き時間に収まりそうなら先回りして回収する
+    double grownKB = heapKB() - kbAfterLastStep;
+    if (enabled && grownKB >= stepKB) {
+        if (idleMs >= estimatedPauseMs) {
+            auto start = std::chrono::steady_clock::now();
+            // 負債を正にして1ステップ進める。data=0 だと負債が0のままで
+            // メジャー GC の判定が通らず、古い世代のゴミが回収されなくなる
+            lua_gc(L, LUA_GCSTEP, kForceStepKB);
+            pauseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            estimatedPauseMs = (estimatedPauseMs == 0.0) ? pauseMs : estimatedPauseMs * 0.8 + pauseMs * 0.2;
+            pauseHistogram[bucketOf(pauseMs)]++;
+            idleSteps++;
+
+            // マイナー GC の停止時間は前回からの確保量にほぼ比例する
+            if (pauseMs > targetPauseMs) {
+                stepKB = std::max(minStepKB, stepKB * 0.75);
+            } else if (pauseMs < targetPauseMs * 0.5) {
+                stepKB = std::min(maxStepKB, stepKB * 1.25);
+            }
         } else {
-            lua_pushnil(G_L);
-        }
-        if (lua_pcall(G_L, 1, 0, 0) != LUA_OK) {
-            std::cerr << "Lua error: " << lua_tostring(G_L, -1) << std::endl;
-            lua_pop(G_L, 1);
+            // メジャー GC の長い停止で見積もりが膨らむと、以後ずっと空き時間に収まらず
+            // 自動 GC 任せになる。見送るたびに見積もりを縮めて、また試せるようにする
+            estimatedPauseMs *= 0.9;
+            skippedSteps++;
         }
-    });
+    }
+    if (pauseMs > 0.0 || grownKB < 0.0) kbAfterLastStep = heapKB();
 
-    return 0;
+    // このフレームのスクリプト時間（コールバック内で走った自動 GC を含む）
+    double scriptMs = 0.0;
+    if (profiler) {
+        scriptMs = profiler->totalCallMs() - lastScriptMs;
+        lastScriptMs = profiler->totalCallMs();
+    }
+    frameHistogram[bucketOf(scriptMs + pauseMs)]++;
+}
+
+void GCController::dump() const {
+    static const char* labels[kBuckets] = { "<0.5", "<1", "<2", "<4", "<8", "<16", ">=16" };
+
+    std::cout << "=== Lua GC (" << (enabled ? "generational, idle steps" : "default") << ") ===" << std::endl;
+    std::cout << "  heap " << (int)heapKB() << " KB, step " << (int)stepKB << " KB, est. pause "
+              << std::fixed << std::setprecision(3) << estimatedPauseMs << std::defaultfloat
+              << " ms, idle steps " << idleSteps << ", skipped " << skippedSteps << std::endl;
+    std::cout << "  ms     frame(script+gc)  idle-gc-pause" << std::endl;
+    for (int i = 0; i < kBuckets; ++i) {
+        std::cout << "  " << std::left << std::setw(6) << labels[i] << std::right
+                  << std::setw(12) << frameHistogram[i]
+                  << std::setw(15) << pauseHistogram[i] << std::endl;
+    }
+}
+
+void stepLuaGC(double idleMs) {
+    G_gc.step(idleMs);
+}
+
+void dumpLuaGC() {
+    G_gc.dump();
 }
 
 // ===================================================================
 // 初期化
 // ===================================================================
 
+void shutdownLua() {
+    if (!G_L) return;
+    RunService::Heartbeat.disconnectAll();   // LuaRef がここで unref される
+    lua_close(G_L);
+    G_L = nullptr;
+}
+
 int initLua() {
-    G_L = luaL_newstate();
+    // 計測用アロケータ付きの VM を作る
+    G_L = G_profiler.newState();
     luaL_openlibs(G_L);
+    G_profiler.registerLua(G_L, true);
+    G_gc.attach(G_L, &G_profiler);
 
     // Part メタテーブル作成
     createPartMetatable(G_L);
@@ -368,11 +1288,14 @@ int initLua() {
     // Workspace 登録
     registerWorkspace(G_L);
 
+    // Instance.new 登録
+    registerInstance(G_L);
+
     // グローバル関数
     lua_register(G_L, "movePlayer", l_movePlayer);
 
-    // Luaスクリプト実行
-    if (luaL_dofile(G_L, "src/Game/script/hello.lua") != LUA_OK) {
+    // Luaスクリプト実行（バイトコードキャッシュ経由）
+    if (ScriptCache::get().doFile(G_L, "src/Game/script/hello.lua") != LUA_OK) {
         std::cerr << "Lua load error: " << lua_tostring(G_L, -1) << std::endl;
         lua_pop(G_L, 1);
     }
@@ -1,4 +1,53 @@
 // src/Game/ScriptRunner.hpp
 #pragma once
 
-int initLua();
\ No newline at end of file
+struct lua_State;
+class ScriptProfiler;
+
+// ===================================================================
+// GCController: フレームの空き時間で Lua の GC を進める
+// 世代別モードにして、フレーム末尾の余り時間でマイナー GC を先回りで実行する。
+// 1回の停止時間が targetPauseMs に収まるよう、GC を起こす確保量 (stepKB) を調整する
+// ===================================================================
+class GCController {
+public:
+    bool enabled = true;
+    double targetPauseMs = 1.0;
+    double minStepKB = 16.0;
+    double maxStepKB = 8192.0;
+
+    // 1フレームのスクリプト時間（GC 込み）の分布
+    static const int kBuckets = 7;   // <0.5, <1, <2, <4, <8, <16, >=16 ms
+    unsigned long long frameHistogram[kBuckets] = {};
+    unsigned long long pauseHistogram[kBuckets] = {};
+
+    void attach(lua_State* L, ScriptProfiler* profiler);
+
+    // フレームの最後に呼ぶ。idleMs はこのフレームで残っている時間
+    void step(double idleMs);
+
+    void dump() const;
+
+private:
+    static const int kForceStepKB = 1 << 20;
+
+    lua_State* L = nullptr;
+    ScriptProfiler* profiler = nullptr;
+    double stepKB = 256.0;
+    double estimatedPauseMs = 0.0;
+    double kbAfterLastStep = 0.0;
+    double lastScriptMs = 0.0;
+    unsigned long long idleSteps = 0;
+    unsigned long long skippedSteps = 0;
+
+    double heapKB() const;
+    static int bucketOf(double ms);
+};
+
+int initLua();
+// 接続を全て外してからメイン VM を閉じる（静的オブジェクトの破棄より前に呼ぶ）
+void shutdownLua();
+
+// メイン VM の GC をフレーム末尾の空き時間で進める
+void stepLuaGC(double idleMs);
+void dumpLuaGC();
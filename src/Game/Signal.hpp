@@ -0,0 +1,235 @@
+// src/Game/Signal.hpp
+#ifndef SIGNAL_HPP
+#define SIGNAL_HPP
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+#include <algorithm>
+
+// ===================================================================
+// Signal 共通部分
+// ===================================================================
+class SignalBase {
+public:
+    SignalBase() : token(std::make_shared<SignalBase*>(this)) {}
+    virtual ~SignalBase() = default;
+
+    // アドレスが Connection から参照されるのでコピー・ムーブ不可
+    SignalBase(const SignalBase&) = delete;
+    SignalBase& operator=(const SignalBase&) = delete;
+
+    virtual void disconnectSlot(uint32_t index, uint32_t generation) = 0;
+    virtual bool isSlotConnected(uint32_t index, uint32_t generation) const = 0;
+
+protected:
+    friend class Connection;
+    // Signal が先に破棄されても Connection が安全に無効になるための生存トークン
+    std::shared_ptr<SignalBase*> token;
+};
+
+// 接続ハンドル（値型）
+// スロット番号 + 世代で識別するので、スロットが再利用されても古いハンドルは効かない
+class Connection {
+public:
+    Connection() = default;
+    Connection(SignalBase* s, uint32_t idx, uint32_t gen)
+        : signal(s->token), index(idx), generation(gen) {}
+
+    void disconnect() {
+        if (auto s = signal.lock()) (*s)->disconnectSlot(index, generation);
+        signal.reset();
+    }
+
+    bool connected() const {
+        auto s = signal.lock();
+        return s && (*s)->isSlotConnected(index, generation);
+    }
+
+private:
+    std::weak_ptr<SignalBase*> signal;
+    uint32_t index = 0;
+    uint32_t generation = 0;
+};
+
+// ===================================================================
+// Signal<Args...>: シングルスレッド用
+// スロットは連続した配列に置き、空きスロットは世代を進めて再利用する。
+// 発火中の connect は次回の fire から、disconnect は即座に有効になる
+// ===================================================================
+template <typename... Args>
+class Signal : public SignalBase {
+public:
+    using Callback = std::function<void(Args...)>;
+
+    Connection connect(Callback cb) {
+        if (firing > 0) {
+            // 発火中は slots を動かせないので保留し、fire 終了時に末尾へ追加する
+            uint32_t index = (uint32_t)(slots.size() + pending.size());
+            pending.push_back(Slot{std::move(cb), 0, true});
+            active++;
+            return Connection(this, index, 0);
+        }
+
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = (uint32_t)slots.size();
+            slots.push_back(Slot{});
+        }
+        Slot& slot = slots[index];
+        slot.fn = std::move(cb);
+        slot.active = true;
+        active++;
+        return Connection(this, index, slot.generation);
+    }
+
+    void fire(Args... args) {
+        firing++;
+        // 発火中に追加された分は pending にあるので、ここでは見えない
+        for (size_t i = 0, n = slots.size(); i < n; ++i) {
+            if (slots[i].active) slots[i].fn(args...);
+        }
+        if (--firing == 0) flushPending();
+    }
+
+    void disconnectAll() {
+        for (uint32_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].active) disconnectSlot(i, slots[i].generation);
+        }
+        for (auto& p : pending) p.active = false;
+        active = 0;
+    }
+
+    size_t listenerCount() const { return active; }
+
+    void disconnectSlot(uint32_t index, uint32_t generation) override {
+        if (index >= slots.size()) {
+            if (index - slots.size() >= pending.size()) return;
+            Slot& p = pending[index - slots.size()];
+            if (p.active && p.generation == generation) {
+                p.active = false;
+                active--;
+            }
+            return;
+        }
+
+        Slot& slot = slots[index];
+        if (!slot.active || slot.generation != generation) return;
+        slot.active = false;
+        active--;
+
+        // 実行中のコールバック自身が切断することもあるので、発火中は解放を遅らせる
+        if (firing > 0) {
+            releasing.push_back(index);
+        } else {
+            release(index);
+        }
+    }
+
+    bool isSlotConnected(uint32_t index, uint32_t generation) const override {
+        if (index >= slots.size()) {
+            size_t p = index - slots.size();
+            return p < pending.size() && pending[p].active && pending[p].generation == generation;
+        }
+        return slots[index].active && slots[index].generation == generation;
+    }
+
+private:
+    struct Slot {
+        Callback fn;
+        uint32_t generation = 0;
+        bool active = false;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::vector<Slot> pending;          // 発火中に connect されたスロット
+    std::vector<uint32_t> releasing;    // 発火中に disconnect されたスロット
+    size_t active = 0;
+    int firing = 0;
+
+    void release(uint32_t index) {
+        Slot& slot = slots[index];
+        slot.fn = nullptr;
+        slot.generation++;
+        freeSlots.push_back(index);
+    }
+
+    void flushPending() {
+        for (uint32_t index : releasing) release(index);
+        releasing.clear();
+
+        // Connection に渡した番号と一致させるため、切断済みでも一旦末尾に積む
+        for (auto& p : pending) {
+            uint32_t index = (uint32_t)slots.size();
+            bool wasActive = p.active;
+            slots.push_back(std::move(p));
+            if (!wasActive) release(index);
+        }
+        pending.clear();
+    }
+};
+
+// ===================================================================
+// ConcurrentSignal<Args...>: 複数スレッドから fire できる版
+// 接続リストは不変のスナップショットとして共有し、connect/disconnect は
+// コピーして差し替える（RCU 方式）。fire はロックを取らない。
+// disconnect 直後でも、既にスナップショットを掴んだ fire では1回呼ばれることがある
+// ===================================================================
+template <typename... Args>
+class ConcurrentSignal : public SignalBase {
+public:
+    using Callback = std::function<void(Args...)>;
+
+    ConcurrentSignal() : list(std::make_shared<const List>()) {}
+
+    Connection connect(Callback cb) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        auto next = std::make_shared<List>(*std::atomic_load(&list));
+        uint32_t id = nextId++;
+        next->push_back(Entry{std::make_shared<const Callback>(std::move(cb)), id});
+        std::atomic_store(&list, std::shared_ptr<const List>(std::move(next)));
+        return Connection(this, id, 0);
+    }
+
+    void fire(Args... args) const {
+        std::shared_ptr<const List> snapshot = std::atomic_load(&list);
+        for (const auto& e : *snapshot) (*e.fn)(args...);
+    }
+
+    size_t listenerCount() const { return std::atomic_load(&list)->size(); }
+
+    void disconnectSlot(uint32_t index, uint32_t) override {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        auto current = std::atomic_load(&list);
+        auto next = std::make_shared<List>();
+        next->reserve(current->size());
+        for (const auto& e : *current) {
+            if (e.id != index) next->push_back(e);
+        }
+        std::atomic_store(&list, std::shared_ptr<const List>(std::move(next)));
+    }
+
+    bool isSlotConnected(uint32_t index, uint32_t) const override {
+        auto current = std::atomic_load(&list);
+        return std::any_of(current->begin(), current->end(), [index](const Entry& e) { return e.id == index; });
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<const Callback> fn;   // スナップショット間で共有（コピーしない）
+        uint32_t id;
+    };
+    using List = std::vector<Entry>;
+
+    std::shared_ptr<const List> list;
+    std::mutex writeMutex;
+    uint32_t nextId = 0;
+};
+
+#endif // SIGNAL_HPP
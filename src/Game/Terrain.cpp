@@ -0,0 +1,439 @@
+// src/Game/Terrain.cpp
+#include "Terrain.hpp"
+#include "JobSystem.hpp"
+#include "src/Math/MathUtils.hpp"
+
+static const char* const kMaterialNames[kTerrainMaterialCount] = {
+    "Air", "Grass", "Ground", "Rock", "Sand", "Snow"
+};
+
+// 素材の色（Roblox の地形の既定色に近いもの）
+static const uint8_t kMaterialColors[kTerrainMaterialCount][3] = {
+    {   0,   0,   0 },
+    { 106, 127,  63 },
+    { 102,  92,  59 },
+    { 102, 108, 111 },
+    { 143, 126,  95 },
+    { 195, 199, 218 },
+};
+
+const char* terrainMaterialName(TerrainMaterial m) {
+    int i = (int)m;
+    return (i >= 0 && i < kTerrainMaterialCount) ? kMaterialNames[i] : "Air";
+}
+
+bool terrainMaterialFromName(const std::string& name, TerrainMaterial& out) {
+    for (int i = 0; i < kTerrainMaterialCount; ++i) {
+        if (name == kMaterialNames[i]) {
+            out = (TerrainMaterial)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ====================================================================
+// TerrainChunk
+// ====================================================================
+
+void TerrainChunk::writeIndex(int index, uint32_t value) {
+    uint32_t bit = (uint32_t)index * bitsPerIndex;
+    uint64_t mask = ((uint64_t(1) << bitsPerIndex) - 1) << (bit & 63);
+    uint64_t& word = bits[bit >> 6];
+    word = (word & ~mask) | ((uint64_t)value << (bit & 63));
+}
+
+// 添字の幅を newBits に広げる（詰め直し）
+void TerrainChunk::widen(uint8_t newBits) {
+    std::vector<uint8_t> old(kVolume);
+    for (int i = 0; i < kVolume; ++i) old[i] = (uint8_t)readIndex(i);
+    bitsPerIndex = newBits;
+    bits.assign((size_t)kVolume * newBits / 64, 0);
+    for (int i = 0; i < kVolume; ++i) writeIndex(i, old[i]);
+}
+
+void TerrainChunk::set(int index, TerrainMaterial m) {
+    TerrainMaterial before = get(index);
+    if (before == m) return;
+
+    uint32_t slot = 0;
+    while (slot < palette.size() && palette[slot] != (uint8_t)m) ++slot;
+    if (slot == palette.size()) {
+        palette.push_back((uint8_t)m);
+        if (palette.size() > (1u << bitsPerIndex)) {
+            uint8_t next = bitsPerIndex == 0 ? 1 : (uint8_t)(bitsPerIndex * 2);
+            widen(next);
+        }
+    }
+    writeIndex(index, slot);
+
+    if (before == TerrainMaterial::Air) ++solid;
+    if (m == TerrainMaterial::Air) --solid;
+}
+
+void TerrainChunk::unpack(uint8_t* out) const {
+    if (bitsPerIndex == 0) {
+        std::fill(out, out + kVolume, palette[0]);
+        return;
+    }
+    for (int i = 0; i < kVolume; ++i) out[i] = palette[readIndex(i)];
+}
+
+void TerrainChunk::pack(const uint8_t* materials) {
+    bool used[256] = {};
+    solid = 0;
+    for (int i = 0; i < kVolume; ++i) {
+        used[materials[i]] = true;
+        solid += materials[i] != (uint8_t)TerrainMaterial::Air;
+    }
+
+    uint8_t slotOf[256];
+    palette.clear();
+    for (int m = 0; m < 256; ++m) {
+        if (!used[m]) continue;
+        slotOf[m] = (uint8_t)palette.size();
+        palette.push_back((uint8_t)m);
+    }
+
+    bitsPerIndex = 0;
+    while ((1u << bitsPerIndex) < palette.size()) bitsPerIndex = bitsPerIndex == 0 ? 1 : (uint8_t)(bitsPerIndex * 2);
+    bits.assign((size_t)kVolume * bitsPerIndex / 64, 0);
+    bits.shrink_to_fit();
+    if (bitsPerIndex == 0) return;
+    for (int i = 0; i < kVolume; ++i) writeIndex(i, slotOf[materials[i]]);
+}
+
+// ====================================================================
+// Terrain: 読み書き
+// ====================================================================
+
+const TerrainChunk* Terrain::findChunk(int cx, int cy, int cz) const {
+    auto it = chunks.find(key(cx, cy, cz));
+    return it != chunks.end() ? it->second.get() : nullptr;
+}
+
+TerrainChunk* Terrain::createChunk(int cx, int cy, int cz) {
+    auto& slot = chunks[key(cx, cy, cz)];
+    if (!slot) slot.reset(new TerrainChunk(cx, cy, cz));
+    int c[3] = { cx, cy, cz };
+    bool first = chunkMin[0] > chunkMax[0];
+    for (int i = 0; i < 3; ++i) {
+        chunkMin[i] = first ? c[i] : std::min(chunkMin[i], c[i]);
+        chunkMax[i] = first ? c[i] : std::max(chunkMax[i], c[i]);
+    }
+    return slot.get();
+}
+
+void Terrain::markDirty(int cx, int cy, int cz) {
+    auto it = chunks.find(key(cx, cy, cz));
+    if (it == chunks.end() || it->second->dirty) return;
+    it->second->dirty = true;
+    dirtyKeys.push_back(it->first);
+}
+
+void Terrain::finishEdit(int x0, int y0, int z0, int x1, int y1, int z1) {
+    // 境目のボクセルは隣の塊の面の出方も変える
+    for (int cz = chunkOf(z0 - 1); cz <= chunkOf(z1 + 1); ++cz)
+    for (int cy = chunkOf(y0 - 1); cy <= chunkOf(y1 + 1); ++cy)
+    for (int cx = chunkOf(x0 - 1); cx <= chunkOf(x1 + 1); ++cx) {
+        auto it = chunks.find(key(cx, cy, cz));
+        if (it == chunks.end()) continue;
+        if (it->second->solidCount() == 0) {
+            chunks.erase(it);   // dirtyKeys に残っていても update が飛ばす
+            continue;
+        }
+        markDirty(cx, cy, cz);
+    }
+
+    Vector3 mn(x0 * kVoxelSize, y0 * kVoxelSize, z0 * kVoxelSize);
+    Vector3 mx((x1 + 1) * kVoxelSize, (y1 + 1) * kVoxelSize, (z1 + 1) * kVoxelSize);
+    if (!edited) {
+        editedMin = mn;
+        editedMax = mx;
+        edited = true;
+    } else {
+        editedMin = Vector3(std::min(editedMin.x, mn.x), std::min(editedMin.y, mn.y), std::min(editedMin.z, mn.z));
+        editedMax = Vector3(std::max(editedMax.x, mx.x), std::max(editedMax.y, mx.y), std::max(editedMax.z, mx.z));
+    }
+}
+
+TerrainMaterial Terrain::getVoxel(int x, int y, int z) const {
+    const int S = TerrainChunk::kSize;
+    int cx = chunkOf(x), cy = chunkOf(y), cz = chunkOf(z);
+    const TerrainChunk* c = findChunk(cx, cy, cz);
+    if (!c) return TerrainMaterial::Air;
+    return c->get(localIndex(x - cx * S, y - cy * S, z - cz * S));
+}
+
+void Terrain::setVoxel(int x, int y, int z, TerrainMaterial m) {
+    const int S = TerrainChunk::kSize;
+    int cx = chunkOf(x), cy = chunkOf(y), cz = chunkOf(z);
+    TerrainChunk* c = const_cast<TerrainChunk*>(findChunk(cx, cy, cz));
+    if (!c) {
+        if (m == TerrainMaterial::Air) return;
+        c = createChunk(cx, cy, cz);
+    }
+    int index = localIndex(x - cx * S, y - cy * S, z - cz * S);
+    if (c->get(index) == m) return;
+    c->set(index, m);
+    finishEdit(x, y, z, x, y, z);
+}
+
+void Terrain::fillBlock(const Vector3& center, const Vector3& rotation, const Vector3& size, TerrainMaterial m) {
+    Matrix3 R = Matrix3::rotate(rotation);
+    Matrix3 Rt = R.transpose();
+    Vector3 h = size * 0.5f;
+    // 箱の AABB（回転した半分の大きさの各軸への投影）
+    Vector3 ext(
+        std::abs(R.m[0][0]) * h.x + std::abs(R.m[0][1]) * h.y + std::abs(R.m[0][2]) * h.z,
+        std::abs(R.m[1][0]) * h.x + std::abs(R.m[1][1]) * h.y + std::abs(R.m[1][2]) * h.z,
+        std::abs(R.m[2][0]) * h.x + std::abs(R.m[2][1]) * h.y + std::abs(R.m[2][2]) * h.z);
+    Vector3 lo = center - ext, hi = center + ext;
+    edit(toVoxel(lo.x), toVoxel(lo.y), toVoxel(lo.z), toVoxel(hi.x), toVoxel(hi.y), toVoxel(hi.z),
+        [&](int x, int y, int z, TerrainMaterial cur) {
+            Vector3 p((x + 0.5f) * kVoxelSize, (y + 0.5f) * kVoxelSize, (z + 0.5f) * kVoxelSize);
+            Vector3 local = Rt * (p - center);
+            bool inside = std::abs(local.x) <= h.x && std::abs(local.y) <= h.y && std::abs(local.z) <= h.z;
+            return inside ? m : cur;
+        });
+}
+
+void Terrain::fillBall(const Vector3& center, float radius, TerrainMaterial m) {
+    float r2 = radius * radius;
+    edit(toVoxel(center.x - radius), toVoxel(center.y - radius), toVoxel(center.z - radius),
+         toVoxel(center.x + radius), toVoxel(center.y + radius), toVoxel(center.z + radius),
+        [&](int x, int y, int z, TerrainMaterial cur) {
+            Vector3 d((x + 0.5f) * kVoxelSize - center.x, (y + 0.5f) * kVoxelSize - center.y,
+                      (z + 0.5f) * kVoxelSize - center.z);
+            return d.lengthSquared() <= r2 ? m : cur;
+        });
+}
+
+void Terrain::clear() {
+    // 地形に乗っていた物体を起こせるように、今までの範囲を編集済みにする
+    if (chunkMin[0] <= chunkMax[0]) {
+        const int S = TerrainChunk::kSize;
+        finishEdit(chunkMin[0] * S, chunkMin[1] * S, chunkMin[2] * S,
+                   chunkMax[0] * S + S - 1, chunkMax[1] * S + S - 1, chunkMax[2] * S + S - 1);
+    }
+    chunks.clear();
+    dirtyKeys.clear();
+    chunkMin[0] = chunkMin[1] = chunkMin[2] = 0;
+    chunkMax[0] = chunkMax[1] = chunkMax[2] = -1;
+    ++version;
+}
+
+bool Terrain::takeEditedRegion(Vector3& mn, Vector3& mx) {
+    if (!edited) return false;
+    mn = editedMin;
+    mx = editedMax;
+    edited = false;
+    return true;
+}
+
+// ====================================================================
+// Terrain: メッシュと当たり判定の箱
+// ====================================================================
+
+void Terrain::update() {
+    if (dirtyKeys.empty()) return;
+    work.clear();
+    for (uint64_t k : dirtyKeys) {
+        auto it = chunks.find(k);
+        if (it == chunks.end() || !it->second->dirty) continue;   // 消えた塊・重複
+        it->second->dirty = false;
+        work.push_back(it->second.get());
+    }
+    dirtyKeys.clear();
+
+    // 塊ごとに自分の出力だけを書き、隣は読むだけ（編集はこの間に起きない）
+    if (parallel && work.size() > 1) {
+        JobSystem::get().parallelFor(work.size(), [&](size_t i) { buildChunk(*work[i]); });
+    } else {
+        for (TerrainChunk* c : work) buildChunk(*c);
+    }
+    ++version;
+}
+
+void Terrain::buildChunk(TerrainChunk& chunk) const {
+    const int S = TerrainChunk::kSize;
+    const int P = S + 2;   // 隣の面を 1 層ずつ足した大きさ
+    const uint8_t air = (uint8_t)TerrainMaterial::Air;
+
+    std::vector<uint8_t> padded((size_t)P * P * P, air);
+    auto at = [&](int x, int y, int z) -> uint8_t& { return padded[(x + 1) + P * ((y + 1) + P * (z + 1))]; };
+
+    std::vector<uint8_t> local(TerrainChunk::kVolume);
+    chunk.unpack(local.data());
+    for (int z = 0; z < S; ++z)
+        for (int y = 0; y < S; ++y) std::copy_n(&local[localIndex(0, y, z)], S, &at(0, y, z));
+
+    // 6 方向の隣の塊の、こちらに接する面
+    for (int axis = 0; axis < 3; ++axis) {
+        for (int side = -1; side <= 1; side += 2) {
+            int n[3] = { chunk.cx, chunk.cy, chunk.cz };
+            n[axis] += side;
+            const TerrainChunk* nb = findChunk(n[0], n[1], n[2]);
+            if (!nb) continue;
+            int src = side > 0 ? 0 : S - 1;   // 隣の塊の中の層
+            int dst = side > 0 ? S : -1;      // padded の中の層
+            int u = (axis + 1) % 3, v = (axis + 2) % 3;
+            for (int b = 0; b < S; ++b)
+            for (int a = 0; a < S; ++a) {
+                int s[3], d[3];
+                s[axis] = src; d[axis] = dst;
+                s[u] = d[u] = a;
+                s[v] = d[v] = b;
+                at(d[0], d[1], d[2]) = (uint8_t)nb->get(localIndex(s[0], s[1], s[2]));
+            }
+        }
+    }
+
+    // ---- 描画: 方向ごと・層ごとに、空気に面した面を同じ素材の長方形にまとめる ----
+    chunk.vertices.clear();
+    chunk.indices.clear();
+    uint8_t mask[S * S];
+    const int stride[3] = { 1, P, P * P };   // padded の各軸の間隔
+    const float base[3] = { (float)(chunk.cx * S), (float)(chunk.cy * S), (float)(chunk.cz * S) };
+    for (int axis = 0; axis < 3; ++axis) {
+        int u = (axis + 1) % 3, v = (axis + 2) % 3;
+        for (int side = -1; side <= 1; side += 2) {
+            for (int layer = 0; layer < S; ++layer) {
+                const uint8_t* row = &at(0, 0, 0) + stride[axis] * layer;
+                const int facing = stride[axis] * side;
+                bool any = false;
+                for (int b = 0; b < S; ++b)
+                for (int a = 0; a < S; ++a) {
+                    const uint8_t* cell = row + stride[u] * a + stride[v] * b;
+                    uint8_t m = cell[0];
+                    uint8_t face = (m != air && cell[facing] == air) ? m : air;
+                    mask[a + S * b] = face;
+                    any = any || face != air;
+                }
+                if (!any) continue;
+
+                for (int b = 0; b < S; ++b)
+                for (int a = 0; a < S; ) {
+                    uint8_t m = mask[a + S * b];
+                    if (m == air) { ++a; continue; }
+                    int w = 1;
+                    while (a + w < S && mask[a + w + S * b] == m) ++w;
+                    int h = 1;
+                    for (; b + h < S; ++h) {
+                        int k = 0;
+                        while (k < w && mask[a + k + S * (b + h)] == m) ++k;
+                        if (k < w) break;
+                    }
+                    for (int y = 0; y < h; ++y)
+                        std::fill(mask + a + S * (b + y), mask + a + w + S * (b + y), air);
+
+                    // 面の4隅（u, v の順に回ると +axis から見て反時計回り）
+                    float plane = (base[axis] + layer + (side > 0 ? 1 : 0)) * kVoxelSize;
+                    float us[4] = { (float)a, (float)(a + w), (float)(a + w), (float)a };
+                    float vs[4] = { (float)b, (float)b, (float)(b + h), (float)(b + h) };
+                    uint32_t first = (uint32_t)chunk.vertices.size();
+                    for (int c = 0; c < 4; ++c) {
+                        float pos[3], nrm[3] = { 0, 0, 0 };
+                        pos[axis] = plane;
+                        pos[u] = (base[u] + us[c]) * kVoxelSize;
+                        pos[v] = (base[v] + vs[c]) * kVoxelSize;
+                        nrm[axis] = (float)side;
+                        TerrainVertex vert;
+                        vert.x = pos[0]; vert.y = pos[1]; vert.z = pos[2];
+                        vert.nx = nrm[0]; vert.ny = nrm[1]; vert.nz = nrm[2];
+                        vert.r = kMaterialColors[m][0];
+                        vert.g = kMaterialColors[m][1];
+                        vert.b = kMaterialColors[m][2];
+                        vert.a = 255;
+                        chunk.vertices.push_back(vert);
+                    }
+                    static const uint32_t kFront[6] = { 0, 1, 2, 0, 2, 3 };
+                    static const uint32_t kBack[6]  = { 0, 2, 1, 0, 3, 2 };
+                    const uint32_t* order = side > 0 ? kFront : kBack;
+                    for (int k = 0; k < 6; ++k) chunk.indices.push_back(first + order[k]);
+                    a += w;
+                }
+            }
+        }
+    }
+
+    // ---- 当たり判定: 中身のボクセルを x, y, z の順に伸ばして箱にまとめる（素材は見ない） ----
+    chunk.boxes.clear();
+    // local を「まだ箱に入っていない中身」の印に使い回す（メッシュはもう padded から作った）
+    const int SY = S, SZ = S * S;
+    for (uint8_t& m : local) m = m != air;
+    for (int z = 0; z < S; ++z)
+    for (int y = 0; y < S; ++y)
+    for (int x = 0; x < S; ++x) {
+        const uint8_t* open = &local[localIndex(x, y, z)];
+        if (!open[0]) continue;
+        int w = 1;
+        while (x + w < S && open[w]) ++w;
+        int h = 1;
+        for (; y + h < S; ++h) {
+            const uint8_t* row = open + SY * h;
+            int k = 0;
+            while (k < w && row[k]) ++k;
+            if (k < w) break;
+        }
+        int d = 1;
+        for (; z + d < S; ++d) {
+            bool full = true;
+            for (int j = 0; j < h && full; ++j) {
+                const uint8_t* row = open + SZ * d + SY * j;
+                for (int k = 0; k < w && full; ++k) full = row[k] != 0;
+            }
+            if (!full) break;
+        }
+        for (int dz = 0; dz < d; ++dz)
+            for (int j = 0; j < h; ++j)
+                std::fill_n(&local[localIndex(x, y + j, z + dz)], w, (uint8_t)0);
+
+        TerrainBox box;
+        box.min = Vector3((base[0] + x) * kVoxelSize, (base[1] + y) * kVoxelSize, (base[2] + z) * kVoxelSize);
+        box.max = Vector3((base[0] + x + w) * kVoxelSize, (base[1] + y + h) * kVoxelSize, (base[2] + z + d) * kVoxelSize);
+        chunk.boxes.push_back(box);
+    }
+
+    if (!chunk.boxes.empty()) {
+        chunk.boundsMin = chunk.boxes[0].min;
+        chunk.boundsMax = chunk.boxes[0].max;
+        for (const TerrainBox& b : chunk.boxes) {
+            chunk.boundsMin = Vector3(std::min(chunk.boundsMin.x, b.min.x), std::min(chunk.boundsMin.y, b.min.y),
+                                      std::min(chunk.boundsMin.z, b.min.z));
+            chunk.boundsMax = Vector3(std::max(chunk.boundsMax.x, b.max.x), std::max(chunk.boundsMax.y, b.max.y),
+                                      std::max(chunk.boundsMax.z, b.max.z));
+        }
+    }
+}
+
+// ====================================================================
+// Terrain: 統計
+// ====================================================================
+
+size_t Terrain::solidVoxelCount() const {
+    size_t n = 0;
+    for (const auto& kv : chunks) n += kv.second->solidCount();
+    return n;
+}
+
+size_t Terrain::voxelBytes() const {
+    size_t n = 0;
+    for (const auto& kv : chunks) n += kv.second->voxelBytes();
+    return n;
+}
+
+size_t Terrain::meshBytes() const {
+    size_t n = 0;
+    for (const auto& kv : chunks) {
+        n += kv.second->vertices.capacity() * sizeof(TerrainVertex);
+        n += kv.second->indices.capacity() * sizeof(uint32_t);
+    }
+    return n;
+}
+
+size_t Terrain::boxCount() const {
+    size_t n = 0;
+    for (const auto& kv : chunks) n += kv.second->boxes.size();
+    return n;
+}
@@ -0,0 +1,244 @@
+// src/Game/Terrain.hpp
+#ifndef TERRAIN_HPP
+#define TERRAIN_HPP
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+
+#include "src/Math/Vector3.hpp"
+
+// 地形の素材（Roblox の Enum.Material の一部）。Air は何もない
+enum class TerrainMaterial : uint8_t { Air, Grass, Ground, Rock, Sand, Snow };
+static const int kTerrainMaterialCount = 6;
+
+const char* terrainMaterialName(TerrainMaterial m);
+// 未知の名前なら false
+bool terrainMaterialFromName(const std::string& name, TerrainMaterial& out);
+
+// 描画の頂点（ワールド座標の位置・法線と、素材の色）
+struct TerrainVertex {
+    float x, y, z;
+    float nx, ny, nz;
+    uint8_t r, g, b, a;
+};
+
+// 当たり判定の箱（ワールド座標の AABB）。隣り合う中身のボクセルをまとめたもの
+struct TerrainBox {
+    Vector3 min, max;
+};
+
+// ===================================================================
+// TerrainChunk: 32³ ボクセルの塊
+//
+// 素材は「パレット」（この塊で使っている素材の一覧）への添字で持ち、添字の幅は種類数で決まる:
+//   1種類なら 0 ビット（配列なし。地中・空中の塊はほぼこれ）、2種類なら 1 ビット、… 最大 8 ビット
+// 描画のメッシュと当たり判定の箱は Terrain::update で作り直す
+// ===================================================================
+struct TerrainChunk {
+    static const int kSize = 32;
+    static const int kVolume = kSize * kSize * kSize;
+
+    int cx, cy, cz;   // 塊の座標（ボクセル座標 / kSize）
+
+    TerrainMaterial get(int index) const { return (TerrainMaterial)palette[readIndex(index)]; }
+    void set(int index, TerrainMaterial m);
+    // 全ボクセルの素材を out[kVolume] に書く / materials から使っている素材だけのパレットで詰め直す
+    void unpack(uint8_t* out) const;
+    void pack(const uint8_t* materials);
+
+    size_t solidCount() const { return solid; }
+    size_t voxelBytes() const { return sizeof(TerrainChunk) + palette.capacity() + bits.capacity() * sizeof(uint64_t); }
+    int bitsPerVoxel() const { return bitsPerIndex; }
+
+    // update で作り直す（描画・物理・空間クエリはこれを読む）
+    std::vector<TerrainVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<TerrainBox> boxes;
+    Vector3 boundsMin, boundsMax;   // boxes 全体の AABB
+
+    TerrainChunk(int cx, int cy, int cz) : cx(cx), cy(cy), cz(cz), palette(1, (uint8_t)TerrainMaterial::Air) {}
+
+private:
+    friend class Terrain;
+
+    std::vector<uint8_t> palette;
+    std::vector<uint64_t> bits;   // 添字を bitsPerIndex ビットずつ詰める（幅は 64 の約数なので語をまたがない）
+    uint8_t bitsPerIndex = 0;
+    size_t solid = 0;             // Air でないボクセルの数
+    bool dirty = false;           // update 待ちの一覧に載っている
+
+    uint32_t readIndex(int index) const {
+        if (bitsPerIndex == 0) return 0;
+        uint32_t bit = (uint32_t)index * bitsPerIndex;
+        return (uint32_t)(bits[bit >> 6] >> (bit & 63)) & ((1u << bitsPerIndex) - 1);
+    }
+    void writeIndex(int index, uint32_t value);
+    void widen(uint8_t newBits);
+};
+
+// ===================================================================
+// Terrain: ボクセルの地形（Roblox の workspace.Terrain）
+//
+// ボクセルは 1 辺 kVoxelSize スタッドの立方体で、ボクセル (x, y, z) はワールドの
+// [x, x+1) * kVoxelSize（y, z も同じ）を占める。塊は中身のあるものだけ持つ。
+// 編集はその場で素材を書き、塊（と境目に触れた隣の塊）を update 待ちにするだけ。
+// update が待ちの塊ごとに（JobSystem で並列に）:
+//   描画: 6 方向それぞれ、空気に面した面を同じ素材の長方形にまとめる（greedy meshing）
+//   当たり判定: 中身のボクセルを大きな箱にまとめる。物理・空間クエリは
+//     ボクセルではなく塊の箱の一覧を見る
+// ===================================================================
+class Terrain {
+public:
+    static constexpr float kVoxelSize = 4.0f;   // Roblox と同じ
+
+    Terrain() = default;
+    Terrain(const Terrain&) = delete;
+    Terrain& operator=(const Terrain&) = delete;
+
+    // ---- 読み書き（ボクセル座標） ----
+    TerrainMaterial getVoxel(int x, int y, int z) const;
+    void setVoxel(int x, int y, int z, TerrainMaterial m);
+    // ワールド座標の点を含むボクセル
+    static int toVoxel(float world) { return (int)std::floor(world / kVoxelSize); }
+
+    // [x0, x1]×[y0, y1]×[z0, z1]（両端を含む）の各ボクセルを fn(x, y, z, 今の素材) の返す素材にする。
+    // 塊ごとに展開して書き、詰め直す（1ボクセルずつ set するより速い）
+    template <typename Fn>
+    void edit(int x0, int y0, int z0, int x1, int y1, int z1, Fn&& fn);
+
+    // ボクセルの中心が形の中にあるものを m にする（Air なら消す。Roblox の FillBlock / FillBall）
+    void fillBlock(const Vector3& center, const Vector3& rotation, const Vector3& size, TerrainMaterial m);
+    void fillBall(const Vector3& center, float radius, TerrainMaterial m);
+    void fillVoxels(int x0, int y0, int z0, int x1, int y1, int z1, TerrainMaterial m) {
+        edit(x0, y0, z0, x1, y1, z1, [m](int, int, int, TerrainMaterial) { return m; });
+    }
+    void clear();
+
+    // 編集された塊の描画メッシュ・当たり判定の箱を作り直す（フレームに1回。描画の前）
+    void update();
+
+    // false なら update を全てメインスレッドで行う（比較・デバッグ用）
+    void setParallel(bool p) { parallel = p; }
+
+    // ---- 読むだけ（update 済みの箱・メッシュ。並列に呼んでよい） ----
+    // ワールド座標の AABB [mn, mx] と重なる当たり判定の箱ごとに fn(box)
+    template <typename Fn>
+    void forEachBox(const Vector3& mn, const Vector3& mx, Fn&& fn) const;
+    template <typename Fn>
+    void forEachChunk(Fn&& fn) const {
+        for (const auto& kv : chunks) fn(*kv.second);
+    }
+    bool empty() const { return chunks.empty(); }
+
+    // 前回取り出してから編集された範囲（ワールド座標の AABB）。物理が眠っている物体を起こすのに使う
+    bool takeEditedRegion(Vector3& mn, Vector3& mx);
+
+    // 統計
+    size_t chunkCount() const { return chunks.size(); }
+    size_t solidVoxelCount() const;
+    size_t voxelBytes() const;    // 素材の保持に使っているバイト数（塊の構造体を含む）
+    size_t meshBytes() const;     // 描画の頂点・添字
+    size_t boxCount() const;
+    uint64_t meshVersion() const { return version; }   // update で作り直すたびに増える
+
+private:
+    std::unordered_map<uint64_t, std::unique_ptr<TerrainChunk>> chunks;
+    std::vector<uint64_t> dirtyKeys;          // update 待ち（塊の dirty で重複を防ぐ）
+    std::vector<TerrainChunk*> work;          // update の作業用（容量を使い回す）
+    std::vector<uint8_t> scratch;             // edit の展開先
+    int chunkMin[3] = { 0, 0, 0 }, chunkMax[3] = { -1, -1, -1 };   // 作ったことのある塊の範囲（縮めない）
+    bool edited = false;
+    Vector3 editedMin, editedMax;
+    uint64_t version = 0;
+    bool parallel = true;
+
+    static uint64_t key(int cx, int cy, int cz) {
+        const uint64_t bias = 1u << 20;   // 各軸 21 ビット
+        return ((uint64_t)(cx + bias) << 42) | ((uint64_t)(cy + bias) << 21) | (uint64_t)(cz + bias);
+    }
+    static int chunkOf(int v) { return v >= 0 ? v / TerrainChunk::kSize : (v + 1) / TerrainChunk::kSize - 1; }
+    static int localIndex(int x, int y, int z) {
+        return x + TerrainChunk::kSize * (y + TerrainChunk::kSize * z);
+    }
+
+    const TerrainChunk* findChunk(int cx, int cy, int cz) const;
+    TerrainChunk* createChunk(int cx, int cy, int cz);
+    void markDirty(int cx, int cy, int cz);
+    // ボクセル範囲の編集を記録する: 範囲に（1ボクセル広げて）触れる塊を update 待ちにし、
+    // 中身のなくなった塊を消す
+    void finishEdit(int x0, int y0, int z0, int x1, int y1, int z1);
+
+    // 塊1つのメッシュと箱を作る（隣の塊を読むだけなので並列に呼べる）
+    void buildChunk(TerrainChunk& chunk) const;
+};
+
+// ====================================================================
+// テンプレートの実装
+// ====================================================================
+
+template <typename Fn>
+void Terrain::edit(int x0, int y0, int z0, int x1, int y1, int z1, Fn&& fn) {
+    if (x0 > x1 || y0 > y1 || z0 > z1) return;
+    const int S = TerrainChunk::kSize;
+    scratch.resize(TerrainChunk::kVolume);
+    bool any = false;
+    for (int cz = chunkOf(z0); cz <= chunkOf(z1); ++cz)
+    for (int cy = chunkOf(y0); cy <= chunkOf(y1); ++cy)
+    for (int cx = chunkOf(x0); cx <= chunkOf(x1); ++cx) {
+        const TerrainChunk* existing = findChunk(cx, cy, cz);
+        if (existing) existing->unpack(scratch.data());
+        else std::fill(scratch.begin(), scratch.end(), (uint8_t)TerrainMaterial::Air);
+
+        int lx0 = std::max(x0 - cx * S, 0), lx1 = std::min(x1 - cx * S, S - 1);
+        int ly0 = std::max(y0 - cy * S, 0), ly1 = std::min(y1 - cy * S, S - 1);
+        int lz0 = std::max(z0 - cz * S, 0), lz1 = std::min(z1 - cz * S, S - 1);
+        bool changed = false;
+        for (int z = lz0; z <= lz1; ++z)
+        for (int y = ly0; y <= ly1; ++y)
+        for (int x = lx0; x <= lx1; ++x) {
+            uint8_t& v = scratch[localIndex(x, y, z)];
+            uint8_t m = (uint8_t)fn(cx * S + x, cy * S + y, cz * S + z, (TerrainMaterial)v);
+            changed = changed || m != v;
+            v = m;
+        }
+        if (!changed) continue;
+        TerrainChunk* chunk = existing ? const_cast<TerrainChunk*>(existing) : createChunk(cx, cy, cz);
+        chunk->pack(scratch.data());
+        any = true;
+    }
+    if (any) finishEdit(x0, y0, z0, x1, y1, z1);
+}
+
+template <typename Fn>
+void Terrain::forEachBox(const Vector3& mn, const Vector3& mx, Fn&& fn) const {
+    if (chunks.empty()) return;
+    const float chunkWorld = kVoxelSize * TerrainChunk::kSize;
+    int lo[3] = { (int)std::floor(mn.x / chunkWorld), (int)std::floor(mn.y / chunkWorld), (int)std::floor(mn.z / chunkWorld) };
+    int hi[3] = { (int)std::floor(mx.x / chunkWorld), (int)std::floor(mx.y / chunkWorld), (int)std::floor(mx.z / chunkWorld) };
+    for (int i = 0; i < 3; ++i) {
+        lo[i] = std::max(lo[i], chunkMin[i]);
+        hi[i] = std::min(hi[i], chunkMax[i]);
+        if (lo[i] > hi[i]) return;
+    }
+    for (int cz = lo[2]; cz <= hi[2]; ++cz)
+    for (int cy = lo[1]; cy <= hi[1]; ++cy)
+    for (int cx = lo[0]; cx <= hi[0]; ++cx) {
+        const TerrainChunk* c = findChunk(cx, cy, cz);
+        if (!c || c->boxes.empty()) continue;
+        if (c->boundsMin.x > mx.x || c->boundsMax.x < mn.x || c->boundsMin.y > mx.y || c->boundsMax.y < mn.y ||
+            c->boundsMin.z > mx.z || c->boundsMax.z < mn.z) continue;
+        for (const TerrainBox& b : c->boxes) {
+            if (b.min.x > mx.x || b.max.x < mn.x || b.min.y > mx.y || b.max.y < mn.y ||
+                b.min.z > mx.z || b.max.z < mn.z) continue;
+            fn(b);
+        }
+    }
+}
+
+#endif // TERRAIN_HPP
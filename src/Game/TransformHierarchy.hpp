@@ -0,0 +1,266 @@
+// src/Game/TransformHierarchy.hpp
+#ifndef TRANSFORMHIERARCHY_HPP
+#define TRANSFORMHIERARCHY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Math/MathUtils.hpp"
+#include "src/Game/GameData.hpp"
+
+// ===================================================================
+// TransformHierarchy: パーツの親子付け（親から見た位置・回転 → ワールド）
+// 子の Transform は毎回 親のワールド × ローカル で上書きされる（物理では動かない）。
+//
+// ノードは幅優先（深さ順）に並べた1本の配列で、親は必ず子より前にある。
+// update() は配列を先頭から1回なめるだけで、
+//   - 根: Transform が前回から動いていれば「変わった」
+//   - 子: 自分のローカルが変わったか、親が今回変わったときだけ計算し直す
+// ので、止まっている部分木は1ノードあたりフラグの確認だけで済む
+// ===================================================================
+class TransformHierarchy {
+public:
+    explicit TransformHierarchy(ComponentStore& store) : store(store) {}
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    // child を parent に繋ぐ（既に繋がっていれば付け替える）。
+    // 自分自身・自分の子孫を親にしようとしたら false
+    bool attach(Cube* child, Cube* parent, const Vector3& localPos, const Vector3& localRot = Vector3(0, 0, 0)) {
+        if (!child || !parent || child == parent) return false;
+        if (!store.alive(child->entity) || !store.alive(parent->entity)) return false;
+
+        // parent から根へたどって child が出てきたら循環
+        for (int32_t p = find(parent->entity); p >= 0; p = nodes[p].parent) {
+            if (nodes[p].entity == child->entity) return false;
+        }
+
+        int32_t parentNode = findOrAdd(parent->entity);
+        int32_t childNode = findOrAdd(child->entity);   // nodes が伸びるので参照は後で取る
+
+        Node& n = nodes[childNode];
+        if (n.parent != parentNode) orderDirty = true;
+        n.parent = parentNode;
+        setLocalRaw(n, localPos, localRot);
+        return true;
+    }
+
+    // 親から外す（ワールドの位置・回転はその時点のまま残る）
+    void detach(Cube* child) {
+        if (!child) return;
+        int32_t i = find(child->entity);
+        if (i < 0 || nodes[i].parent < 0) return;
+        nodes[i].parent = -1;
+        nodes[i].dirty = true;
+        orderDirty = true;
+    }
+
+    // 親から見た位置・回転を変える。繋がっていなければ false
+    bool setLocal(Cube* child, const Vector3& localPos, const Vector3& localRot) {
+        if (!child) return false;
+        int32_t i = find(child->entity);
+        if (i < 0 || nodes[i].parent < 0) return false;
+        setLocalRaw(nodes[i], localPos, localRot);
+        return true;
+    }
+
+    // 親（繋がっていなければ nullptr）
+    Cube* parentOf(const Cube* child) const {
+        if (!child) return nullptr;
+        int32_t i = find(child->entity);
+        if (i < 0 || nodes[i].parent < 0) return nullptr;
+        return store.ownerOf(nodes[nodes[i].parent].entity);
+    }
+
+    bool isAttached(const Cube* child) const { return parentOf(child) != nullptr; }
+
+    // 根を動かしたことを知らせる（知らせなくても update() が位置の変化で気付く。
+    // 回転だけをごく僅かに変えた場合などに確実に反映させたいとき用）
+    void markDirty(Cube* part) {
+        if (!part) return;
+        int32_t i = find(part->entity);
+        if (i >= 0) nodes[i].dirty = true;
+    }
+
+    // 変わった部分木のワールド座標を計算し直す。戻り値: 書き換えた子の数
+    size_t update() {
+        if (cachedLayout != store.layoutVersion()) refreshPointers();   // 破棄されたパーツがあれば orderDirty になる
+        if (orderDirty) rebuild();
+
+        size_t written = 0;
+        for (Node& n : nodes) {
+            if (n.parent < 0) {
+                n.changed = false;
+                const Transform* t = n.transform;
+                if (!t) continue;
+                if (n.dirty || !same(t->pos, n.worldPos) || !same(t->rotation, n.worldRot)) {
+                    if (n.dirty || !same(t->rotation, n.worldRot)) {
+                        n.worldRot = t->rotation;
+                        n.worldR = Matrix3::rotate(n.worldRot);
+                    }
+                    n.worldPos = t->pos;
+                    n.changed = true;
+                }
+                n.dirty = false;
+                continue;
+            }
+
+            const Node& p = nodes[n.parent];   // 幅優先の順なので親は計算済み
+            n.changed = false;
+            if (!n.dirty && !p.changed) continue;
+
+            Transform* t = n.transform;
+            if (!t) continue;
+
+            n.worldPos = p.worldPos + p.worldR * n.localPos;
+            if (n.identityRot) {
+                // 回転なしの子（プレイヤーの手足など）は親の角度をそのまま使う（三角関数を通さない）
+                n.worldR = p.worldR;
+                n.worldRot = p.worldRot;
+            } else {
+                n.worldR = p.worldR * n.localR;
+                n.worldRot = n.worldR.toEuler();
+            }
+            t->pos = n.worldPos;
+            t->rotation = n.worldRot;
+            n.owner->markChanged(Prop_Position | Prop_Rotation);
+
+            n.dirty = false;
+            n.changed = true;
+            written++;
+        }
+        return written;
+    }
+
+    void clear() {
+        nodes.clear();
+        index.clear();
+        orderDirty = false;
+        cachedLayout = UINT64_MAX;
+    }
+
+    size_t nodeCount() const { return nodes.size(); }
+
+private:
+    struct Node {
+        EntityId entity;
+        int32_t parent = -1;        // nodes での親の位置（根は -1）
+        Transform* transform = nullptr;   // store の行の配置が変わるまで有効
+        Cube* owner = nullptr;
+
+        Vector3 localPos = Vector3(0, 0, 0);
+        Matrix3 localR;
+        bool identityRot = true;
+
+        // 前回の update でのワールド（根は動いたかの判定に、子は計算に使う）
+        Vector3 worldPos = Vector3(0, 0, 0);
+        Vector3 worldRot = Vector3(0, 0, 0);
+        Matrix3 worldR;
+
+        bool dirty = true;          // ローカルが変わった・繋ぎ直した
+        bool changed = false;       // 今回の update でワールドが変わった（子が見る）
+    };
+
+    ComponentStore& store;
+    std::vector<Node> nodes;                          // 幅優先の順（rebuild 後）
+    std::unordered_map<uint32_t, int32_t> index;      // EntityId::index -> nodes の位置
+    bool orderDirty = false;
+    uint64_t cachedLayout = UINT64_MAX;               // transform/owner を取った時点の store の版
+
+    static bool same(const Vector3& a, const Vector3& b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    static void setLocalRaw(Node& n, const Vector3& localPos, const Vector3& localRot) {
+        n.localPos = localPos;
+        n.identityRot = localRot.x == 0.0f && localRot.y == 0.0f && localRot.z == 0.0f;
+        n.localR = Matrix3::rotate(localRot);
+        n.dirty = true;
+    }
+
+    int32_t find(EntityId e) const {
+        auto it = index.find(e.index);
+        if (it == index.end() || nodes[it->second].entity != e) return -1;
+        return it->second;
+    }
+
+    int32_t findOrAdd(EntityId e) {
+        int32_t i = find(e);
+        if (i >= 0) return i;
+        i = (int32_t)nodes.size();
+        Node n;
+        n.entity = e;
+        nodes.push_back(n);
+        index[e.index] = i;
+        orderDirty = true;
+        cachedLayout = UINT64_MAX;
+        return i;
+    }
+
+    // 構成要素の行が動いたので、各ノードの Transform・持ち主を取り直す
+    void refreshPointers() {
+        cachedLayout = store.layoutVersion();
+        for (Node& n : nodes) {
+            n.transform = store.get<Transform>(n.entity);
+            n.owner = store.ownerOf(n.entity);
+            if (!n.transform) orderDirty = true;
+        }
+    }
+
+    // 破棄されたパーツ・繋がりのなくなった根を外し、幅優先に並べ直す
+    void rebuild() {
+        orderDirty = false;
+        const size_t count = nodes.size();
+
+        // 破棄されたノードの子は根になる（最後のワールド座標のまま）
+        std::vector<char> alive(count);
+        for (size_t i = 0; i < count; ++i) alive[i] = store.alive(nodes[i].entity);
+        for (Node& n : nodes) {
+            if (n.parent >= 0 && !alive[n.parent]) { n.parent = -1; n.dirty = true; }
+        }
+
+        // 生きている子の一覧（親ごとに連続させる）。破棄された葉はここで落ちる
+        std::vector<uint32_t> childStart(count + 1, 0), children(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (alive[i] && nodes[i].parent >= 0) childStart[nodes[i].parent + 1]++;
+        }
+        for (size_t i = 0; i < count; ++i) childStart[i + 1] += childStart[i];
+        {
+            std::vector<uint32_t> fill(childStart.begin(), childStart.end() - 1);
+            for (size_t i = 0; i < count; ++i) {
+                if (alive[i] && nodes[i].parent >= 0) children[fill[nodes[i].parent]++] = (uint32_t)i;
+            }
+        }
+
+        // 根（生きている子を持つものだけ）から幅優先
+        std::vector<uint32_t> order;
+        order.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (alive[i] && nodes[i].parent < 0 && childStart[i + 1] > childStart[i]) order.push_back((uint32_t)i);
+        }
+        for (size_t head = 0; head < order.size(); ++head) {
+            uint32_t i = order[head];
+            for (uint32_t c = childStart[i]; c < childStart[i + 1]; ++c) order.push_back(children[c]);
+        }
+
+        std::vector<int32_t> remap(count, -1);
+        for (size_t k = 0; k < order.size(); ++k) remap[order[k]] = (int32_t)k;
+
+        std::vector<Node> sorted;
+        sorted.reserve(order.size());
+        index.clear();
+        for (uint32_t i : order) {
+            Node n = nodes[i];
+            if (n.parent >= 0) n.parent = remap[n.parent];
+            else n.dirty = true;   // 並び替え後の最初の update で子まで確実に計算する
+            index[n.entity.index] = (int32_t)sorted.size();
+            sorted.push_back(n);
+        }
+        nodes.swap(sorted);
+    }
+};
+
+#endif // TRANSFORMHIERARCHY_HPP
@@ -5,7 +5,10 @@ Workspace::Workspace()
     : Instance("Workspace", "Workspace"),
       player(nullptr),
       gravity(0, -98.0f, 0) 
-{}
+{
+    // 再帰の FindFirstChild を子孫索引で引けるようにする
+    enableDescendantIndex();
+}
 
 Workspace::~Workspace() {
     if (player) {
@@ -18,18 +21,21 @@ Workspace* global_workspace = nullptr;
 
 void Workspace::initScene(unsigned int skyboxTexID) {
     global_workspace = this;
+    hierarchy.clear();
+    characters.clear();
     cubes.clear();
+    parts.byName.clear();
+    parts.byClass.clear();
 
-    // 【重要修正】メモリ再確保によるポインタ無効化を防ぐため、十分な数を予約する
-    // これをしないと、push_backした瞬間にHumanoidRootPartのポインタがゴミになります
-    cubes.reserve(128); 
-
-    // プレイヤーを作成
+    // プレイヤーを作成（PartPool なのでパーツのポインタは追加しても動かない）
     player = new Player("Player");
-    player->buildBody(cubes, Vector3(0, 10, 0));
+    player->buildBody(cubes, joints, Vector3(0, 10, 0));
+    player->loadAnimations(animation);
+    player->attachController(characters);
+    for (auto& cube : cubes) indexPart(cube);
     
     // Ground
-    cubes.push_back(
+    addPart(
         CubeBuilder()
             .size(512, 5, 512)
             .pos(0, -2.5, 0)
@@ -41,7 +47,7 @@ void Workspace::initScene(unsigned int skyboxTexID) {
     );
     
     // その他のオブジェクト
-    cubes.push_back(
+    addPart(
         CubeBuilder()
             .size(10, 10, 10)
             .pos(5, 10, 20)
@@ -51,7 +57,7 @@ void Workspace::initScene(unsigned int skyboxTexID) {
             .build()
     );
 
-    cubes.push_back(
+    addPart(
         CubeBuilder()
             .size(10, 10, 10)
             .pos(5, 15, 23)
@@ -61,7 +67,7 @@ void Workspace::initScene(unsigned int skyboxTexID) {
             .build()
     );
 
-    cubes.push_back(
+    addPart(
         CubeBuilder()
             .size(5, 5, 5)
             .pos(-10, 10, 0)
@@ -70,7 +76,7 @@ void Workspace::initScene(unsigned int skyboxTexID) {
             .build()
     );
 
-    cubes.push_back(
+    addPart(
         CubeBuilder()
             .size(6, 6, 6)
             .pos(10, 50, 10)
@@ -78,6 +84,75 @@ void Workspace::initScene(unsigned int skyboxTexID) {
             .color(255, 0, 0)
             .build()
     );
+
+    // 地形: 原点から離れた所に丘を1つ（ボクセルは 4 スタッド。底は Ground の上面 y=0）
+    terrain.clear();
+    terrain.edit(16, 0, -64, 63, 11, -17, [](int x, int y, int z, TerrainMaterial) {
+        float dx = (x - 40) / 24.0f, dz = (z + 40) / 24.0f;
+        float hill = 10.0f * std::max(0.0f, 1.0f - (dx * dx + dz * dz));
+        int h = 1 + (int)(hill + 1.5f * std::sin(x * 0.5f) * std::cos(z * 0.4f));
+        if (y >= h) return TerrainMaterial::Air;
+        if (y == h - 1) return h > 9 ? TerrainMaterial::Snow : TerrainMaterial::Grass;
+        return y < h - 3 ? TerrainMaterial::Rock : TerrainMaterial::Ground;
+    });
+    terrain.update();   // 最初のフレームの物理から当たるように
+}
+
+Cube* Workspace::addPart(const PartDesc& desc) {
+    Cube* cube = cubes.create(desc);
+    indexPart(*cube);
+    return cube;
+}
+
+void Workspace::removePart(Cube* part) {
+    if (isPart(part)) part->Destroy();
+}
+
+void Workspace::attachPart(Cube* part) {
+    if (!isPart(part) || part->Parent == this) return;
+    if (part->Parent) part->Parent->removeChild(part);
+    indexPart(*part);
+    part->indexChildSubtrees();
+}
+
+void Workspace::detachPart(Cube* part) {
+    if (!isPart(part) || part->Parent != this) return;
+    part->unindexChildSubtrees();
+    ChildIndex::erase(parts.byName, part->Name, part);
+    ChildIndex::erase(parts.byClass, part->ClassName, part);
+    part->Parent = nullptr;
+}
+
+void Workspace::removeDestroyedChildren(Instance* const* dead, size_t count) {
+    static std::vector<Atom> names, classes;
+    names.clear();
+    classes.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (!isPart(dead[i])) continue;
+        names.push_back(dead[i]->Name);
+        classes.push_back(dead[i]->ClassName);
+    }
+    if (!names.empty()) {
+        ChildIndex::eraseDestroyed(parts.byName, names);
+        ChildIndex::eraseDestroyed(parts.byClass, classes);
+    }
+    Instance::removeDestroyedChildren(dead, count);
+}
+
+void Workspace::indexPart(Cube& cube) {
+    cube.Parent = this;
+    cube.siblingOrder = takeSiblingOrder();
+    ChildIndex::insert(parts.byName, cube.Name, &cube);
+    ChildIndex::insert(parts.byClass, cube.ClassName, &cube);
+}
+
+void Workspace::childRenamed(Instance* child, Atom oldName) {
+    if (isPart(child)) {
+        ChildIndex::erase(parts.byName, oldName, child);
+        ChildIndex::insert(parts.byName, child->Name, child);
+        return;
+    }
+    Instance::childRenamed(child, oldName);
 }
 
 Cube* Workspace::getPlayer() {
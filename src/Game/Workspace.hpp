@@ -7,10 +7,23 @@
 #include "GameData.hpp"
 #include "Instance.hpp"
 #include "Player.hpp"
+#include "PartPool.hpp"
+#include "TransformHierarchy.hpp"
+#include "Joint.hpp"
+#include "Animation.hpp"
+#include "Terrain.hpp"
+#include "src/Physics/SpatialQuery.hpp"
 
 class Workspace : public Instance {
 public:
-    std::vector<Cube> cubes;
+    ComponentStore components;   // パーツのデータ本体（cubes より先に作り、後に壊す）
+    PartPool cubes{components};  // 追加・削除してもポインタは無効にならない
+    TransformHierarchy hierarchy{components};   // パーツの親子付け（プレイヤーの体など）
+    JointSystem joints{components, cubes, hierarchy};   // Weld / Motor6D（hierarchy より後に作り、先に壊す）
+    AnimationSystem animation;   // Animator（Motor6D.Transform を書く）
+    Terrain terrain;             // ボクセルの地形（workspace.Terrain）
+    SpatialQuery spatial{components, &terrain};   // レイ・重なりの問い合わせ（workspace:Raycast など）
+    CharacterSystem characters{components, spatial};   // プレイヤーなどのカプセルの移動
     Player* player;  // プレイヤーオブジェクト
     Vector3 gravity;
 
@@ -20,6 +33,21 @@ public:
     // シーンの初期化
     void initScene(unsigned int skyboxTexID);
 
+    // 実行中のパーツ追加・削除（名前の索引も更新する）
+    // 削除は Destroy() と同じく予約で、実際の解放はフレームの終わり
+    Cube* addPart(const PartDesc& desc);
+    void removePart(Cube* part);
+
+    // 親のないパーツを作る（Instance.new("Part")。物理・描画の対象外）
+    Cube* newPart(const PartDesc& desc) { return cubes.create(desc); }
+
+    // パーツの Parent を workspace / nil にする
+    void attachPart(Cube* part);
+    void detachPart(Cube* part);
+
+    // Lua などが持つハンドルから引く。削除済みなら nullptr
+    Cube* getPart(PartHandle h) const { return cubes.get(h); }
+
     // プレイヤーのルートパーツを取得（後方互換性のため）
     Cube* getPlayer();
     
@@ -28,28 +56,35 @@ public:
         return player;
     }
 
-    // IsA のオーバーライド
-    bool IsA(const std::string& className) const override {
-        return className == "Workspace" || Instance::IsA(className);
-    }
-
     // FindFirstChild のオーバーライド（cubes配列も検索）
     Instance* FindFirstChild(const std::string& name, bool recursive = false) override {
-        // cubes 配列から検索
-        for (auto& cube : cubes) {
-            if (cube.Name == name) {
-                return &cube;
-            }
+        Atom key = Atom::find(name);
+        if (!key.valid()) return nullptr;
+
+        // cubes 配列から検索（名前の索引）
+        if (Instance* found = ChildIndex::first(parts.byName, key)) {
+            return found;
         }
         
         // Player オブジェクトも検索
-        if (player && player->Name == name) {
+        if (player && player->Name == key) {
             return player;
         }
         
         // 通常のChildrenからも検索
-        return Instance::FindFirstChild(name, recursive);
+        return findChild(key, recursive);
     }
+
+protected:
+    void childRenamed(Instance* child, Atom oldName) override;
+    void removeDestroyedChildren(Instance* const* dead, size_t count) override;
+
+private:
+    ChildIndex parts;   // cubes の索引（追加順。siblingOrder は Children と共通の番号）
+
+    // Cube の Parent をこの Workspace にして索引に載せる
+    void indexPart(Cube& cube);
+    bool isPart(const Instance* inst) const { return cubes.contains(inst); }
 };
 
 extern Workspace* global_workspace;
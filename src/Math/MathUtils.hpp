@@ -65,6 +65,31 @@ struct Matrix3 {
         return res;
     }
 
+    // --- 追加: 逆行列 (慣性テンソル用。特異ならゼロ行列) ---
+    Matrix3 inverse() const {
+        float c00 = m[1][1]*m[2][2] - m[1][2]*m[2][1];
+        float c01 = m[1][2]*m[2][0] - m[1][0]*m[2][2];
+        float c02 = m[1][0]*m[2][1] - m[1][1]*m[2][0];
+        float det = m[0][0]*c00 + m[0][1]*c01 + m[0][2]*c02;
+
+        Matrix3 res;
+        if (std::abs(det) < 1e-12f) {
+            res.setZero();
+            return res;
+        }
+        float inv = 1.0f / det;
+        res.m[0][0] = c00 * inv;
+        res.m[0][1] = (m[0][2]*m[2][1] - m[0][1]*m[2][2]) * inv;
+        res.m[0][2] = (m[0][1]*m[1][2] - m[0][2]*m[1][1]) * inv;
+        res.m[1][0] = c01 * inv;
+        res.m[1][1] = (m[0][0]*m[2][2] - m[0][2]*m[2][0]) * inv;
+        res.m[1][2] = (m[0][2]*m[1][0] - m[0][0]*m[1][2]) * inv;
+        res.m[2][0] = c02 * inv;
+        res.m[2][1] = (m[0][1]*m[2][0] - m[0][0]*m[2][1]) * inv;
+        res.m[2][2] = (m[0][0]*m[1][1] - m[0][1]*m[1][0]) * inv;
+        return res;
+    }
+
     // --- 追加: 正規直交化 (回転行列の誤差蓄積を補正) ---
     void orthonormalize() {
         // 列ベクトルとして取り出す
@@ -0,0 +1,88 @@
+// src/Math/Quaternion.hpp
+#ifndef QUATERNION_HPP
+#define QUATERNION_HPP
+
+#include "Vector3.hpp"
+#include "MathUtils.hpp"
+#include <cmath>
+
+// 回転を表す単位クォータニオン (w + xi + yj + zk)
+// アニメーションのキーフレーム補間用。オイラー角の補間と違ってジンバルロックがなく、
+// 重み付きの混ぜ合わせもできる
+struct Quaternion {
+    float w, x, y, z;
+
+    Quaternion() : w(1.0f), x(0.0f), y(0.0f), z(0.0f) {}
+    Quaternion(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {}
+
+    bool isIdentity() const { return w == 1.0f && x == 0.0f && y == 0.0f && z == 0.0f; }
+
+    // 軸 axis（正規化済み）回りに angle ラジアン
+    static Quaternion fromAxisAngle(const Vector3& axis, float angle) {
+        float s = std::sin(angle * 0.5f);
+        return Quaternion(std::cos(angle * 0.5f), axis.x * s, axis.y * s, axis.z * s);
+    }
+
+    // オイラー角（度）から。Matrix3::rotate と同じ Z * Y * X の順
+    static Quaternion fromEuler(const Vector3& rotDeg) {
+        const float k = M_PI / 180.0f;
+        Quaternion qx = fromAxisAngle(Vector3(1, 0, 0), rotDeg.x * k);
+        Quaternion qy = fromAxisAngle(Vector3(0, 1, 0), rotDeg.y * k);
+        Quaternion qz = fromAxisAngle(Vector3(0, 0, 1), rotDeg.z * k);
+        return qz * qy * qx;
+    }
+
+    Quaternion operator*(const Quaternion& o) const {
+        return Quaternion(
+            w*o.w - x*o.x - y*o.y - z*o.z,
+            w*o.x + x*o.w + y*o.z - z*o.y,
+            w*o.y - x*o.z + y*o.w + z*o.x,
+            w*o.z + x*o.y - y*o.x + z*o.w
+        );
+    }
+
+    Quaternion operator*(float s) const { return Quaternion(w*s, x*s, y*s, z*s); }
+    Quaternion operator+(const Quaternion& o) const { return Quaternion(w+o.w, x+o.x, y+o.y, z+o.z); }
+    Quaternion operator-() const { return Quaternion(-w, -x, -y, -z); }
+
+    float dot(const Quaternion& o) const { return w*o.w + x*o.x + y*o.y + z*o.z; }
+
+    // 長さが 0 に近ければ単位クォータニオン
+    Quaternion normalized() const {
+        float len = std::sqrt(dot(*this));
+        if (len < 1e-8f) return Quaternion();
+        return *this * (1.0f / len);
+    }
+
+    Matrix3 toMatrix() const {
+        Matrix3 r;
+        float xx = x*x, yy = y*y, zz = z*z;
+        float xy = x*y, xz = x*z, yz = y*z;
+        float wx = w*x, wy = w*y, wz = w*z;
+        r.m[0][0] = 1 - 2*(yy + zz); r.m[0][1] = 2*(xy - wz);     r.m[0][2] = 2*(xz + wy);
+        r.m[1][0] = 2*(xy + wz);     r.m[1][1] = 1 - 2*(xx + zz); r.m[1][2] = 2*(yz - wx);
+        r.m[2][0] = 2*(xz - wy);     r.m[2][1] = 2*(yz + wx);     r.m[2][2] = 1 - 2*(xx + yy);
+        return r;
+    }
+
+    // 正規化線形補間（短い方の弧を通る）。t の間隔が細かいキーフレーム・混ぜ合わせはこれで十分
+    static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t) {
+        Quaternion to = a.dot(b) < 0.0f ? -b : b;
+        return (a * (1.0f - t) + to * t).normalized();
+    }
+
+    // 球面線形補間（角速度が一定）。角度が小さいときは nlerp に任せる
+    static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t) {
+        float d = a.dot(b);
+        Quaternion to = b;
+        if (d < 0.0f) { d = -d; to = -b; }
+        if (d > 0.9995f) return nlerp(a, to, t);
+        float theta = std::acos(d);
+        float s = std::sin(theta);
+        float wa = std::sin((1.0f - t) * theta) / s;
+        float wb = std::sin(t * theta) / s;
+        return a * wa + to * wb;
+    }
+};
+
+#endif // QUATERNION_HPP
@@ -0,0 +1,262 @@
+// src/Physics/CharacterController.cpp
+#include "CharacterController.hpp"
+#include <algorithm>
+#include <cmath>
+
+#include "src/Game/GameData.hpp"
+#include "src/Game/JobSystem.hpp"
+
+// ====================================================================
+// CharacterController
+// ====================================================================
+
+CharacterController::CharacterController(Cube* root, EntityId entity, const Instance* owner)
+    : root(root), entity(entity)
+{
+    // 幅は古い箱（HumanoidRootPart）の広い方に合わせ、通れる隙間が変わらないようにする
+    const Vector3& size = root->size();
+    radius = 0.5f * std::max(size.x, size.z);
+    height = std::max(size.y, 2.0f * radius);
+    // 根は Workspace 直下に置かれることもあるので、owner とは別に外す
+    params.filter.push_back(root);
+    if (owner && owner != root) params.filter.push_back(owner);
+    params.respectCanCollide = true;
+}
+
+void CharacterController::setMoveDirection(const Vector3& direction) {
+    Vector3 d(direction.x, 0.0f, direction.z);
+    float len = d.length();
+    moveDirection = len > 1.0f ? d / len : d;
+}
+
+bool CharacterController::walkable(const Vector3& normal) const {
+    return normal.y >= std::cos(maxSlopeAngle * M_PI / 180.0f);
+}
+
+bool CharacterController::cast(const SpatialQuery& spatial, const Vector3& from, const Vector3& direction,
+                               QueryHit& hit) const {
+    Vector3 half(0.0f, std::max(0.0f, 0.5f * height - radius), 0.0f);
+    return spatial.castCapsule(from - half, from + half, radius, direction, params, hit);
+}
+
+void CharacterController::load() {
+    position = root->pos();
+    if (const RigidBody* b = root->body()) velocity = b->velocity;
+    pushes.clear();
+}
+
+void CharacterController::move(const SpatialQuery& spatial, const Vector3& gravity, float dt) {
+    // 水平の速さは目標へ寄せていく（60fps で1フレーム 10%）
+    float blend = 1.0f - std::pow(0.9f, dt * 60.0f);
+    Vector3 target = moveDirection * walkSpeed;
+    velocity.x += (target.x - velocity.x) * blend;
+    velocity.z += (target.z - velocity.z) * blend;
+
+    bool grounded = onGround;
+    if (grounded && jumpRequested) {
+        velocity.y = jumpSpeed;
+        grounded = false;
+    }
+    jumpRequested = false;
+    if (grounded) velocity.y = 0.0f;
+    else velocity += gravity * dt;
+
+    onGround = false;
+    ground = nullptr;
+    groundNormal = Vector3(0, 1, 0);
+
+    depenetrate(spatial);
+
+    Vector3 displacement = velocity * dt;
+    if (!grounded) {
+        slide(spatial, displacement, false);
+        return;
+    }
+
+    // 接地中: 段差の分だけ持ち上げて横に動き、下ろして地面を探す
+    Vector3 start = position;
+    float foot = start.y - 0.5f * height;
+    QueryHit hit;
+    float up = stepHeight;
+    if (cast(spatial, position, Vector3(0, stepHeight, 0), hit)) up = std::max(0.0f, hit.distance - kSkin);
+    position.y += up;
+
+    slide(spatial, Vector3(displacement.x, 0.0f, displacement.z), true);
+
+    Vector3 normal;
+    if (cast(spatial, position, Vector3(0, -(up + snapDistance), 0), hit) &&
+        hit.position.y <= foot + stepHeight + kSkin && standable(spatial, hit, normal)) {
+        position.y -= std::max(0.0f, hit.distance - kSkin);
+        touch(spatial, hit);
+        return;
+    }
+
+    // 登れる段差がない（高すぎる・足場がない）: 持ち上げずにやり直す
+    position = start;
+    onGround = false;
+    ground = nullptr;
+    groundNormal = Vector3(0, 1, 0);
+    slide(spatial, Vector3(displacement.x, 0.0f, displacement.z), true);
+    if (cast(spatial, position, Vector3(0, -snapDistance, 0), hit)) {
+        position.y -= std::max(0.0f, hit.distance - kSkin);
+        touch(spatial, hit);
+    }
+}
+
+// 段差の角に丸い底が当たると法線が傾くので、すぐ下を真下に調べて角の上の面で判定する
+bool CharacterController::standable(const SpatialQuery& spatial, const QueryHit& hit, Vector3& normal) const {
+    if (walkable(hit.normal)) {
+        normal = hit.normal;
+        return true;
+    }
+    Vector3 side(hit.normal.x, 0.0f, hit.normal.z);
+    if (hit.normal.y <= 0.0f || side.lengthSquared() < 1e-6f) return false;
+    Vector3 origin = hit.position - side.normalized() * 0.05f + Vector3(0, 0.05f, 0);
+    QueryHit below;
+    if (!spatial.castRay(origin, Vector3(0, -0.1f, 0), params, below) || !walkable(below.normal)) return false;
+    normal = below.normal;
+    return true;
+}
+
+void CharacterController::slide(const SpatialQuery& spatial, Vector3 displacement, bool sideOnly) {
+    for (int iter = 0; iter < 4; ++iter) {
+        float length = displacement.length();
+        if (length < 1e-5f) break;
+
+        QueryHit hit;
+        if (!cast(spatial, position, displacement, hit)) {
+            position += displacement;
+            break;
+        }
+        Vector3 dir = displacement / length;
+        float travel = std::max(0.0f, hit.distance - kSkin);
+        position += dir * travel;
+        touch(spatial, hit);
+
+        // 急な面（段差の角に丸い底が当たったときも）は壁として扱い、沿って上へ逃げない。
+        // 歩いている間は常に、空中では面に沿うと今より上へ向かうときだけ
+        Vector3 n = hit.normal;
+        Vector3 rest = dir * (length - travel);
+        displacement = rest - n * rest.dot(n);
+        if (!walkable(n) && (sideOnly || displacement.y > std::max(rest.y, 0.0f))) {
+            n.y = 0.0f;
+            if (n.lengthSquared() < 1e-6f) break;
+            n = n.normalized();
+            displacement = rest - n * rest.dot(n);
+        }
+        float vn = velocity.dot(n);
+        if (vn < 0.0f) velocity -= n * vn;
+    }
+}
+
+// めり込んだ分を一番深いものから押し出す（動く物体・他のキャラクターに入られたとき）
+void CharacterController::depenetrate(const SpatialQuery& spatial) {
+    Vector3 half(0.0f, std::max(0.0f, 0.5f * height - radius), 0.0f);
+    for (int iter = 0; iter < 4; ++iter) {
+        spatial.capsuleContacts(position - half, position + half, radius, params, contacts);
+        if (contacts.empty()) break;
+        const QueryHit* deepest = &contacts[0];
+        for (const QueryHit& c : contacts) {
+            if (c.distance > deepest->distance) deepest = &c;
+        }
+        position += deepest->normal * (deepest->distance + kSkin);
+        touch(spatial, *deepest);
+        float vn = velocity.dot(deepest->normal);
+        if (vn < 0.0f) velocity -= deepest->normal * vn;
+    }
+}
+
+void CharacterController::touch(const SpatialQuery& spatial, const QueryHit& hit) {
+    Vector3 normal;
+    if (velocity.y <= 0.0f && standable(spatial, hit, normal)) {
+        onGround = true;
+        ground = hit.part;
+        groundNormal = normal;
+    }
+
+    // 歩いてぶつかった動く物体は、向かっていく速さの一部で押す（書くのは apply）
+    const RigidBody* body = hit.part ? hit.part->body() : nullptr;
+    if (!body || body->kinematic || pushStrength <= 0.0f) return;
+    Vector3 into(-hit.normal.x, 0.0f, -hit.normal.z);
+    if (into.lengthSquared() < 1e-6f) return;
+    into = into.normalized();
+    float want = velocity.dot(into);
+    float have = body->velocity.dot(into);
+    if (want > have) pushes.push_back(Push{hit.part, into * ((want - have) * pushStrength)});
+}
+
+void CharacterController::apply() {
+    if (root->pos().x != position.x || root->pos().y != position.y || root->pos().z != position.z) {
+        root->pos() = position;
+        root->markChanged(Prop_Position);
+    }
+    if (RigidBody* b = root->body()) {
+        b->velocity = velocity;
+        root->markChanged(Prop_Velocity);
+    }
+    if (Script* s = root->script()) s->onGround = onGround;
+
+    for (const Push& p : pushes) {
+        RigidBody* b = p.part->body();
+        if (!b || b->kinematic) continue;
+        b->velocity += p.velocity;
+        p.part->wakeUp();
+        p.part->markChanged(Prop_Velocity);
+    }
+}
+
+// ====================================================================
+// CharacterSystem
+// ====================================================================
+
+CharacterController* CharacterSystem::add(Cube* root, const Instance* owner) {
+    if (!root) return nullptr;
+    if (RigidBody* b = root->body()) {
+        b->kinematic = true;
+        b->angularVelocity = Vector3(0, 0, 0);
+        b->isSleeping = false;
+    }
+    controllers.push_back(std::unique_ptr<CharacterController>(
+        new CharacterController(root, root->entity, owner)));
+    return controllers.back().get();
+}
+
+void CharacterSystem::remove(CharacterController* controller) {
+    auto it = std::find_if(controllers.begin(), controllers.end(),
+                           [&](const std::unique_ptr<CharacterController>& c) { return c.get() == controller; });
+    if (it == controllers.end()) return;
+    // 根が残っていれば物理に返す
+    if (store.alive(controller->entity) && store.ownerOf(controller->entity) == controller->root) {
+        if (RigidBody* b = controller->root->body()) b->kinematic = false;
+    }
+    *it = std::move(controllers.back());
+    controllers.pop_back();
+}
+
+void CharacterSystem::step(float dt, const Vector3& gravity) {
+    // 1. メインスレッド: 根が解放・破棄されたものは飛ばす
+    active.clear();
+    for (auto& c : controllers) {
+        if (!store.alive(c->entity) || store.ownerOf(c->entity) != c->root) continue;
+        if (!c->root->isActive()) continue;
+        c->load();
+        active.push_back(c.get());
+    }
+    if (active.empty()) return;
+    spatial.refresh();
+
+    // 2. 並列フェーズ: 1キャラクターは数十マイクロ秒なので、まとめて1ジョブにする
+    const size_t kChunk = 16;
+    size_t jobs = (active.size() + kChunk - 1) / kChunk;
+    if (parallel && jobs > 1) {
+        JobSystem::get().parallelFor(jobs, [&](size_t job) {
+            size_t end = std::min(active.size(), (job + 1) * kChunk);
+            for (size_t i = job * kChunk; i < end; ++i) active[i]->move(spatial, gravity, dt);
+        });
+    } else {
+        for (CharacterController* c : active) c->move(spatial, gravity, dt);
+    }
+
+    // 3. メインスレッド: 根と押した物体に書く
+    for (CharacterController* c : active) c->apply();
+}
@@ -0,0 +1,134 @@
+// src/Physics/CharacterController.hpp
+#ifndef CHARACTERCONTROLLER_HPP
+#define CHARACTERCONTROLLER_HPP
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Game/ComponentStore.hpp"
+#include "src/Physics/SpatialQuery.hpp"
+
+class Instance;
+struct Cube;
+
+// ===================================================================
+// CharacterController: カプセルで歩くキャラクター（Roblox の Humanoid の移動部分）
+//
+// 根のパーツ（プレイヤーの HumanoidRootPart）を剛体の解決の外で動かす。
+// 根の RigidBody は kinematic にして、物理からは動かない障害物に見せる
+// （箱はぶつかって跳ね返るだけで、キャラクターは押されない）。
+// 1ステップの動き:
+//   めり込みの押し出し → 接地中なら 段差の高さだけ持ち上げ → 横に滑らせる → 下ろして地面に吸い付く
+//     （下ろした先が段差より高い・足場がなければ、持ち上げずに横へ滑らせ直す）
+//   空中なら 速度のまま滑らせる（歩ける面に降りたら接地）
+// 衝突は SpatialQuery の木に対するカプセルの掃引で、パーツ同士の総当たりは使わない
+// ===================================================================
+class CharacterController {
+public:
+    float radius;                  // カプセルの半径（根のパーツの幅から）
+    float height;                  // カプセルの全長（根のパーツの高さ。中心は根の中心）
+    float stepHeight = 2.1f;       // これ以下の段差は歩いて登る
+    float maxSlopeAngle = 50.0f;   // 度。これより急な面は地面にならず、壁として扱う
+    float snapDistance = 1.0f;     // 接地中は、この深さまでの下りに吸い付く
+    float walkSpeed = 50.0f;
+    float jumpSpeed = 50.0f;
+    float pushStrength = 0.5f;     // 歩いてぶつかった動く物体に渡す速度の割合
+
+    // 歩く向き（水平。長さ 1 を超えたら縮める）。次の step から効く
+    void setMoveDirection(const Vector3& direction);
+    // 接地していれば次の step で跳ぶ
+    void jump() { jumpRequested = true; }
+
+    bool isOnGround() const { return onGround; }
+    const Vector3& getGroundNormal() const { return groundNormal; }
+    Cube* getGround() const { return ground; }      // 立っているパーツ（空中・地形の上なら nullptr）
+    Cube* getRoot() const { return root; }
+
+private:
+    friend class CharacterSystem;
+
+    CharacterController(Cube* root, EntityId entity, const Instance* owner);
+
+    // 押した動く物体と、足す速度（apply でメインスレッドから書く）
+    struct Push {
+        Cube* part;
+        Vector3 velocity;
+    };
+
+    Cube* root;
+    EntityId entity;          // 根が解放されていないかの確認用
+    QueryParams params;       // 根・owner とその子孫と、CanCollide=false のパーツは無視する
+    Vector3 moveDirection = Vector3(0, 0, 0);
+    bool jumpRequested = false;
+
+    // load で読み、move で進め、apply で書く
+    Vector3 position = Vector3(0, 0, 0);
+    Vector3 velocity = Vector3(0, 0, 0);
+    bool onGround = false;
+    Vector3 groundNormal = Vector3(0, 1, 0);
+    Cube* ground = nullptr;
+    std::vector<Push> pushes;
+    std::vector<QueryHit> contacts;   // めり込みの作業用（容量を使い回す）
+
+    static constexpr float kSkin = 0.02f;   // 面との間に残す隙間（触れたまま始めると掃引で拾えない）
+
+    // メインスレッド: 根の位置・速度を読む
+    void load();
+    // ワーカースレッド: 木を読むだけで、自分の状態にしか書かない
+    void move(const SpatialQuery& spatial, const Vector3& gravity, float dt);
+    // メインスレッド: 根・押した物体に書く
+    void apply();
+
+    bool walkable(const Vector3& normal) const;
+    // from から direction だけ動かしたとき最初に当たるもの
+    bool cast(const SpatialQuery& spatial, const Vector3& from, const Vector3& direction, QueryHit& hit) const;
+    // 当たったら面に沿って向きを変えながら進む（最大4回）。急な面は登らない。sideOnly なら上下にも逸れない
+    void slide(const SpatialQuery& spatial, Vector3 displacement, bool sideOnly);
+    void depenetrate(const SpatialQuery& spatial);
+    // 当たった面の上に立てるか（normal に立つ面の法線を書く）
+    bool standable(const SpatialQuery& spatial, const QueryHit& hit, Vector3& normal) const;
+    // 当たった面: 立てる面なら接地、動く物体なら押す
+    void touch(const SpatialQuery& spatial, const QueryHit& hit);
+};
+
+// ===================================================================
+// CharacterSystem: CharacterController の登録と毎フレームの一括更新
+//   1. メインスレッド: 空間クエリの木を今のパーツに合わせ、根の状態を読む
+//   2. 並列フェーズ: キャラクターごとに移動を計算（木を読むだけ。JobSystem）
+//   3. メインスレッド: 根の位置・速度・接地と、押した物体の速度を書く
+// キャラクター同士は、このステップの始めの位置で互いにぶつかる
+// ===================================================================
+class CharacterSystem {
+public:
+    CharacterSystem(ComponentStore& store, SpatialQuery& spatial) : store(store), spatial(spatial) {}
+
+    CharacterSystem(const CharacterSystem&) = delete;
+    CharacterSystem& operator=(const CharacterSystem&) = delete;
+
+    // root を動かすキャラクターを作る（root の RigidBody は kinematic になる）。
+    // owner とその子孫には当たらない（Player なら体のパーツ全部）
+    CharacterController* add(Cube* root, const Instance* owner);
+    void remove(CharacterController* controller);
+    // 全部消す（シーンを作り直すとき。根は一緒に消える前提なので kinematic は戻さない）
+    void clear() { controllers.clear(); active.clear(); }
+
+    // 毎フレーム呼ぶ
+    void step(float dt, const Vector3& gravity);
+
+    // false なら全てメインスレッドで計算する（比較・デバッグ用）
+    void setParallel(bool p) { parallel = p; }
+    bool isParallel() const { return parallel; }
+
+    size_t controllerCount() const { return controllers.size(); }
+
+private:
+    ComponentStore& store;
+    SpatialQuery& spatial;
+    std::vector<std::unique_ptr<CharacterController>> controllers;
+    std::vector<CharacterController*> active;   // 根が生きているもの（容量を使い回す）
+    bool parallel = true;
+};
+
+#endif // CHARACTERCONTROLLER_HPP
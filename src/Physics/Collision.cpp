@@ -0,0 +1,719 @@
+// src/Physics/Collision.cpp
+#include "Collision.hpp"
+#include <algorithm>
+#include <cmath>
+
+#include "src/Physics/OrientedBox.hpp"
+#include "src/Game/Mesh.hpp"
+
+// 面の中心は相手の箱の範囲に収める（地面のような大きな面だと、中心が接触から遠く離れ
+// 腕の長さが狂う。溶接したアセンブリは根の重心まわりに回るので特に効く）
+static Vector3 clampInto(const Transform& c, const Vector3& p) {
+    Matrix3 R = Matrix3::rotate(c.rotation);
+    Vector3 local = R.transpose() * (p - c.pos);
+    Vector3 half = c.size * 0.5f;
+    local.x = std::max(-half.x, std::min(half.x, local.x));
+    local.y = std::max(-half.y, std::min(half.y, local.y));
+    local.z = std::max(-half.z, std::min(half.z, local.z));
+    return c.pos + R * local;
+}
+
+static float ballRadius(const Transform& t) {
+    return 0.5f * std::min(t.size.x, std::min(t.size.y, t.size.z));
+}
+
+// ====================================================================
+// 箱 - 箱（分離軸定理）
+// ====================================================================
+
+static void getOBBVertices(const Transform& t, Vector3 (&vertices)[8]) {
+    Vector3 half = t.size * 0.5f;
+    Matrix3 R = Matrix3::rotate(t.rotation);
+    Vector3 localVerts[8] = {
+        Vector3(-half.x, -half.y, -half.z), Vector3( half.x, -half.y, -half.z),
+        Vector3( half.x,  half.y, -half.z), Vector3(-half.x,  half.y, -half.z),
+        Vector3(-half.x, -half.y,  half.z), Vector3( half.x, -half.y,  half.z),
+        Vector3( half.x,  half.y,  half.z), Vector3(-half.x,  half.y,  half.z)
+    };
+    for(int i = 0; i < 8; i++) vertices[i] = t.pos + R * localVerts[i];
+}
+
+static void getOBBAxes(const Transform& t, Vector3 axes[3]) {
+    Matrix3 R = Matrix3::rotate(t.rotation);
+    axes[0] = R * Vector3(1, 0, 0);
+    axes[1] = R * Vector3(0, 1, 0);
+    axes[2] = R * Vector3(0, 0, 1);
+}
+
+static void projectVertices(const Vector3* vertices, int count, const Vector3& axis, float& min, float& max) {
+    min = max = vertices[0].dot(axis);
+    for(int i = 1; i < count; i++) {
+        float proj = vertices[i].dot(axis);
+        if(proj < min) min = proj;
+        if(proj > max) max = proj;
+    }
+}
+
+static bool testSeparatingAxis(const Vector3 (&vertsA)[8], const Vector3 (&vertsB)[8],
+                               const Vector3& axis, float& outPenetration) {
+    float minA, maxA, minB, maxB;
+    projectVertices(vertsA, 8, axis, minA, maxA);
+    projectVertices(vertsB, 8, axis, minB, maxB);
+    if(maxA < minB || maxB < minA) return false;
+    float overlap = std::min(maxA - minB, maxB - minA);
+    outPenetration = overlap;
+    return true;
+}
+
+// 頂点のうち n の向きに一番出ているもの（と、ほぼ同じ高さのもの）の平均。
+// used があれば平均した頂点の数を書く（1 なら角、2 なら辺、3 以上なら面）
+static const float kSupportThreshold = 0.15f;
+
+static Vector3 averageSupport(const Vector3* verts, int count, const Vector3& n, int* used = nullptr) {
+    float maxDist = -1e20f;
+    for(int i = 0; i < count; i++) {
+        float d = verts[i].dot(n);
+        if(d > maxDist) maxDist = d;
+    }
+    const float threshold = kSupportThreshold;
+    Vector3 sum(0,0,0);
+    int found = 0;
+    for(int i = 0; i < count; i++) {
+        if(verts[i].dot(n) >= maxDist - threshold) {
+            sum += verts[i]; found++;
+        }
+    }
+    if (used) *used = found;
+    return (found > 0) ? (sum / (float)found) : verts[0];
+}
+
+bool collideBoxes(const Transform& a, const Transform& b, Contact& outContact) {
+    Vector3 vertsA[8], vertsB[8];
+    getOBBVertices(a, vertsA);
+    getOBBVertices(b, vertsB);
+    Vector3 axesA[3], axesB[3];
+    getOBBAxes(a, axesA);
+    getOBBAxes(b, axesB);
+
+    float minPen = 1e10f;
+    Vector3 bestAxis;
+    bool found = false;
+
+    Vector3 axes[15];
+    int axisCount = 0;
+    for(int i=0; i<3; i++) axes[axisCount++] = axesA[i];
+    for(int i=0; i<3; i++) axes[axisCount++] = axesB[i];
+
+    const float crossThreshold = 1e-4f;
+    for(int i=0; i<3; i++) {
+        for(int j=0; j<3; j++) {
+            Vector3 cross = axesA[i].cross(axesB[j]);
+            if(cross.lengthSquared() > crossThreshold) {
+                axes[axisCount++] = cross.normalized();
+            }
+        }
+    }
+
+    for(int i=0; i<axisCount; i++) {
+        float pen;
+        if(!testSeparatingAxis(vertsA, vertsB, axes[i], pen)) return false;
+        if (i >= 6) pen *= 1.05f; // バイアス
+
+        if(pen < minPen) {
+            minPen = pen;
+            bestAxis = axes[i];
+            found = true;
+        }
+    }
+
+    if (!found) return false;
+
+    Vector3 dir = b.pos - a.pos;
+    if(bestAxis.dot(dir) < 0) bestAxis = bestAxis * -1.0f;
+
+    outContact.normal = bestAxis;
+    outContact.penetration = minPen;
+    Vector3 pA = clampInto(b, averageSupport(vertsA, 8, bestAxis));
+    Vector3 pB = clampInto(a, averageSupport(vertsB, 8, bestAxis * -1.0f));
+    outContact.point = (pA + pB) * 0.5f;
+
+    return true;
+}
+
+// ====================================================================
+// 球（閉じた式）
+// ====================================================================
+
+bool collideSpheres(const Transform& a, const Transform& b, Contact& out) {
+    float ra = ballRadius(a), rb = ballRadius(b);
+    float r = ra + rb;
+    Vector3 d = b.pos - a.pos;
+    float dist2 = d.lengthSquared();
+    if (dist2 >= r * r) return false;
+
+    float dist = std::sqrt(dist2);
+    out.normal = dist > 1e-6f ? d / dist : Vector3(0, 1, 0);
+    out.penetration = r - dist;
+    out.point = a.pos + out.normal * (ra - 0.5f * out.penetration);
+    return true;
+}
+
+// 形のローカル座標（中心が原点、半分の大きさ h）で p に一番近い形の上の点を q に書く。
+// p が形の中にあれば true を返し、一番近い面の外向きの法線とそこまでの深さを書く
+static bool closestLocal(PartShape shape, const float h[3], const Vector3& p,
+                         Vector3& q, Vector3& normal, float& depth) {
+    Vector3 c(std::max(-h[0], std::min(h[0], p.x)),
+              std::max(-h[1], std::min(h[1], p.y)),
+              std::max(-h[2], std::min(h[2], p.z)));
+
+    if (shape == PartShape::Cylinder) {
+        // ローカルの X 軸向き。半径は Y・Z の短い方
+        float r = std::min(h[1], h[2]);
+        float rl = std::sqrt(p.y * p.y + p.z * p.z);
+        if (std::abs(p.x) > h[0] || rl > r) {
+            float k = rl > r ? r / rl : 1.0f;
+            q = Vector3(c.x, p.y * k, p.z * k);
+            return false;
+        }
+        float capDepth = h[0] - std::abs(p.x);
+        float sideDepth = r - rl;
+        if (capDepth < sideDepth) {
+            normal = Vector3(p.x >= 0.0f ? 1.0f : -1.0f, 0, 0);
+            depth = capDepth;
+        } else {
+            normal = rl > 1e-6f ? Vector3(0, p.y / rl, p.z / rl) : Vector3(0, 1, 0);
+            depth = sideDepth;
+        }
+        q = p + normal * depth;
+        return true;
+    }
+
+    bool insideBox = c.x == p.x && c.y == p.y && c.z == p.z;
+
+    if (shape == PartShape::Wedge) {
+        // 斜面 y*hz - z*hy = 0 の上（正の側）は外
+        float L = std::sqrt(h[1] * h[1] + h[2] * h[2]);
+        if (L > 1e-6f && c.y * h[2] - c.z * h[1] > 0.0f) {
+            // 箱に寄せた点が斜面の外: 一番近い点は斜面の長方形の上にある
+            Vector3 s(0, h[1] / L, h[2] / L);
+            float v = std::max(-L, std::min(L, p.y * s.y + p.z * s.z));
+            q = Vector3(c.x, s.y * v, s.z * v);
+            return false;
+        }
+        if (!insideBox) {
+            q = c;
+            return false;
+        }
+        // 中: 左右・底・後ろ・斜面のうち一番浅い面
+        normal = Vector3(p.x >= 0.0f ? 1.0f : -1.0f, 0, 0);
+        depth = h[0] - std::abs(p.x);
+        if (p.y + h[1] < depth) { depth = p.y + h[1]; normal = Vector3(0, -1, 0); }
+        if (h[2] - p.z < depth) { depth = h[2] - p.z; normal = Vector3(0, 0, 1); }
+        if (L > 1e-6f) {
+            float slopeDepth = -(p.y * h[2] - p.z * h[1]) / L;
+            if (slopeDepth < depth) { depth = slopeDepth; normal = Vector3(0, h[2] / L, -h[1] / L); }
+        }
+        q = p + normal * depth;
+        return true;
+    }
+
+    // 箱
+    if (!insideBox) {
+        q = c;
+        return false;
+    }
+    depth = 1e30f;
+    const float coord[3] = { p.x, p.y, p.z };
+    for (int i = 0; i < 3; ++i) {
+        float d = h[i] - std::abs(coord[i]);
+        if (d < depth) {
+            depth = d;
+            normal = Vector3(0, 0, 0);
+            float sign = coord[i] >= 0.0f ? 1.0f : -1.0f;
+            if (i == 0) normal.x = sign;
+            else if (i == 1) normal.y = sign;
+            else normal.z = sign;
+        }
+    }
+    q = p + normal * depth;
+    return true;
+}
+
+bool collideSphereShape(const Transform& sphere, const Transform& b, Contact& out) {
+    float r = ballRadius(sphere);
+    OrientedBox box = makeBox(b.pos, b.rotation, b.size);
+    Vector3 d = sphere.pos - box.c;
+    Vector3 p(d.dot(box.axis[0]), d.dot(box.axis[1]), d.dot(box.axis[2]));
+    if (std::abs(p.x) > box.h[0] + r || std::abs(p.y) > box.h[1] + r || std::abs(p.z) > box.h[2] + r) return false;
+
+    auto toWorld = [&](const Vector3& v) { return box.axis[0] * v.x + box.axis[1] * v.y + box.axis[2] * v.z; };
+
+    Vector3 q, n;
+    float depth;
+    if (closestLocal(b.shape, box.h, p, q, n, depth)) {
+        // 中心が相手の中: 一番浅い面から押し出す
+        out.normal = toWorld(n) * -1.0f;
+        out.penetration = r + depth;
+    } else {
+        Vector3 diff = p - q;
+        float dist2 = diff.lengthSquared();
+        if (dist2 >= r * r) return false;
+        float dist = std::sqrt(dist2);
+        n = dist > 1e-6f ? diff / dist : Vector3(0, 1, 0);
+        out.normal = toWorld(n) * -1.0f;
+        out.penetration = r - dist;
+    }
+    out.point = box.c + toWorld(q);
+    return true;
+}
+
+bool collideShapeSphere(const Transform& a, const Transform& sphere, Contact& out) {
+    if (!collideSphereShape(sphere, a, out)) return false;
+    out.normal = out.normal * -1.0f;
+    return true;
+}
+
+// ====================================================================
+// 円柱・くさびを含む組（支持関数の分離軸判定）
+// ====================================================================
+
+namespace {
+
+// 凸包（動く MeshPart）のワールド座標の頂点・面・辺の置き場。
+// 判定のたびに大きな配列を作らないよう、組の片側ごとに1つをスレッドごとに使い回す
+struct HullScratch {
+    Vector3 verts[MeshAsset::kMaxHullVerts];
+    Vector3 faces[MeshAsset::kMaxHullFaces];
+    Vector3 edges[MeshAsset::kMaxHullEdges];
+};
+
+HullScratch& hullScratch(int side) {
+    static thread_local HullScratch scratch[2];
+    return scratch[side];
+}
+
+// 分離軸判定で使う形（ワールド座標）
+struct Solid {
+    PartShape shape;
+    OrientedBox box;
+    float radius;            // 球・円柱の半径
+    const Vector3* verts;    // 箱・くさび・凸包・三角形の頂点
+    int vertCount;
+    const Vector3* faces;    // 面の向き（裏向きの面は同じ軸なので数えない）
+    int faceCount;
+    const Vector3* edges;    // 辺の向き
+    int edgeCount;
+    Vector3 ownVerts[8];     // 凸包以外はここに書く
+    Vector3 ownFaces[4];
+    Vector3 ownEdges[4];
+};
+
+// side は凸包の置き場（組の A なら 0、B なら 1）
+void makeSolid(const Transform& t, Solid& s, int side) {
+    s.shape = t.shape;
+    s.box = makeBox(t.pos, t.rotation, t.size);
+    const OrientedBox& b = s.box;
+    s.vertCount = s.faceCount = s.edgeCount = 0;
+    Vector3* verts = s.ownVerts;
+    Vector3* faces = s.ownFaces;
+    Vector3* edges = s.ownEdges;
+    auto corner = [&](float x, float y, float z) {
+        return b.c + b.axis[0] * (x * b.h[0]) + b.axis[1] * (y * b.h[1]) + b.axis[2] * (z * b.h[2]);
+    };
+
+    switch (t.shape) {
+        case PartShape::Ball:
+            s.radius = std::min(b.h[0], std::min(b.h[1], b.h[2]));
+            break;
+        case PartShape::Cylinder:
+            s.radius = std::min(b.h[1], b.h[2]);
+            faces[s.faceCount++] = b.axis[0];
+            edges[s.edgeCount++] = b.axis[0];
+            break;
+        case PartShape::Wedge: {
+            s.radius = 0.0f;
+            for (float x : {-1.0f, 1.0f}) {
+                verts[s.vertCount++] = corner(x, -1, -1);
+                verts[s.vertCount++] = corner(x, -1, 1);
+                verts[s.vertCount++] = corner(x, 1, 1);
+            }
+            float L = std::sqrt(b.h[1] * b.h[1] + b.h[2] * b.h[2]);
+            Vector3 slopeNormal = b.axis[1] * b.h[2] - b.axis[2] * b.h[1];
+            Vector3 slopeDir = b.axis[1] * b.h[1] + b.axis[2] * b.h[2];
+            for (int i = 0; i < 3; ++i) {
+                faces[s.faceCount++] = b.axis[i];
+                edges[s.edgeCount++] = b.axis[i];
+            }
+            if (L > 1e-6f) {
+                faces[s.faceCount++] = slopeNormal / L;
+                edges[s.edgeCount++] = slopeDir / L;
+            }
+            break;
+        }
+        case PartShape::Mesh: {
+            // 凸包の箱の座標（-0.5..0.5）を引き伸ばす。面の向きは引き伸ばしの逆で移す
+            const MeshAsset& mesh = MeshLibrary::get().asset(t.mesh);
+            HullScratch& hull = hullScratch(side);
+            verts = hull.verts;
+            faces = hull.faces;
+            edges = hull.edges;
+            s.radius = 0.0f;
+            float inv[3];
+            for (int i = 0; i < 3; ++i) inv[i] = 1.0f / std::max(b.h[i], 1e-6f);
+            for (const Vector3& v : mesh.hull) verts[s.vertCount++] = corner(2.0f * v.x, 2.0f * v.y, 2.0f * v.z);
+            for (const Vector3& n : mesh.hullFaces) {
+                faces[s.faceCount++] = (b.axis[0] * (n.x * inv[0]) + b.axis[1] * (n.y * inv[1]) + b.axis[2] * (n.z * inv[2])).normalized();
+            }
+            for (const Vector3& e : mesh.hullEdges) {
+                edges[s.edgeCount++] = (b.axis[0] * (e.x * b.h[0]) + b.axis[1] * (e.y * b.h[1]) + b.axis[2] * (e.z * b.h[2])).normalized();
+            }
+            break;
+        }
+        default:
+            s.radius = 0.0f;
+            for (float x : {-1.0f, 1.0f})
+                for (float y : {-1.0f, 1.0f})
+                    for (float z : {-1.0f, 1.0f}) verts[s.vertCount++] = corner(x, y, z);
+            for (int i = 0; i < 3; ++i) {
+                faces[s.faceCount++] = b.axis[i];
+                edges[s.edgeCount++] = b.axis[i];
+            }
+            break;
+    }
+    s.verts = verts;
+    s.faces = faces;
+    s.edges = edges;
+}
+
+// 固定の MeshPart の三角形 [p0, p1, p2]。箱はメッシュの向きで三角形を囲むもの（接触点を寄せる先）
+void makeTriangle(const Vector3& p0, const Vector3& p1, const Vector3& p2, const OrientedBox& mesh, Solid& s) {
+    s.shape = PartShape::Mesh;
+    s.radius = 0.0f;
+    s.ownVerts[0] = p0;
+    s.ownVerts[1] = p1;
+    s.ownVerts[2] = p2;
+    s.vertCount = 3;
+    s.ownFaces[0] = (p1 - p0).cross(p2 - p0).normalized();
+    s.faceCount = s.ownFaces[0].lengthSquared() > 0.0f ? 1 : 0;
+    s.ownEdges[0] = (p1 - p0).normalized();
+    s.ownEdges[1] = (p2 - p1).normalized();
+    s.ownEdges[2] = (p0 - p2).normalized();
+    s.edgeCount = 3;
+    s.verts = s.ownVerts;
+    s.faces = s.ownFaces;
+    s.edges = s.ownEdges;
+
+    s.box.c = (p0 + p1 + p2) / 3.0f;
+    for (int i = 0; i < 3; ++i) {
+        s.box.axis[i] = mesh.axis[i];
+        float d0 = (p0 - s.box.c).dot(mesh.axis[i]), d1 = (p1 - s.box.c).dot(mesh.axis[i]), d2 = (p2 - s.box.c).dot(mesh.axis[i]);
+        s.box.h[i] = std::max(std::abs(d0), std::max(std::abs(d1), std::abs(d2)));
+    }
+}
+
+// 方向 n（長さ 1）に投影した範囲
+void project(const Solid& s, const Vector3& n, float& lo, float& hi) {
+    if (s.shape == PartShape::Wedge || s.shape == PartShape::Mesh) {
+        projectVertices(s.verts, s.vertCount, n, lo, hi);
+        return;
+    }
+    float ext;
+    if (s.shape == PartShape::Cylinder) {
+        float an = std::abs(s.box.axis[0].dot(n));
+        ext = s.box.h[0] * an + s.radius * std::sqrt(std::max(0.0f, 1.0f - an * an));
+    } else if (s.shape == PartShape::Ball) {
+        ext = s.radius;
+    } else {
+        ext = projectedRadius(s.box, n);
+    }
+    float c = s.box.c.dot(n);
+    lo = c - ext;
+    hi = c + ext;
+}
+
+// n の向きに一番出ている部分の中心（面なら面の中心、辺なら辺の中点）。
+// used に部分の大きさを書く（averageSupport と同じく 1: 点、2: 線、3 以上: 面）
+Vector3 supportCentroid(const Solid& s, const Vector3& n, int& used) {
+    if (s.shape == PartShape::Ball) {
+        used = 1;
+        return s.box.c + n * s.radius;
+    }
+    if (s.shape == PartShape::Cylinder) {
+        // 端の面・側面の線は、両端の高さの差が箱の頂点と同じしきい値以内なら面・線とみなす
+        const Vector3& a = s.box.axis[0];
+        float an = a.dot(n);
+        float side = std::sqrt(std::max(0.0f, 1.0f - an * an));
+        bool cap = 2.0f * s.radius * side <= kSupportThreshold;
+        bool line = 2.0f * s.box.h[0] * std::abs(an) <= kSupportThreshold;
+        Vector3 p = s.box.c;
+        if (!line) p += a * (an > 0.0f ? s.box.h[0] : -s.box.h[0]);   // 端の面の側
+        if (!cap) p += (n - a * an).normalized() * s.radius;            // 縁・側面の線
+        used = cap ? 3 : (line ? 2 : 1);
+        return p;
+    }
+    return averageSupport(s.verts, s.vertCount, n, &used);
+}
+
+// 線分 [p1, q1] と [p2, q2] の一番近い点の組
+void closestOnSegments(const Vector3& p1, const Vector3& q1, const Vector3& p2, const Vector3& q2,
+                       Vector3& c1, Vector3& c2) {
+    Vector3 d1 = q1 - p1, d2 = q2 - p2, r = p1 - p2;
+    float a = d1.dot(d1), e = d2.dot(d2), f = d2.dot(r);
+    float s = 0.0f, t = 0.0f;
+    if (a > 1e-9f && e > 1e-9f) {
+        float b = d1.dot(d2), c = d1.dot(r);
+        float denom = a * e - b * b;
+        if (denom > 1e-9f) s = std::max(0.0f, std::min(1.0f, (b * f - c * e) / denom));
+        t = (b * s + f) / e;
+        if (t < 0.0f) { t = 0.0f; s = std::max(0.0f, std::min(1.0f, -c / a)); }
+        else if (t > 1.0f) { t = 1.0f; s = std::max(0.0f, std::min(1.0f, (b - c) / a)); }
+    } else if (e > 1e-9f) {
+        t = std::max(0.0f, std::min(1.0f, f / e));
+    } else if (a > 1e-9f) {
+        s = std::max(0.0f, std::min(1.0f, -d1.dot(r) / a));
+    }
+    c1 = p1 + d1 * s;
+    c2 = p2 + d2 * t;
+}
+
+// 候補の軸を足した順に調べ、一番浅い重なりの軸を残す。分かれている軸があれば separated
+// （それ以降の軸は調べない）
+struct AxisTest {
+    const Solid& a;
+    const Solid& b;
+    int count = 0;
+    bool separated = false;
+    float bestScore = 1e10f;
+    float bestPen = 0.0f;
+    Vector3 bestAxis;
+
+    AxisTest(const Solid& a, const Solid& b) : a(a), b(b) {}
+
+    void add(const Vector3& v, bool isEdge) {
+        if (separated) return;
+        float len = v.length();
+        if (len <= 1e-5f) return;
+        Vector3 axis = v / len;
+        count++;
+
+        float loA, hiA, loB, hiB;
+        project(a, axis, loA, hiA);
+        project(b, axis, loB, hiB);
+        if (hiA < loB || hiB < loA) {
+            separated = true;
+            return;
+        }
+        // B が軸の正の側にあるとした重なりと、負の側にあるとした重なりの浅い方
+        float forward = hiA - loB;
+        float backward = hiB - loA;
+        float pen = std::min(forward, backward);
+        float score = isEdge ? pen * 1.05f : pen;   // 辺同士の外積は少し選ばれにくくする（バイアス）
+        if (score < bestScore) {
+            bestScore = score;
+            bestPen = pen;
+            bestAxis = forward <= backward ? axis : axis * -1.0f;
+        }
+    }
+};
+
+// 円柱の曲面の候補: 軸に垂直で、相手の中心・頂点（円柱なら軸の一番近い点）へ向かう向き
+void addRadialAxes(const Solid& s, const Solid& other, AxisTest& axes) {
+    if (s.shape != PartShape::Cylinder) return;
+    const Vector3& a = s.box.axis[0];
+    auto radial = [&](const Vector3& p) {
+        Vector3 d = p - s.box.c;
+        axes.add(d - a * d.dot(a), false);
+    };
+    radial(other.box.c);
+    for (int i = 0; i < other.vertCount; ++i) radial(other.verts[i]);
+    if (other.shape == PartShape::Cylinder) {
+        const Vector3& b = other.box.axis[0];
+        Vector3 c1, c2;
+        closestOnSegments(s.box.c - a * s.box.h[0], s.box.c + a * s.box.h[0],
+                          other.box.c - b * other.box.h[0], other.box.c + b * other.box.h[0], c1, c2);
+        axes.add(c2 - c1, false);
+    }
+}
+
+// 面の中心は相手の箱の範囲に収める（clampInto と同じ）
+Vector3 clampIntoBox(const OrientedBox& b, const Vector3& p) {
+    Vector3 d = p - b.c;
+    float x = std::max(-b.h[0], std::min(b.h[0], d.dot(b.axis[0])));
+    float y = std::max(-b.h[1], std::min(b.h[1], d.dot(b.axis[1])));
+    float z = std::max(-b.h[2], std::min(b.h[2], d.dot(b.axis[2])));
+    return b.c + (b.axis[0] * x + b.axis[1] * y + b.axis[2] * z);
+}
+
+bool collideSolids(const Solid& a, const Solid& b, Contact& out) {
+    AxisTest axes(a, b);
+    for (int i = 0; i < a.faceCount; ++i) axes.add(a.faces[i], false);
+    for (int i = 0; i < b.faceCount; ++i) axes.add(b.faces[i], false);
+    for (int i = 0; i < a.edgeCount; ++i) {
+        for (int j = 0; j < b.edgeCount; ++j) axes.add(a.edges[i].cross(b.edges[j]), true);
+    }
+    addRadialAxes(a, b, axes);
+    addRadialAxes(b, a, axes);
+    if (a.shape == PartShape::Ball || b.shape == PartShape::Ball) {
+        axes.add(b.box.c - a.box.c, false);
+        // 球と凸包: 中心から凸包の頂点へ向かう向きも候補にする（角・辺に当たる所の近似）
+        const Solid& ball = a.shape == PartShape::Ball ? a : b;
+        const Solid& other = a.shape == PartShape::Ball ? b : a;
+        if (other.shape == PartShape::Mesh) {
+            for (int i = 0; i < other.vertCount; ++i) axes.add(other.verts[i] - ball.box.c, false);
+        }
+    }
+    if (axes.separated || axes.count == 0) return false;
+
+    out.normal = axes.bestAxis;
+    out.penetration = axes.bestPen;
+    // 大きさの違う部分同士（円柱の縁と箱の面など）は、小さい方が当たっている所
+    int usedA, usedB;
+    Vector3 pA = clampIntoBox(b.box, supportCentroid(a, axes.bestAxis, usedA));
+    Vector3 pB = clampIntoBox(a.box, supportCentroid(b, axes.bestAxis * -1.0f, usedB));
+    if (usedA < usedB) out.point = pA;
+    else if (usedB < usedA) out.point = pB;
+    else out.point = (pA + pB) * 0.5f;
+    return true;
+}
+
+// 三角形 [a, b, c] の上で p に一番近い点
+Vector3 closestOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) {
+    Vector3 ab = b - a, ac = c - a, ap = p - a;
+    float d1 = ab.dot(ap), d2 = ac.dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+    Vector3 bp = p - b;
+    float d3 = ab.dot(bp), d4 = ac.dot(bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+    Vector3 cp = p - c;
+    float d5 = ab.dot(cp), d6 = ac.dot(cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+} // namespace
+
+bool collideConvex(const Transform& ta, const Transform& tb, Contact& out) {
+    Solid a, b;
+    makeSolid(ta, a, 0);
+    makeSolid(tb, b, 1);
+    return collideSolids(a, b, out);
+}
+
+int collideMesh(const Transform& mesh, const Transform& other, Contact* out, int maxContacts) {
+    const MeshAsset& asset = MeshLibrary::get().asset(mesh.mesh);
+    OrientedBox mb = makeBox(mesh.pos, mesh.rotation, mesh.size);
+    Solid b;
+    makeSolid(other, b, 1);
+    const bool ball = other.shape == PartShape::Ball;
+
+    // 相手の箱をメッシュの箱の座標（-0.5..0.5）の AABB にして三角形を絞る
+    Vector3 d = b.box.c - mb.c;
+    float center[3], reach[3];
+    for (int i = 0; i < 3; ++i) {
+        float scale = 1.0f / std::max(2.0f * mb.h[i], 1e-6f);
+        float r = 0.0f;
+        for (int j = 0; j < 3; ++j) r += std::abs(b.box.axis[j].dot(mb.axis[i])) * b.box.h[j];
+        center[i] = d.dot(mb.axis[i]) * scale;
+        reach[i] = (r + 0.01f) * scale;
+    }
+    Vector3 mn(center[0] - reach[0], center[1] - reach[1], center[2] - reach[2]);
+    Vector3 mx(center[0] + reach[0], center[1] + reach[1], center[2] + reach[2]);
+
+    // 向きの近い接触（三角形の継ぎ目をまたぐ面など）は1つにまとめる: 深さは一番深いもの、点は深さの重みの平均
+    int count = 0;
+    float weight[8] = {};
+    maxContacts = std::min(maxContacts, 8);
+    auto toWorld = [&](const Vector3& v) {
+        return mb.c + mb.axis[0] * (2.0f * v.x * mb.h[0]) + mb.axis[1] * (2.0f * v.y * mb.h[1]) + mb.axis[2] * (2.0f * v.z * mb.h[2]);
+    };
+    asset.forEachTriangle(mn, mx, [&](uint32_t tri) {
+        Vector3 p0 = toWorld(asset.corner(tri, 0)), p1 = toWorld(asset.corner(tri, 1)), p2 = toWorld(asset.corner(tri, 2));
+        Contact c;
+        if (ball) {
+            // 球は閉じた式（三角形の上の一番近い点）
+            Vector3 q = closestOnTriangle(b.box.c, p0, p1, p2);
+            Vector3 diff = b.box.c - q;
+            float dist2 = diff.lengthSquared();
+            if (dist2 >= b.radius * b.radius) return;
+            float dist = std::sqrt(dist2);
+            Vector3 n = (p1 - p0).cross(p2 - p0).normalized();
+            if (dist > 1e-6f) n = diff / dist;
+            else if (n.dot(diff) < 0.0f) n = n * -1.0f;
+            c.normal = n;
+            c.penetration = b.radius - dist;
+            c.point = q;
+        } else {
+            Solid t;
+            makeTriangle(p0, p1, p2, mb, t);
+            if (!collideSolids(t, b, c)) return;
+        }
+        if (c.penetration <= 0.0f) return;
+
+        for (int i = 0; i < count; ++i) {
+            if (out[i].normal.dot(c.normal) > 0.95f) {
+                float w = weight[i] + c.penetration;
+                out[i].point = (out[i].point * weight[i] + c.point * c.penetration) / w;
+                weight[i] = w;
+                if (c.penetration > out[i].penetration) {
+                    out[i].penetration = c.penetration;
+                    out[i].normal = c.normal;
+                }
+                return;
+            }
+        }
+        if (count < maxContacts) {
+            out[count] = c;
+            weight[count] = c.penetration;
+            count++;
+            return;
+        }
+        // 一杯なら一番浅いものと入れ替える
+        int shallow = 0;
+        for (int i = 1; i < count; ++i) {
+            if (out[i].penetration < out[shallow].penetration) shallow = i;
+        }
+        if (c.penetration > out[shallow].penetration) {
+            out[shallow] = c;
+            weight[shallow] = c.penetration;
+        }
+    });
+    return count;
+}
+
+// ====================================================================
+// 形の組の表
+// ====================================================================
+
+typedef bool (*CollideFn)(const Transform&, const Transform&, Contact&);
+
+static const CollideFn kCollide[kPartShapeCount][kPartShapeCount] = {
+    //               Block               Ball                Cylinder            Wedge               Mesh
+    /* Block    */ { collideBoxes,       collideShapeSphere, collideConvex,      collideConvex,      collideConvex },
+    /* Ball     */ { collideSphereShape, collideSpheres,     collideSphereShape, collideSphereShape, collideConvex },
+    /* Cylinder */ { collideConvex,      collideShapeSphere, collideConvex,      collideConvex,      collideConvex },
+    /* Wedge    */ { collideConvex,      collideShapeSphere, collideConvex,      collideConvex,      collideConvex },
+    /* Mesh     */ { collideConvex,      collideConvex,      collideConvex,      collideConvex,      collideConvex },
+};
+
+bool collide(const Transform& a, const Transform& b, Contact& out) {
+    return kCollide[(int)a.shape][(int)b.shape](a, b, out);
+}
+
+int collideParts(const Transform& a, bool aFixed, const Transform& b, bool bFixed, Contact* out, int maxContacts) {
+    if (aFixed && a.shape == PartShape::Mesh) return collideMesh(a, b, out, maxContacts);
+    if (bFixed && b.shape == PartShape::Mesh) {
+        int count = collideMesh(b, a, out, maxContacts);
+        for (int i = 0; i < count; ++i) out[i].normal = out[i].normal * -1.0f;
+        return count;
+    }
+    return collide(a, b, out[0]) ? 1 : 0;
+}
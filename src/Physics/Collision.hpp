@@ -0,0 +1,50 @@
+// src/Physics/Collision.hpp
+#ifndef COLLISION_HPP
+#define COLLISION_HPP
+
+#include "src/Math/Vector3.hpp"
+#include "src/Game/ComponentStore.hpp"
+
+// 接触情報構造体
+struct Contact {
+    Vector3 point;         // 衝突点（ワールド座標）
+    Vector3 normal;        // 衝突法線（A から B への押し出し方向）
+    float penetration;     // 貫通深度
+
+    Contact() : point(0,0,0), normal(0,1,0), penetration(0.0f) {}
+};
+
+// ===================================================================
+// 狭域フェーズ: 形の組ごとの衝突判定
+//
+// collide は Transform::shape の組で表を引き、組に合った判定を呼ぶ:
+//   箱 - 箱: 分離軸判定（面 6 本 + 辺の外積 9 本）
+//   球 - 球: 中心の距離
+//   球 - 箱・円柱・くさび: 相手のローカル座標で一番近い点を閉じた式で求める
+//   それ以外（円柱・くさび・メッシュを含む組）: 支持関数で投影する分離軸判定。
+//     円柱の曲面は、軸に垂直で相手の頂点・中心へ向かう方向を候補にして近似する。
+//     メッシュは凸包（MeshAsset::hull）で近似する
+// どの判定も法線は A から B へ向き、確保をしない
+//
+// 固定の MeshPart だけは三角形そのものと判定する（collideParts / collideMesh）。
+// 凹んだ形（アーチの下など）をくぐれるが、接触は複数になる
+// ===================================================================
+
+bool collide(const Transform& a, const Transform& b, Contact& out);
+
+// 物理の組の判定。固定（aFixed / bFixed）の MeshPart が含まれていれば collideMesh、
+// それ以外は collide。out に最大 maxContacts 個書き、その数を返す
+int collideParts(const Transform& a, bool aFixed, const Transform& b, bool bFixed, Contact* out, int maxContacts);
+
+// メッシュ mesh の三角形（BVH で相手の箱と重なるものだけ）と other。
+// 三角形ごとの接触を向きの近いもので1つにまとめて out に書く（法線は mesh から other へ）
+int collideMesh(const Transform& mesh, const Transform& other, Contact* out, int maxContacts);
+
+// 組ごとの判定（collide が表から呼ぶ。比較・計測用に直接呼んでもよい）
+bool collideBoxes(const Transform& a, const Transform& b, Contact& out);
+bool collideSpheres(const Transform& a, const Transform& b, Contact& out);
+bool collideSphereShape(const Transform& sphere, const Transform& b, Contact& out);
+bool collideShapeSphere(const Transform& a, const Transform& sphere, Contact& out);
+bool collideConvex(const Transform& a, const Transform& b, Contact& out);
+
+#endif // COLLISION_HPP
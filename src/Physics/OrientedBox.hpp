@@ -0,0 +1,153 @@
+// src/Physics/OrientedBox.hpp
+#ifndef ORIENTEDBOX_HPP
+#define ORIENTEDBOX_HPP
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Math/MathUtils.hpp"
+
+// ===================================================================
+// 回転した箱（OBB）の重なり・掃引の計算
+// 空間クエリ（SpatialQuery）と連続衝突判定（Physics の CCD）が使う
+// ===================================================================
+
+// OBB（中心・ローカル軸のワールドの向き・半分の大きさ）
+struct OrientedBox {
+    Vector3 c;
+    Vector3 axis[3];
+    float h[3];
+};
+
+inline OrientedBox makeBox(const Vector3& center, const Vector3& rotation, const Vector3& size) {
+    OrientedBox b;
+    b.c = center;
+    Matrix3 R = Matrix3::rotate(rotation);
+    for (int i = 0; i < 3; ++i) b.axis[i] = Vector3(R.m[0][i], R.m[1][i], R.m[2][i]);
+    b.h[0] = size.x * 0.5f;
+    b.h[1] = size.y * 0.5f;
+    b.h[2] = size.z * 0.5f;
+    return b;
+}
+
+// 箱を囲む AABB の半分の大きさ
+inline Vector3 boxExtent(const OrientedBox& b) {
+    Vector3 e(0, 0, 0);
+    for (int i = 0; i < 3; ++i) {
+        e.x += std::abs(b.axis[i].x) * b.h[i];
+        e.y += std::abs(b.axis[i].y) * b.h[i];
+        e.z += std::abs(b.axis[i].z) * b.h[i];
+    }
+    return e;
+}
+
+inline Vector3 closestPoint(const OrientedBox& b, const Vector3& p) {
+    Vector3 d = p - b.c;
+    Vector3 q = b.c;
+    for (int i = 0; i < 3; ++i) {
+        float t = std::max(-b.h[i], std::min(b.h[i], d.dot(b.axis[i])));
+        q += b.axis[i] * t;
+    }
+    return q;
+}
+
+// 方向 n に投影した箱の半径
+inline float projectedRadius(const OrientedBox& b, const Vector3& n) {
+    return b.h[0] * std::abs(n.dot(b.axis[0])) + b.h[1] * std::abs(n.dot(b.axis[1])) +
+           b.h[2] * std::abs(n.dot(b.axis[2]));
+}
+
+// 分離軸の候補（両方の面の向き 6 本 + 辺同士の外積 9 本。平行な辺の組は除く）
+inline int separatingAxes(const OrientedBox& a, const OrientedBox& b, Vector3 (&axes)[15]) {
+    int n = 0;
+    for (int i = 0; i < 3; ++i) axes[n++] = a.axis[i];
+    for (int i = 0; i < 3; ++i) axes[n++] = b.axis[i];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            Vector3 c = a.axis[i].cross(b.axis[j]);
+            float len = c.length();
+            if (len > 1e-5f) axes[n++] = c / len;
+        }
+    }
+    return n;
+}
+
+inline bool boxesOverlap(const OrientedBox& a, const OrientedBox& b) {
+    Vector3 axes[15];
+    int n = separatingAxes(a, b, axes);
+    Vector3 d = b.c - a.c;
+    for (int k = 0; k < n; ++k) {
+        if (std::abs(d.dot(axes[k])) > projectedRadius(a, axes[k]) + projectedRadius(b, axes[k])) return false;
+    }
+    return true;
+}
+
+// 箱 a を motion だけ平行移動したとき、b に最初に触れる割合 s (0..1) と b の面の向き。
+// 分離軸ごとに重なっている s の範囲を求め、全ての軸の共通部分の入り口が答え
+// （平行移動だけなら凸多面体同士で厳密）。始めから重なっていれば当たらない扱い
+inline bool sweepBoxes(const OrientedBox& a, const OrientedBox& b, const Vector3& motion, float& sHit, Vector3& normal) {
+    Vector3 axes[15];
+    int n = separatingAxes(a, b, axes);
+    Vector3 d = b.c - a.c;
+    float sEnter = -std::numeric_limits<float>::infinity();
+    float sExit = std::numeric_limits<float>::infinity();
+    for (int k = 0; k < n; ++k) {
+        const Vector3& axis = axes[k];
+        float r = projectedRadius(a, axis) + projectedRadius(b, axis);
+        float dist = d.dot(axis);
+        float w = motion.dot(axis);
+        if (std::abs(w) < 1e-9f) {
+            if (std::abs(dist) > r) return false;   // この軸では動かないまま離れている
+            continue;
+        }
+        float s1 = (dist - r) / w, s2 = (dist + r) / w;
+        if (s1 > s2) std::swap(s1, s2);
+        if (s1 > sEnter) {
+            sEnter = s1;
+            normal = axis * (w > 0.0f ? -1.0f : 1.0f);
+        }
+        sExit = std::min(sExit, s2);
+        if (sEnter > sExit) return false;
+    }
+    if (sEnter < 0.0f || sEnter > 1.0f) return false;
+    sHit = sEnter;
+    return true;
+}
+
+// 線分 [a, b] と箱の距離（重なっていれば 0）。onSegment / onBox に一番近い点の組を書く。
+// 線分上の点から箱までの距離は線分の位置について凸なので、黄金分割で探す
+inline float segmentBoxDistance(const OrientedBox& box, const Vector3& a, const Vector3& b,
+                                Vector3& onSegment, Vector3& onBox) {
+    const float k = 0.618034f;
+    Vector3 ab = b - a;
+    auto distAt = [&](float t) {
+        Vector3 p = a + ab * t;
+        return (closestPoint(box, p) - p).lengthSquared();
+    };
+    float lo = 0.0f, hi = 1.0f;
+    if (ab.lengthSquared() > 1e-12f) {
+        float x1 = hi - k * (hi - lo), x2 = lo + k * (hi - lo);
+        float f1 = distAt(x1), f2 = distAt(x2);
+        for (int iter = 0; iter < 24; ++iter) {
+            if (f1 <= f2) {
+                hi = x2; x2 = x1; f2 = f1;
+                x1 = hi - k * (hi - lo); f1 = distAt(x1);
+            } else {
+                lo = x1; x1 = x2; f1 = f2;
+                x2 = lo + k * (hi - lo); f2 = distAt(x2);
+            }
+        }
+    }
+    float t = (lo + hi) * 0.5f;
+    // 端が一番近いことが多い（箱の上に立つカプセルなど）ので端も比べる
+    float ft = distAt(t), f0 = distAt(0.0f), f1 = distAt(1.0f);
+    if (f0 < ft) { t = 0.0f; ft = f0; }
+    if (f1 < ft) { t = 1.0f; ft = f1; }
+    onSegment = a + ab * t;
+    onBox = closestPoint(box, onSegment);
+    return std::sqrt(ft);
+}
+
+#endif // ORIENTEDBOX_HPP
@@ -1,96 +1,276 @@
 #include "Physics.hpp"
+#include "OrientedBox.hpp"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
 #include <vector>
 
-// ====================================================================
-// ヘルパー関数 (変更なし)
-// ====================================================================
-
-std::vector<Vector3> getOBBVertices(const Cube& cube) {
-    std::vector<Vector3> vertices;
-    Vector3 half = cube.size * 0.5f;
-    Matrix3 R = Matrix3::rotate(cube.rotation);
-    Vector3 localVerts[8] = {
-        Vector3(-half.x, -half.y, -half.z), Vector3( half.x, -half.y, -half.z),
-        Vector3( half.x,  half.y, -half.z), Vector3(-half.x,  half.y, -half.z),
-        Vector3(-half.x, -half.y,  half.z), Vector3( half.x, -half.y,  half.z),
-        Vector3( half.x,  half.y,  half.z), Vector3(-half.x,  half.y,  half.z)
-    };
-    for(int i = 0; i < 8; i++) vertices.push_back(cube.pos + R * localVerts[i]);
-    return vertices;
-}
-
-void getOBBAxes(const Cube& cube, Vector3 axes[3]) {
-    Matrix3 R = Matrix3::rotate(cube.rotation);
-    axes[0] = R * Vector3(1, 0, 0);
-    axes[1] = R * Vector3(0, 1, 0);
-    axes[2] = R * Vector3(0, 0, 1);
-}
-
-void projectVertices(const std::vector<Vector3>& vertices, const Vector3& axis, float& min, float& max) {
-    min = max = vertices[0].dot(axis);
-    for(size_t i = 1; i < vertices.size(); i++) {
-        float proj = vertices[i].dot(axis);
-        if(proj < min) min = proj;
-        if(proj > max) max = proj;
-    }
-}
-
-bool testSeparatingAxis(const std::vector<Vector3>& vertsA, const std::vector<Vector3>& vertsB,
-                        const Vector3& axis, float& outPenetration) {
-    float minA, maxA, minB, maxB;
-    projectVertices(vertsA, axis, minA, maxA);
-    projectVertices(vertsB, axis, minB, maxB);
-    if(maxA < minB || maxB < minA) return false;
-    float overlap = std::min(maxA - minB, maxB - minA);
-    outPenetration = overlap;
-    return true;
+// ジョイントで繋がった2つのパーツの組（EntityId::index）
+static uint64_t pairKey(uint32_t a, uint32_t b) {
+    if (a > b) std::swap(a, b);
+    return ((uint64_t)a << 32) | b;
 }
 
 // ====================================================================
 // Physics クラス実装
+// 各処理はパーツ（Cube）ではなく ComponentStore の配列を直接走査する
 // ====================================================================
 
 void Physics::simulate(Workspace& ws, float dt) {
-    const int subSteps = 8;
     float subDt = dt / subSteps;
+    ccdSweeps = 0;
+    ccdHits = 0;
 
+    // ジョイント: モーターを進め、繋がりが変わっていればアセンブリ・拘束を組み直す
+    ws.joints.step(dt);
+    const bool assemblies = ws.joints.hasAssemblies();
+
+    // simulate 中はパーツの追加・削除・構成の変更がないので、集めたポインタは最後まで有効
+    gatherColliders(ws);
+    gatherJoints(ws);
+    wakeEdited(ws.terrain);
+
+    Transform shapeA, shapeB;
     for (int step = 0; step < subSteps; ++step) {
         integrateAcceleration(ws, subDt);
+        for (JointLink& link : jointLinks) {
+            link.a.R = Matrix3::rotate(link.a.transform->rotation);
+            link.b.R = Matrix3::rotate(link.b.transform->rotation);
+        }
 
         const int collisionIterations = 4;
         for (int iter = 0; iter < collisionIterations; ++iter) {
-            for (size_t i = 0; i < ws.cubes.size(); ++i) {
-                for (size_t j = i + 1; j < ws.cubes.size(); ++j) {
-                    Cube& a = ws.cubes[i];
-                    Cube& b = ws.cubes[j];
+            if (!jointLinks.empty()) solveJoints();
+
+            for (size_t i = 0; i < colliders.size(); ++i) {
+                for (size_t j = i + 1; j < colliders.size(); ++j) {
+                    PhysicsBody& a = colliders[i];
+                    PhysicsBody& b = colliders[j];
 
                     if (a.anchored && b.anchored) continue;
-                    if (a.isSleeping && b.isSleeping) continue;
-                    
-                    // 【修正】衝突判定フラグのチェック
-                    // どちらかが衝突不可なら無視する
-                    if (!a.canCollide || !b.canCollide) continue;
+                    if (a.body->isSleeping && b.body->isSleeping) continue;
+                    if (a.body == b.body) continue;   // 同じアセンブリ
+
+                    const Transform& ta = shapeOf(a, shapeA);
+                    const Transform& tb = shapeOf(b, shapeB);
+                    if (!broadPhaseAABB(ta, tb)) continue;
+                    if (!jointPairs.empty() && jointPairs.count(pairKey(a.entity, b.entity))) continue;
+
+                    // 固定の MeshPart とは三角形ごとの接触が複数になる
+                    Contact contacts[kMaxPairContacts];
+                    int count = collideParts(ta, a.anchored, tb, b.anchored, contacts, kMaxPairContacts);
+                    if (count > 0) {
+                        if(a.body->isSleeping) { a.body->isSleeping = false; a.body->sleepTimer = 0.0f; }
+                        if(b.body->isSleeping) { b.body->isSleeping = false; b.body->sleepTimer = 0.0f; }
+
+                        for (int c = 0; c < count; ++c) {
+                            resolveCollision(a, b, contacts[c]);
+                            correctPosition(a, b, contacts[c]);
+                        }
+                    }
+                }
+            }
+            collideTerrain(ws.terrain);
+        }
+        if (continuous) sweepFastBodies(subDt, ws.terrain);
+        integrateVelocity(ws, subDt);
 
-                    if (!broadPhaseAABB(a, b)) continue;
+        // アセンブリのメンバーを根に合わせる
+        if (assemblies) {
+            ws.hierarchy.update();
+            syncAssemblies();
+        }
+    }
+}
 
-                    Contact contact;
-                    if (detectOBBCollision(a, b, contact)) {
-                        if(a.isSleeping) a.wakeUp();
-                        if(b.isSleeping) b.wakeUp();
+void Physics::gatherColliders(Workspace& ws) {
+    colliders.clear();
+    const JointSystem& joints = ws.joints;
+    ws.components.forEach(Comp_Transform | Comp_Collider, [&](Archetype& arch) {
+        bool hasBody = arch.has(Comp_RigidBody);
+        for (size_t i = 0; i < arch.size(); ++i) {
+            // 親のないパーツ・破棄予約済みのパーツは世界にいない
+            if (!arch.owners[i]->isActive()) continue;
+
+            PhysicsBody pb;
+            pb.transform = &arch.transforms[i];
+            pb.body = hasBody ? &arch.bodies[i] : &staticBody;
+            pb.collider = &arch.colliders[i];
+            pb.anchored = !hasBody;
+            pb.frame = pb.transform;
+            pb.centerOffset = Vector3(0, 0, 0);
+            pb.entity = arch.entities[i].index;
+
+            // アセンブリのメンバーは根の RigidBody で衝突に応じる（根が固定なら固定）
+            EntityId root = joints.rootOf(arch.entities[i]);
+            if (root != arch.entities[i]) {
+                RigidBody* rootBody = ws.components.get<RigidBody>(root);
+                pb.frame = ws.components.get<Transform>(root);
+                pb.body = rootBody ? rootBody : &staticBody;
+                pb.anchored = !rootBody;
+            } else if (hasBody && arch.bodies[i].kinematic) {
+                // 解決の外で動かされる物体（CharacterController の根）は、動かない障害物として当たる
+                pb.body = &staticBody;
+                pb.anchored = true;
+            }
+            pb.frameSyncPos = pb.frame->pos;
+            if (pb.body->centerOfMass.lengthSquared() > 0.0f) {
+                pb.centerOffset = Matrix3::rotate(pb.frame->rotation) * pb.body->centerOfMass;
+            }
+            colliders.push_back(pb);
+        }
+    });
+}
 
-                        if(a.isPlayer && contact.normal.y < -0.7f) a.onGround = true;
-                        if(b.isPlayer && contact.normal.y > 0.7f) b.onGround = true;
+void Physics::syncAssemblies() {
+    for (PhysicsBody& pb : colliders) {
+        if (pb.frame == pb.transform && pb.body->centerOfMass.lengthSquared() == 0.0f) continue;
+        pb.frameSyncPos = pb.frame->pos;
+        pb.centerOffset = Matrix3::rotate(pb.frame->rotation) * pb.body->centerOfMass;
+    }
+    for (JointLink& link : jointLinks) {
+        syncEnd(link.a);
+        syncEnd(link.b);
+    }
+}
 
-                        resolveCollision(a, b, contact);
-                        correctPosition(a, b, contact);
-                    }
-                }
+// ====================================================================
+// ジョイント（拘束として解くもの）
+// アセンブリにまとめなかった剛体同士の Weld / Motor6D を、
+// 衝突と同じ反復の中で逐次インパルスとして解く
+// ====================================================================
+
+JointEnd Physics::makeEnd(Workspace& ws, EntityId e) {
+    JointEnd end;
+    EntityId root = ws.joints.rootOf(e);
+    end.transform = ws.components.get<Transform>(e);
+    end.frame = ws.components.get<Transform>(root);
+    RigidBody* body = ws.components.get<RigidBody>(root);
+    end.body = body ? body : &staticBody;
+    end.fixed = !body;
+    syncEnd(end);
+    return end;
+}
+
+void Physics::syncEnd(JointEnd& end) {
+    end.frameSyncPos = end.frame->pos;
+    end.centerOffset = Vector3(0, 0, 0);
+    if (end.body->centerOfMass.lengthSquared() > 0.0f) {
+        end.centerOffset = Matrix3::rotate(end.frame->rotation) * end.body->centerOfMass;
+    }
+}
+
+void Physics::gatherJoints(Workspace& ws) {
+    jointLinks.clear();
+    jointPairs.clear();
+    for (const JointSystem::Constraint& c : ws.joints.constraints()) {
+        JointLink link;
+        link.a = makeEnd(ws, c.part0);
+        link.b = makeEnd(ws, c.part1);
+        link.constraint = &c;
+        if (link.a.fixed && link.b.fixed) continue;
+        jointLinks.push_back(link);
+        jointPairs.insert(pairKey(c.part0.index, c.part1.index));
+    }
+}
+
+// 小さな回転（回転軸 × 角度（ラジアン））の行列
+static Matrix3 smallRotation(const Vector3& v) {
+    float angle = v.length();
+    Matrix3 R;
+    if (angle < 1e-12f) return R;
+    Vector3 k = v / angle;
+    float c = std::cos(angle), s = std::sin(angle), t = 1.0f - c;
+    R.m[0][0] = t*k.x*k.x + c;     R.m[0][1] = t*k.x*k.y - s*k.z; R.m[0][2] = t*k.x*k.z + s*k.y;
+    R.m[1][0] = t*k.x*k.y + s*k.z; R.m[1][1] = t*k.y*k.y + c;     R.m[1][2] = t*k.y*k.z - s*k.x;
+    R.m[2][0] = t*k.x*k.z - s*k.y; R.m[2][1] = t*k.y*k.z + s*k.x; R.m[2][2] = t*k.z*k.z + c;
+    return R;
+}
+
+static float trace(const Matrix3& m) { return m.m[0][0] + m.m[1][1] + m.m[2][2]; }
+
+// ジョイントの片側の（アセンブリなら根の）向きを、ワールドで delta だけ回す
+static void rotateEnd(JointEnd& end, const Vector3& delta) {
+    Matrix3 D = smallRotation(delta);
+    Matrix3 frameR = (end.frame == end.transform) ? end.R : Matrix3::rotate(end.frame->rotation);
+    end.frame->rotation = (D * frameR).toEuler();
+    end.R = D * end.R;
+}
+
+void Physics::solveJoints() {
+    const float beta = 0.2f;   // 1回の反復で戻すずれの割合
+    static const Vector3 axes[3] = {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)};
+
+    for (JointLink& link : jointLinks) {
+        JointEnd& ea = link.a;
+        JointEnd& eb = link.b;
+        RigidBody& a = *ea.body;
+        RigidBody& b = *eb.body;
+
+        // 片方だけ寝ていれば起こす（両方寝ていれば解かない）
+        bool aAsleep = !ea.fixed && a.isSleeping;
+        bool bAsleep = !eb.fixed && b.isSleeping;
+        if ((aAsleep || ea.fixed) && (bAsleep || eb.fixed)) continue;
+        if (aAsleep) { a.isSleeping = false; a.sleepTimer = 0.0f; }
+        if (bAsleep) { b.isSleeping = false; b.sleepTimer = 0.0f; }
+
+        const JointSystem::Constraint& c = *link.constraint;
+
+        // --- 位置: Part0 × J の原点に Part1 の原点を合わせる ---
+        // 速度は相対速度を 0 にするだけ（ずれの分を速度に足すと跳ね回る）。
+        // ずれは correctPosition と同じく質量の逆数で分けて位置を直接戻す
+        Vector3 anchorA = ea.pos() + ea.R * c.localPos;
+        Vector3 anchorB = eb.pos();
+        Vector3 rA = anchorA - ea.center();
+        Vector3 rB = anchorB - eb.center();
+
+        for (int k = 0; k < 3; ++k) {
+            const Vector3& n = axes[k];
+            Vector3 vA = a.velocity + a.angularVelocity.cross(rA);
+            Vector3 vB = b.velocity + b.angularVelocity.cross(rB);
+            float K = a.invMass + b.invMass;
+            if (!ea.fixed) K += (a.invInertiaTensorWorld * rA.cross(n)).cross(rA).dot(n);
+            if (!eb.fixed) K += (b.invInertiaTensorWorld * rB.cross(n)).cross(rB).dot(n);
+            if (K < 1e-6f) continue;
+
+            Vector3 impulse = n * (-(vB - vA).dot(n) / K);
+            if (!ea.fixed) {
+                a.velocity -= impulse * a.invMass;
+                a.angularVelocity -= a.invInertiaTensorWorld * rA.cross(impulse);
+            }
+            if (!eb.fixed) {
+                b.velocity += impulse * b.invMass;
+                b.angularVelocity += b.invInertiaTensorWorld * rB.cross(impulse);
             }
         }
-        integrateVelocity(ws, subDt);
+
+        float invMassSum = a.invMass + b.invMass;
+        if (invMassSum > 0.0f) {
+            Vector3 correction = (anchorB - anchorA) * (beta / invMassSum);
+            if (!ea.fixed) ea.frame->pos += correction * a.invMass;
+            if (!eb.fixed) eb.frame->pos -= correction * b.invMass;
+        }
+
+        // --- 向き: Part1 の向きを R(Part0)·J に合わせる ---
+        // 位置と同じく、相対角速度を 0 にしてから、ずれを慣性の逆数で分けて向きを直接戻す
+        Matrix3 invSum;
+        invSum.setZero();
+        if (!ea.fixed) invSum = invSum + a.invInertiaTensorWorld;
+        if (!eb.fixed) invSum = invSum + b.invInertiaTensorWorld;
+        Vector3 L = invSum.inverse() * (a.angularVelocity - b.angularVelocity);
+        if (!ea.fixed) a.angularVelocity -= a.invInertiaTensorWorld * L;
+        if (!eb.fixed) b.angularVelocity += b.invInertiaTensorWorld * L;
+
+        Matrix3 Rerr = (ea.R * c.localR) * eb.R.transpose();
+        Vector3 theta(0.5f * (Rerr.m[2][1] - Rerr.m[1][2]),
+                      0.5f * (Rerr.m[0][2] - Rerr.m[2][0]),
+                      0.5f * (Rerr.m[1][0] - Rerr.m[0][1]));
+        if (theta.lengthSquared() < 1e-10f) continue;
+        float wA = ea.fixed ? 0.0f : trace(a.invInertiaTensorWorld);
+        float wB = eb.fixed ? 0.0f : trace(b.invInertiaTensorWorld);
+        if (wA + wB <= 0.0f) continue;
+        if (wA > 0.0f) rotateEnd(ea, theta * (-beta * wA / (wA + wB)));
+        if (wB > 0.0f) rotateEnd(eb, theta * (beta * wB / (wA + wB)));
     }
 }
 
@@ -99,27 +279,32 @@ void Physics::integrateAcceleration(Workspace& ws, float dt) {
     const float sleepAngThreshold = 0.4f;
     const float sleepTimeThreshold = 0.5f;
 
-    for (auto& c : ws.cubes) {
-        if (c.anchored || c.isSleeping) continue;
-        
-        // 【修正】物理演算フラグのチェック
-        // 装飾用パーツなどはここでスキップされる
-        if (!c.simulated) continue;
+    // 減衰は 1/480 秒（60fps を 8 分割）あたりの値。サブステップの数が変わっても1秒あたりは同じ
+    const float linearDamping = std::pow(0.999f, dt * 480.0f);
+    const float angularDamping = std::pow(0.90f, dt * 480.0f);
 
-        c.velocity += ws.gravity * dt;
+    // RigidBody を持たない（Anchored・装飾用の）パーツはそもそも走査しない
+    ws.components.forEach(Comp_Transform | Comp_RigidBody, [&](Archetype& arch) {
+        for (size_t i = 0; i < arch.size(); ++i) {
+            RigidBody& c = arch.bodies[i];
+            // アセンブリのメンバーは根に合わせて、キャラクターは CharacterController が動かす
+            if (c.isSleeping || c.kinematic || !arch.owners[i]->isActive()) continue;
 
-        c.velocity *= 0.999f; 
-        c.angularVelocity *= 0.90f; 
+            Transform& t = arch.transforms[i];
 
-        if (c.velocity.lengthSquared() < 0.01f) c.velocity = Vector3(0,0,0);
-        if (c.angularVelocity.lengthSquared() < 0.01f) c.angularVelocity = Vector3(0,0,0);
+            c.velocity += ws.gravity * dt;
 
-        const float maxAngVel = 10.0f; 
-        if (c.angularVelocity.lengthSquared() > maxAngVel * maxAngVel) {
-            c.angularVelocity = c.angularVelocity.normalized() * maxAngVel;
-        }
+            c.velocity *= linearDamping;
+            c.angularVelocity *= angularDamping;
+
+            if (c.velocity.lengthSquared() < 0.01f) c.velocity = Vector3(0,0,0);
+            if (c.angularVelocity.lengthSquared() < 0.01f) c.angularVelocity = Vector3(0,0,0);
+
+            const float maxAngVel = 10.0f; 
+            if (c.angularVelocity.lengthSquared() > maxAngVel * maxAngVel) {
+                c.angularVelocity = c.angularVelocity.normalized() * maxAngVel;
+            }
 
-        if (!c.isPlayer) {
             if (c.velocity.lengthSquared() < sleepVelThreshold * sleepVelThreshold &&
                 c.angularVelocity.lengthSquared() < sleepAngThreshold * sleepAngThreshold) {
                 c.sleepTimer += dt;
@@ -131,44 +316,84 @@ void Physics::integrateAcceleration(Workspace& ws, float dt) {
             } else {
                 c.sleepTimer = 0.0f;
             }
-        }
 
-        c.updateInertiaWorld();
-        
-        if (c.isPlayer) {
-            c.angularVelocity = Vector3(0,0,0);
-            c.rotation.x = 0; c.rotation.z = 0;
-            c.onGround = false;
+            c.updateInertiaWorld(t.rotation);
         }
-    }
+    });
 }
 
 void Physics::integrateVelocity(Workspace& ws, float dt) {
-    for (auto& c : ws.cubes) {
-        if (c.anchored || c.isSleeping) continue;
-        
-        // 【修正】物理演算フラグのチェック
-        if (!c.simulated) continue;
-
-        c.pos += c.velocity * dt;
-
-        if (!c.isPlayer && c.angularVelocity.lengthSquared() > 1e-8f) {
-            Matrix3 R = Matrix3::rotate(c.rotation);
-            Matrix3 omegaStar;
-            omegaStar.setZero();
-            omegaStar.m[0][1] = -c.angularVelocity.z; omegaStar.m[0][2] = c.angularVelocity.y;
-            omegaStar.m[1][0] = c.angularVelocity.z;  omegaStar.m[1][2] = -c.angularVelocity.x;
-            omegaStar.m[2][0] = -c.angularVelocity.y; omegaStar.m[2][1] = c.angularVelocity.x;
-
-            Matrix3 dR = omegaStar * R;
-            R = R + (dR * dt);
-            R.orthonormalize();
-            c.rotation = R.toEuler();
+    ws.components.forEach(Comp_Transform | Comp_RigidBody, [&](Archetype& arch) {
+        for (size_t i = 0; i < arch.size(); ++i) {
+            RigidBody& c = arch.bodies[i];
+            if (c.isSleeping || c.kinematic || !arch.owners[i]->isActive()) continue;
+
+            Transform& t = arch.transforms[i];
+            Cube* owner = arch.owners[i];
+
+            t.pos += c.velocity * dt;
+            // 衝突の押し戻し (correctPosition) を受けるのも起きている物体だけなので、ここで一緒に印を付ける
+            owner->markChanged(Prop_Position | Prop_Velocity);
+
+            if (c.angularVelocity.lengthSquared() > 1e-8f) {
+                Matrix3 R = Matrix3::rotate(t.rotation);
+                // アセンブリの根は重心まわりに回す（重心が自分の位置からずれている）
+                const bool offCenter = c.centerOfMass.lengthSquared() > 0.0f;
+                Vector3 center = offCenter ? t.pos + R * c.centerOfMass : t.pos;
+                Matrix3 omegaStar;
+                omegaStar.setZero();
+                omegaStar.m[0][1] = -c.angularVelocity.z; omegaStar.m[0][2] = c.angularVelocity.y;
+                omegaStar.m[1][0] = c.angularVelocity.z;  omegaStar.m[1][2] = -c.angularVelocity.x;
+                omegaStar.m[2][0] = -c.angularVelocity.y; omegaStar.m[2][1] = c.angularVelocity.x;
+
+                Matrix3 dR = omegaStar * R;
+                R = R + (dR * dt);
+                R.orthonormalize();
+                t.rotation = R.toEuler();
+                if (offCenter) t.pos = center - R * c.centerOfMass;
+                owner->markChanged(Prop_Rotation);
+            }
         }
+    });
+}
+
+void Physics::collideTerrain(const Terrain& terrain) {
+    if (terrain.empty()) return;
+    Transform shape, box;
+    PhysicsBody ground = terrainBody(box);
+    for (PhysicsBody& a : colliders) {
+        if (a.anchored || a.body->isSleeping) continue;
+        // 広域フェーズと同じ広さ（回転しても大きさの 1.732 倍に収まる）
+        Vector3 reach = a.transform->size * (1.732f * 0.5f);
+        Vector3 center = shapeOf(a, shape).pos;
+        terrain.forEachBox(center - reach, center + reach, [&](const TerrainBox& b) {
+            box.pos = (b.min + b.max) * 0.5f;
+            box.size = b.max - b.min;
+            ground.frameSyncPos = box.pos;
+            Contact contact;
+            if (collide(shapeOf(a, shape), box, contact)) {
+                resolveCollision(a, ground, contact);
+                correctPosition(a, ground, contact);
+            }
+        });
+    }
+}
+
+void Physics::wakeEdited(Terrain& terrain) {
+    Vector3 mn, mx;
+    if (!terrain.takeEditedRegion(mn, mx)) return;
+    for (PhysicsBody& pb : colliders) {
+        if (pb.anchored || !pb.body->isSleeping) continue;
+        const Transform& t = *pb.transform;
+        Vector3 reach = t.size * (1.732f * 0.5f);
+        if (t.pos.x + reach.x < mn.x || t.pos.x - reach.x > mx.x || t.pos.y + reach.y < mn.y ||
+            t.pos.y - reach.y > mx.y || t.pos.z + reach.z < mn.z || t.pos.z - reach.z > mx.z) continue;
+        pb.body->isSleeping = false;
+        pb.body->sleepTimer = 0.0f;
     }
 }
 
-bool Physics::broadPhaseAABB(const Cube& a, const Cube& b) {
+bool Physics::broadPhaseAABB(const Transform& a, const Transform& b) {
     float scale = 1.732f;
     Vector3 sizeA = a.size * scale;
     Vector3 sizeB = b.size * scale;
@@ -177,82 +402,14 @@ bool Physics::broadPhaseAABB(const Cube& a, const Cube& b) {
            (std::abs(a.pos.z - b.pos.z) < (sizeA.z + sizeB.z) * 0.5f);
 }
 
-bool Physics::detectOBBCollision(const Cube& a, const Cube& b, Contact& outContact) {
-    std::vector<Vector3> vertsA = getOBBVertices(a);
-    std::vector<Vector3> vertsB = getOBBVertices(b);
-    Vector3 axesA[3], axesB[3];
-    getOBBAxes(a, axesA);
-    getOBBAxes(b, axesB);
-
-    float minPen = 1e10f;
-    Vector3 bestAxis;
-    bool found = false;
-
-    std::vector<Vector3> axes;
-    for(int i=0; i<3; i++) axes.push_back(axesA[i]);
-    for(int i=0; i<3; i++) axes.push_back(axesB[i]);
-
-    const float crossThreshold = 1e-4f;
-    for(int i=0; i<3; i++) {
-        for(int j=0; j<3; j++) {
-            Vector3 cross = axesA[i].cross(axesB[j]);
-            if(cross.lengthSquared() > crossThreshold) {
-                axes.push_back(cross.normalized());
-            }
-        }
-    }
-
-    for(size_t i=0; i<axes.size(); i++) {
-        float pen;
-        if(!testSeparatingAxis(vertsA, vertsB, axes[i], pen)) return false; 
-        if (i >= 6) pen *= 1.05f; // バイアス
-
-        if(pen < minPen) {
-            minPen = pen;
-            bestAxis = axes[i];
-            found = true;
-        }
-    }
-
-    if (!found) return false;
-
-    Vector3 dir = b.pos - a.pos;
-    if(bestAxis.dot(dir) < 0) bestAxis = bestAxis * -1.0f;
-
-    outContact.normal = bestAxis;
-    outContact.penetration = minPen;
-    outContact.point = findContactPoint(a, b, bestAxis);
-
-    return true;
-}
-
-Vector3 Physics::findContactPoint(const Cube& a, const Cube& b, const Vector3& normal) {
-    auto getAverageContact = [&](const Cube& c, const Vector3& n) {
-        std::vector<Vector3> verts = getOBBVertices(c);
-        float maxDist = -1e20f;
-        for(const auto& v : verts) {
-            float d = v.dot(n);
-            if(d > maxDist) maxDist = d;
-        }
-        const float threshold = 0.15f; 
-        Vector3 sum(0,0,0);
-        int count = 0;
-        for(const auto& v : verts) {
-            if(v.dot(n) >= maxDist - threshold) {
-                sum += v; count++;
-            }
-        }
-        return (count > 0) ? (sum / (float)count) : verts[0];
-    };
-    Vector3 pA = getAverageContact(a, normal);
-    Vector3 pB = getAverageContact(b, normal * -1.0f);
-    return (pA + pB) * 0.5f;
-}
-
-void Physics::resolveCollision(Cube& a, Cube& b, const Contact& contact) {
+void Physics::resolveCollision(PhysicsBody& pa, PhysicsBody& pb, const Contact& contact) {
+    RigidBody& a = *pa.body;
+    RigidBody& b = *pb.body;
+    const bool aAnchored = pa.anchored, bAnchored = pb.anchored;
     Vector3 n = contact.normal;
-    Vector3 rA = contact.point - a.pos;
-    Vector3 rB = contact.point - b.pos;
+    // アセンブリは根の重心まわりに回る
+    Vector3 rA = contact.point - (pa.frame->pos + pa.centerOffset);
+    Vector3 rB = contact.point - (pb.frame->pos + pb.centerOffset);
 
     Vector3 vA = a.velocity + a.angularVelocity.cross(rA);
     Vector3 vB = b.velocity + b.angularVelocity.cross(rB);
@@ -269,12 +426,12 @@ void Physics::resolveCollision(Cube& a, Cube& b, const Contact& contact) {
 
     float invMassSum = a.invMass + b.invMass;
     
-    if(!a.anchored) invMassSum += angA;
-    if(!b.anchored) invMassSum += angB;
+    if(!aAnchored) invMassSum += angA;
+    if(!bAnchored) invMassSum += angB;
 
     if (invMassSum < 1e-6f) return;
 
-    float e = std::min(a.restitution, b.restitution);
+    float e = std::min(pa.collider->restitution, pb.collider->restitution);
     
     bool isStabilizing = false;
     if (std::abs(velAlongNormal) < 1.0f) { 
@@ -285,12 +442,12 @@ void Physics::resolveCollision(Cube& a, Cube& b, const Contact& contact) {
     float j = -(1.0f + e) * velAlongNormal / invMassSum;
     Vector3 impulse = n * j;
 
-    if (!a.anchored) {
+    if (!aAnchored) {
         a.velocity -= impulse * a.invMass;
         if (!isStabilizing) a.angularVelocity -= a.invInertiaTensorWorld * rA.cross(impulse);
         else a.angularVelocity *= 0.5f; 
     }
-    if (!b.anchored) {
+    if (!bAnchored) {
         b.velocity += impulse * b.invMass;
         if (!isStabilizing) b.angularVelocity += b.invInertiaTensorWorld * rB.cross(impulse);
         else b.angularVelocity *= 0.5f;
@@ -302,19 +459,19 @@ void Physics::resolveCollision(Cube& a, Cube& b, const Contact& contact) {
         
         float jt = -relVel.dot(t) / invMassSum; 
         
-        float mu = std::sqrt(a.friction * b.friction);
+        float mu = std::sqrt(pa.collider->friction * pb.collider->friction);
         float maxFriction = std::abs(j) * mu;
         if (std::abs(jt) > maxFriction) jt = (jt > 0) ? maxFriction : -maxFriction;
 
         Vector3 frictionImpulse = t * jt;
         
-        if (!a.anchored) {
+        if (!aAnchored) {
             a.velocity -= frictionImpulse * a.invMass;
             if(!isStabilizing) {
                 a.angularVelocity -= (a.invInertiaTensorWorld * rA.cross(frictionImpulse)) * 0.1f; 
             }
         }
-        if (!b.anchored) {
+        if (!bAnchored) {
             b.velocity += frictionImpulse * b.invMass;
             if(!isStabilizing) {
                 b.angularVelocity += (b.invInertiaTensorWorld * rB.cross(frictionImpulse)) * 0.1f;
@@ -323,13 +480,116 @@ void Physics::resolveCollision(Cube& a, Cube& b, const Contact& contact) {
     }
 }
 
-void Physics::correctPosition(Cube& a, Cube& b, const Contact& contact) {
+void Physics::correctPosition(PhysicsBody& pa, PhysicsBody& pb, const Contact& contact) {
+    const RigidBody& a = *pa.body;
+    const RigidBody& b = *pb.body;
     const float percent = 0.2f; 
     const float slop = 0.01f;
 
     float correctionMag = std::max(contact.penetration - slop, 0.0f) * percent / (a.invMass + b.invMass);
     Vector3 correction = contact.normal * correctionMag;
     
-    if(!a.anchored) a.pos -= correction * a.invMass;
-    if(!b.anchored) b.pos += correction * b.invMass;
-}
\ No newline at end of file
+    if(!pa.anchored) pa.frame->pos -= correction * a.invMass;
+    if(!pb.anchored) pb.frame->pos += correction * b.invMass;
+}
+
+// ====================================================================
+// 連続衝突判定（CCD）
+// ====================================================================
+
+void Physics::sweepFastBodies(float dt, const Terrain& terrain) {
+    // 1サブステップの移動が一番薄い辺のこの割合を超えたら掃引する
+    const float fastFraction = 0.25f;
+    const float backOff = 1e-3f;   // 当たる直前で止める（触れたまま始めると掃引で拾えない）
+
+    Transform scratch, terrainBox;
+    PhysicsBody ground = terrainBody(terrainBox);
+    for (size_t i = 0; i < colliders.size(); ++i) {
+        PhysicsBody& pb = colliders[i];
+        RigidBody& body = *pb.body;
+        // アセンブリのメンバーは根と一緒に動くので、根の箱だけ掃引する
+        if (pb.anchored || body.isSleeping || body.kinematic || pb.frame != pb.transform) continue;
+
+        const Transform& t = *pb.transform;
+        Vector3 motion = body.velocity * dt;
+        float thinnest = std::min(t.size.x, std::min(t.size.y, t.size.z));
+        if (motion.lengthSquared() <= (fastFraction * thinnest) * (fastFraction * thinnest)) continue;
+
+        OrientedBox box = makeBox(t.pos, t.rotation, t.size);
+        Vector3 extent = boxExtent(box);
+        Vector3 end = t.pos + motion;
+        Vector3 sweptMin(std::min(t.pos.x, end.x) - extent.x, std::min(t.pos.y, end.y) - extent.y,
+                         std::min(t.pos.z, end.z) - extent.z);
+        Vector3 sweptMax(std::max(t.pos.x, end.x) + extent.x, std::max(t.pos.y, end.y) + extent.y,
+                         std::max(t.pos.z, end.z) + extent.z);
+        ccdSweeps++;
+
+        float first = 1.0f;
+        PhysicsBody* hit = nullptr;
+        OrientedBox hitBox;
+        Vector3 hitNormal;
+        for (size_t j = 0; j < colliders.size(); ++j) {
+            PhysicsBody& other = colliders[j];
+            if (j == i || other.body == pb.body) continue;
+            if (!jointPairs.empty() && jointPairs.count(pairKey(pb.entity, other.entity))) continue;
+
+            const Transform& to = shapeOf(other, scratch);
+            OrientedBox target = makeBox(to.pos, to.rotation, to.size);
+            Vector3 e = boxExtent(target);
+            if (to.pos.x - e.x > sweptMax.x || to.pos.x + e.x < sweptMin.x ||
+                to.pos.y - e.y > sweptMax.y || to.pos.y + e.y < sweptMin.y ||
+                to.pos.z - e.z > sweptMax.z || to.pos.z + e.z < sweptMin.z) continue;
+
+            float s;
+            Vector3 normal;
+            if (other.anchored && to.shape == PartShape::Mesh) {
+                // 固定の MeshPart は箱ではなく三角形: 中心のレイが当たる所の、内接球の半径だけ手前で止める
+                float tHit;
+                if (!raycastMeshPart(to, t.pos, motion, first, tHit, normal)) continue;
+                float approach = -motion.dot(normal);
+                if (approach <= 1e-6f) continue;
+                s = std::max(0.0f, tHit - 0.5f * thinnest / approach);
+                if (s < first) {
+                    first = s;
+                    hit = &other;
+                    hitBox = makeBox(t.pos + motion * tHit, Vector3(0, 0, 0), Vector3(0, 0, 0));   // 当たった点（大きさ 0 の箱）
+                    hitNormal = normal;
+                }
+                continue;
+            }
+            if (sweepBoxes(box, target, motion, s, normal) && s < first) {
+                first = s;
+                hit = &other;
+                hitBox = target;
+                hitNormal = normal;
+            }
+        }
+        terrain.forEachBox(sweptMin, sweptMax, [&](const TerrainBox& b) {
+            Vector3 center = (b.min + b.max) * 0.5f;
+            OrientedBox target = makeBox(center, Vector3(0, 0, 0), b.max - b.min);
+            float s;
+            Vector3 normal;
+            if (sweepBoxes(box, target, motion, s, normal) && s < first) {
+                first = s;
+                hit = &ground;
+                hitBox = target;
+                hitNormal = normal;
+                terrainBox.pos = center;
+                terrainBox.size = b.max - b.min;
+            }
+        });
+        if (!hit) continue;
+        ccdHits++;
+
+        // 当たる所まで進め、そこで普通の接触として速度を解く（跳ね返り・摩擦もそのまま効く）。
+        // 残りの移動は integrateVelocity が解いた後の速度で行う
+        pb.frame->pos += motion * std::max(0.0f, first - backOff);
+        if (hit->body->isSleeping) { hit->body->isSleeping = false; hit->body->sleepTimer = 0.0f; }
+
+        Contact contact;
+        contact.normal = hitNormal * -1.0f;   // A（掃引した側）から B へ
+        contact.penetration = 0.0f;
+        contact.point = closestPoint(hitBox, pb.frame->pos);
+        resolveCollision(pb, *hit, contact);
+    }
+}
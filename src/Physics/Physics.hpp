@@ -3,44 +3,146 @@
 
 #include "src/Game/Workspace.hpp"
 #include "src/Math/Vector3.hpp"
+#include "src/Physics/Collision.hpp"
 #include <vector>
+#include <unordered_set>
+#include <algorithm>
 
-// 接触情報構造体
-struct Contact {
-    Vector3 point;         // 衝突点（ワールド座標）
-    Vector3 normal;        // 衝突法線（BからAへ、またはAからBへの押し出し方向）
-    float penetration;     // 貫通深度
-    
-    Contact() : point(0,0,0), normal(0,1,0), penetration(0.0f) {}
+// 衝突判定・応答が扱うパーツ1つ分（構成要素へのポインタ）
+// simulate 中はパーツの追加・削除がないので、1回の simulate の間だけ有効
+struct PhysicsBody {
+    Transform* transform;
+    RigidBody* body;      // 固定パーツは Physics::staticBody（質量0・速度0、書き込まれない）
+    Collider* collider;
+    bool anchored;
+
+    // 剛体アセンブリのメンバーは、根の Transform・RigidBody で動く
+    Transform* frame;     // 動かす Transform（アセンブリの根。それ以外は transform と同じ）
+    Vector3 frameSyncPos; // transform を根に合わせた時点の根の位置
+    Vector3 centerOffset; // 根の位置から重心まで（ワールドの向き）
+    uint32_t entity;      // EntityId::index（ジョイントで繋がった組の判定用）
+};
+
+// 拘束として解くジョイントの片側
+struct JointEnd {
+    Transform* transform; // 繋がっているパーツ
+    Transform* frame;     // 動かす Transform（アセンブリの根）
+    Vector3 frameSyncPos;
+    Vector3 centerOffset;
+    RigidBody* body;
+    bool fixed;           // 固定パーツ（staticBody）
+    Matrix3 R;            // サブステップの始めの向き
+
+    // メンバーは、このサブステップ中に根が押し戻された分だけずらして見る
+    Vector3 pos() const {
+        return frame == transform ? transform->pos : transform->pos + (frame->pos - frameSyncPos);
+    }
+    Vector3 center() const { return frame->pos + centerOffset; }
+};
+
+struct JointLink {
+    JointEnd a, b;        // Part0, Part1
+    const JointSystem::Constraint* constraint;
 };
 
 class Physics {
 public:
+    Physics() {
+        staticBody.mass = 0.0f;
+        staticBody.invMass = 0.0f;
+        staticBody.invInertiaTensorLocal.setZero();
+        staticBody.invInertiaTensorWorld.setZero();
+    }
+
     // メインシミュレーション関数
     // dt: 経過時間（秒）
     void simulate(Workspace& ws, float dt);
 
+    // 1フレームの分割数。すり抜けは速い物体だけ CCD で防ぐので少なくてよい
+    void setSubSteps(int n) { subSteps = std::max(1, n); }
+    int getSubSteps() const { return subSteps; }
+    // false なら連続衝突判定をしない（比較・デバッグ用）
+    void setContinuous(bool c) { continuous = c; }
+    bool isContinuous() const { return continuous; }
+    // 前回の simulate で掃引した回数・掃引で当たった回数
+    size_t ccdSweepCount() const { return ccdSweeps; }
+    size_t ccdHitCount() const { return ccdHits; }
+
 private:
+    static const int kMaxPairContacts = 4;   // 1組の接触の最大数（固定の MeshPart の三角形）
+
+    int subSteps = 2;
+    bool continuous = true;
+    size_t ccdSweeps = 0;
+    size_t ccdHits = 0;
+    RigidBody staticBody;
+    Collider terrainCollider;             // 地形の箱の跳ね返り・摩擦
+    std::vector<PhysicsBody> colliders;   // 毎フレーム作り直す（容量は使い回す）
+    std::vector<JointLink> jointLinks;
+    std::unordered_set<uint64_t> jointPairs;   // 拘束で繋がった組（衝突させない）
+
+    // Collider を持つ、workspace に置かれたパーツを集める
+    void gatherColliders(Workspace& ws);
+
+    // --- ジョイント ---
+    // 拘束として解くジョイントを集める
+    void gatherJoints(Workspace& ws);
+    // アセンブリのメンバーを根に合わせた後、根の位置・重心のずれを取り直す
+    void syncAssemblies();
+    // 逐次インパルスで相対速度を消し、位置と向きのずれを直接戻す
+    void solveJoints();
+    JointEnd makeEnd(Workspace& ws, EntityId e);
+    void syncEnd(JointEnd& end);
+
     // --- フェーズ1: 力の適用と積分 ---
     void integrateAcceleration(Workspace& ws, float dt);
     void integrateVelocity(Workspace& ws, float dt);
 
     // --- フェーズ2: 衝突検出 ---
     // 広域フェーズ（AABB）
-    bool broadPhaseAABB(const Cube& a, const Cube& b);
-    
-    // 狭域フェーズ（OBB - 分離軸定理）
-    bool detectOBBCollision(const Cube& a, const Cube& b, Contact& outContact);
-    
-    // サポート関数：接触点の特定
-    Vector3 findContactPoint(const Cube& a, const Cube& b, const Vector3& normal);
+    bool broadPhaseAABB(const Transform& a, const Transform& b);
+    // 狭域フェーズは形の組ごとの collideParts（Collision.hpp）
+
+    // 地形: 動く物体ごとに、その AABB と重なる塊の当たり判定の箱とだけ判定する
+    // （箱は固定パーツの Block と同じに扱う）
+    void collideTerrain(const Terrain& terrain);
+    // 地形の箱 box を相手にする固定の PhysicsBody
+    PhysicsBody terrainBody(Transform& box) {
+        PhysicsBody pb;
+        pb.transform = &box;
+        pb.body = &staticBody;
+        pb.collider = &terrainCollider;
+        pb.anchored = true;
+        pb.frame = &box;
+        pb.frameSyncPos = box.pos;
+        pb.centerOffset = Vector3(0, 0, 0);
+        pb.entity = UINT32_MAX;
+        return pb;
+    }
+    // 編集された地形と重なる眠っている物体を起こす（足場が消えたら落ちる）
+    void wakeEdited(Terrain& terrain);
 
     // --- フェーズ3: 衝突応答 ---
     // 衝突解決（インパルス法）
-    void resolveCollision(Cube& a, Cube& b, const Contact& contact);
+    void resolveCollision(PhysicsBody& a, PhysicsBody& b, const Contact& contact);
     
     // 位置補正（めり込み防止）
-    void correctPosition(Cube& a, Cube& b, const Contact& contact);
+    void correctPosition(PhysicsBody& a, PhysicsBody& b, const Contact& contact);
+
+    // --- 連続衝突判定（CCD） ---
+    // このサブステップで大きさに比べて大きく動く物体だけ、動く前に箱を掃引し、
+    // 最初に当たる所まで進めてそこで衝突を解く（薄い壁・小さい弾のすり抜け防止）。
+    // 球・円柱・くさびも大きさの箱として掃引する（当たった後の接触は形どおりに解く）。地形の箱も相手にする。
+    // 固定の MeshPart には箱の中心からレイを投げ、当たった三角形の手前で止める
+    void sweepFastBodies(float dt, const Terrain& terrain);
+
+    // アセンブリのメンバーは、このサブステップ中に根が押し戻された分だけずらして見る
+    const Transform& shapeOf(const PhysicsBody& pb, Transform& scratch) const {
+        if (pb.frame == pb.transform) return *pb.transform;
+        scratch = *pb.transform;
+        scratch.pos += pb.frame->pos - pb.frameSyncPos;
+        return scratch;
+    }
 };
 
 #endif // PHYSICS_HPP
\ No newline at end of file
@@ -0,0 +1,866 @@
+// src/Physics/SpatialQuery.cpp
+#include "SpatialQuery.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "src/Game/GameData.hpp"
+#include "src/Game/JobSystem.hpp"
+#include "src/Game/Mesh.hpp"
+#include "src/Physics/OrientedBox.hpp"
+
+// ====================================================================
+// 箱の計算
+// ====================================================================
+
+static const float kInf = std::numeric_limits<float>::infinity();
+
+namespace {
+
+// 0 で割らないための逆数（軸に平行なレイは、十分大きい値で割ったことにする）
+float safeInverse(float v) {
+    if (std::abs(v) > 1e-30f) return 1.0f / v;
+    return v >= 0.0f ? 1e30f : -1e30f;
+}
+
+// 半直線と AABB（expand だけ広げる）の入り口。[0, tMax] で交わらなければ false
+inline bool slab(const Vector3& o, const Vector3& inv, const Vector3& mn, const Vector3& mx,
+                 const Vector3& expand, float tMax, float& tEnter) {
+    float tx1 = (mn.x - expand.x - o.x) * inv.x, tx2 = (mx.x + expand.x - o.x) * inv.x;
+    float ty1 = (mn.y - expand.y - o.y) * inv.y, ty2 = (mx.y + expand.y - o.y) * inv.y;
+    float tz1 = (mn.z - expand.z - o.z) * inv.z, tz2 = (mx.z + expand.z - o.z) * inv.z;
+    float t0 = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+    float t1 = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+    tEnter = t0;
+    return t0 <= t1 && t1 >= 0.0f && t0 <= tMax;
+}
+
+} // namespace
+
+// 葉の4レーンの OBB と半直線のスラブ判定（inflate だけ箱を広げる）。
+// 分岐のない同じ計算を4レーンに並べてあるので、ループはベクトル命令になる。
+// tEnter / tExit は入り口・出口（交わらないレーンは tEnter = +inf）
+template <typename Pack>
+static inline void rayPack(const Pack& p, const Vector3& o, const Vector3& dir, float inflate,
+                           float (&tEnter)[4], float (&tExit)[4]) {
+    for (int k = 0; k < 4; ++k) {
+        float dx = o.x - p.cx[k], dy = o.y - p.cy[k], dz = o.z - p.cz[k];
+        float t0 = -kInf, t1 = kInf;
+        for (int i = 0; i < 3; ++i) {
+            float lo = dx * p.ax[i][k] + dy * p.ay[i][k] + dz * p.az[i][k];
+            float ld = dir.x * p.ax[i][k] + dir.y * p.ay[i][k] + dir.z * p.az[i][k];
+            float inv = 1.0f / (std::abs(ld) > 1e-12f ? ld : 1e-12f);
+            float h = p.h[i][k] + inflate;
+            float a = (-h - lo) * inv, b = (h - lo) * inv;
+            t0 = std::max(t0, std::min(a, b));
+            t1 = std::min(t1, std::max(a, b));
+        }
+        bool hit = p.h[0][k] >= 0.0f && t0 <= t1;
+        tEnter[k] = hit ? t0 : kInf;
+        tExit[k] = t1;
+    }
+}
+
+// rayPack のカプセル版: 芯の線分の中心が o から dir へ進むとき、箱を軸ごとにカプセルの幅
+// （線分の半分 half の軸への影 + radius）だけ広げて判定する。
+// 球で一様に広げるより狭く、面に沿って動くとき（地面の上を歩くなど）触れている箱を弾ける
+template <typename Pack>
+static inline void capsulePack(const Pack& p, const Vector3& o, const Vector3& dir, const Vector3& half, float radius,
+                               float (&tEnter)[4], float (&tExit)[4]) {
+    for (int k = 0; k < 4; ++k) {
+        float dx = o.x - p.cx[k], dy = o.y - p.cy[k], dz = o.z - p.cz[k];
+        float t0 = -kInf, t1 = kInf;
+        for (int i = 0; i < 3; ++i) {
+            float lo = dx * p.ax[i][k] + dy * p.ay[i][k] + dz * p.az[i][k];
+            float ld = dir.x * p.ax[i][k] + dir.y * p.ay[i][k] + dir.z * p.az[i][k];
+            float ls = half.x * p.ax[i][k] + half.y * p.ay[i][k] + half.z * p.az[i][k];
+            float inv = 1.0f / (std::abs(ld) > 1e-12f ? ld : 1e-12f);
+            float h = p.h[i][k] + std::abs(ls) + radius;
+            float a = (-h - lo) * inv, b = (h - lo) * inv;
+            t0 = std::max(t0, std::min(a, b));
+            t1 = std::min(t1, std::max(a, b));
+        }
+        bool hit = p.h[0][k] >= 0.0f && t0 <= t1;
+        tEnter[k] = hit ? t0 : kInf;
+        tExit[k] = t1;
+    }
+}
+
+template <typename Pack>
+static OrientedBox laneBox(const Pack& p, int k) {
+    OrientedBox b;
+    b.c = Vector3(p.cx[k], p.cy[k], p.cz[k]);
+    for (int i = 0; i < 3; ++i) {
+        b.axis[i] = Vector3(p.ax[i][k], p.ay[i][k], p.az[i][k]);
+        b.h[i] = p.h[i][k];
+    }
+    return b;
+}
+
+// 半直線が箱に入る面の外向きの法線
+static Vector3 entryNormal(const OrientedBox& b, const Vector3& o, const Vector3& dir) {
+    Vector3 d = o - b.c;
+    float best = -kInf;
+    Vector3 normal(0, 1, 0);
+    for (int i = 0; i < 3; ++i) {
+        float lo = d.dot(b.axis[i]);
+        float ld = dir.dot(b.axis[i]);
+        if (std::abs(ld) < 1e-12f) continue;
+        float t = std::min((-b.h[i] - lo) / ld, (b.h[i] - lo) / ld);
+        if (t > best) {
+            best = t;
+            normal = b.axis[i] * (ld > 0.0f ? -1.0f : 1.0f);
+        }
+    }
+    return normal;
+}
+
+// 地形の当たり判定の箱（軸に沿った OBB にする）
+static OrientedBox terrainBox(const TerrainBox& b) {
+    OrientedBox box;
+    box.c = (b.min + b.max) * 0.5f;
+    box.axis[0] = Vector3(1, 0, 0);
+    box.axis[1] = Vector3(0, 1, 0);
+    box.axis[2] = Vector3(0, 0, 1);
+    box.h[0] = (b.max.x - b.min.x) * 0.5f;
+    box.h[1] = (b.max.y - b.min.y) * 0.5f;
+    box.h[2] = (b.max.z - b.min.z) * 0.5f;
+    return box;
+}
+
+// from から to へ動く、半分の大きさ expand の箱が通る AABB
+static void sweptBounds(const Vector3& from, const Vector3& to, const Vector3& expand, Vector3& mn, Vector3& mx) {
+    mn = Vector3(std::min(from.x, to.x) - expand.x, std::min(from.y, to.y) - expand.y, std::min(from.z, to.z) - expand.z);
+    mx = Vector3(std::max(from.x, to.x) + expand.x, std::max(from.y, to.y) + expand.y, std::max(from.z, to.z) + expand.z);
+}
+
+// 一番近い当たりが地形のときの bestItem
+static const int kTerrainHit = -2;
+
+static bool sameTransform(const Transform& a, const Transform& b) {
+    return a.pos.x == b.pos.x && a.pos.y == b.pos.y && a.pos.z == b.pos.z &&
+           a.rotation.x == b.rotation.x && a.rotation.y == b.rotation.y && a.rotation.z == b.rotation.z &&
+           a.size.x == b.size.x && a.size.y == b.size.y && a.size.z == b.size.z && a.mesh == b.mesh;
+}
+
+// ====================================================================
+// 木の作成・更新
+// ====================================================================
+
+void SpatialQuery::refresh() {
+    if (store.layoutVersion() != builtLayout) {
+        relink();
+    } else if (PropertyChangeQueue::geometryVersion() != builtGeometry) {
+        if (refits >= kRefitsPerRebuild) rebuild();
+        else refit();
+    }
+}
+
+void SpatialQuery::writeLane(BoxPack& pack, int lane, Item& item) {
+    const Transform& t = *item.transform;
+    OrientedBox b = makeBox(t.pos, t.rotation, t.size);
+    pack.cx[lane] = b.c.x;
+    pack.cy[lane] = b.c.y;
+    pack.cz[lane] = b.c.z;
+    for (int i = 0; i < 3; ++i) {
+        pack.ax[i][lane] = b.axis[i].x;
+        pack.ay[i][lane] = b.axis[i].y;
+        pack.az[i][lane] = b.axis[i].z;
+        pack.h[i][lane] = b.h[i];
+    }
+    Vector3 e = boxExtent(b);
+    item.min = b.c - e;
+    item.max = b.c + e;
+    item.last = t;
+}
+
+void SpatialQuery::place(uint32_t index, const Item& item) {
+    items[index] = item;
+    if (itemOf.size() <= item.entity.index) itemOf.resize(item.entity.index + 1, UINT32_MAX);
+    itemOf[item.entity.index] = index;
+    writeLane(packs[index / kLanes], index % kLanes, items[index]);
+    live++;
+}
+
+// 何にも当たらないレーンにする
+void SpatialQuery::clearLane(uint32_t index) {
+    Item& item = items[index];
+    if (item.owner) live--;
+    item = Item{};
+    item.min = Vector3(kInf, kInf, kInf);
+    item.max = Vector3(-kInf, -kInf, -kInf);
+    BoxPack& p = packs[index / kLanes];
+    int lane = index % kLanes;
+    p.cx[lane] = p.cy[lane] = p.cz[lane] = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        p.ax[i][lane] = p.ay[i][lane] = p.az[i][lane] = 0.0f;
+        p.h[i][lane] = -1.0f;
+    }
+}
+
+void SpatialQuery::appendLoose(const Item& item) {
+    uint32_t index = (uint32_t)(treePacks * kLanes + loose);
+    if (index >= items.size()) {
+        packs.emplace_back();
+        for (int lane = 0; lane < kLanes; ++lane) {
+            items.emplace_back();
+            clearLane((uint32_t)items.size() - 1);
+        }
+    }
+    place(index, item);
+    loose++;
+}
+
+void SpatialQuery::rebuild() {
+    std::vector<Item> source;
+    source.reserve(store.entityCount());
+    store.forEach(Comp_Transform, [&](Archetype& arch) {
+        bool canCollide = arch.has(Comp_Collider);
+        for (size_t i = 0; i < arch.size(); ++i) {
+            Item item{};
+            item.entity = arch.entities[i];
+            item.transform = &arch.transforms[i];
+            item.owner = arch.owners[i];
+            item.canCollide = canCollide;
+            // 箱は place で作るが、分け方を決めるのに AABB が先に要る
+            OrientedBox b = makeBox(item.transform->pos, item.transform->rotation, item.transform->size);
+            Vector3 e = boxExtent(b);
+            item.min = b.c - e;
+            item.max = b.c + e;
+            source.push_back(item);
+        }
+    });
+
+    nodes.clear();
+    items.clear();
+    packs.clear();
+    live = 0;
+    loose = 0;
+    nodes.reserve(source.size() / 2 + 1);
+    items.reserve(source.size() + kLanes);
+    packs.reserve(source.size() / kLanes + 1);
+    if (!source.empty()) {
+        std::vector<uint32_t> order(source.size());
+        std::iota(order.begin(), order.end(), 0u);
+        buildNode(order, source, 0, (uint32_t)source.size());
+    }
+    treePacks = (uint32_t)packs.size();
+
+    builtLayout = store.layoutVersion();
+    builtGeometry = PropertyChangeQueue::geometryVersion();
+    refits = 0;
+    rebuilds++;
+}
+
+// 中心の広がりが一番大きい軸の中央で二つに分ける（釣り合った木になるので深さが読める）。
+// 分け目は kLanes の倍数に揃え、葉を最後の1つ以外埋める
+uint32_t SpatialQuery::buildNode(std::vector<uint32_t>& order, const std::vector<Item>& source,
+                                 uint32_t begin, uint32_t end) {
+    uint32_t index = (uint32_t)nodes.size();
+    nodes.push_back(Node{});
+
+    Vector3 mn(kInf, kInf, kInf), mx(-kInf, -kInf, -kInf);
+    Vector3 cmin = mn, cmax = mx;
+    for (uint32_t i = begin; i < end; ++i) {
+        const Item& it = source[order[i]];
+        mn = Vector3(std::min(mn.x, it.min.x), std::min(mn.y, it.min.y), std::min(mn.z, it.min.z));
+        mx = Vector3(std::max(mx.x, it.max.x), std::max(mx.y, it.max.y), std::max(mx.z, it.max.z));
+        Vector3 c = (it.min + it.max) * 0.5f;
+        cmin = Vector3(std::min(cmin.x, c.x), std::min(cmin.y, c.y), std::min(cmin.z, c.z));
+        cmax = Vector3(std::max(cmax.x, c.x), std::max(cmax.y, c.y), std::max(cmax.z, c.z));
+    }
+
+    uint32_t count = end - begin;
+    if (count <= (uint32_t)kLanes) {
+        uint32_t pack = (uint32_t)packs.size();
+        packs.emplace_back();
+        for (int lane = 0; lane < kLanes; ++lane) {
+            items.emplace_back();
+            clearLane((uint32_t)items.size() - 1);
+            if (lane < (int)count) place((uint32_t)items.size() - 1, source[order[begin + lane]]);
+        }
+        nodes[index] = Node{mn, mx, pack, count};
+        return index;
+    }
+
+    Vector3 ext = cmax - cmin;
+    int axis = (ext.x >= ext.y && ext.x >= ext.z) ? 0 : (ext.y >= ext.z ? 1 : 2);
+    uint32_t mid = begin + (count / 2 + kLanes - 1) / kLanes * kLanes;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                     [&](uint32_t a, uint32_t b) {
+                         const Item& ia = source[a];
+                         const Item& ib = source[b];
+                         float ca = axis == 0 ? ia.min.x + ia.max.x : axis == 1 ? ia.min.y + ia.max.y : ia.min.z + ia.max.z;
+                         float cb = axis == 0 ? ib.min.x + ib.max.x : axis == 1 ? ib.min.y + ib.max.y : ib.min.z + ib.max.z;
+                         return ca < cb;
+                     });
+    buildNode(order, source, begin, mid);
+    uint32_t right = buildNode(order, source, mid, end);
+    nodes[index] = Node{mn, mx, right, 0};
+    return index;
+}
+
+// パーツの追加・削除・構成の変更の後: 構成要素を引き直し、消えたものを空きに、増えたものをはみ出しに
+void SpatialQuery::relink() {
+    if (builtLayout == UINT64_MAX) {
+        rebuild();
+        return;
+    }
+    for (uint32_t i = 0; i < (uint32_t)items.size(); ++i) {
+        Item& item = items[i];
+        if (!item.owner) continue;
+        Transform* t = store.get<Transform>(item.entity);
+        if (!t) {
+            clearLane(i);
+            continue;
+        }
+        item.transform = t;
+        item.canCollide = (store.maskOf(item.entity) & Comp_Collider) != 0;
+    }
+    store.forEach(Comp_Transform, [&](Archetype& arch) {
+        bool canCollide = arch.has(Comp_Collider);
+        for (size_t i = 0; i < arch.size(); ++i) {
+            EntityId e = arch.entities[i];
+            if (e.index < itemOf.size() && itemOf[e.index] < items.size()) {
+                const Item& known = items[itemOf[e.index]];
+                if (known.owner && known.entity == e) continue;
+            }
+            Item item{};
+            item.entity = e;
+            item.transform = &arch.transforms[i];
+            item.owner = arch.owners[i];
+            item.canCollide = canCollide;
+            appendLoose(item);
+        }
+    });
+    builtLayout = store.layoutVersion();
+
+    // はみ出し・空きが増えすぎると問い合わせが遅くなる
+    size_t dead = items.size() - live;
+    if (loose > kMaxLoose || dead > std::max(kMaxLoose, live)) {
+        rebuild();
+        return;
+    }
+    refit();
+}
+
+// 動いたパーツの箱だけ作り直し、節点の AABB を子から付け直す（子は親より後ろにある）
+void SpatialQuery::refit() {
+    for (size_t p = 0; p < packs.size(); ++p) {
+        for (int lane = 0; lane < kLanes; ++lane) {
+            Item& item = items[p * kLanes + lane];
+            if (!item.owner || sameTransform(*item.transform, item.last)) continue;
+            writeLane(packs[p], lane, item);
+        }
+    }
+    for (size_t n = nodes.size(); n-- > 0;) {
+        Node& node = nodes[n];
+        Vector3 mn(kInf, kInf, kInf), mx(-kInf, -kInf, -kInf);
+        if (node.count) {
+            for (int lane = 0; lane < kLanes; ++lane) {
+                const Item& it = items[node.first * kLanes + lane];
+                mn = Vector3(std::min(mn.x, it.min.x), std::min(mn.y, it.min.y), std::min(mn.z, it.min.z));
+                mx = Vector3(std::max(mx.x, it.max.x), std::max(mx.y, it.max.y), std::max(mx.z, it.max.z));
+            }
+        } else {
+            const Node& l = nodes[n + 1];
+            const Node& r = nodes[node.first];
+            mn = Vector3(std::min(l.min.x, r.min.x), std::min(l.min.y, r.min.y), std::min(l.min.z, r.min.z));
+            mx = Vector3(std::max(l.max.x, r.max.x), std::max(l.max.y, r.max.y), std::max(l.max.z, r.max.z));
+        }
+        node.min = mn;
+        node.max = mx;
+    }
+    builtGeometry = PropertyChangeQueue::geometryVersion();
+    refits++;
+}
+
+// ====================================================================
+// 走査
+// ====================================================================
+
+bool SpatialQuery::accepts(const Item& item, const QueryParams& params) const {
+    if (!item.owner || !item.owner->isActive()) return false;
+    if (params.respectCanCollide && !item.canCollide) return false;
+    if (params.filter.empty()) return !params.include;
+    bool listed = false;
+    for (const Instance* a = item.owner; a && !listed; a = a->Parent) {
+        listed = std::find(params.filter.begin(), params.filter.end(), a) != params.filter.end();
+    }
+    return listed == params.include;
+}
+
+void SpatialQuery::setTerrainHit(QueryHit& hit) const {
+    hit.part = nullptr;
+    Vector3 inside = hit.position - hit.normal * (Terrain::kVoxelSize * 0.5f);
+    hit.material = terrain->getVoxel(Terrain::toVoxel(inside.x), Terrain::toVoxel(inside.y), Terrain::toVoxel(inside.z));
+}
+
+template <typename Leaf>
+void SpatialQuery::sweep(const Vector3& origin, const Vector3& dir, const Vector3& expand,
+                         const float& best, Leaf&& leaf) const {
+    for (uint32_t p = treePacks; p < packs.size(); ++p) leaf(p, (uint32_t)kLanes);
+    if (nodes.empty()) return;
+    Vector3 inv(safeInverse(dir.x), safeInverse(dir.y), safeInverse(dir.z));
+    float tRoot;
+    if (!slab(origin, inv, nodes[0].min, nodes[0].max, expand, best, tRoot)) return;
+
+    uint32_t stack[kMaxDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (node.count) {
+            leaf(node.first, node.count);
+            continue;
+        }
+        uint32_t left = (uint32_t)(&node - nodes.data()) + 1, right = node.first;
+        float tl, tr;
+        bool hitL = slab(origin, inv, nodes[left].min, nodes[left].max, expand, best, tl);
+        bool hitR = slab(origin, inv, nodes[right].min, nodes[right].max, expand, best, tr);
+        // 近い方を後に積む（先に調べて best を縮める）
+        if (hitL && hitR) {
+            if (tl <= tr) { stack[top++] = right; stack[top++] = left; }
+            else          { stack[top++] = left;  stack[top++] = right; }
+        } else if (hitL) {
+            stack[top++] = left;
+        } else if (hitR) {
+            stack[top++] = right;
+        }
+    }
+}
+
+template <typename Leaf>
+void SpatialQuery::overlap(const Vector3& mn, const Vector3& mx, Leaf&& leaf) const {
+    for (uint32_t p = treePacks; p < packs.size(); ++p) {
+        if (!leaf(p, (uint32_t)kLanes)) return;
+    }
+    if (nodes.empty()) return;
+    uint32_t stack[kMaxDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        uint32_t index = stack[--top];
+        const Node& node = nodes[index];
+        if (node.max.x < mn.x || node.min.x > mx.x || node.max.y < mn.y || node.min.y > mx.y ||
+            node.max.z < mn.z || node.min.z > mx.z) continue;
+        if (node.count) {
+            if (!leaf(node.first, node.count)) return;
+            continue;
+        }
+        stack[top++] = node.first;
+        stack[top++] = index + 1;
+    }
+}
+
+// ====================================================================
+// レイ
+// ====================================================================
+
+bool SpatialQuery::castRay(const Vector3& origin, const Vector3& direction, const QueryParams& params,
+                           QueryHit& hit) const {
+    hit = QueryHit();
+    float length = direction.length();
+    if (length <= 0.0f) return false;
+    Vector3 dir = direction / length;
+
+    float best = length;
+    int bestItem = -1;
+    Vector3 meshNormal;
+    bool meshHit = false;
+    sweep(origin, dir, Vector3(0, 0, 0), best, [&](uint32_t pack, uint32_t count) {
+        float tEnter[kLanes], tExit[kLanes];
+        rayPack(packs[pack], origin, dir, 0.0f, tEnter, tExit);
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            float t = tEnter[lane];
+            const Item& item = items[pack * kLanes + lane];
+            if (item.last.shape == PartShape::Mesh) {
+                // MeshPart は箱に当たったら三角形で確かめる（始点が箱の中でも、形の外なら当たる）
+                if (tExit[lane] < 0.0f || t > best || tExit[lane] < t) continue;
+                if (!accepts(item, params)) continue;
+                float tMesh;
+                Vector3 n;
+                if (!raycastMeshPart(item.last, origin, dir, best, tMesh, n)) continue;
+                best = tMesh;
+                bestItem = (int)(pack * kLanes + lane);
+                meshNormal = n;
+                meshHit = true;
+                continue;
+            }
+            // 始点が中に入っている（入り口が後ろ）パーツには当たらない
+            if (t < 0.0f || t > best) continue;
+            if (!accepts(item, params)) continue;
+            best = t;
+            bestItem = (int)(pack * kLanes + lane);
+            meshHit = false;
+        }
+    });
+
+    OrientedBox bestBox;
+    if (usesTerrain(params)) {
+        Vector3 inv(safeInverse(dir.x), safeInverse(dir.y), safeInverse(dir.z));
+        Vector3 mn, mx;
+        sweptBounds(origin, origin + dir * best, Vector3(0, 0, 0), mn, mx);
+        terrain->forEachBox(mn, mx, [&](const TerrainBox& b) {
+            float t;
+            if (!slab(origin, inv, b.min, b.max, Vector3(0, 0, 0), best, t) || t < 0.0f) return;
+            best = t;
+            bestItem = kTerrainHit;
+            bestBox = terrainBox(b);
+        });
+    }
+    if (bestItem == -1) return false;
+
+    hit.distance = best;
+    hit.position = origin + dir * best;
+    if (bestItem == kTerrainHit) {
+        hit.normal = entryNormal(bestBox, origin, dir);
+        setTerrainHit(hit);
+        return true;
+    }
+    const Item& item = items[bestItem];
+    hit.part = item.owner;
+    hit.normal = meshHit ? meshNormal : entryNormal(laneBox(packs[bestItem / kLanes], bestItem % kLanes), origin, dir);
+    return true;
+}
+
+bool SpatialQuery::raycast(const Vector3& origin, const Vector3& direction, const QueryParams& params,
+                           QueryHit& hit) {
+    refresh();
+    return castRay(origin, direction, params, hit);
+}
+
+void SpatialQuery::raycastBatch(const QueryRay* rays, size_t count, QueryHit* hits, const QueryParams& params) {
+    refresh();
+    // 1本は数マイクロ秒なので、まとめて1ジョブにする
+    const size_t kChunk = 64;
+    size_t jobs = (count + kChunk - 1) / kChunk;
+    if (jobs > 1) {
+        JobSystem::get().parallelFor(jobs, [&](size_t job) {
+            size_t end = std::min(count, (job + 1) * kChunk);
+            for (size_t i = job * kChunk; i < end; ++i) castRay(rays[i].origin, rays[i].direction, params, hits[i]);
+        });
+    } else {
+        for (size_t i = 0; i < count; ++i) castRay(rays[i].origin, rays[i].direction, params, hits[i]);
+    }
+}
+
+// ====================================================================
+// 形状の投射
+// ====================================================================
+
+// 球と箱の距離は1進むごとに高々1しか縮まないので、距離の分だけ進めても突き抜けない
+// （保守的前進）。始点は半径だけ広げた箱の入り口から
+bool SpatialQuery::spherecast(const Vector3& origin, float radius, const Vector3& direction,
+                              const QueryParams& params, QueryHit& hit) {
+    refresh();
+    hit = QueryHit();
+    float length = direction.length();
+    if (length <= 0.0f || radius < 0.0f) return false;
+    Vector3 dir = direction / length;
+
+    float best = length;
+    int bestItem = -1;
+    Vector3 bestPoint;
+    // 箱の広げた範囲 [tEnter, tExit] の中で当たる所を探し、best より近ければ取る
+    auto advance = [&](const OrientedBox& box, float tEnter, float tExit) {
+        if ((closestPoint(box, origin) - origin).lengthSquared() <= radius * radius) return false;   // 始めから重なっている
+
+        float t = std::max(0.0f, tEnter);
+        float limit = std::min(best, tExit);
+        for (int iter = 0; iter < 64 && t <= limit; ++iter) {
+            Vector3 p = origin + dir * t;
+            Vector3 q = closestPoint(box, p);
+            float gap = (p - q).length() - radius;
+            if (gap < 1e-4f) {
+                best = t;
+                bestPoint = q;
+                return true;
+            }
+            // 箱までの距離は t について凸なので、接線が 0 になる所まで進んでも通り過ぎない
+            // （面に向かうなら1回で着く）。離れていくなら当たらない
+            float closing = -dir.dot(p - q) / (gap + radius);
+            if (closing <= 1e-6f) break;
+            t += gap / closing;
+        }
+        return false;
+    };
+    sweep(origin, dir, Vector3(radius, radius, radius), best, [&](uint32_t pack, uint32_t count) {
+        float tEnter[kLanes], tExit[kLanes];
+        rayPack(packs[pack], origin, dir, radius, tEnter, tExit);
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            if (tEnter[lane] > best || tExit[lane] < 0.0f) continue;
+            const Item& item = items[pack * kLanes + lane];
+            if (!accepts(item, params)) continue;
+            if (advance(laneBox(packs[pack], lane), tEnter[lane], tExit[lane])) bestItem = (int)(pack * kLanes + lane);
+        }
+    });
+    if (usesTerrain(params)) {
+        Vector3 mn, mx;
+        sweptBounds(origin, origin + dir * best, Vector3(radius, radius, radius), mn, mx);
+        terrain->forEachBox(mn, mx, [&](const TerrainBox& b) {
+            if (advance(terrainBox(b), 0.0f, best)) bestItem = kTerrainHit;
+        });
+    }
+    if (bestItem == -1) return false;
+
+    Vector3 center = origin + dir * best;
+    hit.distance = best;
+    hit.position = bestPoint;
+    Vector3 n = center - bestPoint;
+    hit.normal = n.lengthSquared() > 1e-12f ? n.normalized() : dir * -1.0f;
+    if (bestItem == kTerrainHit) setTerrainHit(hit);
+    else hit.part = items[bestItem].owner;
+    return true;
+}
+
+bool SpatialQuery::capsulecast(const Vector3& a, const Vector3& b, float radius, const Vector3& direction,
+                               const QueryParams& params, QueryHit& hit) {
+    refresh();
+    return castCapsule(a, b, radius, direction, params, hit);
+}
+
+// 球と同じく、カプセルを広げた箱に入る所から芯の線分と箱の距離だけ進める
+bool SpatialQuery::castCapsule(const Vector3& a, const Vector3& b, float radius, const Vector3& direction,
+                               const QueryParams& params, QueryHit& hit) const {
+    hit = QueryHit();
+    float length = direction.length();
+    if (length <= 0.0f || radius < 0.0f) return false;
+    Vector3 dir = direction / length;
+    Vector3 center = (a + b) * 0.5f;
+    Vector3 half = (b - a) * 0.5f;
+    Vector3 expand(std::abs(half.x) + radius, std::abs(half.y) + radius, std::abs(half.z) + radius);
+
+    float best = length;
+    int bestItem = -1;
+    Vector3 bestSegment, bestPoint;
+    auto advance = [&](const OrientedBox& box, float tEnter, float tExit) {
+        Vector3 s, q;
+        if (segmentBoxDistance(box, a, b, s, q) <= radius) return false;   // 始めから重なっている
+
+        float t = std::max(0.0f, tEnter);
+        float limit = std::min(best, tExit);
+        for (int iter = 0; iter < 64 && t <= limit; ++iter) {
+            Vector3 offset = dir * t;
+            float gap = segmentBoxDistance(box, a + offset, b + offset, s, q) - radius;
+            if (gap < 1e-4f) {
+                best = t;
+                bestSegment = s;
+                bestPoint = q;
+                return true;
+            }
+            // 箱までの距離は t について凸なので、接線が 0 になる所まで進んでも通り過ぎない
+            // （面に向かうなら1回で着く）。離れていくなら当たらない
+            float closing = -dir.dot(s - q) / (gap + radius);
+            if (closing <= 1e-6f) break;
+            t += gap / closing;
+        }
+        return false;
+    };
+    sweep(center, dir, expand, best, [&](uint32_t pack, uint32_t count) {
+        float tEnter[kLanes], tExit[kLanes];
+        capsulePack(packs[pack], center, dir, half, radius, tEnter, tExit);
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            if (tEnter[lane] > best || tExit[lane] < 0.0f) continue;
+            const Item& item = items[pack * kLanes + lane];
+            if (!accepts(item, params)) continue;
+            if (advance(laneBox(packs[pack], lane), tEnter[lane], tExit[lane])) bestItem = (int)(pack * kLanes + lane);
+        }
+    });
+    if (usesTerrain(params)) {
+        Vector3 mn, mx;
+        sweptBounds(center, center + dir * best, expand, mn, mx);
+        terrain->forEachBox(mn, mx, [&](const TerrainBox& tb) {
+            if (advance(terrainBox(tb), 0.0f, best)) bestItem = kTerrainHit;
+        });
+    }
+    if (bestItem == -1) return false;
+
+    hit.distance = best;
+    hit.position = bestPoint;
+    Vector3 n = bestSegment - bestPoint;
+    hit.normal = n.lengthSquared() > 1e-12f ? n.normalized() : dir * -1.0f;
+    if (bestItem == kTerrainHit) setTerrainHit(hit);
+    else hit.part = items[bestItem].owner;
+    return true;
+}
+
+void SpatialQuery::capsuleContacts(const Vector3& a, const Vector3& b, float radius, const QueryParams& params,
+                                   std::vector<QueryHit>& out) const {
+    out.clear();
+    Vector3 mn(std::min(a.x, b.x) - radius, std::min(a.y, b.y) - radius, std::min(a.z, b.z) - radius);
+    Vector3 mx(std::max(a.x, b.x) + radius, std::max(a.y, b.y) + radius, std::max(a.z, b.z) + radius);
+    Vector3 center = (a + b) * 0.5f;
+    Vector3 half = (b - a) * 0.5f;
+    // めり込んでいれば contact に書いて true
+    auto penetration = [&](const OrientedBox& box, QueryHit& contact) {
+        // 箱の面の向きで離れていれば距離を測るまでもない（立っている地面など）
+        Vector3 rel = center - box.c;
+        for (int i = 0; i < 3; ++i) {
+            if (std::abs(rel.dot(box.axis[i])) >= box.h[i] + std::abs(half.dot(box.axis[i])) + radius) return false;
+        }
+
+        Vector3 s, q;
+        float d = segmentBoxDistance(box, a, b, s, q);
+        if (d >= radius) return false;
+
+        contact.position = q;
+        if (d > 1e-5f) {
+            contact.normal = (s - q) / d;
+            contact.distance = radius - d;
+        } else {
+            // 芯が箱の中: 一番浅い面から押し出す
+            Vector3 local = s - box.c;
+            float shallowest = std::numeric_limits<float>::infinity();
+            for (int i = 0; i < 3; ++i) {
+                float l = local.dot(box.axis[i]);
+                float depth = box.h[i] - std::abs(l);
+                if (depth < shallowest) {
+                    shallowest = depth;
+                    contact.normal = box.axis[i] * (l >= 0.0f ? 1.0f : -1.0f);
+                }
+            }
+            contact.distance = shallowest + radius;
+        }
+        return true;
+    };
+    overlap(mn, mx, [&](uint32_t pack, uint32_t count) {
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            const Item& item = items[pack * kLanes + lane];
+            if (!accepts(item, params)) continue;
+            if (item.min.x > mx.x || item.max.x < mn.x || item.min.y > mx.y || item.max.y < mn.y ||
+                item.min.z > mx.z || item.max.z < mn.z) continue;
+
+            QueryHit contact;
+            if (!penetration(laneBox(packs[pack], lane), contact)) continue;
+            contact.part = item.owner;
+            out.push_back(contact);
+        }
+        return true;
+    });
+    if (usesTerrain(params)) {
+        terrain->forEachBox(mn, mx, [&](const TerrainBox& tb) {
+            QueryHit contact;
+            if (!penetration(terrainBox(tb), contact)) return;
+            setTerrainHit(contact);
+            out.push_back(contact);
+        });
+    }
+}
+
+bool SpatialQuery::blockcast(const Vector3& center, const Vector3& rotation, const Vector3& size,
+                             const Vector3& direction, const QueryParams& params, QueryHit& hit) {
+    refresh();
+    hit = QueryHit();
+    float length = direction.length();
+    if (length <= 0.0f) return false;
+    Vector3 dir = direction / length;
+
+    OrientedBox cast = makeBox(center, rotation, size);
+    float best = length;
+    int bestItem = -1;
+    Vector3 bestNormal;
+    sweep(center, dir, boxExtent(cast), best, [&](uint32_t pack, uint32_t count) {
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            const Item& item = items[pack * kLanes + lane];
+            if (!accepts(item, params)) continue;
+            float s;
+            Vector3 normal;
+            if (!sweepBoxes(cast, laneBox(packs[pack], lane), direction, s, normal)) continue;
+            float t = s * length;
+            if (t > best) continue;
+            best = t;
+            bestItem = (int)(pack * kLanes + lane);
+            bestNormal = normal;
+        }
+    });
+    OrientedBox bestBox;
+    if (usesTerrain(params)) {
+        Vector3 mn, mx;
+        sweptBounds(center, center + dir * best, boxExtent(cast), mn, mx);
+        terrain->forEachBox(mn, mx, [&](const TerrainBox& tb) {
+            OrientedBox target = terrainBox(tb);
+            float s;
+            Vector3 normal;
+            if (!sweepBoxes(cast, target, direction, s, normal)) return;
+            float t = s * length;
+            if (t > best) return;
+            best = t;
+            bestItem = kTerrainHit;
+            bestNormal = normal;
+            bestBox = target;
+        });
+    }
+    if (bestItem == -1) return false;
+
+    // 当たった時の箱の中心に一番近い、相手の表面の点を接触点にする
+    Vector3 moved = center + dir * best;
+    hit.distance = best;
+    hit.normal = bestNormal;
+    if (bestItem == kTerrainHit) {
+        hit.position = closestPoint(bestBox, moved);
+        setTerrainHit(hit);
+        return true;
+    }
+    hit.part = items[bestItem].owner;
+    hit.position = closestPoint(laneBox(packs[bestItem / kLanes], bestItem % kLanes), moved);
+    return true;
+}
+
+// ====================================================================
+// 重なり
+// ====================================================================
+
+void SpatialQuery::partsInRegion(const Vector3& mn, const Vector3& mx, const QueryParams& params,
+                                 std::vector<Cube*>& out) {
+    refresh();
+    out.clear();
+    overlap(mn, mx, [&](uint32_t pack, uint32_t count) {
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            const Item& it = items[pack * kLanes + lane];
+            if (it.max.x < mn.x || it.min.x > mx.x || it.max.y < mn.y || it.min.y > mx.y ||
+                it.max.z < mn.z || it.min.z > mx.z) continue;
+            if (!accepts(it, params)) continue;
+            out.push_back(it.owner);
+            if (out.size() >= params.maxParts) return false;
+        }
+        return true;
+    });
+}
+
+void SpatialQuery::partsInRadius(const Vector3& center, float radius, const QueryParams& params,
+                                 std::vector<Cube*>& out) {
+    refresh();
+    out.clear();
+    Vector3 r(radius, radius, radius);
+    overlap(center - r, center + r, [&](uint32_t pack, uint32_t count) {
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            const Item& it = items[pack * kLanes + lane];
+            OrientedBox box = laneBox(packs[pack], lane);
+            if ((closestPoint(box, center) - center).lengthSquared() > radius * radius) continue;
+            if (!accepts(it, params)) continue;
+            out.push_back(it.owner);
+            if (out.size() >= params.maxParts) return false;
+        }
+        return true;
+    });
+}
+
+void SpatialQuery::partsInBox(const Vector3& center, const Vector3& rotation, const Vector3& size,
+                              const QueryParams& params, std::vector<Cube*>& out) {
+    refresh();
+    out.clear();
+    OrientedBox query = makeBox(center, rotation, size);
+    Vector3 e = boxExtent(query);
+    overlap(center - e, center + e, [&](uint32_t pack, uint32_t count) {
+        for (uint32_t lane = 0; lane < count; ++lane) {
+            const Item& it = items[pack * kLanes + lane];
+            if (!boxesOverlap(query, laneBox(packs[pack], lane))) continue;
+            if (!accepts(it, params)) continue;
+            out.push_back(it.owner);
+            if (out.size() >= params.maxParts) return false;
+        }
+        return true;
+    });
+}
@@ -0,0 +1,172 @@
+// src/Physics/SpatialQuery.hpp
+#ifndef SPATIALQUERY_HPP
+#define SPATIALQUERY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Math/MathUtils.hpp"
+#include "src/Game/ComponentStore.hpp"
+#include "src/Game/Terrain.hpp"
+
+class Instance;
+struct Cube;
+
+// 絞り込み（Roblox の RaycastParams / OverlapParams）
+struct QueryParams {
+    std::vector<const Instance*> filter;   // 対象から外す（include なら対象にする）Instance とその子孫
+    bool include = false;
+    bool respectCanCollide = false;        // CanCollide=false のパーツを無視する
+    bool ignoreTerrain = false;            // 地形に当たらない（include の絞り込みでは常に当たらない）
+    size_t maxParts = SIZE_MAX;            // 重なりクエリで返す最大数
+};
+
+struct QueryRay {
+    Vector3 origin;
+    Vector3 direction;   // 長さが最大距離
+};
+
+struct QueryHit {
+    Cube* part = nullptr;          // 当たらない・地形に当たったら nullptr
+    TerrainMaterial material = TerrainMaterial::Air;   // 地形に当たったらその素材
+    Vector3 position = Vector3(0, 0, 0);
+    Vector3 normal = Vector3(0, 0, 0);
+    float distance = 0.0f;
+};
+
+// ===================================================================
+// SpatialQuery: レイ・形状の投射と重なりの問い合わせ
+//
+// 全パーツの AABB から BVH を作り、葉には最大4個の OBB を成分ごとの配列で並べる
+// （1本のレイと4個の箱のスラブ判定を同じ命令で回せる形。コンパイラが SSE / NEON にする）。
+// 木は問い合わせの時に古ければ取り直す:
+//   位置・回転・サイズの変更（PropertyChangeQueue::geometryVersion）: 動いた箱と節点の AABB の付け直し
+//   パーツの追加・削除・構成の変更（layoutVersion）: 構成要素を引き直し、消えたものは空きにし、
+//     増えたものは木の外の「はみ出し」の葉に入れる（問い合わせのたびに全部調べる）。
+//     はみ出し・空きが増えすぎたら作り直す
+// 物理の後のフレームの最初の問い合わせで1回付け直し、あとは木を読むだけになる
+//
+// 始点がパーツの中にあるレイ・形状は、そのパーツには当たらない（Roblox と同じ）
+// パーツの形（Transform::shape）は見ず、どれも大きさの箱として扱う。
+// ただしレイは MeshPart の箱に当たったら、そのメッシュの BVH で三角形まで確かめる
+//
+// 地形は木に入れず、パーツを調べた後に、その時点の一番近い当たりまでの範囲と重なる
+// 塊の当たり判定の箱（Terrain::forEachBox）を同じ判定で調べる。重なりのクエリ（GetPartsIn*）は
+// パーツだけを返す
+// ===================================================================
+class SpatialQuery {
+public:
+    explicit SpatialQuery(ComponentStore& store, const Terrain* terrain = nullptr) : store(store), terrain(terrain) {}
+
+    SpatialQuery(const SpatialQuery&) = delete;
+    SpatialQuery& operator=(const SpatialQuery&) = delete;
+
+    bool raycast(const Vector3& origin, const Vector3& direction, const QueryParams& params, QueryHit& hit);
+    // hits[i] に rays[i] の結果を書く。本数が多ければ JobSystem で並列に投げる
+    void raycastBatch(const QueryRay* rays, size_t count, QueryHit* hits, const QueryParams& params);
+
+    // 半径 radius の球 / 中心 center・向き rotation（オイラー角）・大きさ size の箱を direction だけ動かす
+    bool spherecast(const Vector3& origin, float radius, const Vector3& direction,
+                    const QueryParams& params, QueryHit& hit);
+    bool blockcast(const Vector3& center, const Vector3& rotation, const Vector3& size,
+                   const Vector3& direction, const QueryParams& params, QueryHit& hit);
+
+    // 線分 [a, b] を芯にした半径 radius のカプセルを direction だけ動かす
+    bool capsulecast(const Vector3& a, const Vector3& b, float radius, const Vector3& direction,
+                     const QueryParams& params, QueryHit& hit);
+
+    // AABB が [min, max] と重なるパーツ
+    void partsInRegion(const Vector3& min, const Vector3& max, const QueryParams& params, std::vector<Cube*>& out);
+    // 形が球・箱と重なるパーツ
+    void partsInRadius(const Vector3& center, float radius, const QueryParams& params, std::vector<Cube*>& out);
+    void partsInBox(const Vector3& center, const Vector3& rotation, const Vector3& size,
+                    const QueryParams& params, std::vector<Cube*>& out);
+
+    // 木を今のパーツに合わせる（問い合わせの中で呼ばれる。並列に問い合わせる前に呼んでおく）
+    void refresh();
+
+    // ---- 木を読むだけ（refresh() 済みであること。並列に呼んでよい） ----
+    bool castRay(const Vector3& origin, const Vector3& direction, const QueryParams& params, QueryHit& hit) const;
+    bool castCapsule(const Vector3& a, const Vector3& b, float radius, const Vector3& direction,
+                     const QueryParams& params, QueryHit& hit) const;
+    // カプセルにめり込んでいるパーツ。position は箱の上の一番近い点、normal は押し出す向き、
+    // distance はめり込みの深さ（out は空にしてから足す）
+    void capsuleContacts(const Vector3& a, const Vector3& b, float radius, const QueryParams& params,
+                         std::vector<QueryHit>& out) const;
+
+    size_t itemCount() const { return live; }
+    size_t nodeCount() const { return nodes.size(); }
+    uint64_t rebuildCount() const { return rebuilds; }
+
+private:
+    static const int kLanes = 4;           // 葉1つの OBB の数
+    static const int kMaxDepth = 64;       // 走査のスタック（中央で分けるので深さは log2(n/4) 程度）
+    static const uint32_t kRefitsPerRebuild = 240;   // 付け直しが続いたら作り直す（木の質が落ちる）
+    static const size_t kMaxLoose = 256;              // はみ出し（問い合わせのたびに全部調べる）がこれを超えたら作り直す
+
+    // 葉の OBB（4個分を成分ごとに。空きのレーンは大きさ -1 にして判定で弾く）
+    struct alignas(16) BoxPack {
+        float cx[kLanes], cy[kLanes], cz[kLanes];
+        float ax[3][kLanes], ay[3][kLanes], az[3][kLanes];   // 回転の列（ローカル軸 i のワールドの向き）
+        float h[3][kLanes];                                  // 半分の大きさ
+    };
+
+    struct Node {
+        Vector3 min, max;
+        uint32_t first;     // 葉: packs の添字（要素は items[first * kLanes + レーン]）。内部: 右の子（左は自分の次）
+        uint32_t count;     // 葉なら要素数（1..kLanes）、内部なら 0
+    };
+
+    struct Item {
+        EntityId entity;
+        Transform* transform;   // layoutVersion が変わるまで有効（変わったら entity から引き直す）
+        Cube* owner;            // 空きのレーンは nullptr
+        bool canCollide;
+        Transform last;         // 箱を作った時の値（変わったものだけ付け直す）
+        Vector3 min, max;
+    };
+
+    ComponentStore& store;
+    const Terrain* terrain;         // なければ nullptr
+    std::vector<Node> nodes;
+    std::vector<Item> items;        // 葉の順に kLanes 個ずつ（空きのレーンは owner == nullptr）
+    std::vector<BoxPack> packs;     // [0, treePacks) は木の葉、その後ろははみ出し
+    std::vector<uint32_t> itemOf;   // EntityId::index -> items の添字（entity が一致するときだけ有効）
+    uint32_t treePacks = 0;
+    size_t live = 0;                // 空きでない items の数
+    size_t loose = 0;               // はみ出しの数
+    uint64_t builtLayout = UINT64_MAX;
+    uint64_t builtGeometry = 0;
+    uint32_t refits = 0;
+    uint64_t rebuilds = 0;
+
+    void rebuild();
+    void relink();
+    void refit();
+    void appendLoose(const Item& item);
+    void clearLane(uint32_t item);
+    uint32_t buildNode(std::vector<uint32_t>& order, const std::vector<Item>& source, uint32_t begin, uint32_t end);
+    void writeLane(BoxPack& pack, int lane, Item& item);
+    void place(uint32_t index, const Item& item);   // items[index] に置き、箱を書く
+
+    bool accepts(const Item& item, const QueryParams& params) const;
+
+    // 地形も調べるか
+    bool usesTerrain(const QueryParams& params) const {
+        return terrain && !terrain->empty() && !params.ignoreTerrain && !params.include;
+    }
+    // 地形に当たった結果の素材を、当たった面の内側のボクセルから引く
+    void setTerrainHit(QueryHit& hit) const;
+
+    // origin から dir（正規化済み）へ best まで、expand だけ広げた節点を近い順に辿り、
+    // 葉（はみ出しは全部）ごとに leaf(packIndex, count) を呼ぶ（leaf は best を縮めてよい）
+    template <typename Leaf>
+    void sweep(const Vector3& origin, const Vector3& dir, const Vector3& expand, const float& best, Leaf&& leaf) const;
+    // [min, max] と重なる葉（はみ出しは全部）ごとに leaf(packIndex, count) を呼ぶ（false を返したら打ち切り）
+    template <typename Leaf>
+    void overlap(const Vector3& min, const Vector3& max, Leaf&& leaf) const;
+};
+
+#endif // SPATIALQUERY_HPP
@@ -0,0 +1,195 @@
+// src/Render/Lod.cpp
+#include "Lod.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <algorithm>
+
+#include "src/Game/GameData.hpp"
+
+namespace {
+
+// 4 バイトずつ混ぜる（FNV-1a を語単位にしたもの。塊の中身が変わったかを見るだけなので十分）
+uint64_t hashWords(uint64_t h, const void* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        uint32_t w;
+        std::memcpy(&w, p + i, 4);
+        h = (h ^ w) * 1099511628211ull;
+    }
+    for (; i < size; ++i) h = (h ^ p[i]) * 1099511628211ull;
+    return h;
+}
+
+int64_t clusterKey(const Vector3& pos, float cellSize) {
+    // 格子の座標を 21 ビットずつ詰める（±100 万升まで）
+    auto cell = [cellSize](float v) { return (int64_t)std::floor(v / cellSize) & 0x1fffff; };
+    return (cell(pos.x) << 42) | (cell(pos.y) << 21) | cell(pos.z);
+}
+
+} // namespace
+
+float projectedPixels(float radius, float distance) {
+    static const float tanHalfFov = std::tan(FOV_Y * 0.5f * (float)M_PI / 180.0f);
+    if (distance <= radius) return 1e30f;
+    return radius * SCREEN_H / (distance * tanHalfFov);
+}
+
+int selectLod(int current, float pixels, const LodSettings& settings) {
+    if (!settings.enabled) return 0;
+    int level = 0;
+    while (level < kLodLevels - 1 && pixels < settings.levelPixels[level]) ++level;
+    if (current < 0 || current == level) return level;
+
+    // 閾値を (1 ± hysteresis) 倍越えるまでは今の段に留まる
+    if (level > current) {
+        // 粗くする: current と current+1 の境目を十分下回ったか
+        return pixels < settings.levelPixels[current] * (1.0f - settings.hysteresis) ? level : current;
+    }
+    // 細かくする: current-1 と current の境目を十分上回ったか
+    return pixels > settings.levelPixels[current - 1] * (1.0f + settings.hysteresis) ? level : current;
+}
+
+bool beyondFarPlane(const Vector3& center, float radius, const Vector3& eye) {
+    return (center - eye).length() - radius > Z_FAR;
+}
+
+// ====================================================================
+// LodClusters
+// ====================================================================
+
+bool LodClusters::isMember(const Archetype& arch, size_t row) {
+    if (!arch.has(Comp_Transform | Comp_Renderable | Comp_Anchored)) return false;
+    const Renderable& r = arch.renderables[row];
+    return r.transparency < 0.01f && arch.owners[row]->isActive();
+}
+
+void LodClusters::setTileCount(int count) {
+    for (LodCluster& c : list) {
+        c.tile = -1;
+        c.impostor = false;
+    }
+    freeTiles.clear();
+    for (int i = count - 1; i >= 0; --i) freeTiles.push_back(i);
+}
+
+void LodClusters::releaseTile(LodCluster& c) {
+    if (c.tile >= 0) freeTiles.push_back(c.tile);
+    c.tile = -1;
+}
+
+void LodClusters::update(const ComponentStore& store, const Vector3& eye, const LodSettings& settings) {
+    // 格子の大きさが変わったら塊を作り直す
+    if (settings.clusterSize != builtClusterSize) {
+        for (LodCluster& c : list) releaseTile(c);
+        list.clear();
+        byKey.clear();
+        builtClusterSize = settings.clusterSize;
+    }
+
+    // 中身を集め直す（並びの近いパーツは同じ升のことが多いので、直前の升は引かずに使う）
+    for (LodCluster& c : list) c.members.clear();
+    int64_t lastKey = 0;
+    uint32_t lastIndex = UINT32_MAX;
+    store.forEach(Comp_Transform | Comp_Renderable | Comp_Anchored, [&](const Archetype& arch) {
+        for (size_t i = 0; i < arch.size(); ++i) {
+            if (!isMember(arch, i)) continue;
+            const Transform& t = arch.transforms[i];
+            int64_t key = clusterKey(t.pos, settings.clusterSize);
+            if (lastIndex == UINT32_MAX || key != lastKey) {
+                auto it = byKey.find(key);
+                if (it == byKey.end()) {
+                    it = byKey.emplace(key, (uint32_t)list.size()).first;
+                    list.emplace_back();
+                    list.back().key = key;
+                }
+                lastKey = key;
+                lastIndex = it->second;
+            }
+            list[lastIndex].members.push_back({ arch.entities[i], &t, &arch.renderables[i] });
+        }
+    });
+    removeEmpty();
+
+    const float cosRecapture = std::cos(settings.recaptureDegrees * (float)M_PI / 180.0f);
+    const bool useImpostors = settings.enabled && settings.impostorPixels > 0.0f;
+    impostors = 0;
+    captures = 0;
+    culled = 0;
+    for (LodCluster& c : list) {
+        // 範囲（パーツの箱を囲む球の AABB）と中身のハッシュ
+        Vector3 mn(1e30f, 1e30f, 1e30f), mx(-1e30f, -1e30f, -1e30f);
+        uint64_t h = 1469598103934665603ull;
+        for (const LodCluster::Member& m : c.members) {
+            const Transform& t = *m.transform;
+            float r = 0.5f * t.size.length();
+            mn = Vector3(std::min(mn.x, t.pos.x - r), std::min(mn.y, t.pos.y - r), std::min(mn.z, t.pos.z - r));
+            mx = Vector3(std::max(mx.x, t.pos.x + r), std::max(mx.y, t.pos.y + r), std::max(mx.z, t.pos.z + r));
+
+            const Renderable& rd = *m.renderable;
+            uint32_t shape[2] = { (uint32_t)t.shape, t.mesh };
+            h = hashWords(h, &m.entity, sizeof(m.entity));
+            h = hashWords(h, &t.pos, 3 * sizeof(Vector3));   // pos, rotation, size
+            h = hashWords(h, shape, sizeof(shape));
+            h = hashWords(h, &rd.color, sizeof(Vector3));
+            h = hashWords(h, rd.texturePath.data(), rd.texturePath.size());
+        }
+        c.center = (mn + mx) * 0.5f;
+        c.radius = (mx - mn).length() * 0.5f;
+        c.signature = h;
+        c.capture = false;
+        c.culled = settings.enabled && beyondFarPlane(c.center, c.radius, eye);
+        if (c.culled) {
+            releaseTile(c);
+            c.impostor = false;
+            culled++;
+            continue;
+        }
+
+        Vector3 toEye = eye - c.center;
+        float distance = toEye.length();
+        float pixels = projectedPixels(c.radius, distance);
+        float threshold = settings.impostorPixels * (c.impostor ? 1.0f + settings.hysteresis : 1.0f - settings.hysteresis);
+        if (!useImpostors || pixels >= threshold || (c.tile < 0 && freeTiles.empty())) {
+            releaseTile(c);
+            c.impostor = false;
+            continue;
+        }
+
+        // 中身が同じで向きもほぼ同じなら前の板をそのまま使う。ずれたら上限の数まで焼き直す
+        Vector3 dir = toEye * (1.0f / distance);
+        bool fresh = c.tile >= 0 && c.capturedSignature == c.signature;
+        if ((!fresh || c.captureDir.dot(dir) < cosRecapture) && (int)captures < settings.capturesPerFrame) {
+            if (c.tile < 0) {
+                c.tile = freeTiles.back();
+                freeTiles.pop_back();
+            }
+            c.capture = true;
+            c.captureDir = dir;
+            c.capturedSignature = c.signature;
+            captures++;
+            fresh = true;
+        }
+        // 焼けなかった（上限に達した）ときは、中身が変わっていれば形のまま描く
+        c.impostor = fresh;
+        if (fresh) impostors++;
+    }
+}
+
+void LodClusters::removeEmpty() {
+    for (size_t i = 0; i < list.size();) {
+        if (!list[i].members.empty()) {
+            ++i;
+            continue;
+        }
+        releaseTile(list[i]);
+        byKey.erase(list[i].key);
+        if (i + 1 != list.size()) {
+            list[i] = std::move(list.back());
+            byKey[list[i].key] = (uint32_t)i;
+        }
+        list.pop_back();
+    }
+}
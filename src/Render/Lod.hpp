@@ -0,0 +1,125 @@
+// src/Render/Lod.hpp
+#ifndef LOD_HPP
+#define LOD_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+#include "src/Math/Vector3.hpp"
+#include "src/Game/ComponentStore.hpp"
+
+// ===================================================================
+// 描画の詳細度（LOD）
+//
+// パーツが画面に映る大きさ（直径のピクセル数）で、描く三角形の細かさを選ぶ。
+//   0: そのまま  1: 粗い  2: 一番粗い
+// 球・円柱は分割を減らし、メッシュは頂点をまとめる（simplifyMesh）。箱・くさびは 1 段だけ。
+// 閾値の前後で行き来してちらつかないよう、粗くするときは閾値の (1 - hysteresis) 倍を、
+// 細かくするときは (1 + hysteresis) 倍を越えるまで待つ。
+//
+// 固定パーツは clusterSize の立方体の格子ごとに塊（LodCluster）にまとめ、塊がさらに小さく
+// 映るときはアトラスに焼いた板（インポスター）1 枚で描く。Z_FAR より遠いパーツ・塊は描かない。
+// ここは GL を触らず、どの塊を板にするか・いつ焼くかだけを決める（焼く・描くのは Renderer）
+// ===================================================================
+static const int kLodLevels = 3;
+
+struct LodSettings {
+    bool enabled = true;
+    float levelPixels[kLodLevels - 1] = { 120.0f, 40.0f };   // これより小さく映ると次の段
+    float impostorPixels = 80.0f;    // 塊がこれより小さく映ると板にする（0 なら使わない）
+    float hysteresis = 0.15f;
+    float clusterSize = 128.0f;      // 塊の一辺（スタッド）
+    float recaptureDegrees = 8.0f;   // 焼いたときの向きからこれ以上ずれたら焼き直す
+    int capturesPerFrame = 8;        // 1 フレームに焼く塊の上限
+};
+
+// 半径 radius の球を distance 先に置いたときの、画面での直径（ピクセル。FOV_Y・SCREEN_H で）
+float projectedPixels(float radius, float distance);
+
+// 今の段 current（-1 なら初めて）から、映る大きさ pixels に合う段を選ぶ
+int selectLod(int current, float pixels, const LodSettings& settings);
+
+// 中心 center・半径 radius の球が、目 eye から見て全て Z_FAR より遠いか
+bool beyondFarPlane(const Vector3& center, float radius, const Vector3& eye);
+
+// パーツごとの今の段。エンティティのスロット番号で引き、世代が違えば初めてとして扱う
+class LodSelector {
+public:
+    int update(EntityId e, float pixels, const LodSettings& settings) {
+        if (states.size() <= e.index) states.resize(e.index + 1);
+        State& s = states[e.index];
+        int current = s.generation == e.generation ? s.level : -1;
+        s.generation = e.generation;
+        s.level = (int8_t)selectLod(current, pixels, settings);
+        return s.level;
+    }
+    void clear() { states.clear(); }
+
+private:
+    struct State {
+        uint32_t generation = 0;
+        int8_t level = -1;
+    };
+    std::vector<State> states;
+};
+
+// 固定パーツの塊（格子の 1 升）
+struct LodCluster {
+    struct Member {
+        EntityId entity;
+        const Transform* transform;     // このフレームの間だけ有効
+        const Renderable* renderable;
+    };
+
+    int64_t key = 0;
+    std::vector<Member> members;
+    Vector3 center = Vector3(0, 0, 0);
+    float radius = 0.0f;                // 中身を全て含む球
+    uint64_t signature = 0;             // 中身（位置・回転・大きさ・形・色・テクスチャ）のハッシュ
+
+    bool culled = false;                // このフレームは描かない（Z_FAR より遠い）
+
+    // インポスター（フレームをまたいで引き継ぐ）
+    bool impostor = false;              // このフレームは板で描く
+    bool capture = false;               // このフレームに焼き直す（描く側が板を描く前に焼く）
+    int tile = -1;                      // アトラスの区画（-1 ならなし）
+    uint64_t capturedSignature = 0;
+    Vector3 captureDir = Vector3(0, 0, 1);   // 焼いた向き（塊の中心から目へ）
+};
+
+// ===================================================================
+// LodClusters: 固定パーツの塊の一覧
+// 毎フレーム update で中身を集め直し（固定パーツでもスクリプトで動かせるので、
+// 中身のハッシュが変わった塊だけ焼き直す）、板にするかを決める
+// ===================================================================
+class LodClusters {
+public:
+    // 塊の中身にするパーツ: 固定・不透明・親あり（描く側はこれらを塊から描き、個別には描かない）
+    static bool isMember(const Archetype& arch, size_t row);
+
+    // アトラスの区画の数（0 ならインポスターを使わない）
+    void setTileCount(int count);
+
+    void update(const ComponentStore& store, const Vector3& eye, const LodSettings& settings);
+
+    const std::vector<LodCluster>& clusters() const { return list; }
+    size_t impostorCount() const { return impostors; }
+    size_t culledCount() const { return culled; }
+    size_t captureCount() const { return captures; }
+
+private:
+    std::vector<LodCluster> list;
+    std::unordered_map<int64_t, uint32_t> byKey;   // 格子の座標 -> list の添字
+    std::vector<int> freeTiles;
+    float builtClusterSize = 0.0f;
+    size_t impostors = 0;
+    size_t captures = 0;
+    size_t culled = 0;
+
+    void releaseTile(LodCluster& c);
+    void removeEmpty();
+};
+
+#endif // LOD_HPP
@@ -7,6 +7,7 @@
 #include <cmath> 
 #include <algorithm>
 #include <cstring> 
+#include <cstddef>
 
 #define GL_SILENCE_DEPRECATION
 #include <GL/glew.h> 
@@ -19,7 +20,7 @@
 #include "stb_image.h"
 
 namespace {
-    std::map<std::string, unsigned int> textureCache; 
+    std::map<std::string, TextureRegion> regionCache;   // Renderer::getTexture
     unsigned int cachedWhiteTextureID = 0;
 
     float cubeVertices[] = {
@@ -66,19 +67,162 @@ namespace {
          0.5f,  0.5f,  0.5f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f,
         -0.5f,  0.5f,  0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f
     };
+
+    // 球・円柱・くさびの三角形（cubeVertices と同じ 位置3・法線3・UV2 の並び。
+    // どれも大きさ 1 の箱に収まる形で、init で作る）。球・円柱は LOD の段ごと
+    std::vector<float> ballVertices[kLodLevels];
+    std::vector<float> cylinderVertices[kLodLevels];
+    std::vector<float> wedgeVertices;
+
+    // LOD の段ごとの分割数と、メッシュを簡略化する格子（0 段目はそのまま）
+    const int kBallSlices[kLodLevels] = { 16, 10, 6 };
+    const int kBallStacks[kLodLevels] = { 12, 7, 4 };
+    const int kCylinderSegments[kLodLevels] = { 24, 12, 6 };
+    const int kMeshLodGrid[kLodLevels] = { 0, 32, 10 };
+
+    const GLfloat kLightPosition[] = { 100.0f, 200.0f, 100.0f, 1.0f };
+    const GLfloat kSkyColor[] = { 0.53f, 0.81f, 0.92f, 1.0f };
+
+    void pushVertex(std::vector<float>& v, float x, float y, float z, float nx, float ny, float nz, float u, float t) {
+        v.insert(v.end(), { x, y, z, nx, ny, nz, u, t });
+    }
+
+    // 半径 0.5 の UV 球
+    void buildBall(std::vector<float>& v, int slices, int stacks) {
+        v.clear();
+        auto point = [&](int i, int j) {
+            float theta = (float)M_PI * j / stacks;          // 上からの角度
+            float phi = 2.0f * (float)M_PI * i / slices;
+            float nx = std::sin(theta) * std::cos(phi), ny = std::cos(theta), nz = std::sin(theta) * std::sin(phi);
+            pushVertex(v, 0.5f * nx, 0.5f * ny, 0.5f * nz, nx, ny, nz, (float)i / slices, 1.0f - (float)j / stacks);
+        };
+        for (int j = 0; j < stacks; ++j) {
+            for (int i = 0; i < slices; ++i) {
+                point(i, j); point(i + 1, j + 1); point(i + 1, j);
+                point(i, j); point(i, j + 1); point(i + 1, j + 1);
+            }
+        }
+    }
+
+    // X 軸向き、長さ 1・半径 0.5 の円柱（側面と両端の面）
+    void buildCylinder(std::vector<float>& v, int segments) {
+        v.clear();
+        for (int i = 0; i < segments; ++i) {
+            float a0 = 2.0f * (float)M_PI * i / segments, a1 = 2.0f * (float)M_PI * (i + 1) / segments;
+            float y0 = std::cos(a0), z0 = std::sin(a0), y1 = std::cos(a1), z1 = std::sin(a1);
+            float u0 = (float)i / segments, u1 = (float)(i + 1) / segments;
+            // 側面
+            pushVertex(v, -0.5f, 0.5f * y0, 0.5f * z0, 0, y0, z0, u0, 0);
+            pushVertex(v,  0.5f, 0.5f * y0, 0.5f * z0, 0, y0, z0, u0, 1);
+            pushVertex(v,  0.5f, 0.5f * y1, 0.5f * z1, 0, y1, z1, u1, 1);
+            pushVertex(v, -0.5f, 0.5f * y0, 0.5f * z0, 0, y0, z0, u0, 0);
+            pushVertex(v,  0.5f, 0.5f * y1, 0.5f * z1, 0, y1, z1, u1, 1);
+            pushVertex(v, -0.5f, 0.5f * y1, 0.5f * z1, 0, y1, z1, u1, 0);
+            // 両端の面
+            for (float x : { -0.5f, 0.5f }) {
+                float nx = x > 0.0f ? 1.0f : -1.0f;
+                pushVertex(v, x, 0, 0, nx, 0, 0, 0.5f, 0.5f);
+                pushVertex(v, x, 0.5f * y0, 0.5f * z0, nx, 0, 0, 0.5f + 0.5f * y0, 0.5f + 0.5f * z0);
+                pushVertex(v, x, 0.5f * y1, 0.5f * z1, nx, 0, 0, 0.5f + 0.5f * y1, 0.5f + 0.5f * z1);
+            }
+        }
+    }
+
+    // 組み込みの形の三角形（位置3・法線3・UV2）と、大きさ 1 の形を size の箱に収める拡大率。
+    // 球・円柱は大きさの箱に収まる分だけ（PartShape のコメント）。メッシュは持たないので false
+    bool shapeGeometry(PartShape shape, const Vector3& size, int lod, const float*& vertices, int& count, Vector3& scale) {
+        vertices = ::cubeVertices;
+        count = 36;
+        scale = size;
+        switch (shape) {
+            case PartShape::Ball: {
+                float d = std::min(size.x, std::min(size.y, size.z));
+                scale = Vector3(d, d, d);
+                vertices = ballVertices[lod].data();
+                count = (int)(ballVertices[lod].size() / 8);
+                return true;
+            }
+            case PartShape::Cylinder: {
+                float d = std::min(size.y, size.z);
+                scale = Vector3(size.x, d, d);
+                vertices = cylinderVertices[lod].data();
+                count = (int)(cylinderVertices[lod].size() / 8);
+                return true;
+            }
+            case PartShape::Wedge:
+                vertices = wedgeVertices.data();
+                count = (int)(wedgeVertices.size() / 8);
+                return true;
+            case PartShape::Mesh:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    // インポスターの板の向き: dir（塊から目へ）に垂直な右・上
+    void impostorBasis(const Vector3& dir, Vector3& right, Vector3& up) {
+        Vector3 worldUp = std::abs(dir.y) > 0.99f ? Vector3(0, 0, 1) : Vector3(0, 1, 0);
+        right = worldUp.cross(dir).normalized();
+        up = dir.cross(right);
+    }
+
+    // 底面と後ろ（+Z）の面を持ち、斜面が前の下の辺から後ろの上の辺へ上るくさび
+    void buildWedge(std::vector<float>& v) {
+        const float s = 0.70710678f;
+        v.clear();
+        // 底面 (-Y)
+        pushVertex(v, -0.5f, -0.5f, -0.5f, 0, -1, 0, 0, 0);
+        pushVertex(v,  0.5f, -0.5f, -0.5f, 0, -1, 0, 1, 0);
+        pushVertex(v,  0.5f, -0.5f,  0.5f, 0, -1, 0, 1, 1);
+        pushVertex(v, -0.5f, -0.5f, -0.5f, 0, -1, 0, 0, 0);
+        pushVertex(v,  0.5f, -0.5f,  0.5f, 0, -1, 0, 1, 1);
+        pushVertex(v, -0.5f, -0.5f,  0.5f, 0, -1, 0, 0, 1);
+        // 後ろ面 (+Z)
+        pushVertex(v, -0.5f, -0.5f,  0.5f, 0, 0, 1, 0, 0);
+        pushVertex(v,  0.5f, -0.5f,  0.5f, 0, 0, 1, 1, 0);
+        pushVertex(v,  0.5f,  0.5f,  0.5f, 0, 0, 1, 1, 1);
+        pushVertex(v, -0.5f, -0.5f,  0.5f, 0, 0, 1, 0, 0);
+        pushVertex(v,  0.5f,  0.5f,  0.5f, 0, 0, 1, 1, 1);
+        pushVertex(v, -0.5f,  0.5f,  0.5f, 0, 0, 1, 0, 1);
+        // 斜面
+        pushVertex(v, -0.5f, -0.5f, -0.5f, 0, s, -s, 0, 0);
+        pushVertex(v,  0.5f, -0.5f, -0.5f, 0, s, -s, 1, 0);
+        pushVertex(v,  0.5f,  0.5f,  0.5f, 0, s, -s, 1, 1);
+        pushVertex(v, -0.5f, -0.5f, -0.5f, 0, s, -s, 0, 0);
+        pushVertex(v,  0.5f,  0.5f,  0.5f, 0, s, -s, 1, 1);
+        pushVertex(v, -0.5f,  0.5f,  0.5f, 0, s, -s, 0, 1);
+        // 左右の三角形 (±X)
+        for (float x : { -0.5f, 0.5f }) {
+            float nx = x > 0.0f ? 1.0f : -1.0f;
+            pushVertex(v, x, -0.5f, -0.5f, nx, 0, 0, 0, 0);
+            pushVertex(v, x, -0.5f,  0.5f, nx, 0, 0, 1, 0);
+            pushVertex(v, x,  0.5f,  0.5f, nx, 0, 0, 1, 1);
+        }
+    }
 }
 
 Renderer::Renderer() : skyboxTextureID(0) {}
 
 Renderer::~Renderer() {
-    // 【修正】不要なキャストを削除
-    for (auto const& [key, val] : textureCache) {
-        glDeleteTextures(1, &val);
-    }
     if (cachedWhiteTextureID != 0) {
         glDeleteTextures(1, &cachedWhiteTextureID);
     }
-    textureCache.clear();
+    streamer.release();
+    regionCache.clear();
+    atlas.release();
+    for (const MeshBuffers& buf : meshBufferList) {
+        if (buf.vbo != 0) glDeleteBuffers(1, &buf.vbo);
+        for (int level = 0; level < kLodLevels; ++level) {
+            // 簡略化で減らなかった段は前の段のバッファを共有している
+            if (buf.ibo[level] != 0 && (level == 0 || buf.ibo[level] != buf.ibo[level - 1])) glDeleteBuffers(1, &buf.ibo[level]);
+        }
+    }
+    for (auto& entry : batches) releaseBatch(entry.second);
+    if (impostorFbo != 0) glDeleteFramebuffers(1, &impostorFbo);
+    if (impostorColor != 0) glDeleteRenderbuffers(1, &impostorColor);
+    if (impostorDepth != 0) glDeleteRenderbuffers(1, &impostorDepth);
+    if (impostorTexture != 0) glDeleteTextures(1, &impostorTexture);
 }
 
 unsigned int Renderer::createWhiteTexture() {
@@ -97,49 +241,6 @@ unsigned int Renderer::createWhiteTexture() {
     return tex;
 }
 
-unsigned int Renderer::loadTexture(const char* filename) {
-    unsigned int tex;
-    glGenTextures(1,&tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    
-    int w,h,nc;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char *data = stbi_load(filename,&w,&h,&nc,0);
-    
-    if(data){
-        std::cout << "✓ Texture loaded: " << filename << " (" << w << "x" << h << ", " << nc << " channels)" << std::endl;
-        
-        // チャンネル数に応じた適切なフォーマット選択
-        GLenum fmt;
-        if (nc == 1) {
-            fmt = GL_LUMINANCE;
-        } else if (nc == 2) {
-            fmt = GL_LUMINANCE_ALPHA;
-        } else if (nc == 3) {
-            fmt = GL_RGB;
-        } else if (nc == 4) {
-            fmt = GL_RGBA;
-        } else {
-            fmt = GL_RGBA; 
-            std::cerr << "Warning: Unexpected channel count " << nc << ", trying GL_RGBA." << std::endl;
-        }
-        
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
-        glTexImage2D(GL_TEXTURE_2D, 0, fmt, w, h, 0, fmt, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    } else {
-        std::cerr << "✗ Failed to load texture: " << filename << std::endl;
-        unsigned char magenta[] = { 255, 0, 255 };
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, magenta);
-    }
-    stbi_image_free(data);
-    return tex;
-}
-
 void Renderer::init() {
     glEnable(GL_DEPTH_TEST); 
     glDisable(GL_CULL_FACE);
@@ -151,20 +252,116 @@ void Renderer::init() {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    for (int level = 0; level < kLodLevels; ++level) {
+        buildBall(ballVertices[level], kBallSlices[level], kBallStacks[level]);
+        buildCylinder(cylinderVertices[level], kCylinderSegments[level]);
+    }
+    buildWedge(wedgeVertices);
+
     cachedWhiteTextureID = createWhiteTexture();
     setupLights();
-    glClearColor(0.53f, 0.81f, 0.92f, 1.0f);
+    glClearColor(kSkyColor[0], kSkyColor[1], kSkyColor[2], kSkyColor[3]);
+    initImpostors();
+}
+
+void Renderer::initImpostors() {
+    if (!GLEW_ARB_framebuffer_object) {
+        std::cerr << "Warning: framebuffer objects unavailable, impostors disabled." << std::endl;
+        return;
+    }
+    glGenTextures(1, &impostorTexture);
+    glBindTexture(GL_TEXTURE_2D, impostorTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, kImpostorAtlasSize, kImpostorAtlasSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // 焼く先は区画 1 枚分（アトラス全体の深度バッファは持たない）
+    glGenRenderbuffers(1, &impostorColor);
+    glBindRenderbuffer(GL_RENDERBUFFER, impostorColor);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, kImpostorTileSize, kImpostorTileSize);
+    glGenRenderbuffers(1, &impostorDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, impostorDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, kImpostorTileSize, kImpostorTileSize);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &impostorFbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, impostorFbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, impostorColor);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, impostorDepth);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (!complete) {
+        std::cerr << "Warning: impostor framebuffer incomplete, impostors disabled." << std::endl;
+        return;
+    }
+    int tilesPerRow = kImpostorAtlasSize / kImpostorTileSize;
+    lodClusters.setTileCount(tilesPerRow * tilesPerRow);
 }
 
 unsigned int Renderer::getTextureID(const std::string& filename) {
     if (filename.empty()) return cachedWhiteTextureID;
-    if (textureCache.count(filename)) return textureCache[filename];
-    
-    unsigned int id = loadTexture(filename.c_str());
-    textureCache[filename] = id;
+    size_t count = streamer.textureCount();
+    unsigned int id = streamer.texture(filename);
+    if (streamer.textureCount() != count) boundTexture = kUnknownTexture;   // 作るときに貼ってあるテクスチャが変わった
     return id;
 }
 
+const TextureRegion& Renderer::getTexture(const std::string& filename) {
+    auto it = regionCache.find(filename);
+    if (it != regionCache.end()) return it->second;
+
+    TextureRegion region;
+    if (!useAtlas || !loadAtlasTexture(filename, region)) region.textureID = getTextureID(filename);
+    boundTexture = kUnknownTexture;
+    return regionCache.emplace(filename, region).first->second;
+}
+
+bool Renderer::loadAtlasTexture(const std::string& filename, TextureRegion& region) {
+    if (filename.empty()) {
+        unsigned char white[] = { 255, 255, 255, 255 };
+        return atlas.add(white, 1, 1, region);
+    }
+    // 大きさだけ先に見て、大きすぎる画像は単独のテクスチャにする
+    int w, h, nc;
+    if (!stbi_info(filename.c_str(), &w, &h, &nc)) return false;
+    if (w > TextureAtlas::kMaxTileSize || h > TextureAtlas::kMaxTileSize) return false;
+
+    stbi_set_flip_vertically_on_load(true);
+    unsigned char* data = stbi_load(filename.c_str(), &w, &h, &nc, 4);
+    if (!data) return false;
+    bool added = atlas.add(data, w, h, region);
+    if (added) std::cout << "✓ Texture loaded: " << filename << " (" << w << "x" << h << ", " << nc << " channels, atlas page " << atlas.pageCount() << ")" << std::endl;
+    stbi_image_free(data);
+    return added;
+}
+
+void Renderer::setTextureAtlas(bool enabled) {
+    if (enabled == useAtlas) return;
+    useAtlas = enabled;
+    // 貼り方が変わるので、区画と UV を焼き込んだバッチは作り直す
+    regionCache.clear();
+    for (auto& entry : batches) releaseBatch(entry.second);
+    batches.clear();
+}
+
+TextureRegion Renderer::partTexture(PartShape shape, const std::string& filename, float pixels) {
+    TextureRegion region;
+    if (shape != PartShape::Mesh) region = getTexture(filename);
+    else region.textureID = getTextureID(filename);
+    if (region.whole()) streamer.request(region.textureID, pixels);
+    return region;
+}
+
+void Renderer::bindTexture(unsigned int textureID) {
+    if (textureID == boundTexture) return;
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    boundTexture = textureID;
+    stats.textureBinds++;
+}
+
 void Renderer::setupLights() const {
     glEnable(GL_LIGHT0);
     GLfloat ambient[] = { 0.7f, 0.7f, 0.7f, 1.0f };
@@ -187,7 +384,55 @@ void Renderer::setViewMatrix(const Vector3& eye, const Vector3& f, const Vector3
     glTranslatef(-eye.x, -eye.y, -eye.z);
 }
 
-void Renderer::drawCube(const Vector3& pos, const Vector3& rot, const Vector3& scale, const Vector3& color, unsigned int textureID, float transparency) {
+const Renderer::MeshBuffers& Renderer::meshBuffers(uint16_t mesh) {
+    if (mesh >= meshBufferList.size()) meshBufferList.resize(mesh + 1);
+    MeshBuffers& buf = meshBufferList[mesh];
+    if (buf.vbo != 0) return buf;
+
+    const MeshAsset& asset = MeshLibrary::get().asset(mesh);
+    glGenBuffers(1, &buf.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, buf.vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(asset.vertices.size() * sizeof(MeshVertex)), asset.vertices.data(), GL_STATIC_DRAW);
+
+    // 粗い段は頂点をまとめた添字。1 割も減らなければ前の段を使う
+    std::vector<uint32_t> simplified;
+    for (int level = 0; level < kLodLevels; ++level) {
+        const std::vector<uint32_t>* indices = &asset.indices;
+        if (level > 0) {
+            simplifyMesh(asset, kMeshLodGrid[level], simplified);
+            if (simplified.empty() || simplified.size() * 10 > (size_t)buf.count[level - 1] * 9) {
+                buf.ibo[level] = buf.ibo[level - 1];
+                buf.count[level] = buf.count[level - 1];
+                continue;
+            }
+            indices = &simplified;
+        }
+        glGenBuffers(1, &buf.ibo[level]);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buf.ibo[level]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(indices->size() * sizeof(uint32_t)), indices->data(), GL_STATIC_DRAW);
+        buf.count[level] = (int)indices->size();
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    return buf;
+}
+
+void Renderer::drawPart(PartShape shape, const Vector3& pos, const Vector3& rot, const Vector3& size, const Vector3& color, const TextureRegion& texture, float transparency, uint16_t mesh, int lod) {
+    const float* vertices = nullptr;
+    int count = 0;
+    Vector3 scale = size;
+    const MeshBuffers* buffers = nullptr;
+    unsigned int ibo = 0;
+    if (!shapeGeometry(shape, size, lod, vertices, count, scale)) {
+        buffers = &meshBuffers(mesh);
+        ibo = buffers->ibo[lod];
+        count = buffers->count[lod];
+    }
+    if (count == 0) return;
+    stats.triangles += count / 3;
+    stats.drawCalls++;
+    stats.parts++;
+
     glPushMatrix();
 
     glTranslatef(pos.x, pos.y, pos.z);
@@ -203,31 +448,385 @@ void Renderer::drawCube(const Vector3& pos, const Vector3& rot, const Vector3& s
     glColor4f(color.x / 255.0f, color.y / 255.0f, color.z / 255.0f, alpha);
 
     glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    bindTexture(texture.textureID);
     
     glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 
+    // アトラスの区画なら、形の UV（0..1）をテクスチャ行列で区画に写す
+    const bool inAtlas = !texture.whole();
+    if (inAtlas) {
+        glMatrixMode(GL_TEXTURE);
+        glLoadIdentity();
+        glTranslatef(texture.u0, texture.v0, 0.0f);
+        glScalef(texture.du, texture.dv, 1.0f);
+        glMatrixMode(GL_MODELVIEW);
+    }
+
     glEnableClientState(GL_VERTEX_ARRAY);
     glEnableClientState(GL_NORMAL_ARRAY);
     glEnableClientState(GL_TEXTURE_COORD_ARRAY);
 
     const int stride = 8 * sizeof(float);
-    glVertexPointer(3, GL_FLOAT, stride, ::cubeVertices + 0);
-    glNormalPointer(GL_FLOAT, stride, ::cubeVertices + 3);
-    glTexCoordPointer(2, GL_FLOAT, stride, ::cubeVertices + 6);
-    
-    glDrawArrays(GL_TRIANGLES, 0, 36);
+    if (buffers) {
+        // メッシュは GPU のバッファから（ポインタはバッファの先頭からのずれ）。
+        // 引き伸ばしで法線の長さが変わるので、描く間だけ長さを 1 に戻させる
+        glEnable(GL_NORMALIZE);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers->vbo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glVertexPointer(3, GL_FLOAT, stride, (const void*)offsetof(MeshVertex, x));
+        glNormalPointer(GL_FLOAT, stride, (const void*)offsetof(MeshVertex, nx));
+        glTexCoordPointer(2, GL_FLOAT, stride, (const void*)offsetof(MeshVertex, u));
+        glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glDisable(GL_NORMALIZE);
+    } else {
+        glVertexPointer(3, GL_FLOAT, stride, vertices + 0);
+        glNormalPointer(GL_FLOAT, stride, vertices + 3);
+        glTexCoordPointer(2, GL_FLOAT, stride, vertices + 6);
+        glDrawArrays(GL_TRIANGLES, 0, count);
+    }
 
     glDisableClientState(GL_VERTEX_ARRAY);
     glDisableClientState(GL_NORMAL_ARRAY);
     glDisableClientState(GL_TEXTURE_COORD_ARRAY);
     
+    if (inAtlas) {
+        glMatrixMode(GL_TEXTURE);
+        glLoadIdentity();
+        glMatrixMode(GL_MODELVIEW);
+    }
     glDisable(GL_TEXTURE_2D);
     
     glPopMatrix();
 }
 
+void Renderer::drawTerrain(const Terrain& terrain) {
+    if (terrain.empty()) return;
+
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    const int stride = sizeof(TerrainVertex);
+    terrain.forEachChunk([&](const TerrainChunk& chunk) {
+        if (chunk.indices.empty()) return;
+        const TerrainVertex* v = chunk.vertices.data();
+        glVertexPointer(3, GL_FLOAT, stride, &v->x);
+        glNormalPointer(GL_FLOAT, stride, &v->nx);
+        glColorPointer(4, GL_UNSIGNED_BYTE, stride, &v->r);
+        glDrawElements(GL_TRIANGLES, (GLsizei)chunk.indices.size(), GL_UNSIGNED_INT, chunk.indices.data());
+        stats.triangles += chunk.indices.size() / 3;
+        stats.drawCalls++;
+    });
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+}
+
+int Renderer::partLod(EntityId entity, const Transform& t, const Vector3& eye) {
+    if (!lod.enabled) return 0;
+    float radius = 0.5f * t.size.length();
+    if (beyondFarPlane(t.pos, radius, eye)) {
+        stats.culledParts++;
+        return -1;
+    }
+    if (t.shape == PartShape::Block || t.shape == PartShape::Wedge) return 0;
+    float pixels = projectedPixels(radius, (t.pos - eye).length());
+    int level = lodSelector.update(entity, pixels, lod);
+    stats.lodParts[level]++;
+    return level;
+}
+
+void Renderer::captureImpostor(const LodCluster& cluster) {
+    glViewport(0, 0, kImpostorTileSize, kImpostorTileSize);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // 塊を囲む球がちょうど収まる平行投影で、焼く向きから見る
+    float r = std::max(cluster.radius, 0.01f);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(-r, r, -r, r, 0.0, 2.0 * r);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    Vector3 right, up;
+    impostorBasis(cluster.captureDir, right, up);
+    setViewMatrix(cluster.center + cluster.captureDir * r, cluster.captureDir * -1.0f, right, up);
+    glLightfv(GL_LIGHT0, GL_POSITION, kLightPosition);
+
+    // 板は小さく映るときにしか使わないので、一番粗い段で焼く（テクスチャも区画に映る大きさの段で足りる）
+    for (const LodCluster::Member& m : cluster.members) {
+        const Transform& t = *m.transform;
+        const Renderable& rd = *m.renderable;
+        float pixels = kImpostorTileSize * 0.5f * t.size.length() / r;
+        drawPart(t.shape, t.pos, t.rotation, t.size, rd.color, partTexture(t.shape, rd.texturePath, pixels), rd.transparency, t.mesh, kLodLevels - 1);
+    }
+
+    // 焼いた絵をアトラスの区画へ写す
+    const int tilesPerRow = kImpostorAtlasSize / kImpostorTileSize;
+    glBindTexture(GL_TEXTURE_2D, impostorTexture);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, (cluster.tile % tilesPerRow) * kImpostorTileSize,
+                        (cluster.tile / tilesPerRow) * kImpostorTileSize, 0, 0, kImpostorTileSize, kImpostorTileSize);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    boundTexture = 0;
+}
+
+void Renderer::drawImpostors(const Vector3& eye) {
+    if (lodClusters.impostorCount() == 0) return;
+    const int tilesPerRow = kImpostorAtlasSize / kImpostorTileSize;
+    const float texel = 1.0f / kImpostorAtlasSize;
+
+    // 位置3・UV2 の四角形を並べて1回で描く
+    std::vector<float> quads;
+    quads.reserve(lodClusters.impostorCount() * 20);
+    for (const LodCluster& c : lodClusters.clusters()) {
+        if (!c.impostor) continue;
+        // 板は塊を囲む球の手前の面に置く（中心に置くと下半分が地面に埋まる）。
+        // 目に近づけた分だけ縮めて、映る大きさは中心に置いたときと同じにする
+        float distance = (c.center - eye).length();
+        float near = std::max(distance - c.radius, Z_NEAR);
+        Vector3 center = eye + (c.center - eye) * (near / distance);
+        float half = c.radius * near / distance;
+        Vector3 right, up;
+        impostorBasis(c.captureDir, right, up);
+        right = right * half;
+        up = up * half;
+        // 隣の区画がにじまないよう半テクセル内側
+        float u0 = ((c.tile % tilesPerRow) * kImpostorTileSize + 0.5f) * texel, u1 = u0 + (kImpostorTileSize - 1) * texel;
+        float v0 = ((c.tile / tilesPerRow) * kImpostorTileSize + 0.5f) * texel, v1 = v0 + (kImpostorTileSize - 1) * texel;
+        Vector3 p[4] = { center - right - up, center + right - up, center + right + up, center - right + up };
+        float uv[4][2] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+        for (int k = 0; k < 4; ++k) quads.insert(quads.end(), { p[k].x, p[k].y, p[k].z, uv[k][0], uv[k][1] });
+        stats.triangles += 2;
+    }
+    stats.drawCalls++;
+
+    // 焼いた色には光が当たっているので光は切り、抜けた（α が 0 の）所は捨てる
+    glDisable(GL_LIGHTING);
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GREATER, 0.5f);
+    glEnable(GL_TEXTURE_2D);
+    bindTexture(impostorTexture);
+    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    const int stride = 5 * sizeof(float);
+    glVertexPointer(3, GL_FLOAT, stride, quads.data());
+    glTexCoordPointer(2, GL_FLOAT, stride, quads.data() + 3);
+    glDrawArrays(GL_QUADS, 0, (GLsizei)(quads.size() / 5));
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_ALPHA_TEST);
+    glEnable(GL_LIGHTING);
+}
+
+void Renderer::buildBatch(const LodCluster& cluster, ClusterBatch& batch) {
+    // テクスチャごとに、ワールド座標に直した頂点を集める
+    std::vector<unsigned int> textures;
+    std::vector<std::vector<BatchVertex>> vertices;
+    batch.parts = 0;
+    batch.leveledParts = 0;
+    for (const LodCluster::Member& m : cluster.members) {
+        const Transform& t = *m.transform;
+        const Renderable& rd = *m.renderable;
+        const float* src;
+        int count;
+        Vector3 scale;
+        if (!shapeGeometry(t.shape, t.size, batch.level, src, count, scale)) continue;
+        // 同じアトラスのページのパーツは 1 つのバッファに入る（UV は区画に写して焼き込む）
+        const TextureRegion& texture = getTexture(rd.texturePath);
+        size_t group = std::find(textures.begin(), textures.end(), texture.textureID) - textures.begin();
+        if (group == textures.size()) {
+            textures.push_back(texture.textureID);
+            vertices.emplace_back();
+        }
+
+        // drawPart と同じ T * Ry * Rx * Rz * S。法線は S の逆数を掛けて回すだけで、
+        // 長さは戻さない（GL_NORMALIZE なしの固定機能と同じ明るさにする）
+        Matrix3 rot = Matrix3::rotate(Vector3(0, t.rotation.y, 0)) * Matrix3::rotate(Vector3(t.rotation.x, 0, 0))
+                    * Matrix3::rotate(Vector3(0, 0, t.rotation.z));
+        Vector3 invScale(scale.x != 0.0f ? 1.0f / scale.x : 0.0f, scale.y != 0.0f ? 1.0f / scale.y : 0.0f, scale.z != 0.0f ? 1.0f / scale.z : 0.0f);
+        unsigned char r = (unsigned char)std::min(std::max(rd.color.x, 0.0f), 255.0f);
+        unsigned char g = (unsigned char)std::min(std::max(rd.color.y, 0.0f), 255.0f);
+        unsigned char b = (unsigned char)std::min(std::max(rd.color.z, 0.0f), 255.0f);
+        std::vector<BatchVertex>& out = vertices[group];
+        out.reserve(out.size() + count);
+        for (int i = 0; i < count; ++i) {
+            const float* v = src + i * 8;
+            Vector3 p = t.pos + rot * Vector3(v[0] * scale.x, v[1] * scale.y, v[2] * scale.z);
+            Vector3 n = rot * Vector3(v[3] * invScale.x, v[4] * invScale.y, v[5] * invScale.z);
+            out.push_back({ p.x, p.y, p.z, n.x, n.y, n.z, texture.u0 + v[6] * texture.du, texture.v0 + v[7] * texture.dv, r, g, b, 255 });
+        }
+        batch.parts++;
+        if (t.shape == PartShape::Ball || t.shape == PartShape::Cylinder) batch.leveledParts++;
+    }
+
+    // バッファは使い回し、余った分は捨てる
+    for (size_t i = textures.size(); i < batch.groups.size(); ++i) glDeleteBuffers(1, &batch.groups[i].vbo);
+    batch.groups.resize(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        BatchGroup& group = batch.groups[i];
+        if (group.vbo == 0) glGenBuffers(1, &group.vbo);
+        group.textureID = textures[i];
+        group.count = (int)vertices[i].size();
+        glBindBuffer(GL_ARRAY_BUFFER, group.vbo);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(vertices[i].size() * sizeof(BatchVertex)), vertices[i].data(), GL_STATIC_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    batch.signature = cluster.signature;
+}
+
+void Renderer::releaseBatch(ClusterBatch& batch) {
+    for (BatchGroup& group : batch.groups) glDeleteBuffers(1, &group.vbo);
+    batch.groups.clear();
+}
+
+void Renderer::drawBatches(const std::vector<const ClusterBatch*>& list) {
+    std::vector<const BatchGroup*> groups;
+    for (const ClusterBatch* batch : list) {
+        for (const BatchGroup& group : batch->groups) groups.push_back(&group);
+        stats.parts += batch->parts;
+        if (lod.enabled) stats.lodParts[batch->level] += batch->leveledParts;
+        stats.batches++;
+    }
+    if (groups.empty()) return;
+    std::sort(groups.begin(), groups.end(), [](const BatchGroup* a, const BatchGroup* b) { return a->textureID < b->textureID; });
+
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    glEnable(GL_TEXTURE_2D);
+    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    const int stride = sizeof(BatchVertex);
+    for (const BatchGroup* group : groups) {
+        bindTexture(group->textureID);
+        glBindBuffer(GL_ARRAY_BUFFER, group->vbo);
+        glVertexPointer(3, GL_FLOAT, stride, (const void*)offsetof(BatchVertex, x));
+        glNormalPointer(GL_FLOAT, stride, (const void*)offsetof(BatchVertex, nx));
+        glTexCoordPointer(2, GL_FLOAT, stride, (const void*)offsetof(BatchVertex, u));
+        glColorPointer(4, GL_UNSIGNED_BYTE, stride, (const void*)offsetof(BatchVertex, r));
+        glDrawArrays(GL_TRIANGLES, 0, group->count);
+        stats.triangles += group->count / 3;
+        stats.drawCalls++;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisable(GL_TEXTURE_2D);
+}
+
+void Renderer::drawClusters(const Vector3& eye) {
+    frameCounter++;
+    std::vector<const ClusterBatch*> visible;
+    for (const LodCluster& c : lodClusters.clusters()) {
+        ClusterBatch* batch = nullptr;
+        if (batching) {
+            batch = &batches[c.key];
+            batch->seenFrame = frameCounter;
+        }
+        if (c.culled) stats.culledParts += c.members.size();
+        if (c.impostor || c.culled) continue;
+
+        // メッシュ（まとめない分）は 1 つずつ
+        for (const LodCluster::Member& m : c.members) {
+            const Transform& t = *m.transform;
+            if (batch && t.shape != PartShape::Mesh) continue;
+            const Renderable& r = *m.renderable;
+            int level = partLod(m.entity, t, eye);
+            if (level < 0) continue;
+            float pixels = projectedPixels(0.5f * t.size.length(), (t.pos - eye).length());
+            drawPart(t.shape, t.pos, t.rotation, t.size, r.color, partTexture(t.shape, r.texturePath, pixels), r.transparency, t.mesh, level);
+        }
+        if (!batch) continue;
+
+        // 段は塊の一番近い所に一番大きいパーツがあるとして選ぶ（塊の中で段は揃える）
+        bool changed = batch->signature != c.signature || batch->groups.empty();
+        if (changed) {
+            batch->partRadius = 0.0f;
+            for (const LodCluster::Member& m : c.members) batch->partRadius = std::max(batch->partRadius, 0.5f * m.transform->size.length());
+        }
+        float distance = std::max((c.center - eye).length() - c.radius, 0.0f);
+        int level = selectLod(batch->level, projectedPixels(batch->partRadius, distance), lod);
+        if (level != batch->level) {
+            batch->level = level;
+            changed = true;
+        }
+        if (changed) {
+            buildBatch(c, *batch);
+            stats.batchRebuilds++;
+        }
+        // 単独のテクスチャの段も、塊の一番近い所の一番大きいパーツの大きさで頼む
+        for (const BatchGroup& group : batch->groups) streamer.request(group.textureID, projectedPixels(batch->partRadius, distance));
+        visible.push_back(batch);
+    }
+    drawBatches(visible);
+
+    // 無くなった塊（中身が全て消えた・格子が変わった）のバッファを捨てる
+    for (auto it = batches.begin(); it != batches.end();) {
+        if (it->second.seenFrame == frameCounter) {
+            ++it;
+            continue;
+        }
+        releaseBatch(it->second);
+        it = batches.erase(it);
+    }
+}
+
+void Renderer::printStats() const {
+    std::cout << "✓ Render: " << stats.triangles << " triangles, " << stats.drawCalls << " draw calls, "
+              << stats.parts << " parts (LOD " << stats.lodParts[0] << " / " << stats.lodParts[1] << " / " << stats.lodParts[2]
+              << "), impostors " << stats.impostors << " of " << stats.clusters << " clusters ("
+              << stats.impostorCaptures << " captured), " << stats.culledParts << " beyond far plane, "
+              << stats.batches << " batches (" << stats.batchRebuilds << " rebuilt), "
+              << stats.textureBinds << " texture binds, " << stats.textureBytes / (1024 * 1024) << " MB textures ("
+              << stats.textureQueue << " streaming)" << std::endl;
+}
+
 void Renderer::render(const Workspace& ws, const Camera& cam, const Vector3& lookTarget) {
+    stats = RenderStats();
+
+    // 前のフレームに頼まれた段まで単独のテクスチャを上げ、予算を越えた分は落とす
+    streamer.update();
+    boundTexture = kUnknownTexture;
+
+    // 遠くの固定パーツの塊を板にするかを決め、焼き直す塊は画面を描く前に別のフレームバッファへ焼く
+    // 固定パーツの塊は LOD・静的バッチのどちらかを使うときだけ作る
+    const bool useClusters = lod.enabled || batching;
+    if (!batching && !batches.empty()) {
+        for (auto& entry : batches) releaseBatch(entry.second);
+        batches.clear();
+    }
+    if (useClusters) {
+        lodClusters.update(ws.components, cam.pos, lod);
+        stats.clusters = lodClusters.clusters().size();
+        stats.impostors = lodClusters.impostorCount();
+        stats.impostorCaptures = lodClusters.captureCount();
+        if (lodClusters.captureCount() > 0) {
+            GLint viewport[4];
+            glGetIntegerv(GL_VIEWPORT, viewport);
+            glBindFramebuffer(GL_FRAMEBUFFER, impostorFbo);
+            for (const LodCluster& c : lodClusters.clusters()) {
+                if (c.capture) captureImpostor(c);
+            }
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+            glClearColor(kSkyColor[0], kSkyColor[1], kSkyColor[2], kSkyColor[3]);
+        }
+    }
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     glMatrixMode(GL_PROJECTION);
@@ -242,26 +841,47 @@ void Renderer::render(const Workspace& ws, const Camera& cam, const Vector3& loo
     std::tie(f, r, u) = cam.get_directions(); 
     setViewMatrix(cam.pos, f, r, u); 
     
-    GLfloat lightPos[] = {100.0f, 200.0f, 100.0f, 1.0f}; 
-    glLightfv(GL_LIGHT0, GL_POSITION, lightPos);
-
-    // パス1: 不透明オブジェクト
-    for (const auto& block : ws.cubes) {
-        if (block.transparency < 0.01f) {
-            unsigned int texID = getTextureID(block.texturePath);
-            drawCube(block.pos, block.rotation, block.size, block.color, texID, block.transparency);
-        }
+    glLightfv(GL_LIGHT0, GL_POSITION, kLightPosition);
+
+    // Transform + Renderable を持つアーキタイプの配列を直接走査する
+    // 親のないパーツ・破棄予約済みのパーツ、完全に透明なパーツは描かない
+    auto drawPass = [&](bool transparentPass) {
+        ws.components.forEach(Comp_Transform | Comp_Renderable, [&](const Archetype& arch) {
+            const Transform* transforms = arch.transforms.data();
+            const Renderable* renderables = arch.renderables.data();
+            // 固定パーツの塊の中身は塊ごとに描く
+            bool clustered = useClusters && arch.has(Comp_Anchored);
+            for (size_t i = 0; i < arch.size(); ++i) {
+                const Renderable& r = renderables[i];
+                if ((r.transparency >= 0.01f) != transparentPass || r.transparency >= 1.0f) continue;
+                if (!arch.owners[i]->isActive()) continue;
+                if (clustered && LodClusters::isMember(arch, i)) continue;
+
+                const Transform& t = transforms[i];
+                int level = partLod(arch.entities[i], t, cam.pos);
+                if (level < 0) continue;
+                float pixels = projectedPixels(0.5f * t.size.length(), (t.pos - cam.pos).length());
+                drawPart(t.shape, t.pos, t.rotation, t.size, r.color, partTexture(t.shape, r.texturePath, pixels), r.transparency, t.mesh, level);
+            }
+        });
+    };
+
+    // パス1: 不透明オブジェクト（固定パーツは塊ごとに、まとめて・形のままか板で）
+    drawPass(false);
+    if (useClusters) {
+        drawClusters(cam.pos);
+        drawImpostors(cam.pos);
     }
+    drawTerrain(ws.terrain);
 
     // パス2: 透明オブジェクト
     glDepthMask(GL_FALSE); 
-    for (const auto& block : ws.cubes) {
-        if (block.transparency >= 0.01f) {
-            unsigned int texID = getTextureID(block.texturePath);
-            drawCube(block.pos, block.rotation, block.size, block.color, texID, block.transparency);
-        }
-    }
+    drawPass(true);
     glDepthMask(GL_TRUE);
 
+    // アトラスは描く間に増えるので、描き終えてから数える
+    stats.textureBytes = streamer.stats().residentBytes + atlas.residentBytes();
+    stats.textureQueue = streamer.stats().queueDepth;
+
     glFlush();
 }
\ No newline at end of file
@@ -7,10 +7,31 @@
 #include <cmath>
 #include <string> 
 #include <map>    
+#include <unordered_map>
 
 #include "src/Math/Vector3.hpp"
 #include "src/Game/GameData.hpp"
 #include "src/Game/Workspace.hpp"
+#include "src/Render/Lod.hpp"
+#include "src/Render/TextureAtlas.hpp"
+#include "src/Render/TextureStreamer.hpp"
+
+// 1 フレーム分の描画の数（Renderer::getStats）
+struct RenderStats {
+    size_t triangles = 0;          // 送った三角形（地形・インポスターの板・焼いた分も含む）
+    size_t drawCalls = 0;
+    size_t parts = 0;              // 形で描いたパーツ（焼いた分も含む）
+    size_t lodParts[kLodLevels] = {};   // 段ごとのパーツ数（段のある球・円柱・メッシュだけ）
+    size_t clusters = 0;           // 固定パーツの塊
+    size_t impostors = 0;          // 板で描いた塊
+    size_t impostorCaptures = 0;   // 焼き直した塊
+    size_t culledParts = 0;        // Z_FAR より遠くて描かなかったパーツ（塊ごと外れた分も含む）
+    size_t batches = 0;            // まとめて描いた塊
+    size_t batchRebuilds = 0;      // まとめ直した塊
+    size_t textureBinds = 0;       // テクスチャを貼り替えた回数（同じテクスチャの続きは数えない）
+    size_t textureBytes = 0;       // GL に載せたテクスチャ（アトラスのページ・単独のテクスチャの載せている段）
+    size_t textureQueue = 0;       // 読み込み・細かい段を上げるのを待っている単独のテクスチャ
+};
 
 class Renderer {
 public:
@@ -22,16 +43,105 @@ public:
 
     unsigned int getSkyboxTextureID() const { return skyboxTextureID; } 
     unsigned int getTextureID(const std::string& filename); 
+    // パーツに貼るテクスチャ（小さい画像はアトラスの区画、大きい画像は単独のテクスチャ全体）
+    const TextureRegion& getTexture(const std::string& filename);
+
+    LodSettings& lodSettings() { return lod; }
+    // 固定パーツを塊ごとにまとめて描くか（切ると 1 つずつ描く）
+    void setStaticBatching(bool enabled) { batching = enabled; }
+    // 小さいテクスチャをアトラスに詰めるか（切ると全て単独のテクスチャで貼る）
+    void setTextureAtlas(bool enabled);
+    // 単独のテクスチャを載せる予算・1 フレームに上げる量
+    TextureStreamer::Settings& textureStreaming() { return streamer.settings(); }
+    // 単独のテクスチャだけの量（getStats の textureBytes はアトラスのページも含む）
+    const TextureStreamer::Stats& textureStreamingStats() const { return streamer.stats(); }
+    const RenderStats& getStats() const { return stats; }
+    void printStats() const;
 
 private:
     unsigned int skyboxTextureID;
     
     void setViewMatrix(const Vector3& eye, const Vector3& f, const Vector3& r, const Vector3& u); 
     // 【修正】引数に transparency を追加
-    void drawCube(const Vector3& pos, const Vector3& rot, const Vector3& scale, const Vector3& color, unsigned int textureID, float transparency);
+    // 形に合ったメッシュを、大きさ size の箱に収めて描く（MeshPart は mesh 番の MeshAsset。lod は LOD の段）
+    void drawPart(PartShape shape, const Vector3& pos, const Vector3& rot, const Vector3& size, const Vector3& color, const TextureRegion& texture, float transparency, uint16_t mesh = 0, int lod = 0);
+    // 地形の塊ごとのメッシュ（Terrain::update 済み。ワールド座標・素材の色）を描く
+    void drawTerrain(const Terrain& terrain);
     void setupLights() const;
 
-    unsigned int loadTexture(const char* filename);
+    // 形に合った貼り方のテクスチャ（メッシュの UV は 0..1 を越えて繰り返すので、アトラスに詰めない）。
+    // 単独のテクスチャなら、映る大きさ pixels に見合う段を streamer に頼む
+    TextureRegion partTexture(PartShape shape, const std::string& filename, float pixels);
+    // 貼ってあるテクスチャと同じなら貼り替えない（stats.textureBinds を数える）
+    void bindTexture(unsigned int textureID);
+    static const unsigned int kUnknownTexture = ~0u;
+    unsigned int boundTexture = kUnknownTexture;
+    TextureAtlas atlas;
+    TextureStreamer streamer;   // 単独のテクスチャ（getTextureID）
+    bool useAtlas = true;
+    bool loadAtlasTexture(const std::string& filename, TextureRegion& region);
+
+    // パーツの LOD の段（段のない形・LOD を切っていれば 0。Z_FAR より遠くて描かないなら -1）
+    int partLod(EntityId entity, const Transform& t, const Vector3& eye);
+
+    // MeshAsset の頂点・添字を置いた GPU のバッファ（MeshLibrary の番号ごと。最初に描くときに作る）。
+    // 添字は LOD の段ごと（頂点は共有。簡略化しても減らない段は前の段と同じバッファ）
+    struct MeshBuffers {
+        unsigned int vbo = 0;
+        unsigned int ibo[kLodLevels] = {};
+        int count[kLodLevels] = {};   // 添字の数
+    };
+    std::vector<MeshBuffers> meshBufferList;
+    const MeshBuffers& meshBuffers(uint16_t mesh);
+
+    // 遠くの固定パーツの塊を板で描く（アトラスは kImpostorAtlasSize 四方を kImpostorTileSize の区画に分ける）。
+    // 区画 1 枚分のフレームバッファに焼いてから、アトラスの区画へ写す
+    static const int kImpostorAtlasSize = 2048;
+    static const int kImpostorTileSize = 64;
+    unsigned int impostorTexture = 0;
+    unsigned int impostorFbo = 0, impostorColor = 0, impostorDepth = 0;
+    void initImpostors();
+    void captureImpostor(const LodCluster& cluster);
+    void drawImpostors(const Vector3& eye);
+
+    // 固定パーツの塊をまとめて描く（静的バッチ）。塊の中身をワールド座標に直した頂点を
+    // テクスチャごとに 1 つのバッファへ詰め、中身（LodCluster::signature）か段が変わった塊だけ作り直す。
+    // メッシュは自分のバッファと LOD を持つので、まとめずに 1 つずつ描く
+    struct BatchVertex {
+        float x, y, z;
+        float nx, ny, nz;
+        float u, v;
+        unsigned char r, g, b, a;
+    };
+    struct BatchGroup {
+        unsigned int textureID = 0;
+        unsigned int vbo = 0;
+        int count = 0;      // 頂点の数
+    };
+    struct ClusterBatch {
+        uint64_t signature = 0;
+        int level = -1;             // 球・円柱の LOD の段（塊の一番近い所で選ぶ）
+        float partRadius = 0.0f;    // 中身の一番大きいパーツの半径（段を選ぶのに使う）
+        size_t parts = 0;           // まとめたパーツ
+        size_t leveledParts = 0;    // そのうち段のある形（球・円柱）
+        std::vector<BatchGroup> groups;
+        uint32_t seenFrame = 0;
+    };
+    std::unordered_map<int64_t, ClusterBatch> batches;   // LodCluster::key -> まとめた頂点
+    bool batching = true;
+    uint32_t frameCounter = 0;
+    void buildBatch(const LodCluster& cluster, ClusterBatch& batch);
+    // まとめた頂点をテクスチャ（アトラスのページ）順に描く
+    void drawBatches(const std::vector<const ClusterBatch*>& list);
+    void releaseBatch(ClusterBatch& batch);
+    // 形のまま描く塊（インポスター・遠すぎる塊以外）を描く
+    void drawClusters(const Vector3& eye);
+
+    LodSettings lod;
+    LodSelector lodSelector;
+    LodClusters lodClusters;
+    RenderStats stats;
+
     unsigned int createWhiteTexture();
 };
 
@@ -0,0 +1,116 @@
+// src/Render/TextureAtlas.cpp
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+
+#include <GL/glew.h>
+
+namespace {
+    const int kAlign = 1 << (TextureAtlas::kMipLevels - 1);
+
+    int alignUp(int v, int a) { return (v + a - 1) / a * a; }
+}
+
+bool TextureAtlas::allocate(int w, int h, int& page, int& x, int& y) {
+    if (w > kPageSize || h > kPageSize) return false;
+
+    // 高さが同じか少しだけ高い棚の空き → 新しい棚（高さはこの画像に合わせる） → 新しいページ
+    for (Shelf& s : shelves) {
+        if (s.height < h || s.height - h > h / 4 || s.x + w > kPageSize) continue;
+        page = s.page;
+        x = s.x;
+        y = s.y;
+        s.x += w;
+        return true;
+    }
+    size_t p = 0;
+    while (p < pageTop.size() && pageTop[p] + h > kPageSize) ++p;
+    if (p == pageTop.size()) pageTop.push_back(0);
+    shelves.push_back({ (int)p, pageTop[p], h, w });
+    pageTop[p] += h;
+    page = (int)p;
+    x = 0;
+    y = shelves.back().y;
+    return true;
+}
+
+unsigned int TextureAtlas::createPage() {
+    unsigned int tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, kMipLevels - 1);
+    for (int level = 0; level < kMipLevels; ++level) {
+        int size = kPageSize >> level;
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    return tex;
+}
+
+bool TextureAtlas::add(const unsigned char* rgba, int w, int h, TextureRegion& out) {
+    if (w <= 0 || h <= 0 || w > kMaxTileSize || h > kMaxTileSize) return false;
+    const int tw = alignUp(w + 2 * kPadding, kAlign);
+    const int th = alignUp(h + 2 * kPadding, kAlign);
+    int page, x, y;
+    if (!allocate(tw, th, page, x, y)) return false;
+    while (pages.size() < pageTop.size()) pages.push_back(createPage());
+
+    // 縁は一番近い画素の色をのばす
+    std::vector<unsigned char> tile((size_t)tw * th * 4);
+    for (int ty = 0; ty < th; ++ty) {
+        int sy = std::min(std::max(ty - kPadding, 0), h - 1);
+        for (int tx = 0; tx < tw; ++tx) {
+            int sx = std::min(std::max(tx - kPadding, 0), w - 1);
+            std::copy_n(rgba + ((size_t)sy * w + sx) * 4, 4, &tile[((size_t)ty * tw + tx) * 4]);
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, pages[page]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    int lw = tw, lh = th;
+    for (int level = 0; level < kMipLevels; ++level) {
+        if (level > 0) {
+            // 2x2 の平均で半分にする
+            std::vector<unsigned char> half((size_t)(lw / 2) * (lh / 2) * 4);
+            for (int hy = 0; hy < lh / 2; ++hy) {
+                for (int hx = 0; hx < lw / 2; ++hx) {
+                    for (int c = 0; c < 4; ++c) {
+                        auto at = [&](int px, int py) { return (int)tile[((size_t)py * lw + px) * 4 + c]; };
+                        int sum = at(2 * hx, 2 * hy) + at(2 * hx + 1, 2 * hy) + at(2 * hx, 2 * hy + 1) + at(2 * hx + 1, 2 * hy + 1);
+                        half[((size_t)hy * (lw / 2) + hx) * 4 + c] = (unsigned char)((sum + 2) / 4);
+                    }
+                }
+            }
+            tile.swap(half);
+            lw /= 2;
+            lh /= 2;
+        }
+        glTexSubImage2D(GL_TEXTURE_2D, level, x >> level, y >> level, lw, lh, GL_RGBA, GL_UNSIGNED_BYTE, tile.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    out.textureID = pages[page];
+    out.u0 = (float)(x + kPadding) / kPageSize;
+    out.v0 = (float)(y + kPadding) / kPageSize;
+    out.du = (float)w / kPageSize;
+    out.dv = (float)h / kPageSize;
+    return true;
+}
+
+void TextureAtlas::release() {
+    if (!pages.empty()) glDeleteTextures((GLsizei)pages.size(), pages.data());
+    pages.clear();
+    pageTop.clear();
+    shelves.clear();
+}
+
+size_t TextureAtlas::residentBytes() const {
+    // 0 段目と、ミップの分（1/4 + 1/16 + 1/64）
+    size_t level0 = (size_t)kPageSize * kPageSize * 4;
+    size_t bytes = 0;
+    for (int level = 0; level < kMipLevels; ++level) bytes += level0 >> (2 * level);
+    return bytes * pages.size();
+}
@@ -0,0 +1,64 @@
+// src/Render/TextureAtlas.hpp
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include <vector>
+#include <cstddef>
+
+// 貼るテクスチャと、形の UV（0..1）を写す範囲（u' = u0 + u * du, v' = v0 + v * dv）
+struct TextureRegion {
+    unsigned int textureID = 0;
+    float u0 = 0.0f, v0 = 0.0f;
+    float du = 1.0f, dv = 1.0f;
+
+    bool whole() const { return u0 == 0.0f && v0 == 0.0f && du == 1.0f && dv == 1.0f; }
+};
+
+// ===================================================================
+// TextureAtlas: 小さいテクスチャを大きなページに詰める
+//
+// パーツごとにテクスチャを貼り替えると、静的バッチも塊の中でテクスチャの数だけ分かれる。
+// kMaxTileSize 以下の画像は kPageSize 四方のページに棚詰めし、同じページのパーツは
+// 貼り替えずに続けて描く（UV は TextureRegion で写す）。
+// 縁は kPadding 幅だけ端の色をのばし、ミップは区画ごとに CPU で作る
+// （区画の位置と大きさを 2^(kMipLevels-1) の倍数に揃え、最後の段でも隣がにじまない）。
+// 区画の中で UV が 0..1 に収まる形にしか使えない（繰り返すメッシュは単独のテクスチャのまま）
+// ===================================================================
+class TextureAtlas {
+public:
+    static const int kPageSize = 2048;
+    static const int kPadding = 8;
+    static const int kMipLevels = 4;     // 0..3 段（kPadding >> 3 で最後の段も縁が 1 テクセル残る）
+    static const int kMaxTileSize = 512;
+
+    TextureAtlas() = default;
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // RGBA8 の画像（w x h）を詰める。大きすぎれば false（単独のテクスチャで貼る）
+    bool add(const unsigned char* rgba, int w, int h, TextureRegion& out);
+
+    // GL のページを捨てる（GL のコンテキストがある間に呼ぶ）
+    void release();
+
+    size_t pageCount() const { return pages.size(); }
+    size_t residentBytes() const;
+
+    // 縁を含めた w x h の区画の置き場所を決める（GL は触らない）
+    bool allocate(int w, int h, int& page, int& x, int& y);
+
+private:
+    struct Shelf {
+        int page;
+        int y;
+        int height;
+        int x;       // 次に置ける位置
+    };
+    std::vector<unsigned int> pages;   // GL のテクスチャ
+    std::vector<int> pageTop;          // ページごとの、棚に使った高さ
+    std::vector<Shelf> shelves;
+
+    unsigned int createPage();
+};
+
+#endif // TEXTURE_ATLAS_HPP
@@ -0,0 +1,321 @@
+// src/Render/TextureStreamer.cpp
+#include "TextureStreamer.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+#include <GL/glew.h>
+
+#include "stb_image.h"
+
+namespace {
+    size_t levelBytes(int width, int height, int level) {
+        return (size_t)std::max(width >> level, 1) * std::max(height >> level, 1) * 4;
+    }
+}
+
+TextureStreamer::~TextureStreamer() {
+    // GL のテクスチャは release で捨てる（ここではコンテキストが残っているとは限らない）
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCv.notify_all();
+    if (loader.joinable()) loader.join();
+}
+
+unsigned int TextureStreamer::texture(const std::string& path) {
+    auto it = byPath.find(path);
+    if (it != byPath.end()) return entries[it->second].id;
+
+    // 読み終わるまでは白い 1x1 を貼っておく（番号はこのまま使い続ける）
+    Entry e;
+    e.path = path;
+    glGenTextures(1, &e.id);
+    glBindTexture(GL_TEXTURE_2D, e.id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    unsigned char white[] = { 255, 255, 255, 255 };
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+
+    size_t index = entries.size();
+    byPath[path] = index;
+    byId[e.id] = index;
+    entries.push_back(std::move(e));
+    enqueue(entries.back());
+    return entries.back().id;
+}
+
+void TextureStreamer::request(unsigned int textureID, float pixels) {
+    auto it = byId.find(textureID);
+    if (it == byId.end()) return;
+    Entry& e = entries[it->second];
+    e.lastUsed = frame;
+    if (e.levelCount == 0) return;
+
+    // 映る大きさに足りる一番粗い段（元の一辺 / 2^段 >= pixels）
+    int level = e.tailLevel;
+    float size = (float)std::max(e.width, e.height);
+    if (pixels >= size) level = 0;
+    else if (pixels > 0.0f) level = std::min((int)std::floor(std::log2(size / pixels)), e.tailLevel);
+    e.frameWanted = std::min(e.frameWanted, level);
+}
+
+// ====================================================================
+// 読み込み用のスレッド
+// ====================================================================
+
+void TextureStreamer::enqueue(Entry& e) {
+    if (e.loading) return;
+    e.loading = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(byPath[e.path]);
+        paths.push_back(e.path);
+        inFlight++;
+    }
+    if (!loader.joinable()) loader = std::thread(&TextureStreamer::loaderLoop, this);
+    wakeCv.notify_one();
+}
+
+void TextureStreamer::loaderLoop() {
+    // 縦を反転して読む（GL の UV は下が 0）。ほかのスレッドの stbi の設定には触らない
+    stbi_set_flip_vertically_on_load_thread(1);
+    for (;;) {
+        size_t index;
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCv.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (stopping) return;
+            index = pending.front();
+            path = std::move(paths.front());
+            pending.pop_front();
+            paths.pop_front();
+        }
+        std::shared_ptr<Source> source = decode(path);
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.emplace_back(index, std::move(source));
+    }
+}
+
+std::shared_ptr<TextureStreamer::Source> TextureStreamer::decode(const std::string& path) {
+    auto source = std::make_shared<Source>();
+    int w, h, nc;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &nc, 4);
+    if (!data) return source;
+    source->ok = true;
+    source->channels = nc;
+    source->levels.push_back({ w, h, std::vector<unsigned char>(data, data + (size_t)w * h * 4) });
+    stbi_image_free(data);
+
+    // 1x1 まで 2x2 の平均で半分にしていく（奇数の辺は端の画素を重ねて数える）
+    while (w > 1 || h > 1) {
+        const Level& src = source->levels.back();
+        int hw = std::max(w / 2, 1), hh = std::max(h / 2, 1);
+        Level half{ hw, hh, std::vector<unsigned char>((size_t)hw * hh * 4) };
+        for (int y = 0; y < hh; ++y) {
+            int y0 = std::min(2 * y, h - 1), y1 = std::min(2 * y + 1, h - 1);
+            for (int x = 0; x < hw; ++x) {
+                int x0 = std::min(2 * x, w - 1), x1 = std::min(2 * x + 1, w - 1);
+                for (int c = 0; c < 4; ++c) {
+                    auto at = [&](int px, int py) { return (int)src.pixels[((size_t)py * w + px) * 4 + c]; };
+                    int sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                    half.pixels[((size_t)y * hw + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+                }
+            }
+        }
+        source->levels.push_back(std::move(half));
+        w = hw;
+        h = hh;
+    }
+    return source;
+}
+
+// ====================================================================
+// 上げる・落とす
+// ====================================================================
+
+size_t TextureStreamer::chainBytes(const Entry& e, int fromLevel) {
+    size_t bytes = 0;
+    for (int level = fromLevel; level < e.levelCount; ++level) bytes += levelBytes(e.width, e.height, level);
+    return bytes;
+}
+
+void TextureStreamer::upload(Entry& e, int top) {
+    // top 段から下を 0 段目から作り直す。短くなった分の段は大きさ 0 にして手放す
+    const int oldCount = e.residentLevel < 0 ? 1 : e.levelCount - e.residentLevel;
+    const int newCount = e.levelCount - top;
+    glBindTexture(GL_TEXTURE_2D, e.id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (int level = top; level < e.levelCount; ++level) {
+        const Level& src = level >= e.tailLevel ? e.tail[level - e.tailLevel] : e.source->levels[level];
+        glTexImage2D(GL_TEXTURE_2D, level - top, GL_RGBA8, src.width, src.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, src.pixels.data());
+    }
+    for (int level = newCount; level < oldCount; ++level) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, newCount - 1);
+
+    size_t bytes = chainBytes(e, top);
+    if (e.residentLevel >= 0) residentBytes -= chainBytes(e, e.residentLevel);
+    residentBytes += bytes;
+    frameStats.uploadedBytes += bytes;
+    e.residentLevel = top;
+}
+
+void TextureStreamer::update() {
+    frameStats = Stats();
+
+    // 前のフレームの request をまとめる（使われなかったものは今の段のまま）
+    const unsigned long long last = frame;
+    for (Entry& e : entries) {
+        if (e.lastUsed == last && e.levelCount > 0) e.wantedLevel = e.frameWanted;
+        e.frameWanted = e.tailLevel;
+    }
+
+    // 読み終えた画像を受け取り、初めてなら mip tail を上げる
+    std::vector<std::pair<size_t, std::shared_ptr<Source>>> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.swap(finished);
+        inFlight -= done.size();
+    }
+    for (auto& [index, source] : done) {
+        Entry& e = entries[index];
+        e.loading = false;
+        if (!source->ok) {
+            if (e.residentLevel >= 0) continue;   // 読み直しに失敗しただけなら今の段のまま
+            std::cerr << "✗ Failed to load texture: " << e.path << std::endl;
+            unsigned char magenta[] = { 255, 0, 255, 255 };
+            glBindTexture(GL_TEXTURE_2D, e.id);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, magenta);
+            continue;
+        }
+        e.source = std::move(source);
+        if (e.residentLevel >= 0) continue;
+
+        const std::vector<Level>& levels = e.source->levels;
+        e.width = levels[0].width;
+        e.height = levels[0].height;
+        e.levelCount = (int)levels.size();
+        e.tailLevel = 0;
+        while (e.tailLevel + 1 < e.levelCount && std::max(levels[e.tailLevel].width, levels[e.tailLevel].height) > config.tailSize) e.tailLevel++;
+        e.tail.assign(levels.begin() + e.tailLevel, levels.end());
+        e.wantedLevel = e.tailLevel;
+        e.frameWanted = e.tailLevel;
+        upload(e, e.tailLevel);
+        std::cout << "✓ Texture loaded: " << e.path << " (" << e.width << "x" << e.height << ", "
+                  << e.source->channels << " channels, streaming)" << std::endl;
+    }
+
+    // 予算を越えるなら mip tail へ落として need バイト空ける。前のフレームに使われなかったものを
+    // 最後に使ったのが古い順に、次に使われていても要る段より細かく載せているもの（遠ざかった）を、
+    // 余分が多い順に落とす（後者は要る段までまた読み直す）。それでも越えるなら細かい段を上げずに待つ
+    std::vector<size_t> lru;
+    size_t lruNext = 0;
+    bool lruBuilt = false;
+    auto makeRoom = [&](size_t need) {
+        if (!lruBuilt) {
+            lruBuilt = true;
+            for (size_t i = 0; i < entries.size(); ++i) {
+                const Entry& e = entries[i];
+                if (e.residentLevel < 0 || e.residentLevel >= e.tailLevel) continue;
+                if (e.lastUsed != last || e.residentLevel < e.wantedLevel) lru.push_back(i);
+            }
+            std::sort(lru.begin(), lru.end(), [this, last](size_t a, size_t b) {
+                const Entry& ea = entries[a];
+                const Entry& eb = entries[b];
+                bool usedA = ea.lastUsed == last, usedB = eb.lastUsed == last;
+                if (usedA != usedB) return usedB;
+                if (!usedA) return ea.lastUsed < eb.lastUsed;
+                return ea.wantedLevel - ea.residentLevel > eb.wantedLevel - eb.residentLevel;
+            });
+        }
+        while (residentBytes + need > config.budgetBytes && lruNext < lru.size()) {
+            Entry& e = entries[lru[lruNext++]];
+            if (e.residentLevel >= e.tailLevel) continue;
+            upload(e, e.tailLevel);
+            if (e.lastUsed != last) e.wantedLevel = e.tailLevel;
+            e.source.reset();
+            frameStats.evictions++;
+        }
+        return residentBytes + need <= config.budgetBytes;
+    };
+
+    // 細かい段が要るものを、大きく映るもの（細かい段が要るもの）から上げる
+    std::vector<size_t> promote;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Entry& e = entries[i];
+        if (e.lastUsed == last && e.residentLevel >= 0 && e.wantedLevel < e.residentLevel) promote.push_back(i);
+    }
+    std::sort(promote.begin(), promote.end(), [this](size_t a, size_t b) { return entries[a].wantedLevel < entries[b].wantedLevel; });
+    size_t uploadedBefore = frameStats.uploadedBytes;
+    size_t waiting = 0;
+    for (size_t index : promote) {
+        Entry& e = entries[index];
+        if (!e.source) {
+            // 細かい段は捨てたので読み直す
+            enqueue(e);
+            continue;
+        }
+        // この回に上げられる量に収まる一番細かい段（何も上げていなければ 1 段だけは上げる）
+        size_t room = config.uploadBytesPerFrame - std::min(config.uploadBytesPerFrame, frameStats.uploadedBytes - uploadedBefore);
+        int top = e.wantedLevel;
+        while (top < e.residentLevel - 1 && chainBytes(e, top) > room) top++;
+        if (chainBytes(e, top) > room && frameStats.uploadedBytes > uploadedBefore) {
+            waiting++;
+            continue;
+        }
+        // 予算に空きが足りなければ、収まる段まで粗くする
+        const size_t current = chainBytes(e, e.residentLevel);
+        while (top < e.residentLevel && !makeRoom(chainBytes(e, top) - current)) top++;
+        if (top == e.residentLevel) {
+            waiting++;
+            continue;
+        }
+        upload(e, top);
+        if (e.residentLevel > e.wantedLevel) waiting++;
+    }
+
+    // 予算を小さくしたときなど、上げなくても越えていれば落とす
+    makeRoom(0);
+
+    // 欲しい段まで上げ終えたものは、読んだ画像を手放す
+    for (Entry& e : entries) {
+        if (e.source && !e.loading && e.residentLevel >= 0 && e.residentLevel <= e.wantedLevel) e.source.reset();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frameStats.queueDepth = inFlight + waiting;
+    }
+    frameStats.textures = entries.size();
+    frameStats.residentBytes = residentBytes;
+    frame++;
+}
+
+void TextureStreamer::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        pending.clear();
+        paths.clear();
+    }
+    wakeCv.notify_all();
+    if (loader.joinable()) loader.join();
+
+    for (const Entry& e : entries) glDeleteTextures(1, &e.id);
+    entries.clear();
+    byPath.clear();
+    byId.clear();
+    finished.clear();
+    inFlight = 0;
+    residentBytes = 0;
+    stopping = false;
+}
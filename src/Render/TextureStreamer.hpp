@@ -0,0 +1,118 @@
+// src/Render/TextureStreamer.hpp
+#ifndef TEXTURE_STREAMER_HPP
+#define TEXTURE_STREAMER_HPP
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <cstddef>
+
+// ===================================================================
+// TextureStreamer: 単独のテクスチャ（アトラスに詰めない大きい画像・メッシュの画像）を
+// VRAM の予算の中で必要な細かさだけ載せる
+//
+// - 画像は読み込み用のスレッドで読み、ミップを全て作る。最初は小さい段（mip tail:
+//   一辺 tailSize 以下の段）だけを上げて、すぐに貼れるようにする
+// - 描く側は毎フレーム、貼る大きさ（画面でのピクセル数）を request で伝える。
+//   それに見合う段まで、1 フレームに uploadBytesPerFrame ずつ細かい段を上げる
+// - 載せた量が budgetBytes を越えるなら、最後に使ったのが古いもの（次に、遠ざかって要る段より
+//   細かく載せているもの）から mip tail だけに落とす。空かなければ、収まる段までしか上げない
+// 細かい段を上げ終えたら、読んだ画像は捨てる（また細かくするときは読み直す）。
+// GL の番号は変えない（段を変えるときは同じテクスチャに一番細かい段を 0 段目として作り直す）
+// ===================================================================
+class TextureStreamer {
+public:
+    struct Settings {
+        size_t budgetBytes = (size_t)256 << 20;
+        size_t uploadBytesPerFrame = (size_t)16 << 20;
+        int tailSize = 64;
+    };
+
+    struct Stats {
+        size_t textures = 0;
+        size_t residentBytes = 0;   // GL に載せている量（全ての段）
+        size_t queueDepth = 0;      // 読み込み待ち・読み込み中・上げ待ち
+        size_t uploadedBytes = 0;   // このフレームに上げた量
+        size_t evictions = 0;       // このフレームに mip tail に落とした数
+    };
+
+    TextureStreamer() = default;
+    ~TextureStreamer();
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // path のテクスチャの GL の番号（初めてなら作って読み込みを頼む。読み終わるまでは白）
+    unsigned int texture(const std::string& path);
+
+    // このフレームに textureID を pixels の大きさで貼る（TextureStreamer のものでなければ何もしない）
+    void request(unsigned int textureID, float pixels);
+
+    // 1 フレームに 1 回、描く前に呼ぶ（前のフレームの request を元に上げる・落とす）
+    void update();
+
+    // GL のテクスチャを捨て、読み込み用のスレッドを止める（GL のコンテキストがある間に呼ぶ）
+    void release();
+
+    Settings& settings() { return config; }
+    const Stats& stats() const { return frameStats; }
+    size_t textureCount() const { return entries.size(); }
+
+private:
+    // 読んだ画像の段（0 段目が元の大きさ。RGBA8）
+    struct Level {
+        int width, height;
+        std::vector<unsigned char> pixels;
+    };
+    struct Source {
+        bool ok = false;
+        int channels = 0;                   // 元の画像のチャンネル数（表示用）
+        std::vector<Level> levels;
+    };
+
+    struct Entry {
+        std::string path;
+        unsigned int id = 0;
+        int width = 0, height = 0;
+        int levelCount = 0;
+        int tailLevel = 0;                  // mip tail の一番細かい段
+        int residentLevel = -1;             // GL に載せている一番細かい段（-1 はまだ何もない）
+        int wantedLevel = 0;                // 前のフレームに頼まれた一番細かい段
+        int frameWanted = 0;                // このフレームの request の集計
+        unsigned long long lastUsed = 0;    // 最後に request されたフレーム
+        bool loading = false;
+        std::shared_ptr<Source> source;     // 細かい段を上げ終えるまで持つ
+        std::vector<Level> tail;            // mip tail（落とすときに作り直すので常に持つ）
+    };
+
+    Settings config;
+    Stats frameStats;
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, size_t> byPath;
+    std::unordered_map<unsigned int, size_t> byId;
+    unsigned long long frame = 1;
+    size_t residentBytes = 0;
+
+    // 読み込み用のスレッド
+    std::thread loader;
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::deque<size_t> pending;                                        // 読む entries の添字
+    std::deque<std::string> paths;                                     // そのパス（entries はスレッドから触らない）
+    std::vector<std::pair<size_t, std::shared_ptr<Source>>> finished;  // 読み終えた分
+    size_t inFlight = 0;                                               // 頼んでから update で受け取るまで
+    bool stopping = false;
+
+    void loaderLoop();
+    void enqueue(Entry& e);
+    static std::shared_ptr<Source> decode(const std::string& path);
+
+    static size_t chainBytes(const Entry& e, int fromLevel);
+    void upload(Entry& e, int top);
+};
+
+#endif // TEXTURE_STREAMER_HPP
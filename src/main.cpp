@@ -11,8 +11,22 @@ g++ -I. -std=c++17 \
     src/Physics/Physics.cpp \
     src/Render/Renderer.cpp \
     src/Render/Shader.cpp \
+    src/Render/Lod.cpp \
+    src/Render/TextureAtlas.cpp \
+    src/Render/TextureStreamer.cpp \
     src/Game/ScriptRunner.cpp \
-    -framework OpenGL -lglfw -lGLEW -lm -llua
+    src/Game/JobSystem.cpp \
+    src/Game/Actor.cpp \
+    src/Game/ScriptCache.cpp \
+    src/Game/ScriptProfiler.cpp \
+    src/Game/Joint.cpp \
+    src/Game/Animation.cpp \
+    src/Physics/SpatialQuery.cpp \
+    src/Physics/CharacterController.cpp \
+    src/Physics/Collision.cpp \
+    src/Game/Terrain.cpp \
+    src/Game/Mesh.cpp \
+    -pthread -framework OpenGL -lglfw -lGLEW -lm -llua
 */
 
 #define GL_SILENCE_DEPRECATION
@@ -27,6 +41,9 @@ g++ -I. -std=c++17 \
 #include "src/Physics/Physics.hpp" 
 #include "src/Render/Renderer.hpp"
 #include "src/Game/ScriptRunner.hpp"
+#include "src/Game/Actor.hpp"
+#include "src/Game/ScriptCache.hpp"
+#include "src/Game/ScriptProfiler.hpp"
 
 // グローバル変数（マウス操作用）
 struct MouseState {
@@ -42,6 +59,7 @@ Camera* g_camera = nullptr;
 // オプション変数
 bool Cursor_locked = true;
 bool Cursor_unlock = true;
+float ScriptStats_dumpInterval = 30.0f; // スクリプト統計を表示する間隔（秒、0で無効）
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
     if (button == GLFW_MOUSE_BUTTON_RIGHT) {
@@ -128,6 +146,11 @@ int main(){
     // 【修正】その後にLuaを初期化（この時点でcubesは存在する）
     std::cout << "\n=== Lua console ===" << std::endl;
     initLua();
+
+    // Actor（独立した lua_State で並列実行されるスクリプト群）
+    ActorManager actors;
+    actors.loadDirectory(workspace, "src/Game/script/actors");
+    ScriptCache::get().printStats();
     std::cout << "========================\n" << std::endl;
 
     float lastTime = glfwGetTime();
@@ -145,7 +168,7 @@ int main(){
         Vector3 lookTarget(0,0,0);
         Cube* player = workspace.getPlayer();
         if (player) {
-            lookTarget = player->pos + Vector3(0, 5.0f, 0);
+            lookTarget = player->pos() + Vector3(0, 5.0f, 0);
         }
 
         if(glfwGetKey(win, GLFW_KEY_P) == GLFW_PRESS) {
@@ -168,6 +191,10 @@ int main(){
         Vector3 f, r, u; 
         std::tie(f, r, u) = mainCamera.get_directions();
 
+        // アニメーション（Motor6D.Transform）を書いてから物理へ。関節の姿勢は simulate の中で反映される
+        if (Player* p = workspace.getPlayerObject()) p->updateAnimation();
+        workspace.animation.step(dt);
+
         physics.simulate(workspace, dt);
 
         if (isFreeCam) {
@@ -182,46 +209,58 @@ int main(){
             Vector3 flatF = Vector3(f.x, 0, f.z).normalized();
             Vector3 flatR = Vector3(r.x, 0, r.z).normalized();
             
-            Vector3 targetV(0, player->velocity.y, 0);
-            float speed = 50.0f;
-            
-            bool hasInput = false; // 入力があるかチェック
-
-            if(glfwGetKey(win,GLFW_KEY_W) == GLFW_PRESS) { targetV += flatF * speed; hasInput = true; }
-            if(glfwGetKey(win,GLFW_KEY_S) == GLFW_PRESS) { targetV -= flatF * speed; hasInput = true; }
-            if(glfwGetKey(win,GLFW_KEY_A) == GLFW_PRESS) { targetV -= flatR * speed; hasInput = true; }
-            if(glfwGetKey(win,GLFW_KEY_D) == GLFW_PRESS) { targetV += flatR * speed; hasInput = true; }
-            if(glfwGetKey(win,GLFW_KEY_SPACE) == GLFW_PRESS && player->onGround) { targetV.y = 50.0f; hasInput = true; }
-
-            // 【重要】入力があったらスリープ（省エネモード）を解除して物理演算を回す
-            if (hasInput) {
-                player->wakeUp();
+            // 歩く・跳ぶのは CharacterController（下の characters.step で動く）
+            Vector3 move(0, 0, 0);
+            if(glfwGetKey(win,GLFW_KEY_W) == GLFW_PRESS) move += flatF;
+            if(glfwGetKey(win,GLFW_KEY_S) == GLFW_PRESS) move -= flatF;
+            if(glfwGetKey(win,GLFW_KEY_A) == GLFW_PRESS) move -= flatR;
+            if(glfwGetKey(win,GLFW_KEY_D) == GLFW_PRESS) move += flatR;
+            Player* p = workspace.getPlayerObject();
+            if (p && p->controller) {
+                p->controller->setMoveDirection(move);
+                if(glfwGetKey(win,GLFW_KEY_SPACE) == GLFW_PRESS) p->controller->jump();
             }
 
-            player->velocity.x += (targetV.x - player->velocity.x) * 0.1f;
-            player->velocity.z += (targetV.z - player->velocity.z) * 0.1f;
-            player->velocity.y = targetV.y;
-
             // カメラ追従（ズーム距離を適用）
             mainCamera.pos = lookTarget - f * mouseState.zoomDistance;
             
             // プレイヤーの向きをカメラに合わせる
-            player->rotation.y = mainCamera.rotation.y;
-            player->rotation.x = 0.0f; 
-            player->rotation.z = 0.0f;
-            
-            // プレイヤーの体パーツを同期
-            if (workspace.getPlayerObject()) {
-                workspace.getPlayerObject()->updateBodyParts();
-            }
+            Vector3& rotation = player->rotation();
+            rotation.y = mainCamera.rotation.y;
+            rotation.x = 0.0f; 
+            rotation.z = 0.0f;
+            player->markChanged(Prop_Rotation);
         }
+
+        // キャラクターを歩かせる（剛体の解決の外。押した箱の速度は次の simulate で効く）
+        workspace.characters.step(dt, workspace.gravity);
+
+        // 親子付けされたパーツ（プレイヤーの体など）を親に合わせる。動いた部分木だけ計算する
+        workspace.hierarchy.update();
         // ここから物理シミュレーション済み
+        // このフレームのプロパティ変更をまとめて通知してから Heartbeat
+        PropertyChangeQueue::dispatch();
         RunService::Heartbeat.fire(dt);
+        actors.step(workspace, dt);
+        if (ScriptProfiler::tick(dt, ScriptStats_dumpInterval)) {
+            dumpLuaGC();
+            renderer.printStats();
+        }
+        // このフレームの地形の編集（スクリプトなど）をメッシュ・当たり判定に反映してから描く
+        workspace.terrain.update();
         renderer.render(workspace, mainCamera, lookTarget);
 
+        // このフレームに Destroy() されたものを解放する（物理・描画・Actor が全て終わった後）
+        DestroyQueue::flush();
+
+        // 残り時間で Lua の GC を進める（vsync 待ちの前）
+        double frameWorkMs = (glfwGetTime() - cur) * 1000.0;
+        stepLuaGC(1000.0 / 60.0 - frameWorkMs);
+
         glfwSwapBuffers(win);
     }
 
+    shutdownLua();
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
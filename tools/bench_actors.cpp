@@ -0,0 +1,73 @@
+// tools/bench_actors.cpp
+// 64 個の Actor の Heartbeat を、ワーカーの数を変えて並列に回したときの 1 フレームの時間を測る
+//   make bench        （または ./tools/bench_actors [フレーム数]）
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <filesystem>
+#include <thread>
+
+#include "src/Game/Actor.hpp"
+#include "src/Game/JobSystem.hpp"
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    const int kActors = 64;
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    // 各 Actor は同じ量の計算をして、結果をパーツに書く（書き込みは捨てる）
+    fs::path dir = fs::temp_directory_path() / "bench_actors";
+    fs::create_directories(dir);
+    std::vector<std::string> paths;
+    for (int i = 0; i < kActors; ++i) {
+        fs::path p = dir / ("a" + std::to_string(i) + ".lua");
+        std::ofstream(p) << "local part = workspace:FindFirstChild(\"RedCube\")\n"
+                            "RunService.Heartbeat:Connect(function(dt)\n"
+                            "  local s = 0\n"
+                            "  for i = 1, 20000 do s = s + math.sin(i) end\n"
+                            "  if part then part.Velocity = {X = 0, Y = s * 0, Z = 0} end\n"
+                            "end)\n";
+        paths.push_back(p.string());
+    }
+
+    Workspace ws;
+    ws.initScene(0);
+    WorkspaceSnapshot snapshot;
+    snapshot.capture(ws);
+    std::vector<std::unique_ptr<Actor>> actors;
+    for (int i = 0; i < kActors; ++i) {
+        actors.push_back(std::make_unique<Actor>("a" + std::to_string(i), std::vector<std::string>{ paths[i] }));
+        actors.back()->load(snapshot);
+        actors.back()->pendingWrites().clear();
+    }
+
+    std::cout << "bench_actors: " << kActors << " actors, " << frames << " frames, hardware threads "
+              << std::thread::hardware_concurrency() << std::endl;
+    double base = 0.0;
+    for (unsigned int threads : { 1u, 2u, 4u, 8u }) {
+        // 1 スレッドはワーカーなし（JobSystem(0) はハードウェアに合わせるので作らない）
+        std::unique_ptr<JobSystem> jobs;
+        if (threads > 1) jobs = std::make_unique<JobSystem>(threads - 1);
+        auto stepAll = [&](float dt) {
+            snapshot.capture(ws);
+            auto body = [&](size_t i) { actors[i]->step(snapshot, dt); };
+            if (jobs) jobs->parallelFor(actors.size(), body);
+            else for (size_t i = 0; i < actors.size(); ++i) body(i);
+            for (auto& a : actors) a->pendingWrites().clear();
+        };
+
+        for (int f = 0; f < 5; ++f) stepAll(1.0f / 60.0f);   // 慣らし
+        auto t0 = Clock::now();
+        for (int f = 0; f < frames; ++f) stepAll(1.0f / 60.0f);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / frames;
+        if (threads == 1) base = ms;
+        std::cout << "  " << threads << " threads: " << std::fixed << std::setprecision(2) << ms
+                  << " ms/frame  (x" << base / ms << ")" << std::endl;
+    }
+    fs::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,70 @@
+// tools/bench_animation.cpp
+// 歩きを流す Player の R6 リグ 1000 体で、アニメーションの評価 + 書き戻しと、
+// 関節の姿勢の更新 + TransformHierarchy の 1 フレームの時間を、直列と JobSystem での並列で測る
+//   make bench        （または ./tools/bench_animation [リグの数]）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cstdlib>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Game/JobSystem.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    const int rigs = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const int frames = 300;
+    const float dt = 1.0f / 60.0f;
+
+    Workspace ws;
+    ws.initScene(0);
+    std::vector<Player*> players;
+    for (int i = 0; i < rigs; ++i) {
+        Player* rig = new Player("Rig");
+        rig->buildBody(ws.cubes, ws.joints, Vector3((float)(i % 40) * 8, 10, (float)(i / 40) * 8));
+        for (Cube* c : { rig->HumanoidRootPart, rig->Torso, rig->Head, rig->LeftArm, rig->RightArm, rig->LeftLeg, rig->RightLeg }) {
+            ws.attachPart(c);
+        }
+        rig->loadAnimations(ws.animation);
+        rig->walkTrack->play(0.0f);
+        rig->walkTrack->setTimePosition(0.001f * i);   // 位相をずらす
+        players.push_back(rig);
+    }
+    ws.joints.step(dt);
+    ws.hierarchy.update();
+
+    std::cout << "bench_animation: " << rigs << " walking R6 rigs, " << frames << " frames, worker threads "
+              << JobSystem::get().concurrency() << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (bool parallel : { false, true }) {
+        ws.animation.setParallel(parallel);
+        for (int f = 0; f < 20; ++f) {
+            ws.animation.step(dt);
+            ws.joints.step(dt);
+            ws.hierarchy.update();
+        }
+        double animate = 0.0, pose = 0.0;
+        for (int f = 0; f < frames; ++f) {
+            auto t0 = Clock::now();
+            ws.animation.step(dt);
+            animate += msSince(t0);
+            t0 = Clock::now();
+            ws.joints.step(dt);
+            ws.hierarchy.update();
+            pose += msSince(t0);
+        }
+        std::cout << "  " << (parallel ? "parallel: " : "serial:   ") << "animators " << ws.animation.activeCount()
+                  << "   evaluate + apply " << std::setw(7) << animate / frames << " ms/frame"
+                  << "   joints + hierarchy " << std::setw(7) << pose / frames << " ms/frame" << std::endl;
+    }
+    for (Player* rig : players) delete rig;
+    return 0;
+}
@@ -0,0 +1,76 @@
+// tools/bench_atoms.cpp
+// IsA（クラス表の ClassId・文字列）と FindFirstChild（文字列・Atom）の 1 回あたりの時間を測る
+// （参考に、ClassName の文字列比較と、子の名前を文字列で比べる線形探索も出す）
+//   make bench        （または ./tools/bench_atoms）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+
+#include "src/Game/PartPool.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const int kCalls = 5000000;
+
+    template <typename F>
+    void report(const char* label, F&& call) {
+        volatile size_t sink = 0;   // 最適化で呼び出しが消されないように結果を足す
+        auto t0 = Clock::now();
+        for (int i = 0; i < kCalls; ++i) sink += call(i);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / kCalls;
+        std::cout << "  " << std::left << std::setw(42) << label << std::right << std::setw(7) << ns << " ns" << std::endl;
+    }
+
+    // 索引を使わず、子の名前を文字列で比べる
+    Instance* linearByString(const Instance* inst, const std::string& name) {
+        for (Instance* c : inst->Children) {
+            if (c->Name.str() == name) return c;
+        }
+        return nullptr;
+    }
+}
+
+int main() {
+    std::cout << "bench_atoms: " << kCalls << " calls each, ns per call" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    // パーツと Folder を半分ずつ
+    ComponentStore store;
+    PartPool pool(store);
+    std::vector<Instance*> objs;
+    std::vector<Instance*> folders;
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 2) {
+            objs.push_back(pool.create(CubeBuilder().setName("Part" + std::to_string(i)).build()));
+        } else {
+            folders.push_back(new Instance("Folder" + std::to_string(i), "Folder"));
+            objs.push_back(folders.back());
+        }
+    }
+    Instance* small = new Instance("Model", "Model");
+    for (int i = 0; i < 8; ++i) small->addChild(new Instance("LongPartName_" + std::to_string(i), "Part"));
+    Instance* big = new Instance("Folder", "Folder");
+    for (int i = 0; i < 1000; ++i) big->addChild(new Instance("LongPartName_" + std::to_string(i), "Part"));
+
+    const std::string part = "Part", basePart = "BasePart", q = "LongPartName_7", qBig = "LongPartName_900";
+    const Atom aq(q), aqBig(qBig);
+
+    report("ClassName == \"Part\" (string compare)", [&](int i) { return objs[i % 1000]->ClassName.str() == part; });
+    report("IsA(\"Part\")", [&](int i) { return objs[i % 1000]->IsA(part); });
+    report("IsA(\"BasePart\")", [&](int i) { return objs[i % 1000]->IsA(basePart); });
+    report("IsA(ClassId::Part)", [&](int i) { return objs[i % 1000]->IsA(ClassId::Part); });
+    report("8 children: linear string compare", [&](int) { return linearByString(small, q) != nullptr; });
+    report("8 children: FindFirstChild(string)", [&](int) { return small->FindFirstChild(q) != nullptr; });
+    report("8 children: findChild(Atom)", [&](int) { return small->findChild(aq) != nullptr; });
+    report("1000 children: linear string compare", [&](int) { return linearByString(big, qBig) != nullptr; });
+    report("1000 children: FindFirstChild(string)", [&](int) { return big->FindFirstChild(qBig) != nullptr; });
+    report("1000 children: findChild(Atom)", [&](int) { return big->findChild(aqBig) != nullptr; });
+
+    for (Instance* f : folders) delete f;
+    delete small;
+    delete big;
+    return 0;
+}
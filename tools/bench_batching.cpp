@@ -0,0 +1,128 @@
+// tools/bench_batching.cpp
+// 10000 個の固定パーツの街と 500 個の動く球を隠しウィンドウに描き、固定パーツを塊ごとにまとめたとき
+// （静的バッチ）と 1 つずつ描いたときの描画呼び出しの数とフレームの時間を比べる
+// （街の中心・隅から。LOD を切った場合も。1 つのパーツの色を変えたときにまとめ直す塊の数も出す）
+//   make bench        （または ./tools/bench_batching [測るフレーム数]）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdlib>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Render/Renderer.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    int measuredFrames = 10;
+    const int kWarmFrames = 60;   // インポスターが焼き終わるまで
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    void buildCity(Workspace& ws) {
+        std::mt19937 rng(1);
+        for (int bx = 0; bx < 50; ++bx) {
+            for (int bz = 0; bz < 50; ++bz) {
+                float x = -1500 + bx * 60.0f, z = -1500 + bz * 60.0f;
+                for (int k = 0; k < 4; ++k) {
+                    PartShape shape = (PartShape)(rng() % 4);
+                    float height = 6 + rng() % 30;
+                    Vector3 color(rng() % 256, rng() % 256, rng() % 256);
+                    ws.addPart(CubeBuilder().size(8, height, 8).pos(x + (k & 1) * 20, height * 0.5f, z + (k >> 1) * 20)
+                                   .shape(shape).color(color).setStatic().build());
+                }
+            }
+        }
+        for (int i = 0; i < 500; ++i) {
+            ws.addPart(CubeBuilder().size(3, 3, 3).pos(-1500 + (rng() % 3000), 50, -1500 + (rng() % 3000))
+                           .shape(PartShape::Ball).build());
+        }
+    }
+
+    // 温めてから measuredFrames フレームを測る（glFinish で GPU を待つ）
+    void measure(Renderer& renderer, const Workspace& ws, const Camera& cam, const std::string& label) {
+        for (int f = 0; f < kWarmFrames; ++f) renderer.render(ws, cam, Vector3());
+        glFinish();
+        auto t0 = Clock::now();
+        for (int f = 0; f < measuredFrames; ++f) {
+            renderer.render(ws, cam, Vector3());
+            glFinish();
+        }
+        const RenderStats& s = renderer.getStats();
+        std::cout << "  " << std::left << std::setw(25) << label << std::right << std::setw(6) << s.drawCalls << " draw calls  "
+                  << std::setw(6) << std::setprecision(1) << msSince(t0) / measuredFrames << " ms/frame  (" << s.batches << " batches)" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) measuredFrames = std::max(1, std::atoi(argv[1]));
+    if (!glfwInit()) return 1;
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow((int)SCREEN_W, (int)SCREEN_H, "bench_batching", NULL, NULL);
+    if (!window) {
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    if (glewInit() != GLEW_OK) return 1;
+
+    std::cout << "bench_batching: 10000 anchored parts + 500 balls, " << (int)SCREEN_W << "x" << (int)SCREEN_H << ", "
+              << glGetString(GL_RENDERER) << std::endl;
+    std::cout << std::fixed;
+    {
+        Renderer renderer;
+        renderer.init();
+        Workspace ws;
+        ws.initScene(0);
+        buildCity(ws);
+        Camera center, corner;
+        center.pos = Vector3(0, 60, 0);
+        center.rotation = Vector3(10, -135, 0);
+        corner.pos = Vector3(-1500, 80, -1500);
+        corner.rotation = Vector3(8, -135, 0);
+
+        // 最初のフレームで見える塊を全てまとめる
+        auto t0 = Clock::now();
+        renderer.render(ws, center, Vector3());
+        glFinish();
+        std::cout << "  first frame: " << std::setprecision(0) << msSince(t0) << " ms, " << renderer.getStats().batchRebuilds
+                  << " batches built" << std::endl;
+
+        // 中心の近くのパーツの色を変える: まとめ直すのはその塊だけ
+        Cube* edited = nullptr;
+        ws.components.forEach(Comp_Transform | Comp_Anchored, [&](const Archetype& arch) {
+            for (size_t i = 0; i < arch.size() && !edited; ++i) {
+                if ((arch.transforms[i].pos - center.pos).length() < 60) edited = arch.owners[i];
+            }
+        });
+        for (int f = 0; f < 5; ++f) renderer.render(ws, center, Vector3());
+        edited->renderable().color = Vector3(255, 0, 0);
+        renderer.render(ws, center, Vector3());
+        std::cout << "  recolour one part: " << renderer.getStats().batchRebuilds << " batch rebuilt" << std::endl;
+
+        for (bool batching : { true, false }) {
+            renderer.setStaticBatching(batching);
+            const char* mode = batching ? "batched" : "per part";
+            measure(renderer, ws, center, std::string("centre, ") + mode);
+            measure(renderer, ws, corner, std::string("corner, ") + mode);
+        }
+        renderer.lodSettings().enabled = false;
+        for (bool batching : { true, false }) {
+            renderer.setStaticBatching(batching);
+            measure(renderer, ws, center, std::string("centre, no LOD, ") + (batching ? "batched" : "per part"));
+        }
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,103 @@
+// tools/bench_components.cpp
+// 10 万個のパーツ（3 割 Anchored）で、Transform + RigidBody の列を辿る積分（simulate を 8 分割）と、
+// 描画と同じ形の走査（Transform + Renderable の列）を測る。
+// 描画の走査は、Cube の受け口（pos() / color() など）を 1 個ずつ通す場合とも比べる
+//   make bench        （または ./tools/bench_components [フレーム数]）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const int kParts = 100000;
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // 不透明・半透明の 2 回に分けて、描画に使う値を読む
+    double iterateArchetypes(Workspace& ws) {
+        double sum = 0.0;
+        for (int pass = 0; pass < 2; ++pass) {
+            ws.components.forEach(Comp_Transform | Comp_Renderable, [&](const Archetype& arch) {
+                for (size_t i = 0; i < arch.size(); ++i) {
+                    const Renderable& r = arch.renderables[i];
+                    if (r.transparency >= 1.0f || (r.transparency > 0.0f) != (pass == 1)) continue;
+                    if (!arch.owners[i]->isActive()) continue;
+                    const Transform& t = arch.transforms[i];
+                    sum += t.pos.x + r.color.y + t.rotation.z + t.size.x;
+                }
+            });
+        }
+        return sum;
+    }
+
+    double iterateCubes(Workspace& ws) {
+        double sum = 0.0;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (Cube& c : ws.cubes) {
+                if (!c.isActive() || c.transparency() >= 1.0f || (c.transparency() > 0.0f) != (pass == 1)) continue;
+                sum += c.pos().x + c.color().y + c.rotation().z + c.size().x;
+            }
+        }
+        return sum;
+    }
+
+    void run(bool spin, int frames) {
+        // 衝突は総当たりなので、積分だけを測るために全て CanCollide=false にする
+        Workspace ws;
+        global_workspace = &ws;
+        for (int i = 0; i < kParts; ++i) {
+            CubeBuilder b;
+            b.pos((float)(i % 100) * 3, 50.0f + (float)(i / 10000) * 3, (float)(i / 100 % 100) * 3)
+             .size(1, 1, 1).color((float)(i % 255), 100, 50).setCanCollide(false);
+            if (i % 10 < 3) b.setStatic();
+            ws.addPart(b.build());
+        }
+        if (spin) {
+            for (Cube& c : ws.cubes) {
+                if (RigidBody* body = c.body()) body->angularVelocity = Vector3(0.5f, 1.0f, 0.2f);
+            }
+        }
+        PropertyChangeQueue::dispatch();
+
+        Physics physics;
+        physics.setSubSteps(8);
+        double integrate = 0.0, archetypes = 0.0, cubes = 0.0;
+        volatile double sink = 0.0;
+        for (int f = 0; f < frames; ++f) {
+            auto t0 = Clock::now();
+            physics.simulate(ws, 1.0f / 60.0f);
+            PropertyChangeQueue::dispatch();
+            integrate += msSince(t0);
+
+            t0 = Clock::now();
+            sink = sink + iterateArchetypes(ws);
+            archetypes += msSince(t0);
+
+            t0 = Clock::now();
+            sink = sink + iterateCubes(ws);
+            cubes += msSince(t0);
+        }
+        std::cout << "  " << (spin ? "with spin:    " : "without spin: ")
+                  << "simulate + dispatch " << std::setw(7) << integrate / frames << " ms"
+                  << "   render iteration: archetypes " << std::setw(5) << archetypes / frames
+                  << " ms, per Cube " << std::setw(5) << cubes / frames << " ms" << std::endl;
+        global_workspace = nullptr;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 60;
+    std::cout << "bench_components: " << kParts << " parts (30% anchored, none colliding), 8 substeps, "
+              << frames << " frames, ms per frame" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    run(true, frames);
+    run(false, frames);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// tools/bench_controller.cpp
+// 4000 個の固定の小道具の間を、500 個の CharacterController が 1 秒ごとに向きを変えながら歩くときの、
+// CharacterSystem::step の 1 ティックの時間を測る（直列と JobSystem での並列）。
+// 根は kinematic で物理からは動かないので、パーツ同士が総当たりの simulate は回さない
+//   make bench        （または ./tools/bench_controller [コントローラーの数]）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cstdlib>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Game/JobSystem.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 500;
+    const int ticks = 300;
+    const float dt = 1.0f / 60.0f;
+
+    Workspace ws;
+    ws.initScene(0);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    for (int i = 0; i < 4000; ++i) {
+        ws.addPart(CubeBuilder().size(2 + 6 * std::fabs(u(rng)), 1 + 4 * std::fabs(u(rng)), 2 + 6 * std::fabs(u(rng)))
+                       .pos(u(rng) * 240, 0.5f, u(rng) * 240).rotation(0, u(rng) * 180, 0)
+                       .setName("Prop").setStatic().build());
+    }
+    std::vector<CharacterController*> controllers;
+    for (int i = 0; i < count; ++i) {
+        Cube* root = ws.addPart(CubeBuilder().size(4, 10, 2).pos(u(rng) * 220, 12, u(rng) * 220).setName("NPC").setPlayer().build());
+        controllers.push_back(ws.characters.add(root, root));
+    }
+
+    auto turn = [&] {
+        for (CharacterController* c : controllers) c->setMoveDirection(Vector3(u(rng), 0, u(rng)));
+    };
+    auto tick = [&](double* characterMs) {
+        auto t0 = Clock::now();
+        ws.characters.step(dt, ws.gravity);
+        if (characterMs) *characterMs += msSince(t0);
+        ws.hierarchy.update();
+        PropertyChangeQueue::dispatch();
+        DestroyQueue::flush();
+    };
+
+    // 降りて接地するまで
+    turn();
+    for (int i = 0; i < 60; ++i) tick(nullptr);
+
+    std::cout << "bench_controller: " << count << " controllers, " << ws.cubes.size() << " parts, " << ticks
+              << " ticks, worker threads " << JobSystem::get().concurrency() << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (bool parallel : { false, true }) {
+        ws.characters.setParallel(parallel);
+        double characterMs = 0.0;
+        for (int i = 0; i < ticks; ++i) {
+            if (i % 60 == 0) turn();
+            tick(&characterMs);
+        }
+        int grounded = 0;
+        for (CharacterController* c : controllers) grounded += c->isOnGround();
+        std::cout << "  " << (parallel ? "parallel: " : "serial:   ") << "characters " << std::setw(7) << characterMs / ticks
+                  << " ms/tick   grounded "
+                  << grounded << "/" << count << std::endl;
+    }
+    return 0;
+}
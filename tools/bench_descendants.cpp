@@ -0,0 +1,138 @@
+// tools/bench_descendants.cpp
+// 10 万個の子孫を、GetDescendants（1 本の vector に詰める）・descendants()・forEachDescendant で辿る時間と
+// global operator new の回数を、階層ごとに vector を作って繋ぐ素直な再帰と比べる。
+// Lua では再帰の GetChildren と IterDescendants を比べる
+//   make bench        （または ./tools/bench_descendants）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <new>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/ScriptRunner.hpp"
+#include "src/Game/Workspace.hpp"
+
+extern lua_State* G_L;
+
+static size_t g_newCalls = 0;
+
+void* operator new(size_t size) {
+    g_newCalls++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const int kDescendants = 100000;
+
+    // 階層ごとに vector を作って繋ぐ（以前の GetDescendants）
+    std::vector<Instance*> recursiveDescendants(const Instance* inst) {
+        std::vector<Instance*> out;
+        for (Instance* c : inst->Children) {
+            out.push_back(c);
+            std::vector<Instance*> sub = recursiveDescendants(c);
+            out.insert(out.end(), sub.begin(), sub.end());
+        }
+        return out;
+    }
+
+    template <typename F>
+    void report(const char* label, F&& walk) {
+        const int reps = 5;
+        volatile size_t sink = 0;
+        size_t news = g_newCalls;
+        auto t0 = Clock::now();
+        for (int i = 0; i < reps; ++i) sink += walk();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / reps;
+        std::cout << "    " << std::left << std::setw(22) << label << std::right << std::setw(8) << ms << " ms"
+                  << std::setw(9) << (g_newCalls - news) / reps << " allocs" << std::endl;
+    }
+
+    void walkTree(bool deep) {
+        Instance* root = new Instance("Root", "Folder");
+        std::vector<Instance*> all{ root };
+        std::mt19937 rng(1);
+        if (!deep) {
+            // ランダムな親に付ける（深さ 30 前後）
+            for (int i = 0; i < kDescendants; ++i) {
+                Instance* c = new Instance("N", "Model");
+                all[rng() % all.size()]->addChild(c);
+                all.push_back(c);
+            }
+        } else {
+            // 100 個ごとに 1 段深くなる（深さ 6000 超。明示スタックがあふれて vector に移る）
+            Instance* parent = root;
+            for (int i = 0; i < kDescendants; ++i) {
+                Instance* c = new Instance("N", "Model");
+                Instance* p = i % 100 == 0 ? parent : all[all.size() - 1 - rng() % (i % 100)];
+                p->addChild(c);
+                all.push_back(c);
+                if (i % 100 == 99) parent = c;
+            }
+        }
+        int depth = 0;
+        for (Instance* inst : all) {
+            int d = 0;
+            for (Instance* a = inst; a; a = a->Parent) d++;
+            depth = std::max(depth, d);
+        }
+
+        std::cout << "  " << (deep ? "deep" : "random") << " tree, max depth " << depth << std::endl;
+        report("recursive vectors", [&] { return recursiveDescendants(root).size(); });
+        report("GetDescendants", [&] { return root->GetDescendants().size(); });
+        report("descendants()", [&] {
+            size_t n = 0;
+            for (Instance* d : root->descendants()) n += !d->destroying;
+            return n;
+        });
+        report("forEachDescendant", [&] {
+            size_t n = 0;
+            root->forEachDescendant([&](Instance* d) { n += !d->destroying; });
+            return n;
+        });
+        delete root;
+    }
+}
+
+int main() {
+    std::cout << "bench_descendants: " << kDescendants << " descendants, mean of 5 walks" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    walkTree(false);
+    walkTree(true);
+
+    Workspace ws;
+    ws.initScene(0);
+    initLua();
+    luaL_dostring(G_L,
+        "local root = Instance.new('Folder', workspace)\n"
+        "local all = { root }\n"
+        "math.randomseed(1)\n"
+        "for i = 1, 100000 do all[#all + 1] = Instance.new('Model', all[math.random(#all)]) end\n"
+        "local function collect(inst, out)\n"
+        "  for _, c in ipairs(inst:GetChildren()) do out[#out + 1] = c; collect(c, out) end\n"
+        "  return out\n"
+        "end\n"
+        "local t = os.clock()\n"
+        "collect(root, {})\n"
+        "recursiveMs = (os.clock() - t) * 1000\n"
+        "t = os.clock()\n"
+        "local n = 0\n"
+        "for d in root:IterDescendants() do n = n + 1 end\n"
+        "iterMs = (os.clock() - t) * 1000");
+    lua_getglobal(G_L, "recursiveMs");
+    lua_getglobal(G_L, "iterMs");
+    std::cout << "  Lua, random tree" << std::endl;
+    std::cout << "    recursive GetChildren " << std::setw(8) << lua_tonumber(G_L, -2) << " ms" << std::endl;
+    std::cout << "    IterDescendants       " << std::setw(8) << lua_tonumber(G_L, -1) << " ms" << std::endl;
+    lua_settop(G_L, 0);
+    shutdownLua();
+    return 0;
+}
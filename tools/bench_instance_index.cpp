@@ -0,0 +1,90 @@
+// tools/bench_instance_index.cpp
+// 10 万個の Instance の木で、FindFirstChild / FindFirstChildOfClass を索引で引く時間と、
+// 索引を使わずに辿る時間を比べる（索引との一致は tools/check_instance_index.cpp で確かめる）
+//   make bench        （または ./tools/bench_instance_index）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <random>
+
+#include "src/Game/Instance.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const int kInstances = 100000;
+
+    Instance* plainByName(const Instance* inst, Atom name) {
+        for (Instance* c : inst->Children) if (!c->destroying && c->Name == name) return c;
+        for (Instance* c : inst->Children) if (Instance* r = plainByName(c, name)) return r;
+        return nullptr;
+    }
+
+    template <typename F>
+    double usPerCall(int calls, F&& call) {
+        auto t0 = Clock::now();
+        for (int i = 0; i < calls; ++i) call(i);
+        return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / calls;
+    }
+}
+
+int main() {
+    std::cout << "bench_instance_index: " << kInstances << " instances, us per lookup" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    volatile size_t sink = 0;   // 最適化で呼び出しが消されないように結果を足す
+
+    // 子孫索引を持つルートの下に、ランダムな深さの木（名前は全て別）
+    {
+        Instance* root = new Instance("Root", "Folder");
+        root->enableDescendantIndex();
+        std::vector<Instance*> nodes{ root };
+        std::mt19937 rng(7);
+        std::vector<std::string> names;
+        for (int i = 0; i < kInstances; ++i) {
+            names.push_back("N" + std::to_string(i));
+            Instance* inst = new Instance(names.back(), i % 3 ? "Folder" : "Model");
+            nodes[rng() % nodes.size()]->addChild(inst);
+            nodes.push_back(inst);
+        }
+
+        const int calls = 2000;
+        double indexed = usPerCall(calls, [&](int i) { sink += root->FindFirstChild(names[(i * 7919) % kInstances], true) != nullptr; });
+        double plain = usPerCall(200, [&](int i) { sink += plainByName(root, Atom::find(names[(i * 7919) % kInstances])) != nullptr; });
+        double fromSubtree = usPerCall(calls, [&](int i) {
+            Instance* from = nodes[1 + (i * 104729) % kInstances];
+            sink += from->FindFirstChild(names[(i * 7919) % kInstances], true) != nullptr;
+        });
+        std::cout << "  recursive FindFirstChild from the root:   indexed " << std::setw(8) << indexed
+                  << "   plain DFS " << std::setw(9) << plain << std::endl;
+        std::cout << "  recursive FindFirstChild from a subtree:  " << std::setw(8) << fromSubtree << std::endl;
+        delete root;
+    }
+
+    // 10 万個の子を持つ Folder（子の索引）
+    {
+        Instance* folder = new Instance("Wide", "Folder");
+        std::vector<std::string> names;
+        for (int i = 0; i < kInstances; ++i) {
+            names.push_back("N" + std::to_string(i));
+            folder->addChild(new Instance(names.back(), "Part"));
+        }
+
+        const int calls = 2000;
+        double indexed = usPerCall(calls, [&](int i) { sink += folder->FindFirstChild(names[(i * 50) % kInstances]) != nullptr; });
+        double linear = usPerCall(calls, [&](int i) {
+            Atom key = Atom::find(names[(i * 50) % kInstances]);
+            for (Instance* c : folder->Children) {
+                if (c->Name == key) { sink++; break; }
+            }
+        });
+        double byClass = usPerCall(calls, [&](int) { sink += folder->FindFirstChildOfClass("Part") != nullptr; });
+        std::cout << "  direct FindFirstChild, 100k children:      indexed " << std::setw(8) << indexed
+                  << "   linear    " << std::setw(9) << linear << std::endl;
+        std::cout << "  direct FindFirstChildOfClass:              indexed " << std::setw(8) << byClass << std::endl;
+        delete folder;
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+// tools/bench_joints.cpp
+// 10x5x10 個（500 個）のパーツを 499 本の Weld で繋いだ車体を、横に滑らせながら落とし、
+// 剛体アセンブリ（既定）と拘束で解いた場合の 1 フレームの時間と、Weld のずれの最大を比べる
+//   make bench        （または ./tools/bench_joints [フレーム数]）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cstdlib>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    struct WeldEnds {
+        Cube* a;
+        Cube* b;
+        Vector3 offset;
+    };
+
+    void run(bool assemblies, int frames) {
+        Workspace ws;
+        ws.initScene(0);
+        ws.joints.setUseAssemblies(assemblies);
+        Physics physics;
+
+        const int nx = 10, ny = 5, nz = 10;
+        const float spacing = 2.2f;
+        std::vector<Cube*> parts;
+        for (int y = 0; y < ny; ++y) {
+            for (int z = 0; z < nz; ++z) {
+                for (int x = 0; x < nx; ++x) {
+                    parts.push_back(ws.addPart(CubeBuilder().size(2, 2, 2).pos(40 + x * spacing, 20 + y * spacing, z * spacing).setName("V").build()));
+                }
+            }
+        }
+        // x 方向に繋ぎ、各列の先頭は z 方向、各層の先頭は y 方向に繋ぐ（全体で木になる）
+        auto at = [&](int x, int y, int z) { return parts[(y * nz + z) * nx + x]; };
+        std::vector<WeldEnds> welds;
+        for (int y = 0; y < ny; ++y) {
+            for (int z = 0; z < nz; ++z) {
+                for (int x = 0; x < nx; ++x) {
+                    Cube* prev = nullptr;
+                    Vector3 offset;
+                    if (x > 0) { prev = at(x - 1, y, z); offset = Vector3(spacing, 0, 0); }
+                    else if (z > 0) { prev = at(x, y, z - 1); offset = Vector3(0, 0, spacing); }
+                    else if (y > 0) { prev = at(x, y - 1, z); offset = Vector3(0, spacing, 0); }
+                    else continue;
+                    JointInstance* weld = new JointInstance(&ws.joints, "Weld");
+                    weld->setPart0(prev);
+                    weld->setPart1(at(x, y, z));
+                    weld->setC0(JointFrame(offset));
+                    ws.addChild(weld);
+                    welds.push_back({ prev, at(x, y, z), offset });
+                }
+            }
+        }
+        for (Cube* p : parts) p->setVelocity(Vector3(10, 0, 0));
+
+        // 最初の 10 フレーム（組み立て）は時間に入れない
+        double total = 0.0;
+        float maxDrift = 0.0f;
+        for (int f = 0; f < frames; ++f) {
+            auto t0 = Clock::now();
+            physics.simulate(ws, 1.0f / 60.0f);
+            ws.hierarchy.update();
+            if (f >= 10) total += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            PropertyChangeQueue::dispatch();
+            DestroyQueue::flush();
+            for (const WeldEnds& w : welds) {
+                Matrix3 R = Matrix3::rotate(w.a->rotation());
+                maxDrift = std::max(maxDrift, (w.b->pos() - (w.a->pos() + R * w.offset)).length());
+            }
+        }
+        std::cout << "  " << (assemblies ? "compound:    " : "constraints: ") << std::setw(7) << std::setprecision(1)
+                  << total / (frames - 10) << " ms/frame   max weld drift " << std::setprecision(4) << maxDrift
+                  << "   (welds " << welds.size() << ")" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int frames = std::max(11, argc > 1 ? std::atoi(argv[1]) : 180);
+    std::cout << "bench_joints: 500-part vehicle, " << frames << " frames" << std::endl;
+    std::cout << std::fixed;
+    run(true, frames);
+    run(false, frames);
+    return 0;
+}
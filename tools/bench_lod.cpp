@@ -0,0 +1,167 @@
+// tools/bench_lod.cpp
+// 10000 個の固定パーツの街と 500 個の動く球で、LOD・インポスターを使ったときに送る三角形の数
+// （Renderer と同じ選び方で数える。GL は使わない）と LodClusters::update の時間、
+// 回るカメラでの焼き直しの数、simplifyMesh の時間を測る
+//   make bench        （または ./tools/bench_lod）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <cmath>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Game/Mesh.hpp"
+#include "src/Render/Lod.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // Renderer の分割の三角形の数（球 16x12 / 10x7 / 6x4、円柱 24 / 12 / 6 分割）
+    int trianglesOf(PartShape shape, int level) {
+        static const int ball[kLodLevels] = { 384, 140, 48 }, cylinder[kLodLevels] = { 96, 48, 24 };
+        switch (shape) {
+        case PartShape::Ball:     return ball[level];
+        case PartShape::Cylinder: return cylinder[level];
+        case PartShape::Wedge:    return 8;
+        default:                  return 12;
+        }
+    }
+
+    // 3000 x 3000 スタッドに 50 x 50 区画、区画ごとに 4 棟（形はばらばら）
+    void buildCity(Workspace& ws) {
+        std::mt19937 rng(1);
+        for (int bx = 0; bx < 50; ++bx) {
+            for (int bz = 0; bz < 50; ++bz) {
+                float x = -1500 + bx * 60.0f, z = -1500 + bz * 60.0f;
+                for (int k = 0; k < 4; ++k) {
+                    PartShape shape = (PartShape)(rng() % 4);
+                    ws.addPart(CubeBuilder().size(8, 6 + rng() % 30, 8).pos(x + (k & 1) * 20, 20, z + (k >> 1) * 20)
+                                   .shape(shape).setStatic().build());
+                }
+            }
+        }
+        for (int i = 0; i < 500; ++i) {
+            ws.addPart(CubeBuilder().size(3, 3, 3).pos(-1500 + (rng() % 3000), 50, -1500 + (rng() % 3000))
+                           .shape(PartShape::Ball).build());
+        }
+    }
+
+    struct Frame {
+        size_t triangles = 0, unreduced = 0, culled = 0;
+        size_t levels[kLodLevels] = {};   // 球・円柱の段ごとの数
+        double updateMs = 0.0;
+    };
+
+    // 1 フレーム分: 塊を更新し、Renderer と同じように段を選んで三角形を数える
+    Frame frame(Workspace& ws, LodClusters& clusters, LodSelector& selector, const LodSettings& settings, const Vector3& eye) {
+        Frame out;
+        auto t0 = Clock::now();
+        clusters.update(ws.components, eye, settings);
+        out.updateMs = msSince(t0);
+        auto part = [&](EntityId e, const Transform& t) {
+            float radius = 0.5f * t.size.length();
+            if (beyondFarPlane(t.pos, radius, eye)) {
+                out.culled++;
+                return;
+            }
+            int level = 0;
+            if (t.shape == PartShape::Ball || t.shape == PartShape::Cylinder) {
+                level = selector.update(e, projectedPixels(radius, (t.pos - eye).length()), settings);
+                out.levels[level]++;
+            }
+            out.triangles += trianglesOf(t.shape, level);
+        };
+        ws.components.forEach(Comp_Transform | Comp_Renderable, [&](const Archetype& arch) {
+            for (size_t i = 0; i < arch.size(); ++i) {
+                if (!arch.owners[i]->isActive() || arch.renderables[i].transparency >= 1.0f) continue;
+                out.unreduced += trianglesOf(arch.transforms[i].shape, 0);
+                if (arch.has(Comp_Anchored) && LodClusters::isMember(arch, i)) continue;
+                part(arch.entities[i], arch.transforms[i]);
+            }
+        });
+        for (const LodCluster& c : clusters.clusters()) {
+            if (c.culled) out.culled += c.members.size();
+            else if (c.impostor) out.triangles += 2;
+            else for (const LodCluster::Member& m : c.members) part(m.entity, *m.transform);
+        }
+        return out;
+    }
+
+    void report(const std::string& label, const Frame& f, const LodClusters& clusters) {
+        std::cout << "  " << std::left << std::setw(16) << label << std::right
+                  << " triangles " << std::setw(8) << f.triangles << " (" << std::setw(4) << std::setprecision(1)
+                  << 100.0 * f.triangles / f.unreduced << "%)   impostors " << std::setw(3) << clusters.impostorCount()
+                  << "   ball/cylinder LOD " << f.levels[0] << "/" << f.levels[1] << "/" << f.levels[2]
+                  << "   culled " << std::setw(4) << f.culled << "   update " << std::setprecision(2) << f.updateMs << " ms" << std::endl;
+    }
+
+    void makeSphere(MeshAsset& mesh, int rings, int segments) {
+        std::string obj;
+        for (int r = 0; r <= rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                float th = (float)M_PI * r / rings, ph = 2.0f * (float)M_PI * s / segments;
+                float radius = 1.0f + 0.08f * std::sin(ph * 7) * std::sin(th * 5);
+                obj += "v " + std::to_string(radius * std::sin(th) * std::cos(ph)) + " " + std::to_string(radius * std::cos(th)) +
+                       " " + std::to_string(radius * std::sin(th) * std::sin(ph)) + "\n";
+            }
+        }
+        for (int r = 0; r < rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                int a = r * segments + s + 1, b = r * segments + (s + 1) % segments + 1;
+                obj += "f " + std::to_string(a) + " " + std::to_string(b) + " " + std::to_string(b + segments) + " " +
+                       std::to_string(a + segments) + "\n";
+            }
+        }
+        parseObj(obj.data(), obj.size(), mesh);
+    }
+}
+
+int main() {
+    Workspace ws;
+    ws.initScene(0);
+    buildCity(ws);
+    LodSettings settings;
+    LodClusters clusters;
+    clusters.setTileCount(1024);
+    LodSelector selector;
+
+    std::cout << "bench_lod: 10000 anchored parts + 500 balls" << std::endl;
+    std::cout << std::fixed;
+    Vector3 center(0, 60, 0), corner(-1500, 60, -1500);
+    Frame f = frame(ws, clusters, selector, settings, center);
+    std::cout << "  without LOD: " << f.unreduced << " triangles, " << clusters.clusters().size() << " clusters" << std::endl;
+    report("centre, frame 1", f, clusters);
+    for (int i = 0; i < 40; ++i) frame(ws, clusters, selector, settings, center);
+    report("centre, settled", frame(ws, clusters, selector, settings, center), clusters);
+    report("corner, frame 1", frame(ws, clusters, selector, settings, corner), clusters);
+    for (int i = 0; i < 60; ++i) frame(ws, clusters, selector, settings, corner);
+    report("corner, settled", frame(ws, clusters, selector, settings, corner), clusters);
+
+    // 隅で半径 30 の円をゆっくり回る（焼いた向きからずれた塊だけ焼き直す）
+    size_t captures = 0;
+    double updateMs = 0.0;
+    for (int i = 0; i < 120; ++i) {
+        Vector3 eye(-1500 + 30 * std::cos(i * 0.02f), 60, -1500 + 30 * std::sin(i * 0.02f));
+        updateMs += frame(ws, clusters, selector, settings, eye).updateMs;
+        captures += clusters.captureCount();
+    }
+    std::cout << "  orbit, 120 frames: " << captures << " recaptures, update " << std::setprecision(2) << updateMs / 120 << " ms/frame" << std::endl;
+
+    // メッシュの簡略化（224 x 224 の四角形 = 10 万三角形）
+    MeshAsset mesh;
+    makeSphere(mesh, 224, 224);
+    for (int grid : { 32, 10 }) {
+        std::vector<uint32_t> indices;
+        auto t0 = Clock::now();
+        simplifyMesh(mesh, grid, indices);
+        std::cout << "  simplifyMesh grid " << std::setw(2) << grid << ": " << mesh.triangleCount() << " -> " << std::setw(5)
+                  << indices.size() / 3 << " triangles, " << std::setprecision(1) << msSince(t0) << " ms" << std::endl;
+    }
+    return 0;
+}
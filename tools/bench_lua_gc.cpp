@@ -0,0 +1,79 @@
+// tools/bench_lua_gc.cpp
+// 確保の多い Heartbeat を 3000 フレーム回し、Lua の既定の GC と GCController（世代別・空き時間でステップ）で
+// 1 フレームの時間（スクリプト + GC）が 8 ms を超えた回数とヒープの大きさを比べる
+//   make bench        （または ./tools/bench_lua_gc [フレーム数]）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/ScriptRunner.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    // 毎フレーム 1500 個の表を作り、2 万個を持ち続ける（古いものから入れ替わる）
+    const char* kScript =
+        "local keep = {} local n = 0\n"
+        "function heartbeat(dt)\n"
+        "  for i = 1, 1500 do n = n + 1; keep[n % 20000 + 1] = {x = i, y = {i}, s = 'p' .. i} end\n"
+        "end\n";
+
+    struct Result {
+        int slowFrames = 0;
+        double worstMs = 0.0;
+        double totalMs = 0.0;
+        double heapKB = 0.0;
+        double peakKB = 0.0;
+    };
+
+    double heapKB(lua_State* L) {
+        return lua_gc(L, LUA_GCCOUNT) + lua_gc(L, LUA_GCCOUNTB) / 1024.0;
+    }
+
+    Result run(bool controller, int frames, double budgetMs) {
+        lua_State* L = luaL_newstate();
+        luaL_openlibs(L);
+        GCController gc;
+        gc.enabled = controller;
+        gc.attach(L, nullptr);
+        luaL_dostring(L, kScript);
+
+        Result r;
+        for (int f = 0; f < frames; ++f) {
+            auto t0 = Clock::now();
+            lua_getglobal(L, "heartbeat");
+            lua_pushnumber(L, 1.0 / 60.0);
+            lua_pcall(L, 1, 0, 0);
+            double work = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            gc.step(budgetMs - work);
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+            if (ms >= budgetMs) r.slowFrames++;
+            r.worstMs = std::max(r.worstMs, ms);
+            r.totalMs += ms;
+            r.peakKB = std::max(r.peakKB, heapKB(L));
+        }
+        r.heapKB = heapKB(L);
+        lua_close(L);
+        return r;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 3000;
+    const double budgetMs = 8.0;
+
+    std::cout << "bench_lua_gc: " << frames << " frames, 1500 tables per frame, budget " << budgetMs << " ms" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (bool controller : { false, true }) {
+        Result r = run(controller, frames, budgetMs);
+        std::cout << "  " << (controller ? "GCController:  " : "default GC:    ")
+                  << "frames over budget " << std::setw(5) << r.slowFrames
+                  << "   mean " << std::setw(6) << r.totalMs / frames << " ms   worst " << std::setw(7) << r.worstMs << " ms"
+                  << "   heap " << std::setw(6) << r.heapKB / 1024.0 << " MB (peak " << r.peakKB / 1024.0 << ")" << std::endl;
+    }
+    return 0;
+}
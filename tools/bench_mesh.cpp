@@ -0,0 +1,126 @@
+// tools/bench_mesh.cpp
+// 10 万三角形の OBJ（5.3MB）で、OBJ を読んで BVH と凸包を作る時間と、焼いた形式（.mesh）を読む時間、
+// BVH を辿るレイと全ての三角形を調べるレイの本数/秒を比べる
+//   make bench        （または ./tools/bench_mesh）
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <vector>
+#include <string>
+#include <cmath>
+
+#include "src/Game/Mesh.hpp"
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const int kRings = 224;   // 224 x 224 の四角形 = 10 万三角形
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // 表面に起伏のある球（法線つき、面は四角形）
+    void writeSphere(const fs::path& path, int rings, int segments) {
+        std::ofstream out(path);
+        out << std::fixed << std::setprecision(6);
+        for (int r = 0; r <= rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                float th = (float)M_PI * r / rings, ph = 2.0f * (float)M_PI * s / segments;
+                float radius = 1.0f + 0.08f * std::sin(ph * 7) * std::sin(th * 5);
+                Vector3 n(std::sin(th) * std::cos(ph), std::cos(th), std::sin(th) * std::sin(ph));
+                out << "v " << n.x * radius << " " << n.y * radius << " " << n.z * radius << "\n";
+                out << "vn " << n.x << " " << n.y << " " << n.z << "\n";
+            }
+        }
+        for (int r = 0; r < rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                int a = r * segments + s + 1, b = r * segments + (s + 1) % segments + 1, c = a + segments, d = b + segments;
+                out << "f " << a << "//" << a << " " << b << "//" << b << " " << d << "//" << d << " " << c << "//" << c << "\n";
+            }
+        }
+    }
+
+    // 全ての三角形との Möller–Trumbore（一番近い t、当たらなければ -1）
+    float bruteRaycast(const MeshAsset& mesh, const Vector3& origin, const Vector3& dir, float maxT) {
+        float best = -1.0f;
+        for (uint32_t k = 0; k < mesh.triangleCount(); ++k) {
+            Vector3 p0 = mesh.corner(k, 0);
+            Vector3 e1 = mesh.corner(k, 1) - p0, e2 = mesh.corner(k, 2) - p0;
+            Vector3 pv = dir.cross(e2);
+            float det = e1.dot(pv);
+            if (std::fabs(det) < 1e-12f) continue;
+            float inv = 1.0f / det;
+            Vector3 tv = origin - p0;
+            float u = tv.dot(pv) * inv;
+            if (u < 0.0f || u > 1.0f) continue;
+            Vector3 qv = tv.cross(e1);
+            float v = dir.dot(qv) * inv;
+            if (v < 0.0f || u + v > 1.0f) continue;
+            float t = e2.dot(qv) * inv;
+            if (t >= 0.0f && t <= maxT && (best < 0.0f || t < best)) best = t;
+        }
+        return best;
+    }
+}
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / "bench_mesh";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::path obj = dir / "sphere.obj", cooked = dir / "sphere.mesh";
+    writeSphere(obj, kRings, kRings);
+    double mb = fs::file_size(obj) / 1048576.0;
+
+    MeshAsset mesh;
+    auto t0 = Clock::now();
+    bool ok = loadObj(obj.string(), mesh);
+    double parse = msSince(t0);
+    mesh.saveCooked(cooked.string());
+    MeshAsset fromCooked;
+    t0 = Clock::now();
+    ok = fromCooked.loadCooked(cooked.string()) && ok;
+    double load = msSince(t0);
+
+    std::cout << "bench_mesh: " << mesh.triangleCount() << " triangles, " << mesh.nodes.size() << " BVH nodes" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  OBJ parse + build:  " << std::setw(7) << parse << " ms   (" << std::setprecision(2) << mb << " MB, "
+              << std::setprecision(1) << mb / (parse / 1000.0) << " MB/s)" << std::endl;
+    std::cout << "  cooked load:        " << std::setw(7) << std::setprecision(2) << load << " ms   (x"
+              << std::setprecision(0) << parse / load << ")" << std::endl;
+
+    // 箱の中（-1.5..1.5）から中心の近くを狙うレイ
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    const int rays = 20000, bruteRays = 200;
+    std::vector<Vector3> origins(rays), dirs(rays);
+    for (int i = 0; i < rays; ++i) {
+        origins[i] = Vector3(u(rng), u(rng), u(rng)) * 1.5f;
+        dirs[i] = Vector3(u(rng), u(rng), u(rng)) * 0.3f - origins[i];
+    }
+    std::vector<float> hits(rays, -1.0f);
+    t0 = Clock::now();
+    for (int i = 0; i < rays; ++i) {
+        float t;
+        Vector3 normal;
+        if (mesh.raycast(origins[i], dirs[i], 2.0f, t, normal)) hits[i] = t;
+    }
+    double bvh = rays / (msSince(t0) / 1000.0);
+    int differ = 0;
+    t0 = Clock::now();
+    for (int i = 0; i < bruteRays; ++i) {
+        float t = bruteRaycast(mesh, origins[i], dirs[i], 2.0f);
+        if ((t >= 0.0f) != (hits[i] >= 0.0f) || std::fabs(t - hits[i]) > 1e-4f) differ++;
+    }
+    double brute = bruteRays / (msSince(t0) / 1000.0);
+    std::cout << "  raycast, BVH:       " << std::setw(9) << std::setprecision(0) << bvh << " rays/s" << std::endl;
+    std::cout << "  raycast, brute:     " << std::setw(9) << brute << " rays/s   (x" << bvh / brute << "; "
+              << differ << " of " << bruteRays << " differ)" << std::endl;
+
+    fs::remove_all(dir);
+    return ok && differ == 0 ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// tools/bench_script_cache.cpp
+// 500 本のスクリプトを読み込む時間を、キャッシュなし・キャッシュが空（コンパイルして書く）・
+// キャッシュが温まった状態（バイトコードを読む）で比べる
+//   make bench        （または ./tools/bench_script_cache）
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/ScriptCache.hpp"
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const int kScripts = 500;
+    const int kFunctions = 150;   // 1 本あたり 25KB 程度
+
+    // 全部のスクリプトを新しい VM で読んで実行し、掛かった時間（ms）を返す
+    double loadAll(const std::vector<std::string>& paths) {
+        lua_State* L = luaL_newstate();
+        luaL_openlibs(L);
+        auto t0 = Clock::now();
+        for (const std::string& path : paths) {
+            if (ScriptCache::get().doFile(L, path) != LUA_OK) {
+                std::cerr << "bench_script_cache: " << lua_tostring(L, -1) << std::endl;
+                lua_close(L);
+                return -1.0;
+            }
+            lua_settop(L, 0);
+        }
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        lua_close(L);
+        return ms;
+    }
+}
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / "bench_script_cache";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "src");
+    std::vector<std::string> paths;
+    for (int i = 0; i < kScripts; ++i) {
+        fs::path p = dir / "src" / ("s" + std::to_string(i) + ".lua");
+        std::ofstream out(p);
+        for (int f = 0; f < kFunctions; ++f) {
+            out << "local function f" << f << "(a, b)\n"
+                << "  local t = {x = a, y = b, n = '" << f << "'}\n"
+                << "  for k = 1, 3 do t.x = t.x + k * b end\n"
+                << "  return t.x + t.y\n"
+                << "end\n";
+        }
+        out << "return f0(" << i << ", 1) + f" << kFunctions - 1 << "(1, 2)\n";
+        paths.push_back(p.string());
+    }
+
+    ScriptCache& cache = ScriptCache::get();
+    cache.setDirectory((dir / "luac").string());
+
+    cache.setEnabled(false);
+    double source = loadAll(paths);
+    cache.setEnabled(true);
+    ScriptCache::Stats before = cache.getStats();
+    double cold = loadAll(paths);
+    double warm = loadAll(paths);
+    int hits = cache.getStats().hits - before.hits;
+    int misses = cache.getStats().misses - before.misses;
+
+    std::cout << "bench_script_cache: " << kScripts << " scripts, " << kFunctions << " functions each" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  no cache:              " << std::setw(7) << source << " ms" << std::endl;
+    std::cout << "  cold (compile + store):" << std::setw(7) << cold << " ms" << std::endl;
+    std::cout << "  warm (bytecode):       " << std::setw(7) << warm << " ms   (x" << source / warm << " vs no cache)" << std::endl;
+    std::cout << "  cache hits " << hits << " / misses " << misses << std::endl;
+
+    fs::remove_all(dir);
+    return source < 0 || cold < 0 || warm < 0;
+}
@@ -0,0 +1,61 @@
+// tools/bench_shapes.cpp
+// 形の組ごとの狭域判定（collide）の速さを、重なりかけたランダムな組で測る。
+// 比べるために、同じ組を箱どうし（collideBoxes）として判定した速さも出す
+//   make bench        （または ./tools/bench_shapes [繰り返し回数]）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cstdlib>
+
+#include "src/Physics/Collision.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    const int kPairs = 4096;
+    const int reps = argc > 1 ? std::atoi(argv[1]) : 200;
+    // MeshPart は凸包の判定なので、ここでは基本の 4 つの形だけ
+    const int kShapes = 4;
+
+    std::cout << "bench_shapes: " << kPairs << " random pairs x " << reps << ", million tests per second" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    std::vector<Transform> shapes(kPairs * 2);
+    volatile int sink = 0;
+    for (int sa = 0; sa < kShapes; ++sa) {
+        for (int sb = sa; sb < kShapes; ++sb) {
+            for (int i = 0; i < kPairs * 2; ++i) {
+                Transform& t = shapes[i];
+                t.pos = Vector3(u(rng) * 2.5f, u(rng) * 2.5f, u(rng) * 2.5f);
+                t.rotation = Vector3(u(rng) * 180, u(rng) * 180, u(rng) * 180);
+                t.size = Vector3(2 + u(rng), 2 + u(rng), 2 + u(rng));
+                t.shape = (PartShape)(i < kPairs ? sa : sb);
+            }
+
+            Contact contact;
+            int hits = 0;
+            auto t0 = Clock::now();
+            for (int r = 0; r < reps; ++r) {
+                for (int i = 0; i < kPairs; ++i) hits += collide(shapes[i], shapes[kPairs + i], contact);
+            }
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+            int boxHits = 0;
+            t0 = Clock::now();
+            for (int r = 0; r < reps; ++r) {
+                for (int i = 0; i < kPairs; ++i) boxHits += collideBoxes(shapes[i], shapes[kPairs + i], contact);
+            }
+            double boxMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            sink = sink + boxHits;
+
+            double tests = (double)kPairs * reps;
+            std::cout << "  " << std::left << std::setw(9) << partShapeName((PartShape)sa) << std::setw(9) << partShapeName((PartShape)sb)
+                      << std::right << std::setw(8) << tests / ms / 1000.0 << "   (hit " << std::setw(5) << std::setprecision(1)
+                      << 100.0 * hits / tests << "%)   as boxes " << std::setprecision(2) << std::setw(6) << tests / boxMs / 1000.0 << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+// tools/bench_signals.cpp
+// Signal / ConcurrentSignal の fire 1 回の時間を、接続の数（1・100・1万）ごとに測る
+//   make bench        （または ./tools/bench_signals）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include "src/Game/Signal.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    // 接続 1 つあたりの仕事は加算 1 回（呼び出しの費用だけを見る）
+    template <typename SignalT>
+    double nsPerFire(int listeners) {
+        SignalT signal;
+        volatile float sink = 0.0f;
+        std::vector<Connection> connections;
+        for (int i = 0; i < listeners; ++i) connections.push_back(signal.connect([&sink](float v) { sink = sink + v; }));
+
+        // 呼び出しの総数をそろえる（接続が少ないほど fire を多く回す）
+        const int reps = std::max(20000000 / listeners, 100);
+        for (int r = 0; r < reps / 10; ++r) signal.fire(1.0f);   // 慣らし
+        auto t0 = Clock::now();
+        for (int r = 0; r < reps; ++r) signal.fire(1.0f);
+        return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / reps;
+    }
+}
+
+int main() {
+    std::cout << "bench_signals: ns per fire (ns per listener)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (int listeners : { 1, 100, 10000 }) {
+        double plain = nsPerFire<Signal<float>>(listeners);
+        double concurrent = nsPerFire<ConcurrentSignal<float>>(listeners);
+        std::cout << "  " << std::setw(5) << listeners << " listeners:  Signal " << plain << " (" << plain / listeners
+                  << ")   ConcurrentSignal " << concurrent << " (" << concurrent / listeners << ")" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+// tools/bench_spatial.cpp
+// 5 万個の回転したパーツに対するレイ・形状の投射の速さと、木の付け直し・作り直しの時間を測る
+//   make bench        （または ./tools/bench_spatial）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cmath>
+
+#include "src/Game/Workspace.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // 比較用: 全パーツとのスラブ判定（tools/check_spatial.cpp と同じ）
+    bool plainRaycast(Workspace& ws, const Vector3& origin, const Vector3& direction) {
+        float length = direction.length();
+        Vector3 dir = direction / length;
+        float best = length;
+        bool found = false;
+        for (Cube& c : ws.cubes) {
+            Matrix3 r = Matrix3::rotate(c.rotation());
+            Vector3 h = c.size() * 0.5f;
+            float half[3] = { h.x, h.y, h.z };
+            Vector3 rel = origin - c.pos();
+            float t0 = -1e30f, t1 = 1e30f;
+            bool miss = false;
+            for (int i = 0; i < 3 && !miss; ++i) {
+                Vector3 axis(r.m[0][i], r.m[1][i], r.m[2][i]);
+                float o = rel.dot(axis), d = dir.dot(axis);
+                if (std::fabs(d) < 1e-9f) {
+                    miss = std::fabs(o) > half[i];
+                    continue;
+                }
+                float a = (-half[i] - o) / d, b = (half[i] - o) / d;
+                if (a > b) std::swap(a, b);
+                t0 = std::max(t0, a);
+                t1 = std::min(t1, b);
+            }
+            if (miss || t0 > t1 || t0 < 0.0f || t0 > best) continue;
+            best = t0;
+            found = true;
+        }
+        return found;
+    }
+}
+
+int main() {
+    const int kParts = 50000;
+    const int kRays = 200000;
+
+    Workspace ws;   // 地形・Ground なしでパーツだけ
+    global_workspace = &ws;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    for (int i = 0; i < kParts; ++i) {
+        ws.addPart(CubeBuilder()
+                       .size(1 + 3 * std::fabs(u(rng)), 1 + 3 * std::fabs(u(rng)), 1 + 3 * std::fabs(u(rng)))
+                       .pos(u(rng) * 250, 5 + std::fabs(u(rng)) * 60, u(rng) * 250)
+                       .rotation(u(rng) * 180, u(rng) * 180, u(rng) * 180)
+                       .setName("P").setStatic().setSimulated(false).build());
+    }
+
+    // 上から斜め下へのレイ（長さ 100 程度）
+    std::vector<QueryRay> rays(kRays);
+    std::vector<QueryHit> hits(kRays);
+    for (QueryRay& r : rays) {
+        r.origin = Vector3(u(rng) * 250, 70, u(rng) * 250);
+        r.direction = Vector3(u(rng) * 30, -100, u(rng) * 30);
+    }
+    QueryParams params;
+    QueryHit hit;
+
+    auto t0 = Clock::now();
+    ws.spatial.refresh();
+    double build = msSince(t0);
+
+    std::cout << "bench_spatial: " << kParts << " rotated parts, " << ws.spatial.nodeCount() << " nodes" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  build            " << std::setw(8) << build << " ms" << std::endl;
+
+    t0 = Clock::now();
+    size_t found = 0;
+    for (const QueryRay& r : rays) found += ws.spatial.raycast(r.origin, r.direction, params, hit);
+    std::cout << "  raycast          " << std::setw(8) << kRays / msSince(t0) / 1000.0 << " M rays/s (" << found << " hits)" << std::endl;
+
+    t0 = Clock::now();
+    ws.spatial.raycastBatch(rays.data(), rays.size(), hits.data(), params);
+    std::cout << "  raycastBatch     " << std::setw(8) << kRays / msSince(t0) / 1000.0 << " M rays/s" << std::endl;
+
+    const int kPlain = 200;
+    t0 = Clock::now();
+    for (int i = 0; i < kPlain; ++i) found += plainRaycast(ws, rays[i].origin, rays[i].direction);
+    std::cout << "  brute force      " << std::setw(8) << kPlain / msSince(t0) * 1000.0 << " rays/s" << std::endl;
+
+    const int kShapes = 20000;
+    t0 = Clock::now();
+    for (int i = 0; i < kShapes; ++i) found += ws.spatial.spherecast(rays[i].origin, 1.0f, rays[i].direction, params, hit);
+    std::cout << "  spherecast       " << std::setw(8) << kShapes / msSince(t0) / 1000.0 << " M/s" << std::endl;
+    t0 = Clock::now();
+    for (int i = 0; i < kShapes; ++i) {
+        found += ws.spatial.blockcast(rays[i].origin, Vector3(0, 30, 0), Vector3(2, 2, 2), rays[i].direction, params, hit);
+    }
+    std::cout << "  blockcast        " << std::setw(8) << kShapes / msSince(t0) / 1000.0 << " M/s" << std::endl;
+
+    // 1割を動かしてから付け直す
+    int k = 0;
+    for (Cube& c : ws.cubes) {
+        if (++k % 10 != 0) continue;
+        c.pos().y += 0.01f;
+        c.markChanged(Prop_Position);
+    }
+    t0 = Clock::now();
+    ws.spatial.refresh();
+    std::cout << "  refit, 10% moved " << std::setw(8) << msSince(t0) << " ms" << std::endl;
+
+    uint64_t rebuilds = ws.spatial.rebuildCount();
+    ws.addPart(CubeBuilder().size(1, 1, 1).pos(0, 0, 0).setName("X").build());
+    t0 = Clock::now();
+    ws.spatial.refresh();
+    std::cout << "  relink, 1 added  " << std::setw(8) << msSince(t0) << " ms" << (ws.spatial.rebuildCount() > rebuilds ? " (rebuilt)" : "") << std::endl;
+
+    for (int i = 0; i < 1000; ++i) ws.addPart(CubeBuilder().size(1, 1, 1).pos(0, -50, 0).setName("Y").build());
+    t0 = Clock::now();
+    ws.spatial.refresh();
+    std::cout << "  1000 added       " << std::setw(8) << msSince(t0) << " ms" << (ws.spatial.rebuildCount() > rebuilds ? " (rebuilt)" : "") << std::endl;
+
+    global_workspace = nullptr;
+    return 0;
+}
@@ -0,0 +1,93 @@
+// tools/bench_terrain.cpp
+// 512x512 列・高さ 96 ボクセルの起伏（2520 万ボクセル）で、地形の保持の大きさ・メッシュの大きさ・
+// 当たり判定の箱の数・最初のメッシュ作成の時間と、編集してから見えるまで（編集 + update）の時間を測る
+//   make bench        （または ./tools/bench_terrain [列の数]）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "src/Game/Terrain.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // 正弦波の起伏。表面は高さで砂・草・雪、その下 4 つは土、さらに下は岩
+    void fillHeightmap(Terrain& terrain, int n) {
+        terrain.edit(0, -32, 0, n - 1, 63, n - 1, [](int x, int y, int z, TerrainMaterial) {
+            float h = 16.0f + 14.0f * std::sin(x * 0.031f) * std::cos(z * 0.027f) + 6.0f * std::sin(x * 0.11f + z * 0.07f);
+            int top = (int)h;
+            if (y >= top) return TerrainMaterial::Air;
+            if (y == top - 1) return top < 8 ? TerrainMaterial::Sand : (top > 30 ? TerrainMaterial::Snow : TerrainMaterial::Grass);
+            if (y >= top - 4) return TerrainMaterial::Ground;
+            return TerrainMaterial::Rock;
+        });
+    }
+
+    void reportLatency(const char* label, std::vector<double>& ms) {
+        std::sort(ms.begin(), ms.end());
+        std::cout << "  edit-to-visible, " << std::left << std::setw(24) << label << std::right
+                  << "p50 " << std::setw(6) << ms[ms.size() / 2] << " ms   p95 " << std::setw(6) << ms[ms.size() * 95 / 100]
+                  << " ms   max " << std::setw(6) << ms.back() << " ms" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? std::atoi(argv[1]) : 512;
+    Terrain terrain;
+    auto t0 = Clock::now();
+    fillHeightmap(terrain, n);
+    double fillMs = msSince(t0);
+    t0 = Clock::now();
+    terrain.update();
+    double meshMs = msSince(t0);
+
+    const double volume = (double)n * n * 96;
+    size_t triangles = 0;
+    terrain.forEachChunk([&](const TerrainChunk& chunk) { triangles += chunk.indices.size() / 3; });
+
+    std::cout << "bench_terrain: " << n << "x" << n << " columns, 96 voxels tall (" << std::setprecision(1) << std::fixed
+              << volume / 1e6 << "M voxels), " << terrain.chunkCount() << " chunks" << std::endl;
+    std::cout << "  voxel storage   " << std::setw(7) << std::setprecision(2) << terrain.voxelBytes() / 1048576.0 << " MB   "
+              << std::setprecision(1) << terrain.voxelBytes() / volume * 1e6 / 1024.0 << " KB per million voxels (raw u8: 1024)" << std::endl;
+    std::cout << "  mesh            " << std::setw(7) << std::setprecision(2) << terrain.meshBytes() / 1048576.0 << " MB   "
+              << std::setprecision(1) << terrain.meshBytes() / volume * 1e6 / 1024.0 << " KB per million voxels, " << triangles
+              << " triangles" << std::endl;
+    std::cout << "  collision boxes " << std::setw(7) << terrain.boxCount() << "      " << std::setprecision(0)
+              << terrain.boxCount() / volume * 1e6 << " per million voxels" << std::endl;
+    std::cout << std::setprecision(1) << "  fill " << fillMs << " ms, initial mesh build " << meshMs << " ms" << std::endl;
+
+    // 表面付近を半径 12 の球で掘る・埋めるのを交互に
+    std::cout << std::setprecision(3);
+    for (bool parallel : { false, true }) {
+        terrain.setParallel(parallel);
+        std::mt19937 rng(parallel ? 8 : 7);   // 同じ場所を同じ素材で埋め直すと変化がなく速く見える
+        std::vector<double> ms;
+        for (int i = 0; i < 200; ++i) {
+            float x = (float)(rng() % (n - 40) + 20) * Terrain::kVoxelSize;
+            float z = (float)(rng() % (n - 40) + 20) * Terrain::kVoxelSize;
+            t0 = Clock::now();
+            terrain.fillBall(Vector3(x, 64.0f, z), 12.0f, (i & 1) ? TerrainMaterial::Air : TerrainMaterial::Rock);
+            terrain.update();
+            ms.push_back(msSince(t0));
+        }
+        reportLatency(parallel ? "fillBall r=12, parallel" : "fillBall r=12, serial", ms);
+    }
+    std::vector<double> ms;
+    for (int i = 0; i < 200; ++i) {
+        t0 = Clock::now();
+        terrain.setVoxel(100 + i, 20, 100, TerrainMaterial::Rock);
+        terrain.update();
+        ms.push_back(msSince(t0));
+    }
+    reportLatency("setVoxel", ms);
+    return 0;
+}
@@ -0,0 +1,142 @@
+// tools/bench_texture_binds.cpp
+// 200 種類のテクスチャ（64〜256px）を貼った 10000 個の固定パーツの街と 500 個の球を隠しウィンドウに描き、
+// 小さいテクスチャをアトラスに詰めたときと全て単独のテクスチャで貼ったときの、
+// 1 フレームのテクスチャの貼り替え・描画呼び出しの数とフレームの時間を比べる
+//   make bench        （または ./tools/bench_texture_binds [測るフレーム数]）
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Render/Renderer.hpp"
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const int kTextures = 200;
+    const int kWarmFrames = 60;   // インポスターが焼き終わるまで
+    int measuredFrames = 10;
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // 64 / 128 / 256px の市松模様（テクスチャごとに色が違う）
+    std::vector<std::string> writeTextures(const fs::path& dir) {
+        std::vector<std::string> paths;
+        std::mt19937 rng(2);
+        for (int i = 0; i < kTextures; ++i) {
+            int size = 64 << (i % 3);
+            unsigned char a[3] = { (unsigned char)rng(), (unsigned char)rng(), (unsigned char)rng() };
+            fs::path path = dir / ("t" + std::to_string(i) + ".ppm");
+            std::ofstream out(path, std::ios::binary);
+            out << "P6 " << size << " " << size << " 255\n";
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    bool dark = ((x / 8) + (y / 8)) % 2;
+                    for (unsigned char c : a) out.put((char)(dark ? c / 2 : c));
+                }
+            }
+            paths.push_back(path.string());
+        }
+        return paths;
+    }
+
+    void buildCity(Workspace& ws, const std::vector<std::string>& textures) {
+        std::mt19937 rng(1);
+        size_t next = 0;
+        for (int bx = 0; bx < 50; ++bx) {
+            for (int bz = 0; bz < 50; ++bz) {
+                float x = -1500 + bx * 60.0f, z = -1500 + bz * 60.0f;
+                for (int k = 0; k < 4; ++k) {
+                    PartShape shape = (PartShape)(rng() % 4);
+                    float height = 6 + rng() % 30;
+                    Vector3 color(rng() % 256, rng() % 256, rng() % 256);
+                    ws.addPart(CubeBuilder().size(8, height, 8).pos(x + (k & 1) * 20, height * 0.5f, z + (k >> 1) * 20)
+                                   .shape(shape).color(color).texture(textures[next++ % textures.size()]).setStatic().build());
+                }
+            }
+        }
+        for (int i = 0; i < 500; ++i) {
+            ws.addPart(CubeBuilder().size(3, 3, 3).pos(-1500 + (rng() % 3000), 50, -1500 + (rng() % 3000))
+                           .shape(PartShape::Ball).texture(textures[next++ % textures.size()]).build());
+        }
+    }
+
+    void measure(Renderer& renderer, const Workspace& ws, const Camera& cam, const std::string& label) {
+        for (int f = 0; f < kWarmFrames; ++f) renderer.render(ws, cam, Vector3());
+        glFinish();
+        auto t0 = Clock::now();
+        for (int f = 0; f < measuredFrames; ++f) {
+            renderer.render(ws, cam, Vector3());
+            glFinish();
+        }
+        const RenderStats& s = renderer.getStats();
+        std::cout << "  " << std::left << std::setw(28) << label << std::right << std::setw(6) << s.textureBinds << " binds  "
+                  << std::setw(6) << s.drawCalls << " draw calls  " << std::setw(6) << std::setprecision(1)
+                  << msSince(t0) / measuredFrames << " ms/frame" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) measuredFrames = std::max(1, std::atoi(argv[1]));
+    if (!glfwInit()) return 1;
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow((int)SCREEN_W, (int)SCREEN_H, "bench_texture_binds", NULL, NULL);
+    if (!window) {
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    if (glewInit() != GLEW_OK) return 1;
+
+    fs::path dir = fs::temp_directory_path() / "bench_texture_binds";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::vector<std::string> textures = writeTextures(dir);
+
+    std::cout << "bench_texture_binds: " << kTextures << " textures on 10000 anchored parts + 500 balls, "
+              << (int)SCREEN_W << "x" << (int)SCREEN_H << ", " << glGetString(GL_RENDERER) << std::endl;
+    std::cout << std::fixed;
+    {
+        Renderer renderer;
+        renderer.init();
+        Workspace ws;
+        ws.initScene(0);
+        buildCity(ws, textures);
+        Camera center, corner;
+        center.pos = Vector3(0, 60, 0);
+        center.rotation = Vector3(10, -135, 0);
+        corner.pos = Vector3(-1500, 80, -1500);
+        corner.rotation = Vector3(8, -135, 0);
+
+        for (bool atlas : { true, false }) {
+            renderer.setTextureAtlas(atlas);
+            const char* mode = atlas ? "atlas" : "standalone";
+            measure(renderer, ws, center, std::string("centre, ") + mode);
+            measure(renderer, ws, corner, std::string("corner, ") + mode);
+        }
+        renderer.setStaticBatching(false);
+        for (bool atlas : { true, false }) {
+            renderer.setTextureAtlas(atlas);
+            measure(renderer, ws, center, std::string("centre, per part, ") + (atlas ? "atlas" : "standalone"));
+        }
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    fs::remove_all(dir);
+    return 0;
+}
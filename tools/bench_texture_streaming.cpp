@@ -0,0 +1,146 @@
+// tools/bench_texture_streaming.cpp
+// 49 枚の 1024x1024 のテクスチャを地区ごとに貼った 10000 個の固定パーツの街を隠しウィンドウに描き、
+// 最初のフレームの時間、細かい段が上がりきるまでのフレーム数、単独のテクスチャとして載せている量と落とした数を測る
+// （中心 → 隅 → 中心。予算を絞ると隅へ移ったときに遠いテクスチャを mip tail に落とす）
+//   make bench        （または ./tools/bench_texture_streaming [予算 MB]）
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Render/Renderer.hpp"
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    const int kRegions = 7;       // 7 x 7 地区、1 地区 8 x 8 区画
+    const int kTextureSize = 1024;
+    const int kFrames = 60;
+
+    double msSince(Clock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    std::vector<std::string> writeTextures(const fs::path& dir) {
+        std::vector<std::string> paths;
+        std::mt19937 rng(4);
+        std::vector<char> row(kTextureSize * 3);
+        for (int i = 0; i < kRegions * kRegions; ++i) {
+            unsigned char color[3] = { (unsigned char)rng(), (unsigned char)rng(), (unsigned char)rng() };
+            fs::path path = dir / ("region" + std::to_string(i) + ".ppm");
+            std::ofstream out(path, std::ios::binary);
+            out << "P6 " << kTextureSize << " " << kTextureSize << " 255\n";
+            for (int y = 0; y < kTextureSize; ++y) {
+                for (int x = 0; x < kTextureSize; ++x) {
+                    bool dark = ((x / 32) + (y / 32)) % 2;
+                    for (int c = 0; c < 3; ++c) row[x * 3 + c] = (char)(dark ? color[c] / 2 : color[c]);
+                }
+                out.write(row.data(), (std::streamsize)row.size());
+            }
+            paths.push_back(path.string());
+        }
+        return paths;
+    }
+
+    void buildCity(Workspace& ws, const std::vector<std::string>& textures) {
+        std::mt19937 rng(1);
+        for (int bx = 0; bx < 50; ++bx) {
+            for (int bz = 0; bz < 50; ++bz) {
+                float x = -1500 + bx * 60.0f, z = -1500 + bz * 60.0f;
+                const std::string& texture = textures[(bx / 8) * kRegions + bz / 8];
+                for (int k = 0; k < 4; ++k) {
+                    PartShape shape = (PartShape)(rng() % 4);
+                    float height = 6 + rng() % 30;
+                    ws.addPart(CubeBuilder().size(8, height, 8).pos(x + (k & 1) * 20, height * 0.5f, z + (k >> 1) * 20)
+                                   .shape(shape).color(Vector3(255, 255, 255)).texture(texture).setStatic().build());
+                }
+            }
+        }
+    }
+
+    // kFrames フレーム描く（フレームの間に 20ms 空けて、読み込みのスレッドに時間を渡す）
+    void run(Renderer& renderer, const Workspace& ws, const Camera& cam, const std::string& label) {
+        double first = 0.0, worst = 0.0, tail = 0.0, peakMb = 0.0;
+        size_t evictions = 0;
+        int settled = -1;
+        for (int f = 0; f < kFrames; ++f) {
+            auto t0 = Clock::now();
+            renderer.render(ws, cam, Vector3());
+            glFinish();
+            double ms = msSince(t0);
+            const TextureStreamer::Stats& s = renderer.textureStreamingStats();
+            if (f == 0) first = ms;
+            worst = std::max(worst, ms);
+            if (f >= kFrames - 40) tail += ms;
+            peakMb = std::max(peakMb, s.residentBytes / 1048576.0);
+            evictions += s.evictions;
+            if (s.queueDepth == 0 && settled < 0) settled = f;
+            if (s.queueDepth != 0) settled = -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        const TextureStreamer::Stats& s = renderer.textureStreamingStats();
+        std::cout << "  " << std::left << std::setw(8) << label << std::right << std::setprecision(0)
+                  << " first frame " << std::setw(5) << first << " ms   worst " << std::setw(5) << worst
+                  << " ms   last 40 " << std::setw(4) << tail / 40 << " ms/frame   queue empty from frame "
+                  << (settled < 0 ? std::string("-") : std::to_string(settled)) << std::setprecision(1)
+                  << "   streamed " << s.residentBytes / 1048576.0 << " MB (peak " << peakMb << ")   evictions " << evictions << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (!glfwInit()) return 1;
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow((int)SCREEN_W, (int)SCREEN_H, "bench_texture_streaming", NULL, NULL);
+    if (!window) {
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    if (glewInit() != GLEW_OK) return 1;
+
+    fs::path dir = fs::temp_directory_path() / "bench_texture_streaming";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::vector<std::string> textures = writeTextures(dir);
+
+    std::cout << std::fixed;
+    {
+        Renderer renderer;
+        renderer.init();
+        if (argc > 1) renderer.textureStreaming().budgetBytes = (size_t)std::atoi(argv[1]) << 20;
+        std::cout << "bench_texture_streaming: " << textures.size() << " textures of " << kTextureSize << "x" << kTextureSize
+                  << " on 10000 anchored parts, budget " << (renderer.textureStreaming().budgetBytes >> 20) << " MB, "
+                  << glGetString(GL_RENDERER) << std::endl;
+        Workspace ws;
+        ws.initScene(0);
+        buildCity(ws, textures);
+        Camera center, corner;
+        center.pos = Vector3(0, 60, 0);
+        center.rotation = Vector3(10, -135, 0);
+        corner.pos = Vector3(-1500, 20, -1500);
+        corner.rotation = Vector3(8, -135, 0);
+
+        run(renderer, ws, center, "centre");
+        run(renderer, ws, corner, "corner");
+        run(renderer, ws, center, "centre");
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    fs::remove_all(dir);
+    return 0;
+}
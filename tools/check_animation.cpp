@@ -0,0 +1,96 @@
+// tools/check_animation.cpp
+// R6 のアニメーションを確かめる（Quaternion の変換が Matrix3::rotate と一致するか、待機中の腕の位置、
+// 歩きのフェードで姿勢が変わるか、全て止めると元の姿勢と単位の Transform に戻るか、関節を壊すと結び直すか）
+//   make check        （または ./tools/check_animation）
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    void step(Workspace& ws, Physics& physics, Player* player) {
+        ws.animation.step(1.0f / 60.0f);
+        physics.simulate(ws, 1.0f / 60.0f);
+        player->updateBodyParts();
+        PropertyChangeQueue::dispatch();
+        DestroyQueue::flush();
+    }
+
+    std::string text(const Vector3& v) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(3) << "(" << v.x << ", " << v.y << ", " << v.z << ")";
+        return s.str();
+    }
+
+    bool near(const Vector3& a, const Vector3& b, float eps) {
+        return std::fabs(a.x - b.x) < eps && std::fabs(a.y - b.y) < eps && std::fabs(a.z - b.z) < eps;
+    }
+}
+
+int main() {
+    std::cout << "check_animation" << std::endl;
+
+    float worst = 0.0f;
+    for (const Vector3& e : { Vector3(30, -50, 70), Vector3(0, 90, 0), Vector3(-120, 10, 45), Vector3(179, -179, 1) }) {
+        Matrix3 a = Matrix3::rotate(e), b = Quaternion::fromEuler(e).toMatrix();
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) worst = std::max(worst, std::fabs(a.m[i][j] - b.m[i][j]));
+        }
+    }
+    std::ostringstream diff;
+    diff << worst;
+    expect(worst < 1e-5f, "Quaternion::fromEuler matches Matrix3::rotate (max diff " + diff.str() + ")");
+
+    Workspace ws;
+    ws.initScene(0);
+    Physics physics;
+    Player* player = ws.getPlayerObject();
+    expect(player->animator && player->animator->boundJointCount() == 6, "player animator binds the 6 R6 joints");
+
+    for (int f = 0; f < 60; ++f) step(ws, physics, player);
+    Vector3 idle = player->RightArm->pos() - player->Torso->pos();
+    expect(near(idle, Vector3(3, 0, 0), 0.1f), "idle right arm offset " + text(idle));
+
+    // 歩きを 0.2 秒でフェードイン: 腕と脚が振れる
+    player->walkTrack->play(0.2f);
+    float swing = 0.0f;
+    for (int f = 0; f < 30; ++f) {
+        step(ws, physics, player);
+        swing = std::max(swing, std::fabs(player->RightArm->rotation().x));
+    }
+    expect(player->walkTrack->getWeight() > 0.99f, "walk track fades in to weight 1");
+    expect(swing > 20.0f, "walk swings the right arm (max " + std::to_string((int)swing) + " degrees)");
+
+    // 全て止めると、腕は元の位置に戻り Transform は単位回転
+    player->walkTrack->stop(0.2f);
+    player->idleTrack->stop(0.1f);
+    for (int f = 0; f < 30; ++f) step(ws, physics, player);
+    Vector3 rest = player->RightArm->pos() - player->Torso->pos();
+    expect(near(rest, Vector3(3, 0, 0), 1e-3f) && ws.animation.activeCount() == 0 && player->RightShoulder->getTransform().isIdentity(),
+           "stopping every track restores the rest pose " + text(rest));
+
+    // 関節を壊すと次の評価で結び直す
+    player->Neck->Destroy();
+    DestroyQueue::flush();
+    player->idleTrack->play(0.0f);
+    ws.animation.step(1.0f / 60.0f);
+    expect(player->animator->boundJointCount() == 5, "destroying the Neck rebinds to 5 joints");
+
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
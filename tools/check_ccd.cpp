@@ -0,0 +1,84 @@
+// tools/check_ccd.cpp
+// 連続衝突判定（CCD）が、既定の分割数（2）で速い物体のすり抜けを止めるかを確かめる
+//   - 0.4 スタッドの弾を薄い壁・厚い壁に撃つ（CCD なしの結果も参考に出す）
+//   - 厚さ 0.2 の板を y=300 から落とし、Ground の上で止まる
+//   make check        （または ./tools/check_ccd）
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <algorithm>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    void step(Workspace& ws, Physics& physics) {
+        physics.simulate(ws, 1.0f / 60.0f);
+        PropertyChangeQueue::dispatch();
+        DestroyQueue::flush();
+    }
+
+    // x=30 に立てた壁へ弾を撃ち、1 秒の間に弾が届いた一番先の x を返す
+    float shoot(bool continuous, float speed, float thickness) {
+        Workspace ws;
+        ws.initScene(0);
+        Physics physics;
+        physics.setContinuous(continuous);
+        ws.addPart(CubeBuilder().size(thickness, 20, 20).pos(30, 10, 60).setName("Wall").setStatic().build());
+        Cube* bullet = ws.addPart(CubeBuilder().size(0.4f, 0.4f, 0.4f).pos(0, 10, 60).setName("Bullet").build());
+        bullet->setVelocity(Vector3(speed, 0, 0));
+
+        float farthest = bullet->pos().x;
+        for (int f = 0; f < 60; ++f) {
+            step(ws, physics);
+            farthest = std::max(farthest, bullet->pos().x);
+        }
+        return farthest;
+    }
+}
+
+int main() {
+    std::cout << "check_ccd" << std::endl;
+
+    {
+        Physics physics;
+        expect(physics.getSubSteps() == 2 && physics.isContinuous(), "defaults: 2 substeps, CCD on");
+    }
+
+    // 壁の中心は x=30。弾の中心が 30 を越えたらすり抜け
+    struct Shot { float speed, thickness; };
+    for (const Shot& s : { Shot{ 100, 0.2f }, Shot{ 600, 0.2f }, Shot{ 3000, 1.0f } }) {
+        float withCcd = shoot(true, s.speed, s.thickness);
+        float without = shoot(false, s.speed, s.thickness);
+        std::ostringstream what;
+        what << std::fixed << std::setprecision(0) << "bullet " << s.speed << " studs/s, wall "
+             << std::setprecision(1) << s.thickness << ": stops at x " << std::setprecision(2) << withCcd << " (without CCD: " << (without > 30.0f ? "tunnels" : "stops") << ")";
+        expect(withCcd < 30.0f - s.thickness * 0.5f, what.str());
+    }
+
+    // 薄い板は Ground（上面 y=0）の上に厚さの半分だけ浮いて止まる
+    {
+        Workspace ws;
+        ws.initScene(0);
+        Physics physics;
+        Cube* plate = ws.addPart(CubeBuilder().size(4, 0.2f, 4).pos(40, 300, 0).setName("Plate").build());
+        for (int f = 0; f < 600; ++f) step(ws, physics);
+        std::ostringstream what;
+        what << std::fixed << std::setprecision(3) << "0.2 plate dropped from y=300 rests at y " << plate->pos().y;
+        expect(plate->pos().y > 0.05f && plate->pos().y < 0.15f, what.str());
+    }
+
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// tools/check_controller.cpp
+// プレイヤーの CharacterController を、段差・斜面・階段・押せる箱・壁・ジャンプのレーンで歩かせて確かめる
+//   - 2 スタッドの段は登り、3 スタッドの段と 60 度の斜面では止まる（stepHeight 2.1、maxSlopeAngle 50）
+//   - 25 度の斜面は登り、0.8 スタッドずつの下り階段は一度も宙に浮かずに降りる
+//   - 箱を 20 スタッド押し、壁には沿って滑り、跳んだら解析解に近い高さまで上がって着地する
+//   make check        （または ./tools/check_controller）
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <cmath>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    std::string fixed(float v, int digits = 2) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(digits) << v;
+        return s.str();
+    }
+
+    Cube* addStatic(Workspace& ws, const char* name, const Vector3& size, const Vector3& pos, float rollDegrees = 0.0f) {
+        return ws.addPart(CubeBuilder().size(size.x, size.y, size.z).pos(pos.x, pos.y, pos.z).rotation(0, 0, rollDegrees)
+                              .setName(name).setStatic().build());
+    }
+
+    void step(Workspace& ws, Physics& physics) {
+        const float dt = 1.0f / 60.0f;
+        physics.simulate(ws, dt);
+        ws.characters.step(dt, ws.gravity);
+        ws.hierarchy.update();
+        PropertyChangeQueue::dispatch();
+        DestroyQueue::flush();
+    }
+
+    struct Walk {
+        Vector3 end;
+        float minY = 1e9f, maxY = -1e9f;
+        int airborneFrames = 0;
+        bool grounded = false;
+        std::string ground;
+    };
+
+    // 根を start に置き、direction へ frames フレーム歩かせる
+    Walk walk(Workspace& ws, Physics& physics, const Vector3& start, const Vector3& direction, int frames) {
+        Player* player = ws.getPlayerObject();
+        Cube* root = player->HumanoidRootPart;
+        root->pos() = start;
+        root->setVelocity(Vector3(0, 0, 0));
+        root->markChanged(Prop_Position | Prop_Velocity);
+        player->controller->setMoveDirection(direction);
+
+        Walk w;
+        for (int f = 0; f < frames; ++f) {
+            step(ws, physics);
+            w.minY = std::min(w.minY, root->pos().y);
+            w.maxY = std::max(w.maxY, root->pos().y);
+            if (!player->controller->isOnGround()) w.airborneFrames++;
+        }
+        w.end = root->pos();
+        w.grounded = player->controller->isOnGround();
+        Cube* ground = player->controller->getGround();
+        w.ground = ground ? ground->Name.str() : "-";
+        player->controller->setMoveDirection(Vector3(0, 0, 0));
+        return w;
+    }
+}
+
+int main() {
+    std::cout << "check_controller" << std::endl;
+    Workspace ws;
+    ws.initScene(0);
+    Physics physics;
+
+    // レーン（Ground の上面は y=0。x=0 から +x へ歩く）
+    addStatic(ws, "Step2", Vector3(10, 2, 10), Vector3(20, 1, -40));
+    addStatic(ws, "Step3", Vector3(10, 3, 10), Vector3(20, 1.5f, -60));
+    addStatic(ws, "Slope60", Vector3(40, 1, 10), Vector3(25, 0, -80), 60);
+    addStatic(ws, "Slope25", Vector3(40, 1, 10), Vector3(25, 0, -100), 25);
+    for (int k = 0; k < 5; ++k) {
+        float h = 4.0f - 0.8f * k;
+        addStatic(ws, "Stair", Vector3(6, h, 10), Vector3(6.0f * k, h * 0.5f, -120));
+    }
+    Cube* crate = ws.addPart(CubeBuilder().size(4, 4, 4).pos(15, 2, -140).setName("Crate").build());
+    addStatic(ws, "Wall", Vector3(2, 20, 30), Vector3(20, 10, -160));
+    for (int f = 0; f < 30; ++f) step(ws, physics);
+
+    Player* player = ws.getPlayerObject();
+    CharacterController* controller = player->controller;
+    const float standY = controller->height * 0.5f;   // Ground に立ったときの根の高さ
+
+    Walk fall = walk(ws, physics, Vector3(0, 30, -20), Vector3(0, 0, 0), 90);
+    expect(fall.grounded && fall.ground == "Ground" && std::fabs(fall.end.y - standY) < 0.1f,
+           "falls from y=30 and stands on Ground at y " + fixed(fall.end.y, 3));
+
+    Walk step2 = walk(ws, physics, Vector3(0, standY + 0.05f, -40), Vector3(1, 0, 0), 60);
+    expect(step2.end.x > 25.0f && std::fabs(step2.maxY - (standY + 2.0f)) < 0.1f,
+           "climbs the 2-stud step (top y " + fixed(step2.maxY) + ", ends at x " + fixed(step2.end.x) + ")");
+
+    Walk step3 = walk(ws, physics, Vector3(0, standY + 0.05f, -60), Vector3(1, 0, 0), 60);
+    expect(step3.end.x < 15.0f && step3.maxY < standY + 0.1f,
+           "blocked by the 3-stud step at x " + fixed(step3.end.x));
+
+    Walk slope60 = walk(ws, physics, Vector3(-5, standY + 0.05f, -80), Vector3(1, 0, 0), 90);
+    expect(slope60.maxY < standY + 0.5f && slope60.ground == "Ground",
+           "blocked by the 60 degree slope (max y " + fixed(slope60.maxY) + ")");
+
+    Walk slope25 = walk(ws, physics, Vector3(-5, standY + 0.05f, -100), Vector3(1, 0, 0), 60);
+    expect(slope25.grounded && slope25.ground == "Slope25" && slope25.end.y > standY + 5.0f,
+           "walks up the 25 degree slope to y " + fixed(slope25.end.y));
+
+    Walk stairs = walk(ws, physics, Vector3(0, standY + 4.05f, -120), Vector3(1, 0, 0), 40);
+    expect(stairs.airborneFrames == 0 && stairs.end.y < standY + 1.0f,
+           "walks down 0.8-stud stairs without leaving the ground (" + std::to_string(stairs.airborneFrames) +
+           " airborne frames, ends at y " + fixed(stairs.end.y) + ")");
+
+    float crateStart = crate->pos().x;
+    walk(ws, physics, Vector3(0, standY + 0.05f, -140), Vector3(1, 0, 0), 90);
+    expect(crate->pos().x - crateStart >= 20.0f && std::fabs(crate->pos().y - 2.0f) < 0.1f,
+           "pushes the crate " + fixed(crate->pos().x - crateStart) + " studs");
+
+    // 壁（x=19..21, z=-175..-145）へ斜めに歩くと、止まらずに z へ滑る
+    Walk wall = walk(ws, physics, Vector3(0, standY + 0.05f, -165), Vector3(1, 0, 0.3f), 30);
+    expect(wall.end.x < 19.0f - controller->radius + 0.05f && wall.end.z > -165.0f + 3.0f,
+           "slides along the wall (x " + fixed(wall.end.x) + ", z " + fixed(wall.end.z) + ")");
+
+    // 真上に跳ぶ: 頂点は y0 + v^2 / 2g（離散の積分なので少し低い）
+    walk(ws, physics, Vector3(0, standY + 0.05f, -20), Vector3(0, 0, 0), 10);
+    controller->jump();
+    Walk jump = walk(ws, physics, player->HumanoidRootPart->pos(), Vector3(0, 0, 0), 120);
+    float g = std::fabs(ws.gravity.y);
+    float apex = standY + controller->jumpSpeed * controller->jumpSpeed / (2.0f * g);
+    expect(std::fabs(jump.maxY - apex) < 1.0f && jump.grounded && std::fabs(jump.end.y - standY) < 0.1f,
+           "jump reaches y " + fixed(jump.maxY) + " (analytic " + fixed(apex) + ") and lands");
+
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
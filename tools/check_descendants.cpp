@@ -0,0 +1,117 @@
+// tools/check_descendants.cpp
+// descendants() / forEachDescendant / GetDescendants が素直な再帰と同じ順で辿るか、
+// 辿っている途中の Destroy・子の追加で壊れないか、flush をまたいだ Lua の IterDescendants がエラーになるかを確かめる
+//   make check        （または ./tools/check_descendants）
+#include <iostream>
+#include <vector>
+#include <random>
+#include <string>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/ScriptRunner.hpp"
+#include "src/Game/Workspace.hpp"
+
+extern lua_State* G_L;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    void preorder(const Instance* inst, std::vector<Instance*>& out) {
+        for (Instance* c : inst->Children) {
+            out.push_back(c);
+            preorder(c, out);
+        }
+    }
+
+    // depthStep 個ごとに 1 段深くする（大きいほど浅い木）
+    Instance* buildTree(int count, int depthStep, std::mt19937& rng) {
+        Instance* root = new Instance("Root", "Folder");
+        std::vector<Instance*> all{ root };
+        Instance* spine = root;
+        for (int i = 0; i < count; ++i) {
+            Instance* c = new Instance("N" + std::to_string(i % 13), i % 2 ? "Model" : "Folder");
+            Instance* p = depthStep ? (i % depthStep == 0 ? spine : all[all.size() - 1 - rng() % (i % depthStep)])
+                                    : all[rng() % all.size()];
+            p->addChild(c);
+            all.push_back(c);
+            if (depthStep && i % depthStep == depthStep - 1) spine = c;
+        }
+        return root;
+    }
+}
+
+int main() {
+    std::cout << "check_descendants" << std::endl;
+    std::mt19937 rng(3);
+
+    // 浅い木と、明示スタックの 32 段を超える深い木
+    for (int depthStep : { 0, 10 }) {
+        Instance* root = buildTree(20000, depthStep, rng);
+        std::vector<Instance*> expected;
+        preorder(root, expected);
+
+        std::vector<Instance*> walked;
+        for (Instance* d : root->descendants()) walked.push_back(d);
+        std::vector<Instance*> visited;
+        root->forEachDescendant([&](Instance* d) { visited.push_back(d); });
+        std::string tree = depthStep ? "deep tree" : "random tree";
+        expect(walked == expected, tree + ": descendants() matches the recursive pre-order");
+        expect(visited == expected, tree + ": forEachDescendant matches the recursive pre-order");
+        expect(root->GetDescendants() == expected, tree + ": GetDescendants matches the recursive pre-order");
+
+        // 途中で子を足しても、破棄予約した部分木は飛ばし、足した子も辿る
+        size_t seen = 0;
+        bool skipped = true;
+        Instance* added = nullptr;
+        bool sawAdded = false;
+        Instance* destroyed = root->Children.back();
+        for (Instance* d : root->descendants()) {
+            if (seen++ == 10) {
+                destroyed->Destroy();
+                added = new Instance("Added", "Folder");
+                root->Children.front()->addChild(added);
+            }
+            if (seen > 11 && d == destroyed) skipped = false;
+            if (d == added) sawAdded = true;
+        }
+        expect(skipped && sawAdded, tree + ": Destroy and addChild during a walk (" + std::to_string(seen) + " visited)");
+        DestroyQueue::flush();
+        delete root;
+    }
+
+    // Lua: flush で解放が起きた後に古いイテレータを進めるとエラーになる
+    Workspace ws;
+    ws.initScene(0);
+    initLua();
+    luaL_dostring(G_L,
+        "root = Instance.new('Folder', workspace)\n"
+        "local a = Instance.new('Folder', root)\n"
+        "Instance.new('Model', a); Instance.new('Model', root)\n"
+        "count = 0\n"
+        "for d in root:IterDescendants() do count = count + 1 end\n"
+        "held = { root:IterDescendants() }\n"
+        "a:Destroy()");
+    DestroyQueue::flush();
+    luaL_dostring(G_L,
+        "after = 0\n"
+        "for d in root:IterDescendants() do after = after + 1 end\n"
+        "staleOk = pcall(function() return held[1](held[2]) end)");
+    lua_getglobal(G_L, "count");
+    lua_getglobal(G_L, "after");
+    lua_getglobal(G_L, "staleOk");
+    expect(lua_tointeger(G_L, 1) == 3 && lua_tointeger(G_L, 2) == 1, "Lua IterDescendants counts 3, then 1 after Destroy");
+    expect(!lua_toboolean(G_L, 3), "an iterator kept across a releasing flush raises an error");
+    lua_settop(G_L, 0);
+    shutdownLua();
+
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
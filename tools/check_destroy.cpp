@@ -0,0 +1,126 @@
+// tools/check_destroy.cpp
+// Instance.new / Destroy / Parent の書き換えを Lua から行い、破棄の予約・flush の後の見え方と、
+// パーツを外して付け直したときの子孫索引を確かめる
+//   make check        （または ./tools/check_destroy）
+#include <iostream>
+#include <string>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/ScriptRunner.hpp"
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+extern lua_State* G_L;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    void run(const char* code) {
+        if (luaL_dostring(G_L, code) != LUA_OK) {
+            expect(false, std::string("lua error: ") + lua_tostring(G_L, -1));
+            lua_pop(G_L, 1);
+        }
+    }
+
+    // 式が true になるか（エラーも失敗にする）
+    void expectLua(const std::string& expression, const std::string& what) {
+        std::string code = "return " + expression;
+        bool ok = luaL_dostring(G_L, code.c_str()) == LUA_OK && lua_toboolean(G_L, -1);
+        if (!ok && lua_isstring(G_L, -1)) std::cout << "        " << lua_tostring(G_L, -1) << std::endl;
+        lua_settop(G_L, 0);
+        expect(ok, what);
+    }
+
+    void step(Workspace& ws, Physics& physics) {
+        physics.simulate(ws, 1.0f / 60.0f);
+        PropertyChangeQueue::dispatch();
+        DestroyQueue::flush();
+    }
+}
+
+int main() {
+    std::cout << "check_destroy" << std::endl;
+    Workspace ws;
+    ws.initScene(0);
+    initLua();
+    Physics physics;
+
+    run("f = Instance.new('Folder', workspace); f.Name = 'Stuff'\n"
+        "m = Instance.new('Model', f)\n"
+        "p = Instance.new('Part', workspace); p.Name = 'Spawned'");
+    // Lua の参照は引くたびに別の表になるので、名前で比べる
+    expectLua("workspace:FindFirstChild('Stuff').Name == 'Stuff' and workspace:FindFirstChild('Spawned') ~= nil and m.Parent.Name == 'Stuff'",
+              "Instance.new with a parent is found by FindFirstChild");
+    expectLua("workspace:FindFirstChild('Model', true) ~= nil", "recursive FindFirstChild finds the Model under the Folder");
+
+    // Destroy 直後（flush 前）: 親は nil、検索にも出ない
+    run("p:Destroy(); f:Destroy()");
+    expectLua("p.Parent == nil and workspace:FindFirstChild('Spawned') == nil", "destroyed part: Parent nil, not found before the flush");
+    expectLua("workspace:FindFirstChild('Stuff') == nil and workspace:FindFirstChild('Model', true) == nil and m.Parent == nil",
+              "destroyed folder hides its whole subtree before the flush");
+    expectLua("not pcall(function() p.Parent = workspace end)", "a destroyed part cannot be parented again");
+
+    // 壊せないもの・作れないもの
+    expectLua("not pcall(function() workspace:FindFirstChild('HumanoidRootPart'):Destroy() end)", "the player's parts are locked");
+    expectLua("not pcall(function() Instance.new('Banana') end)", "unknown class names are rejected");
+    expectLua("not pcall(function() Instance.new('Part', Instance.new('Model', workspace)) end)", "parts can only be parented to workspace");
+    run("a = Instance.new('Folder', workspace); b = Instance.new('Folder', a)");
+    expectLua("not pcall(function() a.Parent = b end)", "parenting a folder under its own descendant is rejected");
+
+    // nil に外して付け直す
+    run("q = Instance.new('Part', workspace); q.Name = 'Q'; q.Parent = nil");
+    expectLua("q.Parent == nil and workspace:FindFirstChild('Q') == nil", "part parented to nil is not found");
+    run("q.Parent = workspace");
+    expectLua("q.Parent ~= nil and workspace:FindFirstChild('Q') ~= nil", "part parented back is found again");
+
+    step(ws, physics);
+    expectLua("p.Name == nil and m.Name == nil and f.Parent == nil and q.Name == 'Q'", "references to freed instances resolve to nil after the flush");
+
+    // パーツの子を付けたままパーツを外し、子を壊してから同じ名前でないものを足しても、
+    // 再帰の検索が古い索引に引っかからない
+    {
+        Cube* part = ws.addPart(CubeBuilder().pos(0, 50, 0).setName("Holder").build());
+        Instance* inner = new Instance("Inner", "Folder");
+        part->addChild(inner);
+        expect(ws.FindFirstChild("Inner", true) == inner, "child of a part is found recursively from workspace");
+        ws.detachPart(part);
+        expect(ws.FindFirstChild("Inner", true) == nullptr, "detached part's child is not found from workspace");
+        inner->Destroy();
+        DestroyQueue::flush();
+        ws.addChild(new Instance("Other", "Folder"));
+        expect(ws.FindFirstChild("Inner", true) == nullptr, "destroyed child of a detached part leaves no stale index entry");
+        Instance* again = new Instance("Inner", "Folder");
+        part->addChild(again);
+        ws.attachPart(part);
+        expect(ws.FindFirstChild("Inner", true) == again, "re-attached part's new child is indexed again");
+    }
+
+    // 作っては壊すのを繰り返した後の数
+    run("for i = 1, 300 do local x = Instance.new('Part', workspace); x.Name = 'C' .. (i % 7); if i % 2 == 0 then x:Destroy() end end\n"
+        "for i = 1, 50 do local fo = Instance.new('Folder', workspace); fo.Name = 'F'\n"
+        "  for j = 1, 20 do Instance.new('Model', fo).Name = 'M' .. j end\n"
+        "  if i % 3 == 0 then fo:Destroy() end end");
+    for (int i = 0; i < 3; ++i) step(ws, physics);
+    expectLua("(function() local n, folders = 0, 0\n"
+              "  for _, c in ipairs(workspace:GetChildren()) do\n"
+              "    if c.Name:sub(1, 1) == 'C' then n = n + 1 elseif c.Name == 'F' then folders = folders + 1 end\n"
+              "  end\n"
+              "  return n == 150 and folders == 34 end)()",
+              "churn leaves 150 parts and 34 folders");
+
+    InstanceAllocator::Stats stats = InstanceAllocator::getStats();
+    expect(stats.frees > 0 && stats.allocations >= stats.frees, "allocator: " + std::to_string(stats.allocations) + " allocations, " +
+           std::to_string(stats.frees) + " frees, " + std::to_string(stats.systemCalls) + " system calls");
+
+    shutdownLua();
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
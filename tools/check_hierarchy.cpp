@@ -0,0 +1,75 @@
+// tools/check_hierarchy.cpp
+// TransformHierarchy が破棄されたパーツのノードを rebuild で落とすかを確かめる
+//   make check        （または ./tools/check_hierarchy）
+#include <iostream>
+#include <cmath>
+
+#include "src/Game/PartPool.hpp"
+#include "src/Game/TransformHierarchy.hpp"
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const char* what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    bool near(const Vector3& a, const Vector3& b) {
+        return std::fabs(a.x - b.x) < 1e-4f && std::fabs(a.y - b.y) < 1e-4f && std::fabs(a.z - b.z) < 1e-4f;
+    }
+}
+
+int main() {
+    std::cout << "check_hierarchy" << std::endl;
+    ComponentStore store;
+    PartPool pool(store);
+    TransformHierarchy hierarchy(store);
+
+    // 子を繋いで壊すのを繰り返しても、ノードは増えない
+    Cube* root = pool.create(CubeBuilder().setStatic().build());
+    bool steady = true;
+    for (int i = 0; i < 5; ++i) {
+        Cube* child = pool.create(CubeBuilder().build());
+        hierarchy.attach(child, root, Vector3(0, 1, 0));
+        hierarchy.update();
+        steady = steady && hierarchy.nodeCount() == 2;
+        pool.destroy(child);
+        hierarchy.update();
+        steady = steady && hierarchy.nodeCount() == 0;
+    }
+    expect(steady, "attach + destroy repeated: nodeCount 2 -> 0 every time");
+
+    // 兄弟の1つを壊しても、残った子は同じ親に付いたまま動く
+    Cube* a = pool.create(CubeBuilder().build());
+    Cube* b = pool.create(CubeBuilder().build());
+    hierarchy.attach(a, root, Vector3(1, 0, 0));
+    hierarchy.attach(b, root, Vector3(0, 0, 2));
+    hierarchy.update();
+    pool.destroy(a);
+    hierarchy.update();
+    expect(hierarchy.nodeCount() == 2, "destroyed sibling leaves root + one child");
+    expect(hierarchy.parentOf(b) == root, "surviving child keeps its parent");
+    root->transform().pos = Vector3(10, 0, 0);
+    hierarchy.update();
+    expect(near(b->transform().pos, Vector3(10, 0, 2)), "surviving child follows the root");
+
+    // 途中の親を壊すと、孫は最後のワールド座標の根になり、子のない根は落ちる
+    Cube* mid = pool.create(CubeBuilder().build());
+    Cube* leaf = pool.create(CubeBuilder().build());
+    hierarchy.attach(mid, b, Vector3(0, 3, 0));
+    hierarchy.attach(leaf, mid, Vector3(0, 0, 4));
+    hierarchy.update();
+    expect(hierarchy.nodeCount() == 4, "chain root -> b -> mid -> leaf");
+    pool.destroy(mid);
+    hierarchy.update();
+    expect(hierarchy.nodeCount() == 2, "destroyed middle node drops it and the orphaned leaf");
+    expect(!hierarchy.isAttached(leaf) && near(leaf->transform().pos, Vector3(10, 3, 6)),
+           "orphaned leaf keeps its last world position");
+
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// tools/check_instance_index.cpp
+// 子の索引・子孫索引で引いた FindFirstChild / FindFirstChildOfClass の結果が、
+// 索引を使わない素直な深さ優先の探索と同じになるかを確かめる
+// （Workspace のパーツの下と Folder / Model の下に同じ名前が混ざる木で、
+//   付け替え・改名・パーツの detach / attach・Destroy を挟みながら）
+//   make check        （または ./tools/check_instance_index）
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "src/Game/Workspace.hpp"
+
+namespace {
+    const char* kNames[] = { "A", "B", "C", "D", "E", "Handle" };
+    const char* kClasses[] = { "Folder", "Model" };
+
+    bool usable(const Instance* inst) {
+        for (const Instance* a = inst; a; a = a->Parent) {
+            if (a->destroying) return false;
+        }
+        return true;
+    }
+
+    // 索引を使わない探索（直接の子を全て見てから、子を順に潜る）
+    Instance* plainByName(const Instance* inst, Atom name) {
+        for (Instance* c : inst->Children) if (!c->destroying && c->Name == name) return c;
+        for (Instance* c : inst->Children) if (Instance* r = plainByName(c, name)) return r;
+        return nullptr;
+    }
+    Instance* plainByClass(const Instance* inst, Atom className) {
+        for (Instance* c : inst->Children) if (!c->destroying && c->ClassName == className) return c;
+        for (Instance* c : inst->Children) if (Instance* r = plainByClass(c, className)) return r;
+        return nullptr;
+    }
+
+    // Workspace の直下: パーツ（Children にない）と Children を siblingOrder の順に並べる
+    std::vector<Instance*> workspaceChildren(Workspace& ws) {
+        std::vector<Instance*> list(ws.Children.begin(), ws.Children.end());
+        for (Cube& part : ws.cubes) {
+            if (part.Parent == &ws) list.push_back(&part);
+        }
+        std::sort(list.begin(), list.end(), [](const Instance* a, const Instance* b) { return a->siblingOrder < b->siblingOrder; });
+        return list;
+    }
+
+    // Workspace からの再帰の FindFirstChild: 直下のパーツ、直下の Children、その後に子を順に潜る
+    Instance* plainWorkspaceByName(Workspace& ws, Atom name) {
+        std::vector<Instance*> top = workspaceChildren(ws);
+        for (Instance* c : top) if (ws.cubes.contains(c) && !c->destroying && c->Name == name) return c;
+        for (Instance* c : ws.Children) if (!c->destroying && c->Name == name) return c;
+        for (Instance* c : top) if (Instance* r = plainByName(c, name)) return r;
+        return nullptr;
+    }
+
+    // FindFirstChildOfClass はパーツ自身を直下として見ない（パーツは子孫索引にも載らない）
+    Instance* plainWorkspaceByClass(Workspace& ws, Atom className) {
+        for (Instance* c : ws.Children) if (!c->destroying && c->ClassName == className) return c;
+        for (Instance* c : workspaceChildren(ws)) if (Instance* r = plainByClass(c, className)) return r;
+        return nullptr;
+    }
+}
+
+int main() {
+    std::cout << "check_instance_index" << std::endl;
+    std::mt19937 rng(12345);
+    size_t checks = 0, mismatches = 0;
+
+    for (int round = 0; round < 100; ++round) {
+        Workspace* ws = new Workspace();
+        global_workspace = ws;
+        std::vector<Instance*> folders;   // パーツ以外の Instance（Folder / Model）
+        std::vector<Cube*> parts;
+
+        auto randomParent = [&]() -> Instance* {
+            size_t n = folders.size() + parts.size() + 1;
+            size_t k = rng() % n;
+            if (k == 0) return ws;
+            if (k <= folders.size()) return folders[k - 1];
+            return parts[k - 1 - folders.size()];
+        };
+
+        // 木を作り、途中で手を加える
+        for (int step = 0; step < 600; ++step) {
+            int op = (int)(rng() % 100);
+            if (op < 20 || folders.size() + parts.size() < 8) {
+                Cube* part = ws->newPart(CubeBuilder().setName(kNames[rng() % 6]).build());
+                ws->attachPart(part);
+                parts.push_back(part);
+            } else if (op < 60) {
+                Instance* parent = randomParent();
+                if (!usable(parent)) continue;
+                Instance* folder = new Instance(kNames[rng() % 6], kClasses[rng() % 2]);
+                parent->addChild(folder);
+                folders.push_back(folder);
+            } else if (op < 72 && !folders.empty()) {
+                // Folder の付け替え（自分の子孫の下には付けない）
+                Instance* folder = folders[rng() % folders.size()];
+                Instance* parent = randomParent();
+                bool cycle = false;
+                for (Instance* a = parent; a; a = a->Parent) cycle = cycle || a == folder;
+                if (!cycle && usable(folder) && usable(parent)) parent->addChild(folder);
+            } else if (op < 84) {
+                Instance* target = randomParent();
+                if (target != ws && usable(target)) target->setName(kNames[rng() % 6]);
+            } else if (op < 92 && !parts.empty()) {
+                Cube* part = parts[rng() % parts.size()];
+                if (!usable(part)) continue;
+                if (part->Parent) ws->detachPart(part);
+                else ws->attachPart(part);
+            } else if (op < 96) {
+                Instance* target = randomParent();
+                if (target != ws && usable(target)) target->Destroy();
+            } else {
+                // 破棄予約済みの部分木にあるものは flush で解放されるので、先に一覧から外す
+                folders.erase(std::remove_if(folders.begin(), folders.end(), [](Instance* f) { return !usable(f); }), folders.end());
+                parts.erase(std::remove_if(parts.begin(), parts.end(), [](Cube* p) { return !usable(p); }), parts.end());
+                DestroyQueue::flush();
+            }
+        }
+
+        // Workspace と、生きている全ての Instance から引く
+        std::vector<Instance*> from{ ws };
+        for (Instance* f : folders) if (usable(f)) from.push_back(f);
+        for (Cube* p : parts) if (usable(p)) from.push_back(p);
+        for (Instance* inst : from) {
+            for (const char* name : kNames) {
+                Atom key(name);
+                Instance* expected = inst == ws ? plainWorkspaceByName(*ws, key) : plainByName(inst, key);
+                checks++;
+                if (inst->FindFirstChild(name, true) != expected) mismatches++;
+            }
+            for (const char* className : kClasses) {
+                Atom key(className);
+                Instance* expected = inst == ws ? plainWorkspaceByClass(*ws, key) : plainByClass(inst, key);
+                checks++;
+                if (inst->FindFirstChildOfClass(className, true) != expected) mismatches++;
+            }
+        }
+
+        DestroyQueue::flush();
+        global_workspace = nullptr;
+        delete ws;
+    }
+
+    std::cout << "  " << (mismatches == 0 ? "ok    " : "FAIL  ") << checks << " lookups, " << mismatches
+              << " differ from the plain DFS" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// tools/check_joints.cpp
+// Weld / Motor6D の振る舞いを確かめる（剛体アセンブリと拘束の両方で Weld がずれないか、
+// 外すと離れるか、モーターが MaxVelocity ずつ目標角へ進むか、Lua から作れるか、プレイヤーの関節は守られるか）
+//   make check        （または ./tools/check_joints）
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cmath>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/ScriptRunner.hpp"
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+extern lua_State* G_L;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    void step(Workspace& ws, Physics& physics) {
+        physics.simulate(ws, 1.0f / 60.0f);
+        ws.hierarchy.update();
+        PropertyChangeQueue::dispatch();
+        DestroyQueue::flush();
+    }
+
+    // b が a から見て offset の位置にあるはずのとき、そこからのずれ
+    float drift(Cube* a, Cube* b, const Vector3& offset) {
+        Matrix3 R = Matrix3::rotate(a->rotation());
+        return (b->pos() - (a->pos() + R * offset)).length();
+    }
+
+    bool luaTrue(const char* expression) {
+        std::string code = std::string("return ") + expression;
+        bool ok = luaL_dostring(G_L, code.c_str()) == LUA_OK && lua_toboolean(G_L, -1);
+        lua_settop(G_L, 0);
+        return ok;
+    }
+
+    std::string fixed(float v, int digits) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(digits) << v;
+        return s.str();
+    }
+
+    // 傾けて落とした 2 つのパーツを Weld で繋ぎ、90 フレーム後のずれを見てから Weld を外す
+    void weldPair(bool assemblies) {
+        Workspace ws;
+        ws.initScene(0);
+        ws.joints.setUseAssemblies(assemblies);
+        Physics physics;
+        step(ws, physics);
+        // プレイヤーの関節の分を除いて数える
+        size_t baseAssemblies = ws.joints.assemblyCount(), baseConstraints = ws.joints.constraints().size();
+        Cube* a = ws.addPart(CubeBuilder().size(4, 2, 4).pos(20, 12, 0).rotation(0, 0, 20).setName("A").build());
+        Cube* b = ws.addPart(CubeBuilder().size(2, 2, 2).pos(23, 12, 0).setName("B").build());
+        JointInstance* weld = new JointInstance(&ws.joints, "Weld");
+        weld->setPart0(a);
+        weld->setPart1(b);
+        weld->setC0(JointFrame(Vector3(3, 0, 0)));
+        ws.addChild(weld);
+
+        for (int f = 0; f < 90; ++f) step(ws, physics);
+        std::string mode = assemblies ? "assembly" : "constraint";
+        float d = drift(a, b, Vector3(3, 0, 0));
+        expect(assemblies ? ws.joints.assemblyCount() == baseAssemblies + 1 : ws.joints.constraints().size() == baseConstraints + 1,
+               mode + ": the weld is solved as " + (assemblies ? "one assembly" : "one constraint"));
+        expect(d < (assemblies ? 1e-3f : 0.05f), mode + ": welded pair drift after landing " + fixed(d, 4));
+
+        // 外した後に B だけを跳ね上げると、A から離れる
+        weld->Destroy();
+        step(ws, physics);
+        b->setVelocity(Vector3(0, 30, 0));
+        for (int f = 0; f < 10; ++f) step(ws, physics);
+        expect(ws.joints.assemblyCount() == baseAssemblies && ws.joints.constraints().size() == baseConstraints &&
+               drift(a, b, Vector3(3, 0, 0)) > 1.0f,
+               mode + ": destroying the weld lets the parts separate");
+    }
+}
+
+int main() {
+    std::cout << "check_joints" << std::endl;
+    weldPair(true);
+    weldPair(false);
+
+    Workspace ws;
+    ws.initScene(0);
+    initLua();
+    Physics physics;
+
+    // 固定した台に付けたモーター: 1 フレームに MaxVelocity ずつ目標角へ進み、そこで止まる
+    Cube* base = ws.addPart(CubeBuilder().size(2, 2, 2).pos(-20, 10, 0).setStatic().setName("Base").build());
+    Cube* arm = ws.addPart(CubeBuilder().size(6, 1, 1).pos(-17, 10, 0).setName("Arm").build());
+    JointInstance* motor = new JointInstance(&ws.joints, "Motor6D");
+    motor->setPart0(base);
+    motor->setPart1(arm);
+    motor->setC0(JointFrame(Vector3(1, 0, 0)));
+    motor->setC1(JointFrame(Vector3(-3, 0, 0)));
+    ws.addChild(motor);
+    motor->desiredAngle = 1.5708f;
+    motor->maxVelocity = 0.05f;
+    for (int f = 0; f < 20; ++f) step(ws, physics);
+    float halfway = motor->getCurrentAngle();
+    expect(std::fabs(halfway - 1.0f) < 0.051f, "motor after 20 frames at 0.05/frame: angle " + fixed(halfway, 3));
+    for (int f = 0; f < 60; ++f) step(ws, physics);
+    expect(std::fabs(motor->getCurrentAngle() - 1.5708f) < 1e-3f, "motor stops at the desired angle " + fixed(motor->getCurrentAngle(), 4));
+    expect(drift(base, arm, Vector3(1, 0, 0) + Matrix3::rotate(base->rotation()).transpose() * (Matrix3::rotate(arm->rotation()) * Vector3(3, 0, 0))) < 1e-3f,
+           "motored arm stays attached to the anchored base");
+
+    // Lua から Weld を作り、外すと落ちる
+    luaL_dostring(G_L,
+        "local p1 = Instance.new('Part', workspace)\n"
+        "p1.Name = 'Lamp'; p1.Position = {X = -20, Y = 14, Z = 0}\n"
+        "lampWeld = Instance.new('Weld', workspace)\n"
+        "lampWeld.Part0 = workspace:FindFirstChild('Base'); lampWeld.Part1 = p1; lampWeld.C0 = {Y = 4}");
+    expect(luaTrue("lampWeld.ClassName == 'Weld' and lampWeld.Part0.Name == 'Base' and lampWeld.Part1.Name == 'Lamp' and lampWeld.C0.Y == 4"),
+           "Lua Weld properties read back");
+    expect(luaTrue("not pcall(function() lampWeld.Part0 = 5 end)"), "assigning a non-part to Part0 is rejected");
+    for (int f = 0; f < 30; ++f) step(ws, physics);
+    expect(luaTrue("math.abs(workspace:FindFirstChild('Lamp').Position.Y - 14) < 1e-3"), "lamp welded to the anchored base does not fall");
+    luaL_dostring(G_L, "lampWeld:Destroy()");
+    for (int f = 0; f < 30; ++f) step(ws, physics);
+    expect(luaTrue("workspace:FindFirstChild('Lamp').Position.Y < 13"), "lamp falls once its weld is destroyed");
+
+    // プレイヤーの関節（R6 の Motor6D）は角度だけ変えられる
+    expect(luaTrue("workspace:FindFirstChild('Player'):FindFirstChild('Right Shoulder').ClassName == 'Motor6D'"),
+           "player rig has a Right Shoulder Motor6D");
+    expect(luaTrue("(function() local rs = workspace:FindFirstChild('Player'):FindFirstChild('Right Shoulder')\n"
+                   "  rs.CurrentAngle = 0.5\n"
+                   "  return not pcall(function() rs.Part1 = nil end) and not pcall(function() rs:Destroy() end) end)()"),
+           "player joints accept CurrentAngle but cannot be re-pointed or destroyed");
+
+    // Weld の片方のパーツを消すと、関節もアセンブリも残らない
+    size_t joints = ws.joints.jointCount();
+    Cube* c = ws.addPart(CubeBuilder().size(2, 2, 2).pos(0, 30, 30).setName("C").build());
+    Cube* d = ws.addPart(CubeBuilder().size(2, 2, 2).pos(0, 30, 32).setName("D").build());
+    JointInstance* weld = new JointInstance(&ws.joints, "Weld");
+    weld->setPart0(c);
+    weld->setPart1(d);
+    weld->setC0(JointFrame(Vector3(0, 0, 2)));
+    ws.addChild(weld);
+    for (int f = 0; f < 10; ++f) step(ws, physics);
+    size_t assemblies = ws.joints.assemblyCount();
+    ws.removePart(c);
+    for (int f = 0; f < 10; ++f) step(ws, physics);
+    expect(ws.joints.assemblyCount() == assemblies - 1 && ws.joints.jointCount() <= joints + 1,
+           "removing a welded part drops its assembly (" + std::to_string(ws.joints.assemblyCount()) + " left)");
+
+    shutdownLua();
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+// tools/check_lod.cpp
+// LOD の段の選び方（ヒステリシス）と、LodClusters のインポスターの切り替え・焼き直しを確かめる
+// （10000 個の固定パーツの街で。GL は使わない）
+//   make check        （または ./tools/check_lod）
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Game/Mesh.hpp"
+#include "src/Render/Lod.hpp"
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    // 閾値 120px の前後を amplitude px でゆらしたときに段が変わった回数
+    int oscillate(float amplitude, const LodSettings& settings) {
+        int level = -1, flips = 0;
+        for (int f = 0; f < 600; ++f) {
+            int next = selectLod(level, 120.0f + amplitude * std::sin(f * 0.3f), settings);
+            if (level >= 0 && next != level) flips++;
+            level = next;
+        }
+        return flips;
+    }
+
+    // tools/bench_lod.cpp と同じ街（50 x 50 区画に 4 棟ずつ）
+    void buildCity(Workspace& ws) {
+        std::mt19937 rng(1);
+        for (int bx = 0; bx < 50; ++bx) {
+            for (int bz = 0; bz < 50; ++bz) {
+                float x = -1500 + bx * 60.0f, z = -1500 + bz * 60.0f;
+                for (int k = 0; k < 4; ++k) {
+                    PartShape shape = (PartShape)(rng() % 4);
+                    ws.addPart(CubeBuilder().size(8, 6 + rng() % 30, 8).pos(x + (k & 1) * 20, 20, z + (k >> 1) * 20)
+                                   .shape(shape).setStatic().build());
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    std::cout << "check_lod" << std::endl;
+    LodSettings settings;
+
+    // 段は閾値（120 / 40px）を hysteresis（15%）越えてから変わる
+    {
+        std::ostringstream switches;
+        int level = -1;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (float px = 200; px > 10; px -= 2) {
+                float pixels = pass ? 210 - px : px;
+                int next = selectLod(level, pixels, settings);
+                if (next != level) switches << " " << pixels << "->" << next;
+                level = next;
+            }
+        }
+        expect(switches.str() == " 200->0 100->1 32->2 48->1 140->0", "sweep 200 -> 10 -> 200 px switches at" + switches.str());
+    }
+    int flips = oscillate(11.0f, settings);
+    expect(flips == 0, "size oscillating 120 +-9% px: " + std::to_string(flips) + " flips");
+    flips = oscillate(25.0f, settings);
+    expect(flips > 0, "size oscillating 120 +-21% px still switches (" + std::to_string(flips) + " flips)");
+
+    // LodSelector は世代の違うエンティティを初めてとして扱う
+    {
+        LodSelector selector;
+        EntityId a{ 5, 1 }, b{ 5, 2 };
+        selector.update(a, 200.0f, settings);
+        int kept = selector.update(a, 110.0f, settings);
+        int fresh = selector.update(b, 110.0f, settings);
+        expect(kept == 0 && fresh == 1, "110 px keeps level 0 for the same entity, a reused slot starts at level 1");
+    }
+
+    expect(beyondFarPlane(Vector3(0, 0, Z_FAR + 11), 10.0f, Vector3(0, 0, 0)) &&
+           !beyondFarPlane(Vector3(0, 0, Z_FAR + 9), 10.0f, Vector3(0, 0, 0)),
+           "a sphere is far-culled only when all of it lies beyond Z_FAR");
+
+    // simplifyMesh: 添字は元の頂点を指し、格子が粗いほど三角形が減る
+    {
+        std::string obj;
+        const int rings = 32, segments = 32;
+        for (int r = 0; r <= rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                float th = (float)M_PI * r / rings, ph = 2.0f * (float)M_PI * s / segments;
+                obj += "v " + std::to_string(std::sin(th) * std::cos(ph)) + " " + std::to_string(std::cos(th)) + " " +
+                       std::to_string(std::sin(th) * std::sin(ph)) + "\n";
+            }
+        }
+        for (int r = 0; r < rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                int a = r * segments + s + 1, b = r * segments + (s + 1) % segments + 1;
+                obj += "f " + std::to_string(a) + " " + std::to_string(b) + " " + std::to_string(b + segments) + " " +
+                       std::to_string(a + segments) + "\n";
+            }
+        }
+        MeshAsset mesh;
+        parseObj(obj.data(), obj.size(), mesh);
+        std::vector<uint32_t> fine, coarse;
+        simplifyMesh(mesh, 16, fine);
+        simplifyMesh(mesh, 4, coarse);
+        bool inRange = true;
+        for (uint32_t i : fine) inRange = inRange && i < mesh.vertices.size();
+        for (uint32_t i : coarse) inRange = inRange && i < mesh.vertices.size();
+        expect(inRange && coarse.size() < fine.size() && fine.size() < mesh.indices.size() && !coarse.empty(),
+               "simplifyMesh " + std::to_string(mesh.triangleCount()) + " -> " + std::to_string(fine.size() / 3) + " (grid 16) -> " +
+               std::to_string(coarse.size() / 3) + " (grid 4) triangles");
+    }
+
+    // 街の塊
+    Workspace ws;
+    ws.initScene(0);
+    buildCity(ws);
+    LodClusters clusters;
+    clusters.setTileCount(1024);
+    Vector3 corner(-1500, 60, -1500);
+    clusters.update(ws.components, corner, settings);
+    expect(clusters.captureCount() == (size_t)settings.capturesPerFrame,
+           "first frame captures " + std::to_string(clusters.captureCount()) + " clusters (the per-frame limit)");
+    for (int f = 0; f < 60; ++f) clusters.update(ws.components, corner, settings);
+    expect(clusters.impostorCount() > 100 && clusters.captureCount() == 0,
+           "settled: " + std::to_string(clusters.impostorCount()) + " impostors, no captures");
+
+    // 色を変えると、その塊だけ 1 度焼き直す
+    Cube* edited = nullptr;
+    for (const LodCluster& c : clusters.clusters()) {
+        if (c.impostor) {
+            edited = ws.components.ownerOf(c.members[0].entity);
+            break;
+        }
+    }
+    edited->renderable().color = Vector3(255, 0, 0);
+    clusters.update(ws.components, corner, settings);
+    size_t afterEdit = clusters.captureCount();
+    clusters.update(ws.components, corner, settings);
+    expect(afterEdit == 1 && clusters.captureCount() == 0, "a colour edit recaptures exactly 1 cluster, once");
+
+    // 一番大きな塊の板にする距離の前後 +-10% を往復しても切り替わらない
+    {
+        const LodCluster* largest = nullptr;
+        for (const LodCluster& c : clusters.clusters()) {
+            if (!largest || c.members.size() > largest->members.size()) largest = &c;
+        }
+        Vector3 center = largest->center;
+        int64_t key = largest->key;
+        float distance = largest->radius * SCREEN_H / (settings.impostorPixels * std::tan(FOV_Y * 0.5f * (float)M_PI / 180.0f));
+        int switches = 0, previous = -1;
+        for (int f = 0; f < 300; ++f) {
+            clusters.update(ws.components, center + Vector3(distance * (1.0f + 0.1f * std::sin(f * 0.2f)), 0, 0), settings);
+            for (const LodCluster& c : clusters.clusters()) {
+                if (c.key != key) continue;
+                if (previous >= 0 && (int)c.impostor != previous) switches++;
+                previous = c.impostor;
+            }
+        }
+        expect(switches == 0, "camera at the impostor distance +-10%: " + std::to_string(switches) + " switches in 300 frames");
+    }
+
+    // アトラスの区画が足りなければ、残りは形のまま描く
+    {
+        LodClusters few;
+        few.setTileCount(4);
+        for (int f = 0; f < 60; ++f) few.update(ws.components, corner, settings);
+        expect(few.impostorCount() == 4, "with 4 atlas tiles only " + std::to_string(few.impostorCount()) + " clusters become impostors");
+    }
+
+    // 塊の中身を全て壊すと塊が消える
+    size_t before = clusters.clusters().size();
+    std::vector<Cube*> doomed;
+    ws.components.forEach(Comp_Transform | Comp_Anchored, [&](const Archetype& arch) {
+        for (size_t i = 0; i < arch.size(); ++i) {
+            const Vector3& p = arch.transforms[i].pos;
+            if (p.x < -1400 && p.z < -1400) doomed.push_back(arch.owners[i]);
+        }
+    });
+    for (Cube* part : doomed) part->Destroy();
+    DestroyQueue::flush();
+    clusters.update(ws.components, corner, settings);
+    expect(clusters.clusters().size() == before - 1,
+           "destroying the " + std::to_string(doomed.size()) + " parts of the corner cluster: " + std::to_string(before) + " -> " +
+           std::to_string(clusters.clusters().size()) + " clusters");
+
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
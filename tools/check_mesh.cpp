@@ -0,0 +1,228 @@
+// tools/check_mesh.cpp
+// MeshPart の当たり判定・レイ・Lua の API と、焼いた形式（.mesh）の検査を確かめる
+//   - 固定のアーチ（半円の厚い板）の上に箱が乗り、下はくぐり、球は外側を転がり落ちる
+//   - 速い箱がアーチをすり抜けず、動くメッシュの岩は床の上で止まる
+//   - レイはアーチの穴を通り抜け、三角形の面で止まる
+//   - 切り詰めた .mesh は読まず、ビットを反転させた .mesh でも落ちない（ASan で確かめるとよい）
+//   make check        （または ./tools/check_mesh）
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/Mesh.hpp"
+#include "src/Game/ScriptRunner.hpp"
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+namespace fs = std::filesystem;
+
+extern lua_State* G_L;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    void expectLua(const std::string& expression, const std::string& what) {
+        std::string code = "return " + expression;
+        bool ok = luaL_dostring(G_L, code.c_str()) == LUA_OK && lua_toboolean(G_L, -1);
+        if (!ok && lua_isstring(G_L, -1)) std::cout << "        " << lua_tostring(G_L, -1) << std::endl;
+        lua_settop(G_L, 0);
+        expect(ok, what);
+    }
+
+    std::string fixed(float v) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(3) << v;
+        return s.str();
+    }
+
+    void step(Workspace& ws, Physics& physics, int frames) {
+        for (int f = 0; f < frames; ++f) {
+            physics.simulate(ws, 1.0f / 60.0f);
+            PropertyChangeQueue::dispatch();
+            DestroyQueue::flush();
+        }
+    }
+
+    // アーチ: 内半径 3・外半径 4 の半円を奥行き 4 に伸ばした板（24 分割）
+    void writeArch(const fs::path& path) {
+        std::ofstream out(path);
+        const int n = 24;
+        for (int i = 0; i <= n; ++i) {
+            float a = (float)M_PI * i / n;
+            for (int z = 0; z < 2; ++z) {
+                out << "v " << 3 * std::cos(a) << " " << 3 * std::sin(a) << " " << (z ? 2 : -2) << "\n";
+                out << "v " << 4 * std::cos(a) << " " << 4 * std::sin(a) << " " << (z ? 2 : -2) << "\n";
+            }
+        }
+        auto id = [](int i, int z, int outer) { return i * 4 + z * 2 + outer + 1; };
+        for (int i = 0; i < n; ++i) {
+            out << "f " << id(i, 0, 1) << " " << id(i + 1, 0, 1) << " " << id(i + 1, 1, 1) << " " << id(i, 1, 1) << "\n";
+            out << "f " << id(i, 1, 0) << " " << id(i + 1, 1, 0) << " " << id(i + 1, 0, 0) << " " << id(i, 0, 0) << "\n";
+            out << "f " << id(i, 0, 0) << " " << id(i + 1, 0, 0) << " " << id(i + 1, 0, 1) << " " << id(i, 0, 1) << "\n";
+            out << "f " << id(i, 1, 1) << " " << id(i + 1, 1, 1) << " " << id(i + 1, 1, 0) << " " << id(i, 1, 0) << "\n";
+        }
+    }
+
+    // 岩: 表面に起伏のある低い分割の球（8 x 12）
+    void writeRock(const fs::path& path) {
+        std::ofstream out(path);
+        const int rings = 8, segments = 12;
+        for (int r = 0; r <= rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                float th = (float)M_PI * r / rings, ph = 2.0f * (float)M_PI * s / segments;
+                float radius = 1.0f + 0.08f * std::sin(ph * 7) * std::sin(th * 5);
+                out << "v " << radius * std::sin(th) * std::cos(ph) << " " << radius * std::cos(th) << " "
+                    << radius * std::sin(th) * std::sin(ph) << "\n";
+            }
+        }
+        for (int r = 0; r < rings; ++r) {
+            for (int s = 0; s < segments; ++s) {
+                int a = r * segments + s + 1, b = r * segments + (s + 1) % segments + 1;
+                out << "f " << a << " " << b << " " << b + segments << " " << a + segments << "\n";
+            }
+        }
+    }
+}
+
+int main() {
+    std::cout << "check_mesh" << std::endl;
+    fs::path dir = fs::temp_directory_path() / "check_mesh";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::path arch = dir / "arch.obj", rock = dir / "rock.obj";
+    writeArch(arch);
+    writeRock(rock);
+    MeshLibrary& library = MeshLibrary::get();
+    library.setDirectory((dir / "cooked").string());
+
+    Workspace ws;
+    ws.initScene(0);
+    Physics physics;
+    // x=1000 に床（上面 y=1）と、幅 8・高さ 4 のアーチ（外側の頂上 y=5、内側の頂上 y=4）
+    ws.addPart(CubeBuilder().size(80, 2, 80).pos(1000, 0, 0).setName("Floor").setStatic().build());
+    Cube* archPart = ws.addPart(CubeBuilder().size(8, 4, 4).pos(1000, 3, 0).mesh(arch.string()).setStatic().setName("Arch").build());
+    expect(archPart->ClassName == "MeshPart" && library.asset(archPart->transform().mesh).triangleCount() == 192,
+           "arch loads as a MeshPart with 192 triangles");
+
+    Cube* onTop = ws.addPart(CubeBuilder().size(1, 1, 1).pos(1000, 9, 0).setName("OnTop").build());
+    Cube* under = ws.addPart(CubeBuilder().size(1, 1, 1).pos(1000, 3, 0).setName("Under").build());
+    Cube* ball = ws.addPart(CubeBuilder().size(1, 1, 1).pos(1002.5f, 9, 0).shape(PartShape::Ball).setName("Ball").build());
+    Cube* rockPart = ws.addPart(CubeBuilder().size(3, 3, 3).pos(1020, 8, 0).mesh(rock.string()).setName("Rock").build());
+    Cube* fast = ws.addPart(CubeBuilder().size(0.5f, 0.5f, 0.5f).pos(1000, 40, 1.5f).setName("Fast").build());
+    fast->setVelocity(Vector3(0, -400, 0));
+    float fastLowest = fast->pos().y;
+    for (int f = 0; f < 30; ++f) {
+        step(ws, physics, 1);
+        fastLowest = std::min(fastLowest, fast->pos().y);
+    }
+    step(ws, physics, 270);
+
+    expect(std::fabs(onTop->pos().y - 5.5f) < 0.05f, "box rests on the top of the arch at y " + fixed(onTop->pos().y) + " (5.5)");
+    expect(std::fabs(under->pos().y - 1.5f) < 0.05f, "box inside the opening falls to the floor at y " + fixed(under->pos().y) + " (1.5)");
+    expect(ball->pos().x > 1004.0f && ball->pos().y < 1.6f,
+           "ball rolls off the outer side to (" + fixed(ball->pos().x) + ", " + fixed(ball->pos().y) + ")");
+    expect(std::fabs(rockPart->pos().y - 2.5f) < 0.1f, "moving mesh rock rests on its hull at y " + fixed(rockPart->pos().y) + " (2.5)");
+    expect(fastLowest > 5.0f, "0.5 box at 400 studs/s does not pass through the arch (lowest y " + fixed(fastLowest) + ")");
+
+    // レイ
+    QueryParams params;
+    QueryHit hit;
+    expect(!ws.spatial.raycast(Vector3(1000, 3, -10), Vector3(0, 0, 20), params, hit), "a ray through the opening hits nothing");
+    bool found = ws.spatial.raycast(Vector3(1001, 20, -1.5f), Vector3(0, -30, 0), params, hit);
+    float outer = 1.0f + std::sqrt(15.0f);
+    expect(found && hit.part == archPart && std::fabs(hit.position.y - outer) < 0.05f && hit.normal.y > 0.9f,
+           "a ray down hits the outer surface at y " + fixed(hit.position.y) + " (circle: " + fixed(outer) + ")");
+    found = ws.spatial.raycast(Vector3(1003.5f, 2, 0), Vector3(0, 10, 0), params, hit);
+    outer = 1.0f + std::sqrt(16.0f - 3.5f * 3.5f);
+    expect(found && hit.part == archPart && std::fabs(hit.position.y - outer) < 0.05f,
+           "a ray starting inside the wall stops at its outer surface y " + fixed(hit.position.y) + " (circle: " + fixed(outer) + ")");
+
+    // MeshLibrary
+    int failed = library.getStats().failures;
+    expect(library.load(arch.string()) == archPart->transform().mesh, "loading the same path again returns the same mesh");
+    expect(library.load((dir / "missing.obj").string()) == 0 && library.getStats().failures == failed + 1,
+           "a missing file gives mesh 0 (the box)");
+
+    // Lua
+    initLua();
+    std::string code =
+        "m = Instance.new('MeshPart')\n"
+        "m.Parent = workspace\n"
+        "m.Position = {X = 1030, Y = 10, Z = 0}\n"
+        "m.MeshId = '" + rock.string() + "'\n";
+    luaL_dostring(G_L, code.c_str());
+    expectLua("m.ClassName == 'MeshPart' and m:IsA('BasePart')", "Instance.new('MeshPart') is a BasePart");
+    expectLua("m.MeshId == '" + rock.string() + "' and m.MeshSize.X == 2 and m.MeshSize.Y == 2", "MeshId loads the rock and sets MeshSize 2 x 2");
+    expectLua("not pcall(function() m.Shape = 'Ball' end)", "a MeshPart cannot change its Shape");
+    expectLua("not pcall(function() Instance.new('Part', workspace).MeshId = 'x' end)", "a Part has no MeshId");
+    expectLua("(function() m.MeshId = '" + (dir / "missing.obj").string() + "'; local id = m.MeshId\n"
+              "  m.MeshId = '" + rock.string() + "'; return id == '' end)()",
+              "a MeshId that fails to load reads back empty");
+    step(ws, physics, 200);
+    expectLua("m.Position.Y > 1 and m.Position.Y < 2", "the Lua rock falls onto the floor");
+    shutdownLua();
+
+    // 焼いた形式
+    const MeshAsset& rockMesh = library.asset(rockPart->transform().mesh);
+    fs::path cooked = dir / "rock.mesh";
+    MeshAsset copy;
+    expect(rockMesh.saveCooked(cooked.string()) && copy.loadCooked(cooked.string()) &&
+           copy.indices == rockMesh.indices && copy.nodes.size() == rockMesh.nodes.size(),
+           "a cooked file reads back the same triangles and BVH");
+    std::vector<char> bytes;
+    {
+        std::ifstream in(cooked, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(dir / "truncated.mesh", std::ios::binary);
+        out.write(bytes.data(), (std::streamsize)bytes.size() - 100);
+    }
+    MeshAsset truncated;
+    expect(!truncated.loadCooked((dir / "truncated.mesh").string()), "a truncated cooked file is rejected");
+
+    // 8 ビットを反転させた 200 個: 多くは検査で落とし、読めたもの（頂点のビットなら構わない）もレイと BVH を辿って落ちない
+    std::mt19937 rng(5);
+    int accepted = 0;
+    for (int k = 0; k < 200; ++k) {
+        std::vector<char> flipped = bytes;
+        for (int j = 0; j < 8; ++j) flipped[rng() % flipped.size()] ^= (char)(1u << (rng() % 8));
+        {
+            std::ofstream out(dir / "flipped.mesh", std::ios::binary);
+            out.write(flipped.data(), (std::streamsize)flipped.size());
+        }
+        MeshAsset mesh;
+        if (!mesh.loadCooked((dir / "flipped.mesh").string())) continue;
+        accepted++;
+        float t;
+        Vector3 normal;
+        mesh.raycast(Vector3(0, 2, 0), Vector3(0, -4, 0), 1.0f, t, normal);
+        size_t count = 0;
+        mesh.forEachTriangle(Vector3(-1, -1, -1), Vector3(1, 1, 1), [&](uint32_t triangle) {
+            count += triangle < mesh.triangleCount();
+        });
+    }
+    expect(accepted < 200, "200 bit-flipped cooked files: " + std::to_string(200 - accepted) + " rejected, " +
+           std::to_string(accepted) + " accepted and traversed");
+
+    fs::remove_all(dir);
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
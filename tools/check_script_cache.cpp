@@ -0,0 +1,104 @@
+// tools/check_script_cache.cpp
+// 壊れたキャッシュのエントリ（途中で切れた・1 バイト違う・Lua の版が違う・ヘッダーより短い）を
+// 読まずに捨て、ソースから読み直して同じ結果になるかを確かめる
+//   make check        （または ./tools/check_script_cache）
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/ScriptCache.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    // スクリプトを実行して返した数の和（読めなければ -1）
+    long long runAll(const std::vector<std::string>& paths) {
+        lua_State* L = luaL_newstate();
+        luaL_openlibs(L);
+        long long sum = 0;
+        for (const std::string& path : paths) {
+            if (ScriptCache::get().doFile(L, path) != LUA_OK) {
+                lua_close(L);
+                return -1;
+            }
+            sum += lua_tointeger(L, -1);
+            lua_settop(L, 0);
+        }
+        lua_close(L);
+        return sum;
+    }
+
+    std::string readFile(const fs::path& p) {
+        std::ifstream in(p, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const fs::path& p, const std::string& bytes) {
+        std::ofstream(p, std::ios::binary | std::ios::trunc).write(bytes.data(), (std::streamsize)bytes.size());
+    }
+}
+
+int main() {
+    std::cout << "check_script_cache" << std::endl;
+    fs::path dir = fs::temp_directory_path() / "check_script_cache";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "src");
+
+    std::vector<std::string> paths;
+    long long expected = 0;
+    for (int i = 0; i < 4; ++i) {
+        fs::path p = dir / "src" / ("s" + std::to_string(i) + ".lua");
+        std::ofstream(p) << "local t = {}\nfor k = 1, 10 do t[k] = k * " << i + 1 << " end\n"
+                            "local s = 0\nfor _, v in ipairs(t) do s = s + v end\nreturn s\n";
+        expected += 55 * (i + 1);
+        paths.push_back(p.string());
+    }
+
+    ScriptCache& cache = ScriptCache::get();
+    cache.setDirectory((dir / "luac").string());
+
+    expect(runAll(paths) == expected, "cold run returns the right values");
+    ScriptCache::Stats before = cache.getStats();
+    expect(runAll(paths) == expected && cache.getStats().hits - before.hits == 4, "warm run loads all 4 from the cache");
+
+    // エントリを1つずつ別の壊し方で壊す（ヘッダーは magic[8] の次が luaVersion）
+    std::vector<fs::path> entries;
+    for (const auto& e : fs::directory_iterator(dir / "luac")) entries.push_back(e.path());
+    expect(entries.size() == 4, std::to_string(entries.size()) + " cache entries written");
+    if (entries.size() == 4) {
+        std::string truncated = readFile(entries[0]);
+        writeFile(entries[0], truncated.substr(0, truncated.size() / 2));
+        std::string flipped = readFile(entries[1]);
+        flipped.back() ^= 0x5a;
+        writeFile(entries[1], flipped);
+        std::string version = readFile(entries[2]);
+        version[8] ^= 0x01;
+        writeFile(entries[2], version);
+        writeFile(entries[3], "RBLU");
+
+        before = cache.getStats();
+        expect(runAll(paths) == expected, "corrupt entries fall back to source with the same results");
+        expect(cache.getStats().misses - before.misses == 4, "all 4 corrupt entries were discarded");
+
+        before = cache.getStats();
+        expect(runAll(paths) == expected && cache.getStats().hits - before.hits == 4, "rewritten entries load from the cache again");
+    }
+
+    fs::remove_all(dir);
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+// tools/check_shapes.cpp
+// 形の組ごとに、動くパーツを固定のパーツの上に落として止まった高さを、解析的な値と比べる
+//   - 箱の床（上面 y=1）に: 箱・球・横倒しの円柱・立てた円柱・くさび
+//   - 立てた円柱の平らな上面に: 箱・球・横倒しの円柱
+//   - くさびの斜面に: 球（下っている間の斜面からの距離）・箱（摩擦で止まる）
+//   make check        （または ./tools/check_shapes）
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    std::string fixed(float v) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(3) << v;
+        return s.str();
+    }
+
+    void step(Workspace& ws, Physics& physics, int frames) {
+        for (int f = 0; f < frames; ++f) {
+            physics.simulate(ws, 1.0f / 60.0f);
+            PropertyChangeQueue::dispatch();
+            DestroyQueue::flush();
+        }
+    }
+
+    struct Drop {
+        const char* name;
+        PartShape shape;
+        Vector3 size;
+        Vector3 rotation;
+        float restHalfHeight;   // 止まったときの中心から下の面までの距離
+    };
+
+    // 固定のパーツ base（上面が baseTop、中心から上面まで baseHalfHeight）の上に、ずらして並べたパーツを落として 4 秒待つ
+    void dropOn(const char* baseName, PartShape baseShape, const Vector3& baseSize, const Vector3& baseRotation,
+                float baseHalfHeight, float baseTop, const Drop* drops, int count) {
+        Workspace ws;   // initScene は呼ばない（地形・Ground・プレイヤーなし）
+        global_workspace = &ws;
+        Physics physics;
+        Cube* parts[8];
+        for (int i = 0; i < count; ++i) {
+            float x = 20.0f * i;
+            ws.addPart(CubeBuilder().size(baseSize.x, baseSize.y, baseSize.z).pos(x, baseTop - baseHalfHeight, 0)
+                           .rotation(baseRotation).shape(baseShape).setName(baseName).setStatic().build());
+            parts[i] = ws.addPart(CubeBuilder().size(drops[i].size.x, drops[i].size.y, drops[i].size.z)
+                                      .pos(x, baseTop + drops[i].restHalfHeight + 2.0f, 0).rotation(drops[i].rotation)
+                                      .shape(drops[i].shape).setName(drops[i].name).build());
+        }
+        step(ws, physics, 240);
+        for (int i = 0; i < count; ++i) {
+            float expected = baseTop + drops[i].restHalfHeight;
+            float y = parts[i]->pos().y;
+            bool stayed = std::fabs(parts[i]->pos().x - 20.0f * i) < 1.0f;
+            expect(std::fabs(y - expected) < 0.05f && stayed,
+                   std::string(drops[i].name) + " on " + baseName + ": y " + fixed(y) + " (expected " + fixed(expected) + ")");
+        }
+        global_workspace = nullptr;
+    }
+
+    // くさびの斜面（前 -Z の下の辺から後ろ +Z の上の辺）からの距離
+    float slopeDistance(const Cube& wedge, const Vector3& p) {
+        Vector3 s = wedge.size();
+        Vector3 n = Vector3(0, s.z, -s.y).normalized();
+        Vector3 onSlope = wedge.pos() + Vector3(0, -s.y * 0.5f, -s.z * 0.5f);
+        return (p - onSlope).dot(n);
+    }
+}
+
+int main() {
+    std::cout << "check_shapes" << std::endl;
+
+    const Vector3 level(0, 0, 0), upright(0, 0, 90);
+    const Drop onBlock[] = {
+        { "Block", PartShape::Block, Vector3(2, 2, 2), level, 1.0f },
+        { "Ball", PartShape::Ball, Vector3(4, 4, 4), level, 2.0f },
+        { "Cylinder (side)", PartShape::Cylinder, Vector3(6, 3, 3), level, 1.5f },
+        { "Cylinder (upright)", PartShape::Cylinder, Vector3(4, 2, 2), upright, 2.0f },
+        { "Wedge", PartShape::Wedge, Vector3(4, 2, 4), level, 1.0f },
+    };
+    dropOn("Block", PartShape::Block, Vector3(16, 2, 16), level, 1.0f, 1.0f, onBlock, 5);
+
+    // 立てた円柱（直径 8・長さ 4）の平らな上面
+    const Drop onCylinder[] = {
+        { "Block", PartShape::Block, Vector3(2, 2, 2), level, 1.0f },
+        { "Ball", PartShape::Ball, Vector3(2, 2, 2), level, 1.0f },
+        { "Cylinder (side)", PartShape::Cylinder, Vector3(3, 2, 2), level, 1.0f },
+    };
+    dropOn("Cylinder (upright)", PartShape::Cylinder, Vector3(4, 8, 8), upright, 2.0f, 1.0f, onCylinder, 3);
+
+    // 球は 26.6 度（atan(10/20)）の斜面を下り、箱は 11.3 度（atan(6/30)）の斜面で摩擦（0.5 > tan 11.3）で止まる。
+    // 緩い斜面では、1 サブステップで付く角速度が積分の切り捨て（0.1 rad/s 未満は 0）に消されて球も止まる
+    {
+        Workspace ws;
+        global_workspace = &ws;
+        Physics physics;
+        Cube* wedgeA = ws.addPart(CubeBuilder().size(20, 10, 20).pos(0, 5, 0)
+                                      .shape(PartShape::Wedge).setName("Wedge").setStatic().build());
+        Cube* wedgeB = ws.addPart(CubeBuilder().size(20, 6, 30).pos(40, 3, 0)
+                                      .shape(PartShape::Wedge).setName("Wedge").setStatic().build());
+        Cube* ball = ws.addPart(CubeBuilder().size(2, 2, 2).pos(0, 13, 7).shape(PartShape::Ball).setName("Ball").build());
+        Cube* box = ws.addPart(CubeBuilder().size(2, 2, 2).pos(40, 8, 0).rotation(-11.31f, 0, 0).setName("Block").build());
+
+        // 落ちて斜面で跳ね終わるまで待ってから、下っている間の距離を見る
+        step(ws, physics, 30);
+        float worst = 0.0f;
+        float startZ = ball->pos().z;
+        for (int f = 0; f < 30; ++f) {
+            step(ws, physics, 1);
+            worst = std::max(worst, std::fabs(slopeDistance(*wedgeA, ball->pos()) - 1.0f));
+        }
+        expect(worst < 0.05f && ball->pos().z < startZ - 0.3f,
+               "Ball moving down Wedge: distance to the slope within " + fixed(worst) + " of the radius, moved " +
+               fixed(startZ - ball->pos().z) + " studs");
+
+        step(ws, physics, 180);
+        float d = slopeDistance(*wedgeB, box->pos());
+        expect(std::fabs(d - 1.0f) < 0.05f && box->body()->velocity.length() < 0.5f,
+               "Block resting on Wedge: distance to the slope " + fixed(d) + " (expected 1.000)");
+        global_workspace = nullptr;
+    }
+
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+// tools/check_spatial.cpp
+// SpatialQuery の BVH で引いたレイ・領域の結果が、全パーツを1つずつ調べた結果と同じかを確かめる
+// （作った直後・1割を動かした後（付け直し）・1000 個を壊して 100 個を足した後（はみ出しの葉）・
+//   さらに 1000 個を足した後（作り直し））
+//   make check        （または ./tools/check_spatial）
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "src/Game/Workspace.hpp"
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    // OBB の軸（回転行列の列）と半分の大きさ
+    void boxOf(const Cube& c, Vector3 axes[3], float half[3]) {
+        Matrix3 r = Matrix3::rotate(c.rotation());
+        for (int i = 0; i < 3; ++i) axes[i] = Vector3(r.m[0][i], r.m[1][i], r.m[2][i]);
+        Vector3 h = c.size() * 0.5f;
+        half[0] = h.x; half[1] = h.y; half[2] = h.z;
+    }
+
+    // 全パーツとのスラブ判定。始点が中にあるパーツは当たらない（SpatialQuery と同じ）
+    Cube* plainRaycast(Workspace& ws, const Vector3& origin, const Vector3& direction, float& distance) {
+        float length = direction.length();
+        Vector3 dir = direction / length;
+        Cube* best = nullptr;
+        distance = length;
+        for (Cube& c : ws.cubes) {
+            if (!c.isActive()) continue;
+            Vector3 axes[3];
+            float half[3];
+            boxOf(c, axes, half);
+            Vector3 rel = origin - c.pos();
+            float t0 = -1e30f, t1 = 1e30f;
+            bool miss = false;
+            for (int i = 0; i < 3 && !miss; ++i) {
+                float o = rel.dot(axes[i]), d = dir.dot(axes[i]);
+                if (std::fabs(d) < 1e-9f) {
+                    miss = std::fabs(o) > half[i];
+                    continue;
+                }
+                float a = (-half[i] - o) / d, b = (half[i] - o) / d;
+                if (a > b) std::swap(a, b);
+                t0 = std::max(t0, a);
+                t1 = std::min(t1, b);
+            }
+            if (miss || t0 > t1 || t0 < 0.0f || t0 > distance) continue;
+            distance = t0;
+            best = &c;
+        }
+        return best;
+    }
+
+    // 全パーツの AABB と領域の重なり
+    std::vector<Cube*> plainRegion(Workspace& ws, const Vector3& min, const Vector3& max) {
+        std::vector<Cube*> out;
+        for (Cube& c : ws.cubes) {
+            if (!c.isActive()) continue;
+            Vector3 axes[3];
+            float half[3];
+            boxOf(c, axes, half);
+            Vector3 e(0, 0, 0);
+            for (int i = 0; i < 3; ++i) {
+                e.x += std::fabs(axes[i].x) * half[i];
+                e.y += std::fabs(axes[i].y) * half[i];
+                e.z += std::fabs(axes[i].z) * half[i];
+            }
+            Vector3 lo = c.pos() - e, hi = c.pos() + e;
+            if (lo.x <= max.x && hi.x >= min.x && lo.y <= max.y && hi.y >= min.y && lo.z <= max.z && hi.z >= min.z) {
+                out.push_back(&c);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    // 同じ乱数のレイを BVH と全探索で引き比べ、違った本数を返す
+    int compareRays(Workspace& ws, std::mt19937& rng, int count) {
+        std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+        QueryParams params;
+        int differ = 0;
+        for (int i = 0; i < count; ++i) {
+            Vector3 origin(u(rng) * 260, u(rng) * 40 + 40, u(rng) * 260);
+            Vector3 direction = Vector3(u(rng), u(rng), u(rng)).normalized() * 300.0f;
+            float distance;
+            Cube* expected = plainRaycast(ws, origin, direction, distance);
+            QueryHit hit;
+            bool found = ws.spatial.raycast(origin, direction, params, hit);
+            if (found != (expected != nullptr)) differ++;
+            else if (found && hit.part != expected && std::fabs(hit.distance - distance) > 1e-3f) differ++;
+        }
+        return differ;
+    }
+
+    bool compareRegion(Workspace& ws, const Vector3& min, const Vector3& max, size_t& count) {
+        QueryParams params;
+        std::vector<Cube*> out;
+        ws.spatial.partsInRegion(min, max, params, out);
+        std::sort(out.begin(), out.end());
+        count = out.size();
+        return out == plainRegion(ws, min, max);
+    }
+
+    void report(Workspace& ws, std::mt19937& rng, const std::string& stage) {
+        const int rays = 1000;
+        int differ = compareRays(ws, rng, rays);
+        size_t regionCount = 0;
+        bool region = compareRegion(ws, Vector3(-50, 0, -50), Vector3(50, 30, 50), regionCount);
+        expect(differ == 0 && region, stage + ": " + std::to_string(rays) + " rays, " + std::to_string(differ) +
+               " differ; region " + std::to_string(regionCount) + " parts " + (region ? "match" : "differ"));
+    }
+}
+
+int main() {
+    std::cout << "check_spatial" << std::endl;
+    Workspace ws;   // initScene は呼ばない（地形・Ground なしでパーツだけ）
+    global_workspace = &ws;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+    auto addRandom = [&](const char* name) {
+        return ws.addPart(CubeBuilder()
+                              .size(1 + 3 * std::fabs(u(rng)), 1 + 3 * std::fabs(u(rng)), 1 + 3 * std::fabs(u(rng)))
+                              .pos(u(rng) * 250, 5 + std::fabs(u(rng)) * 60, u(rng) * 250)
+                              .rotation(u(rng) * 180, u(rng) * 180, u(rng) * 180)
+                              .setName(name).setStatic().setSimulated(false).build());
+    };
+    for (int i = 0; i < 5000; ++i) addRandom("P");
+    report(ws, rng, "built");
+
+    // 1割を動かす（付け直し）
+    int k = 0;
+    for (Cube& c : ws.cubes) {
+        if (++k % 10 != 0) continue;
+        c.pos() = c.pos() + Vector3(u(rng) * 5, u(rng) * 5, u(rng) * 5);
+        c.markChanged(Prop_Position);
+    }
+    uint64_t rebuilds = ws.spatial.rebuildCount();
+    report(ws, rng, "10% moved");
+    expect(ws.spatial.rebuildCount() == rebuilds, "moving parts refits without a rebuild");
+
+    // 1000 個を壊して 100 個を足す（空きとはみ出しの葉）
+    k = 0;
+    for (Cube& c : ws.cubes) {
+        if (++k % 5 == 0) c.Destroy();
+    }
+    DestroyQueue::flush();
+    for (int i = 0; i < 100; ++i) addRandom("Q");
+    rebuilds = ws.spatial.rebuildCount();
+    report(ws, rng, "1000 destroyed, 100 added");
+    expect(ws.spatial.rebuildCount() == rebuilds, "small churn relinks without a rebuild");
+    expect(ws.spatial.itemCount() == 4100, "item count " + std::to_string(ws.spatial.itemCount()) + " (want 4100)");
+
+    // はみ出しが増えすぎたら作り直す
+    for (int i = 0; i < 1000; ++i) addRandom("R");
+    report(ws, rng, "1000 more added");
+    expect(ws.spatial.rebuildCount() > rebuilds, "large churn rebuilds the tree");
+
+    global_workspace = nullptr;
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
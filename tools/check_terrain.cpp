@@ -0,0 +1,148 @@
+// tools/check_terrain.cpp
+// initScene の丘で、地形の当たり判定・問い合わせ・編集・Lua の API を確かめる
+//   - 球と速い（CCD の）箱が丘の上に止まり、足元を掘ると箱が落ちる
+//   - レイ・球・箱の掃引が地形に当たり、素材を返す（part は nullptr）
+//   - プレイヤーが丘の上に立つ
+//   - Lua の FillBall / FillBlock は update の後に見え、Clear で全て消える
+//   make check        （または ./tools/check_terrain）
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cmath>
+
+#include "assets/lua-5.4.6/src/lua.hpp"
+#include "src/Game/ScriptRunner.hpp"
+#include "src/Game/Workspace.hpp"
+#include "src/Physics/Physics.hpp"
+
+extern lua_State* G_L;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool ok, const std::string& what) {
+        std::cout << "  " << (ok ? "ok    " : "FAIL  ") << what << std::endl;
+        if (!ok) failures++;
+    }
+
+    void expectLua(const std::string& expression, const std::string& what) {
+        std::string code = "return " + expression;
+        bool ok = luaL_dostring(G_L, code.c_str()) == LUA_OK && lua_toboolean(G_L, -1);
+        if (!ok && lua_isstring(G_L, -1)) std::cout << "        " << lua_tostring(G_L, -1) << std::endl;
+        lua_settop(G_L, 0);
+        expect(ok, what);
+    }
+
+    std::string fixed(float v) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(2) << v;
+        return s.str();
+    }
+
+    void step(Workspace& ws, Physics& physics, int frames) {
+        for (int f = 0; f < frames; ++f) {
+            ws.characters.step(1.0f / 60.0f, ws.gravity);
+            physics.simulate(ws, 1.0f / 60.0f);
+            ws.hierarchy.update();
+            PropertyChangeQueue::dispatch();
+            DestroyQueue::flush();
+        }
+    }
+
+    // (x, z) の列で一番上の固いボクセルの上面
+    float terrainTop(const Terrain& terrain, float x, float z) {
+        int vx = Terrain::toVoxel(x), vz = Terrain::toVoxel(z);
+        int y = 63;
+        while (y >= 0 && terrain.getVoxel(vx, y, vz) == TerrainMaterial::Air) --y;
+        return (y + 1) * Terrain::kVoxelSize;
+    }
+}
+
+int main() {
+    std::cout << "check_terrain" << std::endl;
+    Workspace ws;
+    ws.initScene(0);
+    Physics physics;
+    expect(ws.terrain.chunkCount() > 0 && ws.terrain.boxCount() > 0,
+           "scene hill: " + std::to_string(ws.terrain.solidVoxelCount()) + " voxels in " + std::to_string(ws.terrain.boxCount()) + " boxes");
+
+    Cube* box = ws.addPart(CubeBuilder().size(4, 4, 4).pos(160, 80, -160).setName("DropBox").build());
+    Cube* ball = ws.addPart(CubeBuilder().size(4, 4, 4).pos(120, 80, -140).shape(PartShape::Ball).setName("DropBall").build());
+    Cube* fast = ws.addPart(CubeBuilder().size(1, 1, 1).pos(200, 60, -120).setName("Fast").build());
+    fast->setVelocity(Vector3(0, -600, 0));
+    step(ws, physics, 300);
+
+    float top = terrainTop(ws.terrain, ball->pos().x, ball->pos().z);
+    expect(std::fabs(ball->pos().y - (top + 2.0f)) < 0.1f, "ball rests on the hill at y " + fixed(ball->pos().y) + " (top " + fixed(top) + " + 2)");
+    top = terrainTop(ws.terrain, fast->pos().x, fast->pos().z);
+    expect(std::fabs(fast->pos().y - (top + 0.5f)) < 0.1f,
+           "1-stud box at 600 studs/s stops on the hill at y " + fixed(fast->pos().y) + " (top " + fixed(top) + " + 0.5)");
+    top = terrainTop(ws.terrain, box->pos().x, box->pos().z);
+    expect(box->pos().y > top && box->pos().y < top + 8.0f && box->velocity().length() < 0.5f,
+           "box comes to rest on the hill at y " + fixed(box->pos().y));
+
+    // 足元を掘ると落ちる
+    float before = box->pos().y;
+    ws.terrain.fillBall(box->pos() - Vector3(0, 2, 0), 14.0f, TerrainMaterial::Air);
+    ws.terrain.update();
+    step(ws, physics, 120);
+    expect(box->pos().y < before - 4.0f, "digging under the box drops it from y " + fixed(before) + " to " + fixed(box->pos().y));
+
+    // 問い合わせ（丘の (170, -170) は雪）
+    top = terrainTop(ws.terrain, 170, -170);
+    QueryParams params;
+    QueryHit hit;
+    bool found = ws.spatial.raycast(Vector3(170, 100, -170), Vector3(0, -200, 0), params, hit);
+    expect(found && !hit.part && std::fabs(hit.position.y - top) < 1e-3f && hit.normal.y > 0.99f && hit.material == TerrainMaterial::Snow,
+           "raycast hits the terrain top " + fixed(top) + " with material " + terrainMaterialName(hit.material));
+    found = ws.spatial.spherecast(Vector3(170, 100, -170), 2.0f, Vector3(0, -200, 0), params, hit);
+    // 半径 2 の球は隣の列（一段高い）の角に先に当たることがある
+    expect(found && !hit.part && hit.distance <= 100.0f - 2.0f - top + 1e-3f && hit.position.y >= top - 1e-3f,
+           "spherecast (r 2) hits the terrain at y " + fixed(hit.position.y) + " after " + fixed(hit.distance) + " studs");
+    found = ws.spatial.blockcast(Vector3(170, 100, -170), Vector3(0, 0, 0), Vector3(2, 2, 2), Vector3(0, -200, 0), params, hit);
+    expect(found && !hit.part && std::fabs(hit.distance - (100.0f - 1.0f - top)) < 1e-3f, "blockcast stops 1 stud above the terrain top");
+    params.include = true;
+    expect(!ws.spatial.raycast(Vector3(170, 100, -170), Vector3(0, -200, 0), params, hit), "an include filter with no parts ignores the terrain");
+
+    // プレイヤーを丘の上に置く
+    Cube* root = ws.getPlayer();
+    root->pos() = Vector3(150, 90, -150);
+    root->markChanged(Prop_Position);
+    step(ws, physics, 180);
+    Player* player = ws.getPlayerObject();
+    float foot = root->pos().y - player->controller->height * 0.5f;
+    top = terrainTop(ws.terrain, root->pos().x, root->pos().z);
+    expect(player->controller->isOnGround() && std::fabs(foot - top) < 0.1f,
+           "player stands on the hill (capsule bottom " + fixed(foot) + ", top " + fixed(top) + ")");
+
+    // Lua
+    initLua();
+    luaL_dostring(G_L,
+        "workspace.Terrain:FillBall({X = 0, Y = 20, Z = -40}, 8, 'Sand')\n"
+        "workspace.Terrain:FillBlock({X = 0, Y = 2, Z = 60, RX = 0, RY = 45, RZ = 0}, {X = 16, Y = 4, Z = 16}, 'Rock')");
+    expectLua("workspace.Terrain:ReadVoxel({X = 0, Y = 20, Z = -40}) == 'Sand' and workspace.Terrain:ReadVoxel({X = 0, Y = 60, Z = -40}) == 'Air'",
+              "ReadVoxel sees the edit immediately");
+    expectLua("workspace:Raycast({X = 0, Y = 60, Z = -40}, {X = 0, Y = -100, Z = 0}).Instance.Name == 'Ground'",
+              "before update() the new voxels do not collide");
+    ws.terrain.update();
+    expectLua("(function() local r = workspace:Raycast({X = 0, Y = 60, Z = -40}, {X = 0, Y = -100, Z = 0})\n"
+              "  return r.Instance.Name == 'Terrain' and r.Material == 'Sand' and r.Position.Y == 28 end)()",
+              "after update() a ray hits the sand ball at y 28");
+    expectLua("(function() local r = workspace:Raycast({X = 0, Y = 30, Z = 60}, {X = 0, Y = -100, Z = 0})\n"
+              "  return r.Instance.Name == 'Terrain' and r.Material == 'Rock' and r.Position.Y == 4 end)()",
+              "FillBlock makes a rock slab up to y 4");
+    expectLua("not pcall(function() workspace.Terrain:FillBall({X = 0, Y = 0, Z = 0}, 4, 'Lava') end)", "unknown materials are rejected");
+
+    luaL_dostring(G_L, "workspace.Terrain:Clear()");
+    ws.terrain.update();
+    step(ws, physics, 120);
+    expect(ws.terrain.chunkCount() == 0 && ball->pos().y < 3.0f, "Clear removes every chunk and the ball falls to y " + fixed(ball->pos().y));
+
+    shutdownLua();
+    if (failures) {
+        std::cout << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}